@@ -0,0 +1,543 @@
+#include "audiokernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <QtGlobal>
+
+#include "libmythbase/mythconfig.h"
+#include "libmythbase/mythlogging.h"
+
+extern "C" {
+#include "libavutil/cpu.h"
+}
+
+#if defined(Q_PROCESSOR_X86)
+#   include <immintrin.h>
+#   if defined(__GNUC__) || defined(__clang__)
+#       define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#   else
+#       define KERNEL_TARGET(isa)
+#   endif
+#   define HAVE_KERNELS_X86 1
+#elif defined(Q_PROCESSOR_ARM_64) && HAVE_INTRINSICS_NEON
+#   include <arm_neon.h>
+#   define HAVE_KERNELS_NEON 1
+#endif
+
+#define LOC QString("AudioKernels: ")
+
+// The C kernels are the reference, the SIMD ones finish off with them.
+
+static void c_s16ToFloat(float *out, const int16_t *in, int len)
+{
+    float f = 1.0F / ((1<<15));
+    for (int i = 0; i < len; i++)
+        *out++ = *in++ * f;
+}
+
+// lrintf() returns a long, which may be wider than 32 bits
+static inline short clip_short(long a)
+{
+    return static_cast<short>(std::clamp<long>(a, INT16_MIN, INT16_MAX));
+}
+
+static void c_floatToS16(int16_t *out, const float *in, int len)
+{
+    float f = (1<<15);
+    for (int i = 0; i < len; i++)
+        *out++ = clip_short(lrintf(*in++ * f));
+}
+
+static void c_s32ToFloat(float *out, const int32_t *in, int len, int bits,
+                         int shift)
+{
+    float f = 1.0F / ((uint)(1<<(bits-1)));
+    for (int i = 0; i < len; i++)
+        *out++ = (*in++ >> shift) * f;
+}
+
+static void c_floatToS32(int32_t *out, const float *in, int len, int bits,
+                         int shift)
+{
+    float f = (uint)(1<<(bits-1));
+    uint range = 1<<(bits-1);
+    for (int i = 0; i < len; i++)
+    {
+        float valf = *in++;
+
+        if (valf >= 1.0F)
+        {
+            *out++ = (range - 128) << shift;
+            continue;
+        }
+        if (valf <= -1.0F)
+        {
+            *out++ = (-range) << shift;
+            continue;
+        }
+        *out++ = lrintf(valf * f) << shift;
+    }
+}
+
+static void c_clipFloat(float *out, const float *in, int len)
+{
+    for (int i = 0; i < len; i++)
+        *out++ = std::clamp(*in++, -1.0F, 1.0F);
+}
+
+static void c_scale(float *buffer, int len, float gain)
+{
+    for (int i = 0; i < len; i++)
+        *buffer++ *= gain;
+}
+
+static void c_downmixStereo(float *dst, const float *src, int frames,
+                            int channels, const float *matrix)
+{
+    for (int n = 0; n < frames; n++)
+    {
+        for (int i = 0; i < 2; i++)
+        {
+            float tmp = 0.0F;
+            for (int j = 0; j < channels; j++)
+                tmp += src[j] * matrix[(j * 2) + i];
+            *dst++ = tmp;
+        }
+        src += channels;
+    }
+}
+
+static const AudioKernels s_cKernels
+{
+    "C",
+    c_s16ToFloat, c_floatToS16, c_s32ToFloat, c_floatToS32,
+    c_clipFloat, c_scale, c_downmixStereo
+};
+
+#if HAVE_KERNELS_X86
+/*
+ * SSE2
+ *
+ * Rounding relies on the default MXCSR mode, round to nearest even, which
+ * is what lrintf() uses too. Values are clamped before any conversion that
+ * could overflow, so that saturation matches the C code.
+ */
+
+KERNEL_TARGET("sse2")
+static void sse2_s16ToFloat(float *out, const int16_t *in, int len)
+{
+    const __m128 f = _mm_set1_ps(1.0F / ((1<<15)));
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        _mm_storeu_ps(out + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), f));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), f));
+    }
+    c_s16ToFloat(out + i, in + i, len - i);
+}
+
+KERNEL_TARGET("sse2")
+static void sse2_floatToS16(int16_t *out, const float *in, int len)
+{
+    const __m128 f = _mm_set1_ps(1<<15);
+    const __m128 hi = _mm_set1_ps(2.0F);
+    const __m128 lo = _mm_set1_ps(-2.0F);
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        __m128 a = _mm_max_ps(lo, _mm_min_ps(hi, _mm_loadu_ps(in + i)));
+        __m128 b = _mm_max_ps(lo, _mm_min_ps(hi, _mm_loadu_ps(in + i + 4)));
+        __m128i ia = _mm_cvtps_epi32(_mm_mul_ps(a, f));
+        __m128i ib = _mm_cvtps_epi32(_mm_mul_ps(b, f));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_packs_epi32(ia, ib));
+    }
+    c_floatToS16(out + i, in + i, len - i);
+}
+
+KERNEL_TARGET("sse2")
+static void sse2_s32ToFloat(float *out, const int32_t *in, int len, int bits,
+                            int shift)
+{
+    const __m128 f = _mm_set1_ps(1.0F / ((uint)(1<<(bits-1))));
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        s = _mm_sra_epi32(s, count);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(s), f));
+    }
+    c_s32ToFloat(out + i, in + i, len - i, bits, shift);
+}
+
+KERNEL_TARGET("sse2")
+static void sse2_floatToS32(int32_t *out, const float *in, int len, int bits,
+                            int shift)
+{
+    uint range = 1<<(bits-1);
+    const __m128 f = _mm_set1_ps((uint)(1<<(bits-1)));
+    const __m128 one = _mm_set1_ps(1.0F);
+    const __m128 mone = _mm_set1_ps(-1.0F);
+    const __m128i high = _mm_set1_epi32(static_cast<int>((range - 128) << shift));
+    const __m128i low = _mm_set1_epi32(static_cast<int>((-range) << shift));
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        __m128 v = _mm_loadu_ps(in + i);
+        __m128i s = _mm_sll_epi32(_mm_cvtps_epi32(_mm_mul_ps(v, f)), count);
+        __m128i ishigh = _mm_castps_si128(_mm_cmpge_ps(v, one));
+        __m128i islow = _mm_castps_si128(_mm_cmple_ps(v, mone));
+        s = _mm_or_si128(_mm_andnot_si128(ishigh, s), _mm_and_si128(ishigh, high));
+        s = _mm_or_si128(_mm_andnot_si128(islow, s), _mm_and_si128(islow, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), s);
+    }
+    c_floatToS32(out + i, in + i, len - i, bits, shift);
+}
+
+KERNEL_TARGET("sse2")
+static void sse2_clipFloat(float *out, const float *in, int len)
+{
+    const __m128 hi = _mm_set1_ps(1.0F);
+    const __m128 lo = _mm_set1_ps(-1.0F);
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+        _mm_storeu_ps(out + i, _mm_max_ps(lo, _mm_min_ps(hi, _mm_loadu_ps(in + i))));
+    c_clipFloat(out + i, in + i, len - i);
+}
+
+KERNEL_TARGET("sse2")
+static void sse2_scale(float *buffer, int len, float gain)
+{
+    const __m128 g = _mm_set1_ps(gain);
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+        _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), g));
+    c_scale(buffer + i, len - i, gain);
+}
+
+// Two frames at a time, as L0 R0 L1 R1, adding the channels up in the
+// same order as the C code.
+KERNEL_TARGET("sse2")
+static void sse2_downmixStereo(float *dst, const float *src, int frames,
+                               int channels, const float *matrix)
+{
+    int n = 0;
+    for (; n + 2 <= frames; n += 2)
+    {
+        __m128 acc = _mm_setzero_ps();
+        for (int j = 0; j < channels; j++)
+        {
+            __m128 s = _mm_set_ps(src[channels + j], src[channels + j],
+                                  src[j], src[j]);
+            __m128 m = _mm_set_ps(matrix[(j * 2) + 1], matrix[j * 2],
+                                  matrix[(j * 2) + 1], matrix[j * 2]);
+            acc = _mm_add_ps(acc, _mm_mul_ps(s, m));
+        }
+        _mm_storeu_ps(dst, acc);
+        dst += 4;
+        src += 2 * channels;
+    }
+    c_downmixStereo(dst, src, frames - n, channels, matrix);
+}
+
+static const AudioKernels s_sse2Kernels
+{
+    "SSE2",
+    sse2_s16ToFloat, sse2_floatToS16, sse2_s32ToFloat, sse2_floatToS32,
+    sse2_clipFloat, sse2_scale, sse2_downmixStereo
+};
+
+/*
+ * AVX2
+ */
+
+KERNEL_TARGET("avx2")
+static void avx2_s16ToFloat(float *out, const int16_t *in, int len)
+{
+    const __m256 f = _mm256_set1_ps(1.0F / ((1<<15)));
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+        _mm256_storeu_ps(out + i,
+                         _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(a)), f));
+        _mm256_storeu_ps(out + i + 8,
+                         _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(b)), f));
+    }
+    c_s16ToFloat(out + i, in + i, len - i);
+}
+
+KERNEL_TARGET("avx2")
+static void avx2_floatToS16(int16_t *out, const float *in, int len)
+{
+    const __m256 f = _mm256_set1_ps(1<<15);
+    const __m256 hi = _mm256_set1_ps(2.0F);
+    const __m256 lo = _mm256_set1_ps(-2.0F);
+    int i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m256 a = _mm256_max_ps(lo, _mm256_min_ps(hi, _mm256_loadu_ps(in + i)));
+        __m256 b = _mm256_max_ps(lo, _mm256_min_ps(hi, _mm256_loadu_ps(in + i + 8)));
+        __m256i ia = _mm256_cvtps_epi32(_mm256_mul_ps(a, f));
+        __m256i ib = _mm256_cvtps_epi32(_mm256_mul_ps(b, f));
+        // packs works within each 128 bit lane, put the quarters back in order
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(ia, ib), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+    }
+    c_floatToS16(out + i, in + i, len - i);
+}
+
+KERNEL_TARGET("avx2")
+static void avx2_s32ToFloat(float *out, const int32_t *in, int len, int bits,
+                            int shift)
+{
+    const __m256 f = _mm256_set1_ps(1.0F / ((uint)(1<<(bits-1))));
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        s = _mm256_sra_epi32(s, count);
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(s), f));
+    }
+    c_s32ToFloat(out + i, in + i, len - i, bits, shift);
+}
+
+KERNEL_TARGET("avx2")
+static void avx2_floatToS32(int32_t *out, const float *in, int len, int bits,
+                            int shift)
+{
+    uint range = 1<<(bits-1);
+    const __m256 f = _mm256_set1_ps((uint)(1<<(bits-1)));
+    const __m256 one = _mm256_set1_ps(1.0F);
+    const __m256 mone = _mm256_set1_ps(-1.0F);
+    const __m256 high = _mm256_castsi256_ps(
+        _mm256_set1_epi32(static_cast<int>((range - 128) << shift)));
+    const __m256 low = _mm256_castsi256_ps(
+        _mm256_set1_epi32(static_cast<int>((-range) << shift)));
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        __m256 v = _mm256_loadu_ps(in + i);
+        __m256i s = _mm256_sll_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(v, f)), count);
+        __m256 r = _mm256_castsi256_ps(s);
+        r = _mm256_blendv_ps(r, high, _mm256_cmp_ps(v, one, _CMP_GE_OQ));
+        r = _mm256_blendv_ps(r, low, _mm256_cmp_ps(v, mone, _CMP_LE_OQ));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + i), r);
+    }
+    c_floatToS32(out + i, in + i, len - i, bits, shift);
+}
+
+KERNEL_TARGET("avx2")
+static void avx2_clipFloat(float *out, const float *in, int len)
+{
+    const __m256 hi = _mm256_set1_ps(1.0F);
+    const __m256 lo = _mm256_set1_ps(-1.0F);
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        _mm256_storeu_ps(out + i,
+                         _mm256_max_ps(lo, _mm256_min_ps(hi, _mm256_loadu_ps(in + i))));
+    }
+    c_clipFloat(out + i, in + i, len - i);
+}
+
+KERNEL_TARGET("avx2")
+static void avx2_scale(float *buffer, int len, float gain)
+{
+    const __m256 g = _mm256_set1_ps(gain);
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+        _mm256_storeu_ps(buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), g));
+    c_scale(buffer + i, len - i, gain);
+}
+
+// Four frames at a time, gathering each channel twice for left and right.
+KERNEL_TARGET("avx2")
+static void avx2_downmixStereo(float *dst, const float *src, int frames,
+                               int channels, const float *matrix)
+{
+    const __m256i index = _mm256_set_epi32(3 * channels, 3 * channels,
+                                           2 * channels, 2 * channels,
+                                           channels, channels, 0, 0);
+    int n = 0;
+    for (; n + 4 <= frames; n += 4)
+    {
+        __m256 acc = _mm256_setzero_ps();
+        for (int j = 0; j < channels; j++)
+        {
+            __m256 s = _mm256_i32gather_ps(src + j, index, 4);
+            __m256 m = _mm256_castpd_ps(_mm256_broadcast_sd(
+                reinterpret_cast<const double*>(matrix + (j * 2))));
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(s, m));
+        }
+        _mm256_storeu_ps(dst, acc);
+        dst += 8;
+        src += 4 * channels;
+    }
+    c_downmixStereo(dst, src, frames - n, channels, matrix);
+}
+
+static const AudioKernels s_avx2Kernels
+{
+    "AVX2",
+    avx2_s16ToFloat, avx2_floatToS16, avx2_s32ToFloat, avx2_floatToS32,
+    avx2_clipFloat, avx2_scale, avx2_downmixStereo
+};
+#endif // HAVE_KERNELS_X86
+
+#if HAVE_KERNELS_NEON
+/*
+ * NEON
+ *
+ * vcvtnq rounds to nearest even like lrintf() and saturates, which only
+ * matters where the C code clamps anyway.
+ */
+
+static void neon_s16ToFloat(float *out, const int16_t *in, int len)
+{
+    const float f = 1.0F / ((1<<15));
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        int16x8_t s = vld1q_s16(in + i);
+        vst1q_f32(out + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), f));
+        vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), f));
+    }
+    c_s16ToFloat(out + i, in + i, len - i);
+}
+
+static void neon_floatToS16(int16_t *out, const float *in, int len)
+{
+    const float f = (1<<15);
+    int i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        int32x4_t a = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + i), f));
+        int32x4_t b = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + i + 4), f));
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+    }
+    c_floatToS16(out + i, in + i, len - i);
+}
+
+static void neon_s32ToFloat(float *out, const int32_t *in, int len, int bits,
+                            int shift)
+{
+    const float f = 1.0F / ((uint)(1<<(bits-1)));
+    const int32x4_t count = vdupq_n_s32(-shift);
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        int32x4_t s = vshlq_s32(vld1q_s32(in + i), count);
+        vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(s), f));
+    }
+    c_s32ToFloat(out + i, in + i, len - i, bits, shift);
+}
+
+static void neon_floatToS32(int32_t *out, const float *in, int len, int bits,
+                            int shift)
+{
+    uint range = 1<<(bits-1);
+    const float f = (uint)(1<<(bits-1));
+    const int32x4_t high = vdupq_n_s32(static_cast<int>((range - 128) << shift));
+    const int32x4_t low = vdupq_n_s32(static_cast<int>((-range) << shift));
+    const int32x4_t count = vdupq_n_s32(shift);
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        float32x4_t v = vld1q_f32(in + i);
+        int32x4_t s = vshlq_s32(vcvtnq_s32_f32(vmulq_n_f32(v, f)), count);
+        s = vbslq_s32(vcgeq_f32(v, vdupq_n_f32(1.0F)), high, s);
+        s = vbslq_s32(vcleq_f32(v, vdupq_n_f32(-1.0F)), low, s);
+        vst1q_s32(out + i, s);
+    }
+    c_floatToS32(out + i, in + i, len - i, bits, shift);
+}
+
+static void neon_clipFloat(float *out, const float *in, int len)
+{
+    const float32x4_t hi = vdupq_n_f32(1.0F);
+    const float32x4_t lo = vdupq_n_f32(-1.0F);
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+        vst1q_f32(out + i, vmaxq_f32(lo, vminq_f32(hi, vld1q_f32(in + i))));
+    c_clipFloat(out + i, in + i, len - i);
+}
+
+static void neon_scale(float *buffer, int len, float gain)
+{
+    int i = 0;
+    for (; i + 4 <= len; i += 4)
+        vst1q_f32(buffer + i, vmulq_n_f32(vld1q_f32(buffer + i), gain));
+    c_scale(buffer + i, len - i, gain);
+}
+
+static void neon_downmixStereo(float *dst, const float *src, int frames,
+                               int channels, const float *matrix)
+{
+    int n = 0;
+    for (; n + 2 <= frames; n += 2)
+    {
+        float32x4_t acc = vdupq_n_f32(0.0F);
+        for (int j = 0; j < channels; j++)
+        {
+            float32x4_t s = vcombine_f32(vdup_n_f32(src[j]),
+                                         vdup_n_f32(src[channels + j]));
+            float32x2_t m = vld1_f32(matrix + (j * 2));
+            acc = vaddq_f32(acc, vmulq_f32(s, vcombine_f32(m, m)));
+        }
+        vst1q_f32(dst, acc);
+        dst += 4;
+        src += 2 * channels;
+    }
+    c_downmixStereo(dst, src, frames - n, channels, matrix);
+}
+
+static const AudioKernels s_neonKernels
+{
+    "NEON",
+    neon_s16ToFloat, neon_floatToS16, neon_s32ToFloat, neon_floatToS32,
+    neon_clipFloat, neon_scale, neon_downmixStereo
+};
+#endif // HAVE_KERNELS_NEON
+
+/**
+ * The kernels this processor can run, the C kernels first and the
+ * fastest last.
+ */
+std::vector<const AudioKernels*> AudioKernels::Available(void)
+{
+    std::vector<const AudioKernels*> kernels { &s_cKernels };
+    [[maybe_unused]] int flags = av_get_cpu_flags();
+#if HAVE_KERNELS_X86
+    if (flags & AV_CPU_FLAG_SSE2)
+        kernels.push_back(&s_sse2Kernels);
+    if (flags & AV_CPU_FLAG_AVX2)
+        kernels.push_back(&s_avx2Kernels);
+#elif HAVE_KERNELS_NEON
+    if (flags & AV_CPU_FLAG_NEON)
+        kernels.push_back(&s_neonKernels);
+#endif
+    return kernels;
+}
+
+const AudioKernels &AudioKernels::Get(void)
+{
+    static const AudioKernels &s_kernels = []() -> const AudioKernels &
+    {
+        const AudioKernels *best = Available().back();
+        LOG(VB_AUDIO, LOG_INFO, LOC + QString("Using %1 kernels")
+            .arg(best->m_name));
+        return *best;
+    }();
+    return s_kernels;
+}
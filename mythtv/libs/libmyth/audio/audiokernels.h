@@ -0,0 +1,47 @@
+#ifndef AUDIOKERNELS_H
+#define AUDIOKERNELS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "libmyth/mythexp.h"
+
+/** \struct AudioKernels
+ *  \brief The inner loops of sample conversion, downmixing and volume
+ *         scaling.
+ *
+ *  There is a plain C version of every routine and, depending on the
+ *  processor, SSE2, AVX2 or NEON versions. The best set the CPU supports
+ *  is picked the first time Get() is called.
+ *
+ *  All versions produce bit identical results for finite input, so the
+ *  choice of kernels never changes the audio.
+ */
+struct MPUBLIC AudioKernels
+{
+    const char *m_name;
+
+    /// 16 bit integers to floats in [-1, 1)
+    void  (*m_s16ToFloat)(float *out, const int16_t *in, int len);
+    /// floats to 16 bit integers, rounding to nearest and saturating
+    void  (*m_floatToS16)(int16_t *out, const float *in, int len);
+    /// \a bits bit integers, stored \a shift bits up, to floats
+    void  (*m_s32ToFloat)(float *out, const int32_t *in, int len,
+                          int bits, int shift);
+    /// floats to \a bits bit integers stored \a shift bits up, saturating
+    void  (*m_floatToS32)(int32_t *out, const float *in, int len,
+                          int bits, int shift);
+    /// clamp floats to [-1, 1]
+    void  (*m_clipFloat)(float *out, const float *in, int len);
+    /// multiply floats, in place, by \a gain
+    void  (*m_scale)(float *buffer, int len, float gain);
+    /// mix interleaved frames of \a channels down to stereo; \a matrix holds
+    /// the left and right weight of each input channel
+    void  (*m_downmixStereo)(float *dst, const float *src, int frames,
+                             int channels, const float *matrix);
+
+    static const AudioKernels &Get(void);
+    static std::vector<const AudioKernels*> Available(void);
+};
+
+#endif // AUDIOKERNELS_H
@@ -821,10 +821,16 @@ void AudioOutputBase::Reconfigure(const AudioSettings &orig_settings)
     if (m_needsUpmix && m_configuredChannels > 2)
     {
         m_surroundMode = gCoreContext->GetNumSetting("AudioUpmixType", QUALITY_HIGH);
+        // Half size blocks halve the upmixer latency, at the cost of
+        // frequency resolution
+        uint blockSize = SURROUND_BUFSIZE;
+        if (gCoreContext->GetBoolSetting("AudioUpmixLowLatency", false))
+            blockSize /= 2;
         m_upmixer = new FreeSurround(m_sampleRate, m_source == AUDIOOUTPUT_VIDEO,
-                                   (FreeSurround::SurroundMode)m_surroundMode);
-        VBAUDIO(QString("Create %1 quality upmixer done")
-                .arg(quality_string(m_surroundMode)));
+                                   (FreeSurround::SurroundMode)m_surroundMode,
+                                   blockSize);
+        VBAUDIO(QString("Create %1 quality upmixer done, %2 sample blocks")
+                .arg(quality_string(m_surroundMode)).arg(blockSize));
     }
 
     VBAUDIO(QString("Audio Stretch Factor: %1").arg(m_stretchFactor));
@@ -21,6 +21,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include <cstring>
 
+#include "audiokernels.h"
+
 #define LOC QString("Downmixer: ")
 
 /*
@@ -177,17 +179,8 @@ int AudioOutputDownmix::DownmixFrames(int channels_in, int  channels_out,
     if (channels_out == 2)
     {
         int index = channels_in - 1;
-        for (int n=0; n < frames; n++)
-        {
-            for (int i=0; i < channels_out; i++)
-            {
-                float tmp = 0.0F;
-                for (int j=0; j < channels_in; j++)
-                    tmp += src[j] * stereo_matrix[index][j][i];
-                *dst++ = tmp;
-            }
-            src += channels_in;
-        }
+        AudioKernels::Get().m_downmixStereo(dst, src, frames, channels_in,
+                                            stereo_matrix[index][0].data());
     }
     else if (channels_out == 6)
     {
@@ -9,6 +9,7 @@
 #include "libmythbase/mythlogging.h"
 
 #include "audioconvert.h"
+#include "audiokernels.h"
 #include "mythaverror.h"
 
 extern "C" {
@@ -18,43 +19,13 @@ extern "C" {
 
 #define LOC QString("AOUtil: ")
 
-#ifdef Q_PROCESSOR_X86
-// Check cpuid for SSE2 support on x86 / x86_64
-static inline bool sse2_check()
-{
-#ifdef Q_PROCESSOR_X86_64
-    return true;
-#else
-    static int has_sse2 = -1;
-    if (has_sse2 != -1)
-        return (bool)has_sse2;
-    __asm__(
-        // -fPIC - we may not clobber ebx/rbx
-        "push       %%ebx               \n\t"
-        "mov        $1, %%eax           \n\t"
-        "cpuid                          \n\t"
-        "and        $0x4000000, %%edx   \n\t"
-        "shr        $26, %%edx          \n\t"
-        "pop        %%ebx               \n\t"
-        :"=d"(has_sse2)
-        ::"%eax","%ecx"
-    );
-    return (bool)has_sse2;
-#endif
-}
-#endif //Q_PROCESSOR_X86
-
 /**
  * Returns true if the processor supports MythTV's optimized SIMD for AudioOutputUtil/AudioConvert.
- * Currently, only SSE2 is implemented.
+ * SSE2, AVX2 and NEON are implemented, see AudioKernels.
  */
 bool AudioOutputUtil::has_optimized_SIMD()
 {
-#ifdef Q_PROCESSOR_X86
-    return sse2_check();
-#else
-    return false;
-#endif
+    return AudioKernels::Available().size() > 1;
 }
 
 /**
@@ -99,7 +70,6 @@ void AudioOutputUtil::AdjustVolume(void *buf, int len, int volume,
     float g     = volume / 100.0F;
     auto *fptr  = (float *)buf;
     int samples = len >> 2;
-    int i       = 0;
 
     // Should be exponential - this'll do
     g *= g;
@@ -115,40 +85,7 @@ void AudioOutputUtil::AdjustVolume(void *buf, int len, int volume,
     if (g == 1.0F)
         return;
 
-#ifdef Q_PROCESSOR_X86
-    if (sse2_check() && samples >= 16)
-    {
-        int loops = samples >> 4;
-        i = loops << 4;
-
-        __asm__ volatile (
-            "movss      %2, %%xmm0          \n\t"
-            "punpckldq  %%xmm0, %%xmm0      \n\t"
-            "punpckldq  %%xmm0, %%xmm0      \n\t"
-            "1:                             \n\t"
-            "movups     (%0), %%xmm1        \n\t"
-            "movups     16(%0), %%xmm2      \n\t"
-            "mulps      %%xmm0, %%xmm1      \n\t"
-            "movups     32(%0), %%xmm3      \n\t"
-            "mulps      %%xmm0, %%xmm2      \n\t"
-            "movups     48(%0), %%xmm4      \n\t"
-            "mulps      %%xmm0, %%xmm3      \n\t"
-            "movups     %%xmm1, (%0)        \n\t"
-            "mulps      %%xmm0, %%xmm4      \n\t"
-            "movups     %%xmm2, 16(%0)      \n\t"
-            "movups     %%xmm3, 32(%0)      \n\t"
-            "movups     %%xmm4, 48(%0)      \n\t"
-            "add        $64,    %0          \n\t"
-            "sub        $1, %%ecx           \n\t"
-            "jnz        1b                  \n\t"
-            :"+r"(fptr)
-            :"c"(loops),"m"(g)
-            :"xmm0","xmm1","xmm2","xmm3","xmm4"
-        );
-    }
-#endif //Q_PROCESSOR_X86
-    for (; i < samples; i++)
-        *fptr++ *= g;
+    AudioKernels::Get().m_scale(fptr, samples, g);
 }
 
 template <class AudioDataType>
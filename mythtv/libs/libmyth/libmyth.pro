@@ -31,7 +31,7 @@ contains(INCLUDEPATH, /usr/X11R6/include) {
 # Input
 HEADERS += audio/audiooutput.h audio/audiooutputbase.h audio/audiooutputnull.h
 HEADERS += audio/audiooutpututil.h audio/audiooutputdownmix.h
-HEADERS += audio/audioconvert.h
+HEADERS += audio/audioconvert.h audio/audiokernels.h
 HEADERS += audio/audiooutputdigitalencoder.h audio/spdifencoder.h
 HEADERS += audio/audiosettings.h audio/audiooutputsettings.h audio/pink.h
 HEADERS += audio/volumebase.h audio/eldutils.h
@@ -55,7 +55,7 @@ SOURCES += audio/audiooutput.cpp audio/audiooutputbase.cpp
 SOURCES += audio/spdifencoder.cpp audio/audiooutputdigitalencoder.cpp
 SOURCES += audio/audiooutputnull.cpp
 SOURCES += audio/audiooutpututil.cpp audio/audiooutputdownmix.cpp
-SOURCES += audio/audioconvert.cpp
+SOURCES += audio/audioconvert.cpp audio/audiokernels.cpp
 SOURCES += audio/audiosettings.cpp audio/audiooutputsettings.cpp audio/pink.cpp
 SOURCES += audio/volumebase.cpp audio/eldutils.cpp
 SOURCES += audio/audiooutputgraph.cpp
@@ -114,7 +114,7 @@ inc.files += standardsettings.h
 inc2.path = $${PREFIX}/include/mythtv/libmyth/audio
 inc2.files += audio/audiooutput.h audio/audiosettings.h
 inc2.files += audio/audiooutputsettings.h audio/audiooutpututil.h
-inc2.files += audio/audioconvert.h
+inc2.files += audio/audioconvert.h audio/audiokernels.h
 inc2.files += audio/volumebase.h audio/eldutils.h
 
 using_oss {
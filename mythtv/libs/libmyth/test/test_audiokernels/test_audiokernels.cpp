@@ -0,0 +1,311 @@
+/*
+ *  Class TestAudioKernels
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "test_audiokernels.h"
+#include "libmyth/audio/audiokernels.h"
+
+Q_DECLARE_METATYPE(const AudioKernels*)
+
+// Odd lengths exercise the scalar tails of the vector loops
+static constexpr std::array<int,13> kLengths
+    { 0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 33, 100, 4099 };
+
+// Values at and around the clipping and rounding points
+static constexpr std::array<float,17> kSpecial
+{
+    1.0F, -1.0F, 0.99999994F, -0.99999994F, 2.0F, -2.0F, 3.5F, -7.0F,
+    1e6F, -1e6F, 0.5F / 32768, 1.5F / 32768, 2.5F / 32768, -0.5F / 32768,
+    0.0F, -0.0F, 8388607.5F / 8388608
+};
+
+static std::vector<float> Floats(int len, float range = 1.2F)
+{
+    std::vector<float> buffer(len);
+    uint32_t seed = 0x1234567;
+    for (int i = 0; i < len; i++)
+    {
+        seed = (seed * 1664525) + 1013904223;
+        if (i % 5 == 0)
+            buffer[i] = kSpecial[(i / 5) % kSpecial.size()];
+        else
+            buffer[i] = range * ((static_cast<float>(seed >> 8) / (1 << 23)) - 1.0F);
+    }
+    return buffer;
+}
+
+template <typename T>
+static std::vector<T> Integers(int len)
+{
+    std::vector<T> buffer(len);
+    uint32_t seed = 0x7654321;
+    for (int i = 0; i < len; i++)
+    {
+        seed = (seed * 1664525) + 1013904223;
+        buffer[i] = static_cast<T>(seed);
+    }
+    return buffer;
+}
+
+template <typename T>
+static bool Identical(const std::vector<T> &a, const std::vector<T> &b)
+{
+    return a.size() == b.size() &&
+        std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+static void AddKernelRows(void)
+{
+    QTest::addColumn<const AudioKernels*>("kernels");
+    for (const auto *kernels : AudioKernels::Available())
+        QTest::newRow(kernels->m_name) << kernels;
+}
+
+static const AudioKernels &Reference(void)
+{
+    return *AudioKernels::Available().front();
+}
+
+void TestAudioKernels::Selection(void)
+{
+    auto available = AudioKernels::Available();
+    QVERIFY(!available.empty());
+    QCOMPARE(QString(available.front()->m_name), QString("C"));
+    QCOMPARE(&AudioKernels::Get(), available.back());
+}
+
+void TestAudioKernels::S16ToFloat_data(void)
+{
+    AddKernelRows();
+}
+
+void TestAudioKernels::S16ToFloat(void)
+{
+    QFETCH(const AudioKernels*, kernels);
+
+    for (int len : kLengths)
+    {
+        auto in = Integers<int16_t>(len);
+        std::vector<float> expected(len);
+        std::vector<float> out(len);
+        Reference().m_s16ToFloat(expected.data(), in.data(), len);
+        kernels->m_s16ToFloat(out.data(), in.data(), len);
+        QVERIFY2(Identical(out, expected), qPrintable(QString::number(len)));
+    }
+}
+
+void TestAudioKernels::FloatToS16_data(void)
+{
+    AddKernelRows();
+}
+
+void TestAudioKernels::FloatToS16(void)
+{
+    QFETCH(const AudioKernels*, kernels);
+
+    for (int len : kLengths)
+    {
+        auto in = Floats(len);
+        std::vector<int16_t> expected(len);
+        std::vector<int16_t> out(len);
+        Reference().m_floatToS16(expected.data(), in.data(), len);
+        kernels->m_floatToS16(out.data(), in.data(), len);
+        QVERIFY2(Identical(out, expected), qPrintable(QString::number(len)));
+    }
+}
+
+void TestAudioKernels::S32ToFloat_data(void)
+{
+    QTest::addColumn<const AudioKernels*>("kernels");
+    QTest::addColumn<int>("bits");
+    QTest::addColumn<int>("shift");
+    for (const auto *kernels : AudioKernels::Available())
+    {
+        QTest::addRow("%s S24", kernels->m_name) << kernels << 24 << 8;
+        QTest::addRow("%s S24LSB", kernels->m_name) << kernels << 24 << 0;
+        QTest::addRow("%s S32", kernels->m_name) << kernels << 32 << 0;
+    }
+}
+
+void TestAudioKernels::S32ToFloat(void)
+{
+    QFETCH(const AudioKernels*, kernels);
+    QFETCH(int, bits);
+    QFETCH(int, shift);
+
+    for (int len : kLengths)
+    {
+        auto in = Integers<int32_t>(len);
+        // S24LSB samples are sign extended
+        if (bits == 24 && shift == 0)
+            for (auto &sample : in)
+                sample >>= 8;
+        std::vector<float> expected(len);
+        std::vector<float> out(len);
+        Reference().m_s32ToFloat(expected.data(), in.data(), len, bits, shift);
+        kernels->m_s32ToFloat(out.data(), in.data(), len, bits, shift);
+        QVERIFY2(Identical(out, expected), qPrintable(QString::number(len)));
+    }
+}
+
+void TestAudioKernels::FloatToS32_data(void)
+{
+    S32ToFloat_data();
+}
+
+void TestAudioKernels::FloatToS32(void)
+{
+    QFETCH(const AudioKernels*, kernels);
+    QFETCH(int, bits);
+    QFETCH(int, shift);
+
+    for (int len : kLengths)
+    {
+        auto in = Floats(len);
+        std::vector<int32_t> expected(len);
+        std::vector<int32_t> out(len);
+        Reference().m_floatToS32(expected.data(), in.data(), len, bits, shift);
+        kernels->m_floatToS32(out.data(), in.data(), len, bits, shift);
+        QVERIFY2(Identical(out, expected), qPrintable(QString::number(len)));
+    }
+}
+
+void TestAudioKernels::ClipFloat_data(void)
+{
+    AddKernelRows();
+}
+
+void TestAudioKernels::ClipFloat(void)
+{
+    QFETCH(const AudioKernels*, kernels);
+
+    for (int len : kLengths)
+    {
+        auto in = Floats(len, 2.0F);
+        std::vector<float> expected(len);
+        std::vector<float> out(len);
+        Reference().m_clipFloat(expected.data(), in.data(), len);
+        kernels->m_clipFloat(out.data(), in.data(), len);
+        QVERIFY2(Identical(out, expected), qPrintable(QString::number(len)));
+        for (float sample : out)
+            QVERIFY(sample >= -1.0F && sample <= 1.0F);
+    }
+}
+
+void TestAudioKernels::Scale_data(void)
+{
+    AddKernelRows();
+}
+
+void TestAudioKernels::Scale(void)
+{
+    QFETCH(const AudioKernels*, kernels);
+
+    for (int len : kLengths)
+    {
+        auto expected = Floats(len);
+        auto out = expected;
+        Reference().m_scale(expected.data(), len, 0.3F);
+        kernels->m_scale(out.data(), len, 0.3F);
+        QVERIFY2(Identical(out, expected), qPrintable(QString::number(len)));
+    }
+}
+
+void TestAudioKernels::DownmixStereo_data(void)
+{
+    QTest::addColumn<const AudioKernels*>("kernels");
+    QTest::addColumn<int>("channels");
+    for (const auto *kernels : AudioKernels::Available())
+        for (int channels : { 1, 2, 6, 8 })
+            QTest::addRow("%s %d", kernels->m_name, channels) << kernels << channels;
+}
+
+void TestAudioKernels::DownmixStereo(void)
+{
+    QFETCH(const AudioKernels*, kernels);
+    QFETCH(int, channels);
+
+    auto matrix = Floats(channels * 2);
+    for (int frames : kLengths)
+    {
+        auto in = Floats(frames * channels);
+        std::vector<float> expected(frames * 2);
+        std::vector<float> out(frames * 2);
+        Reference().m_downmixStereo(expected.data(), in.data(), frames,
+                                    channels, matrix.data());
+        kernels->m_downmixStereo(out.data(), in.data(), frames, channels,
+                                 matrix.data());
+        QVERIFY2(Identical(out, expected), qPrintable(QString::number(frames)));
+    }
+}
+
+void TestAudioKernels::Benchmark_data(void)
+{
+    QTest::addColumn<const AudioKernels*>("kernels");
+    QTest::addColumn<QString>("routine");
+    for (const auto *kernels : AudioKernels::Available())
+    {
+        for (const char *routine : { "s16", "s32", "downmix" })
+        {
+            QTest::addRow("%s %s", kernels->m_name, routine)
+                << kernels << QString(routine);
+        }
+    }
+}
+
+// One second of 7.1 audio at 48kHz
+void TestAudioKernels::Benchmark(void)
+{
+    QFETCH(const AudioKernels*, kernels);
+    QFETCH(QString, routine);
+
+    static constexpr int kFrames   { 48000 };
+    static constexpr int kChannels { 8 };
+    static constexpr int kSamples  { kFrames * kChannels };
+
+    auto floats = Floats(kSamples);
+    auto matrix = Floats(kChannels * 2);
+    std::vector<float> stereo(kFrames * 2);
+    std::vector<int16_t> s16(kSamples);
+    std::vector<int32_t> s32(kSamples);
+
+    QBENCHMARK
+    {
+        if (routine == "s16")
+        {
+            kernels->m_floatToS16(s16.data(), floats.data(), kSamples);
+            kernels->m_s16ToFloat(floats.data(), s16.data(), kSamples);
+        }
+        else if (routine == "s32")
+        {
+            kernels->m_floatToS32(s32.data(), floats.data(), kSamples, 24, 8);
+            kernels->m_s32ToFloat(floats.data(), s32.data(), kSamples, 24, 8);
+        }
+        else
+        {
+            kernels->m_downmixStereo(stereo.data(), floats.data(), kFrames,
+                                     kChannels, matrix.data());
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(TestAudioKernels)
@@ -0,0 +1,46 @@
+/*
+ *  Class TestAudioKernels
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QTest>
+
+class TestAudioKernels : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    static void Selection(void);
+
+    // Every kernel set must match the C kernels bit for bit
+    static void S16ToFloat_data(void);
+    static void S16ToFloat(void);
+    static void FloatToS16_data(void);
+    static void FloatToS16(void);
+    static void S32ToFloat_data(void);
+    static void S32ToFloat(void);
+    static void FloatToS32_data(void);
+    static void FloatToS32(void);
+    static void ClipFloat_data(void);
+    static void ClipFloat(void);
+    static void Scale_data(void);
+    static void Scale(void);
+    static void DownmixStereo_data(void);
+    static void DownmixStereo(void);
+
+    static void Benchmark_data(void);
+    static void Benchmark(void);
+};
@@ -23,7 +23,7 @@ HEADERS += mythlocale.h storagegroup.h
 HEADERS += mythcoreutil.h mythdownloadmanager.h mythtranslation.h
 HEADERS += unzip2.h iso639.h iso3166.h mythmedia.h
 HEADERS += mythmiscutil.h mythhdd.h mythcdrom.h autodeletedeque.h dbutil.h
-HEADERS += mythdeque.h mythlogging.h
+HEADERS += mythdeque.h mythlogging.h mythbytequeue.h
 HEADERS += mythbaseutil.h referencecounter.h referencecounterlist.h
 HEADERS += version.h mythcommandlineparser.h
 HEADERS += mythscheduler.h filesysteminfo.h hardwareprofile.h serverpool.h
@@ -59,7 +59,7 @@ SOURCES += mthread.cpp mthreadpool.cpp
 SOURCES += mythsocket.cpp
 SOURCES += mythdbcon.cpp mythdb.cpp mythdbparams.cpp
 SOURCES += mythobservable.cpp mythevent.cpp
-SOURCES += mythtimer.cpp mythdirs.cpp
+SOURCES += mythtimer.cpp mythdirs.cpp mythbytequeue.cpp
 SOURCES += lcddevice.cpp mythstorage.cpp remotefile.cpp
 SOURCES += mythcorecontext.cpp mythsystem.cpp mythlocale.cpp storagegroup.cpp
 SOURCES += mythcoreutil.cpp mythdownloadmanager.cpp mythtranslation.cpp
@@ -188,7 +188,7 @@ inc.files += mythsocket.h mythsocket_cb.h mythlogging.h
 inc.files += mythcorecontext.h mythsystem.h storagegroup.h loggingserver.h
 inc.files += mythcoreutil.h mythlocale.h mythdownloadmanager.h
 inc.files += mythtranslation.h iso639.h iso3166.h mythmedia.h mythmiscutil.h
-inc.files += mythcdrom.h autodeletedeque.h dbutil.h mythdeque.h
+inc.files += mythcdrom.h autodeletedeque.h dbutil.h mythdeque.h mythbytequeue.h
 inc.files += referencecounter.h referencecounterlist.h mythcommandlineparser.h
 inc.files += mthread.h mthreadpool.h mythchrono.h
 inc.files += filesysteminfo.h hardwareprofile.h bonjourregister.h serverpool.h
@@ -0,0 +1,73 @@
+// C++
+#include <algorithm>
+#include <cstring>
+
+// MythTV
+#include "mythbytequeue.h"
+
+MythByteQueue::MythByteQueue(size_t capacity)
+{
+    Reserve(capacity);
+}
+
+QByteArray MythByteQueue::Peek(size_t len) const
+{
+    len = std::min(len, Size());
+    return {reinterpret_cast<const char*>(Data()), static_cast<int>(len)};
+}
+
+void MythByteQueue::Append(const void *data, size_t len)
+{
+    if (len == 0)
+        return;
+    memcpy(GetWriteBuffer(len), data, len);
+    m_tail += len;
+}
+
+uint8_t *MythByteQueue::GetWriteBuffer(size_t len)
+{
+    MakeRoom(len);
+    return m_data.data() + m_tail;
+}
+
+void MythByteQueue::Commit(size_t len)
+{
+    m_tail = std::min(m_tail + len, m_data.size());
+}
+
+void MythByteQueue::Consume(size_t len)
+{
+    if (len >= Size())
+        Clear();
+    else
+        m_head += len;
+}
+
+void MythByteQueue::Reserve(size_t capacity)
+{
+    if (capacity > m_data.size())
+        m_data.resize(capacity);
+}
+
+void MythByteQueue::MakeRoom(size_t len)
+{
+    if (m_data.size() - m_tail >= len)
+        return;
+
+    size_t used = Size();
+    if (used + len > m_data.size() / 2)
+    {
+        // Grow, leaving the block at most half full so that the next
+        // compaction also frees at least half of it.
+        m_data.resize(std::max(m_data.size() * 2, (used + len) * 2));
+    }
+
+    // Move the unread data to the start of the block.
+    if (m_head > 0)
+    {
+        if (used > 0)
+            memmove(m_data.data(), m_data.data() + m_head, used);
+        m_head = 0;
+        m_tail = used;
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef MYTHBYTEQUEUE_H
+#define MYTHBYTEQUEUE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <QByteArray>
+
+#include "mythbaseexp.h"
+
+/** \class MythByteQueue
+ *  \brief FIFO of bytes kept in one contiguous block.
+ *
+ *  Consuming from the front only advances a read offset, so a consumer
+ *  that takes a little at a time doesn't move the rest of the data the
+ *  way QByteArray::remove(0, n) does. Unread data is moved back to the
+ *  start of the block only when that frees at least half of it, which
+ *  keeps appends and consumes amortized O(1).
+ *
+ *  Data() and Size() always describe the whole unread span, so it can be
+ *  handed to a parser such as MPEGStreamData::ProcessData() without a
+ *  copy. Producers can also write straight into the queue with
+ *  GetWriteBuffer() and Commit().
+ *
+ *  Not thread safe.
+ */
+class MBASE_PUBLIC MythByteQueue
+{
+  public:
+    explicit MythByteQueue(size_t capacity = 0);
+
+    bool           IsEmpty(void) const  { return m_head == m_tail; }
+    size_t         Size(void) const     { return m_tail - m_head; }
+    size_t         Capacity(void) const { return m_data.size(); }
+    /// Start of the unread data. Invalidated by any non-const call.
+    const uint8_t *Data(void) const     { return m_data.data() + m_head; }
+    /// Copy of the first \p len unread bytes.
+    QByteArray     Peek(size_t len) const;
+
+    void     Append(const void *data, size_t len);
+    void     Append(const QByteArray &data)
+        { Append(data.constData(), static_cast<size_t>(data.size())); }
+
+    /// Returns space for at least \p len bytes after the unread data.
+    /// Call Commit() with the number of bytes actually written.
+    uint8_t *GetWriteBuffer(size_t len);
+    void     Commit(size_t len);
+
+    /// Drops up to \p len bytes from the front.
+    void     Consume(size_t len);
+    /// Drops all data, keeping the allocated block.
+    void     Clear(void) { m_head = m_tail = 0; }
+    void     Reserve(size_t capacity);
+
+  private:
+    void     MakeRoom(size_t len);
+
+    std::vector<uint8_t> m_data;
+    size_t               m_head {0};
+    size_t               m_tail {0};
+};
+
+#endif // MYTHBYTEQUEUE_H
@@ -3,6 +3,10 @@
 // ANSI C
 #include <cstdlib>
 
+// C++
+#include <algorithm>
+#include <vector>
+
 // Qt
 #include <QCoreApplication>
 #include <QElapsedTimer>
@@ -36,6 +40,22 @@
 
 static constexpr std::chrono::seconds kPurgeTimeout { 1h };
 
+// Prepared statements kept per connection. MySQL limits the number of
+// prepared statements per server (max_prepared_stmt_count, 16382 by
+// default), so keep this modest. MYTHTV_DB_STATEMENT_CACHE_SIZE=0
+// disables the cache.
+static constexpr size_t kStatementCacheSize { 64 };
+static constexpr uint64_t kStatementStatsInterval { 1000 };
+
+static size_t statement_cache_size(void)
+{
+    bool ok = false;
+    int size = qEnvironmentVariableIntValue("MYTHTV_DB_STATEMENT_CACHE_SIZE", &ok);
+    if (ok && size >= 0)
+        return size;
+    return kStatementCacheSize;
+}
+
 static QMutex sMutex;
 
 bool TestDatabase(const QString& dbHostName,
@@ -81,8 +101,146 @@ bool TestDatabase(const QString& dbHostName,
     return ret;
 }
 
+/// \brief Check out the cached statement for the given SQL text.
+/// \return nullptr if the statement is not cached or is in use.
+MSqlStatementCache::Entry *MSqlStatementCache::Acquire(const QString &sql)
+{
+    if ((m_hits + m_misses + m_busy + 1) % kStatementStatsInterval == 0 &&
+        VERBOSE_LEVEL_CHECK(VB_DATABASE, LOG_DEBUG))
+    {
+        LogStats();
+    }
+
+    auto it = m_index.find(sql);
+    if (it == m_index.end())
+    {
+        m_misses++;
+        return nullptr;
+    }
+
+    auto entry = *it;
+    if (entry->m_inUse)
+    {
+        m_busy++;
+        return nullptr;
+    }
+
+    m_hits++;
+    m_lru.splice(m_lru.begin(), m_lru, entry);
+    entry->m_inUse = true;
+    entry->m_uses++;
+    return &(*entry);
+}
+
+/// \brief Add a checked out entry for a statement that was just prepared.
+/// \return nullptr if the cache is disabled, full of checked out
+///         statements, or already has another copy of this statement.
+MSqlStatementCache::Entry *MSqlStatementCache::Insert(
+    const QString &sql, std::chrono::microseconds prepareTime)
+{
+    if (!IsEnabled() || m_index.contains(sql))
+        return nullptr;
+
+    // Evict the least recently used statements that are not checked out.
+    auto it = m_lru.end();
+    while (m_lru.size() >= m_capacity && it != m_lru.begin())
+    {
+        --it;
+        if (it->m_inUse)
+            continue;
+        m_index.remove(it->m_sql);
+        it = m_lru.erase(it);
+        m_evictions++;
+    }
+    if (m_lru.size() >= m_capacity)
+        return nullptr;
+
+    Entry &entry = m_lru.emplace_front();
+    entry.m_sql = sql;
+    entry.m_inUse = true;
+    entry.m_uses = 1;
+    entry.m_prepareTime = prepareTime;
+    m_index.insert(sql, m_lru.begin());
+    return &entry;
+}
+
+/// \brief Check a statement back in, taking the prepared query from the
+///        MSqlQuery that used it.
+void MSqlStatementCache::Release(Entry *entry, QSqlQuery &query)
+{
+    if (!entry)
+        return;
+
+    entry->m_inUse = false;
+    if (entry->m_stale)
+    {
+        auto it = std::find_if(m_lru.begin(), m_lru.end(),
+                               [entry](const Entry &e) { return &e == entry; });
+        if (it != m_lru.end())
+            m_lru.erase(it);
+        return;
+    }
+
+    query.finish();
+    entry->m_query = std::move(query);
+}
+
+/// \brief Drop all statements, e.g. because the connection is being reset.
+///
+/// Statements that are checked out are dropped when they are released.
+void MSqlStatementCache::Clear(void)
+{
+    m_index.clear();
+    for (auto it = m_lru.begin(); it != m_lru.end(); )
+    {
+        if (it->m_inUse)
+        {
+            it->m_stale = true;
+            ++it;
+        }
+        else
+        {
+            it = m_lru.erase(it);
+        }
+    }
+}
+
+void MSqlStatementCache::LogStats(void) const
+{
+    uint64_t lookups = m_hits + m_misses + m_busy;
+    LOG(VB_DATABASE, LOG_DEBUG,
+        QString("Statement cache %1: %2 statements, %3 lookups, "
+                "%4% hits, %5 misses, %6 busy, %7 evictions")
+            .arg(m_name).arg(m_lru.size()).arg(lookups)
+            .arg(lookups ? 100.0 * m_hits / lookups : 0.0, 0, 'f', 1)
+            .arg(m_misses).arg(m_busy).arg(m_evictions));
+
+    std::vector<const Entry*> entries;
+    entries.reserve(m_lru.size());
+    for (const auto & entry : m_lru)
+        entries.push_back(&entry);
+    auto busiest = [](const Entry *a, const Entry *b)
+        { return a->m_execTime > b->m_execTime; };
+    size_t count = std::min<size_t>(entries.size(), 10);
+    std::partial_sort(entries.begin(), entries.begin() + count,
+                      entries.end(), busiest);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Entry *entry = entries[i];
+        LOG(VB_DATABASE, LOG_DEBUG,
+            QString("Statement cache %1: uses %2 execs %3 "
+                    "avg exec %4us prepare %5us: %6")
+                .arg(m_name).arg(entry->m_uses).arg(entry->m_execs)
+                .arg(entry->m_execs ? entry->m_execTime.count() / entry->m_execs : 0)
+                .arg(entry->m_prepareTime.count())
+                .arg(entry->m_sql.simplified().left(100)));
+    }
+}
+
 MSqlDatabase::MSqlDatabase(QString name, QString driver)
-    : m_name(std::move(name)), m_driver(std::move(driver))
+    : m_name(std::move(name)), m_driver(std::move(driver)),
+      m_statements(m_name, statement_cache_size())
 {
     if (!QSqlDatabase::isDriverAvailable(m_driver))
     {
@@ -108,6 +266,10 @@ MSqlDatabase::MSqlDatabase(QString name, QString driver)
 
 MSqlDatabase::~MSqlDatabase()
 {
+    if (m_statements.IsEnabled() && VERBOSE_LEVEL_CHECK(VB_DATABASE, LOG_DEBUG))
+        m_statements.LogStats();
+    m_statements.Clear();
+
     if (m_db.isOpen())
     {
         m_db.close();
@@ -256,14 +418,18 @@ bool MSqlDatabase::KickDatabase(void)
     m_lastDBKick = MythDate::current().addSecs(-60);
 
     if (!m_db.isOpen())
+    {
+        // Prepared statements do not survive a new connection
+        m_statements.Clear();
         m_db.open();
+    }
 
     return m_db.isOpen();
 }
 
 bool MSqlDatabase::Reconnect()
 {
-    m_db.close();
+    Close();
     m_db.open();
 
     bool open = m_db.isOpen();
@@ -276,6 +442,13 @@ bool MSqlDatabase::Reconnect()
     return open;
 }
 
+void MSqlDatabase::Close(void)
+{
+    // Prepared statements must be freed before their connection is closed
+    m_statements.Clear();
+    m_db.close();
+}
+
 void MSqlDatabase::InitSessionVars()
 {
     QSqlQuery query(m_db);
@@ -492,7 +665,7 @@ void MDBManager::CloseDatabases()
     {
         LOG(VB_DATABASE, LOG_INFO,
             "Closing DB connection named '" + conn->m_name + "'");
-        conn->m_db.close();
+        conn->Close();
         delete conn;
         m_connCount--;
     }
@@ -504,7 +677,7 @@ void MDBManager::CloseDatabases()
         MSqlDatabase *db = slist.takeFirst();
         LOG(VB_DATABASE, LOG_INFO,
             "Closing DB connection named '" + db->m_name + "'");
-        db->m_db.close();
+        db->Close();
         delete db;
 
         if (db == m_schedCon)
@@ -536,6 +709,8 @@ MSqlQuery::MSqlQuery(const MSqlQueryInfo &qi)
 
 MSqlQuery::~MSqlQuery()
 {
+    ReleaseStatement();
+
     if (m_returnConnection)
     {
         MDBManager *dbmanager = GetMythDB()->GetDBManager();
@@ -652,6 +827,7 @@ bool MSqlQuery::exec()
 
     bool result = QSqlQuery::exec();
     qint64 elapsed = timer.elapsed();
+    qint64 elapsed_ns = timer.nsecsElapsed();
 
     if (!result && lostConnectionCheck())
         result = QSqlQuery::exec();
@@ -692,6 +868,7 @@ bool MSqlQuery::exec()
             timer.restart();
             result = QSqlQuery::exec();
             elapsed = timer.elapsed();
+            elapsed_ns = timer.nsecsElapsed();
         }
         if (result)
         {
@@ -702,6 +879,12 @@ bool MSqlQuery::exec()
         }
     }
 
+    if (m_statement)
+    {
+        m_statement->m_execs++;
+        m_statement->m_execTime += std::chrono::microseconds(elapsed_ns / 1000);
+    }
+
     if (VERBOSE_LEVEL_CHECK(VB_DATABASE, LOG_INFO))
     {
         QString str = lastQuery();
@@ -751,6 +934,9 @@ bool MSqlQuery::exec(const QString &query)
         return false;
     }
 
+    // Running an unprepared query would discard the checked out statement
+    ReleaseStatement();
+
     // Database connection down.  Try to restart it, give up if it's still
     // down
     if (!m_db->isOpen() && !Reconnect())
@@ -850,6 +1036,29 @@ bool MSqlQuery::prepare(const QString& query)
         return false;
     }
 
+    // Preparing the statement this query used last time again is a no-op.
+    if (m_statement && !m_statement->m_stale && m_statement->m_sql == query)
+    {
+        QSqlQuery::finish();
+        ClearBindings();
+        m_statement->m_uses++;
+        return true;
+    }
+
+    ReleaseStatement();
+
+    MSqlStatementCache &cache = m_db->m_statements;
+    if (cache.IsEnabled())
+    {
+        m_statement = cache.Acquire(query);
+        if (m_statement)
+        {
+            static_cast<QSqlQuery&>(*this) = std::move(m_statement->m_query);
+            ClearBindings();
+            return true;
+        }
+    }
+
     // QT docs indicate that there are significant speed ups and a reduction
     // in memory usage by enabling forward-only cursors
     //
@@ -857,10 +1066,18 @@ bool MSqlQuery::prepare(const QString& query)
     // iterate forward over the result set.
     setForwardOnly(true);
 
+    QElapsedTimer timer;
+    timer.start();
+
     bool ok = QSqlQuery::prepare(query);
 
     if (!ok && lostConnectionCheck())
         ok = true;
+    else if (ok && cache.IsEnabled())
+    {
+        m_statement = cache.Insert(
+            query, std::chrono::microseconds(timer.nsecsElapsed() / 1000));
+    }
 
     if (!ok && !(GetMythDB()->SuppressDBMessages()))
     {
@@ -937,8 +1154,44 @@ QVariant MSqlQuery::lastInsertId()
     return QSqlQuery::lastInsertId();
 }
 
+/// \brief Check the statement prepared by this query back into the
+///        connection's statement cache.
+void MSqlQuery::ReleaseStatement(void)
+{
+    if (!m_statement)
+        return;
+
+    MSqlStatementCache::Entry *entry = m_statement;
+    m_statement = nullptr;
+    if (!m_db)
+        return;
+
+    auto &query = static_cast<QSqlQuery&>(*this);
+    m_db->m_statements.Release(entry, query);
+    query = QSqlQuery(QString(), m_db->db());
+}
+
+/// \brief Reset every value bound to a reused prepared statement to NULL.
+///
+/// A freshly prepared statement has no values bound, so any placeholder the
+/// caller does not bind must not execute with the value of an earlier use.
+void MSqlQuery::ClearBindings(void)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+    MSqlBindings tmp = QSqlQuery::boundValues();
+    for (auto it = tmp.cbegin(); it != tmp.cend(); ++it)
+        QSqlQuery::bindValue(it.key(), QVariant(), QSql::In);
+#else
+    int count = static_cast<int>(QSqlQuery::boundValues().size());
+    for (int i = 0; i < count; i++)
+        QSqlQuery::bindValue(i, QVariant(), QSql::In);
+#endif
+}
+
 bool MSqlQuery::Reconnect(void)
 {
+    // The connection reset marks a checked out statement stale, this
+    // query keeps the statement it re-prepares below to itself.
     if (!m_db->Reconnect())
         return false;
     if (!m_lastPreparedQuery.isEmpty())
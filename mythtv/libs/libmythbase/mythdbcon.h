@@ -1,6 +1,11 @@
 #ifndef MYTHDBCON_H_
 #define MYTHDBCON_H_
 
+#include <cstdint>
+#include <list>
+#include <utility>
+
+#include <QHash>
 #include <QSqlDatabase>
 #include <QSqlRecord>
 #include <QSqlError>
@@ -11,6 +16,7 @@
 #include <QList>
 
 #include "mythbaseexp.h"
+#include "mythchrono.h"
 #include "mythdbparams.h"
 
 #define REUSE_CONNECTION 1 // NOLINT(cppcoreguidelines-macro-usage)
@@ -21,6 +27,49 @@ MBASE_PUBLIC bool TestDatabase(const QString& dbHostName,
                                QString dbName = "mythconverg",
                                int     dbPort = 3306);
 
+/// \brief LRU cache of the prepared statements of one MSqlDatabase
+///        connection, used by MSqlQuery. Do not use directly.
+///
+/// An MSqlQuery checks a statement out of the cache in prepare() and
+/// checks it back in when it prepares another statement or is destroyed,
+/// so a statement is never used by two queries at once. Statements that
+/// are checked out are never evicted.
+class MSqlStatementCache
+{
+  public:
+    struct Entry
+    {
+        QString   m_sql;
+        QSqlQuery m_query;         ///< empty while checked out
+        bool      m_inUse {false};
+        bool      m_stale {false}; ///< connection was reset while in use
+        uint64_t  m_uses  {0};
+        uint64_t  m_execs {0};
+        std::chrono::microseconds m_prepareTime {0us};
+        std::chrono::microseconds m_execTime    {0us};
+    };
+
+    MSqlStatementCache(QString name, size_t capacity)
+        : m_name(std::move(name)), m_capacity(capacity) {}
+
+    bool IsEnabled(void) const { return m_capacity > 0; }
+    Entry *Acquire(const QString &sql);
+    Entry *Insert(const QString &sql, std::chrono::microseconds prepareTime);
+    void Release(Entry *entry, QSqlQuery &query);
+    void Clear(void);
+    void LogStats(void) const;
+
+  private:
+    QString               m_name;
+    size_t                m_capacity;
+    std::list<Entry>      m_lru; // most recently used first
+    QHash<QString, std::list<Entry>::iterator> m_index;
+    uint64_t              m_hits      {0};
+    uint64_t              m_misses    {0};
+    uint64_t              m_busy      {0};
+    uint64_t              m_evictions {0};
+};
+
 /// \brief QSqlDatabase wrapper, used by MSqlQuery. Do not use directly.
 class MSqlDatabase
 {
@@ -40,6 +89,7 @@ class MSqlDatabase
     QString GetConnectionName(void) const { return m_name; }
     QSqlDatabase db(void) const { return m_db; }
     bool Reconnect(void);
+    void Close(void);
     void InitSessionVars(void);
 
   private:
@@ -48,6 +98,7 @@ class MSqlDatabase
     QSqlDatabase m_db;
     QDateTime m_lastDBKick;
     DatabaseParams m_dbparms;
+    MSqlStatementCache m_statements;
 };
 
 /// \brief DB connection pool, used by MSqlQuery. Do not use directly.
@@ -247,11 +298,14 @@ class MBASE_PUBLIC MSqlQuery : private QSqlQuery
 
     bool seekDebug(const char *type, bool result,
                    int where, bool relative) const;
+    void ReleaseStatement(void);
+    void ClearBindings(void);
 
     MSqlDatabase *m_db               {nullptr};
     bool          m_isConnected      {false};
     bool          m_returnConnection {false};
     QString       m_lastPreparedQuery; // holds a copy of the last prepared query
+    MSqlStatementCache::Entry *m_statement {nullptr}; // checked out statement
 };
 
 #endif
@@ -0,0 +1,186 @@
+/*
+ *  Class TestMythByteQueue
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "test_mythbytequeue.h"
+#include "mythbytequeue.h"
+
+// One second of a 50 Mbit/s stream.
+static constexpr int kSecond     { 50000000 / 8 };
+static constexpr int kTSPacket   { 188 };
+// Size of a read from a pipe, and of a read by the HLS stream handler.
+static constexpr int kReadSize   { 65536 };
+
+void TestMythByteQueue::StartsEmpty(void)
+{
+    MythByteQueue queue;
+    QVERIFY(queue.IsEmpty());
+    QCOMPARE(queue.Size(), size_t{0});
+    queue.Consume(10);
+    QVERIFY(queue.IsEmpty());
+}
+
+void TestMythByteQueue::AppendConsume(void)
+{
+    MythByteQueue queue;
+    queue.Append(QByteArray("abc"));
+    queue.Append("def", 3);
+    QCOMPARE(queue.Size(), size_t{6});
+    QCOMPARE(memcmp(queue.Data(), "abcdef", 6), 0);
+
+    queue.Consume(2);
+    QCOMPARE(queue.Size(), size_t{4});
+    QCOMPARE(memcmp(queue.Data(), "cdef", 4), 0);
+
+    queue.Consume(100);
+    QVERIFY(queue.IsEmpty());
+
+    queue.Append(QByteArray("xyz"));
+    queue.Clear();
+    QVERIFY(queue.IsEmpty());
+}
+
+void TestMythByteQueue::WriteBuffer(void)
+{
+    MythByteQueue queue;
+    queue.Append(QByteArray("ab"));
+
+    uint8_t *write = queue.GetWriteBuffer(10);
+    QVERIFY(write != nullptr);
+    QVERIFY(queue.Capacity() >= 12);
+    memcpy(write, "cd", 2);
+    queue.Commit(2);
+
+    QCOMPARE(queue.Size(), size_t{4});
+    QCOMPARE(memcmp(queue.Data(), "abcd", 4), 0);
+}
+
+void TestMythByteQueue::Peek(void)
+{
+    MythByteQueue queue;
+    queue.Append(QByteArray("abcdef"));
+    queue.Consume(1);
+    QCOMPARE(queue.Peek(3), QByteArray("bcd"));
+    QCOMPARE(queue.Peek(100), QByteArray("bcdef"));
+    QCOMPARE(queue.Size(), size_t{5});
+}
+
+void TestMythByteQueue::KeepsOrderWhileCompacting(void)
+{
+    MythByteQueue queue(64);
+    uint8_t next_in = 0;
+    uint8_t next_out = 0;
+    size_t max_size = 0;
+
+    // Uneven appends and consumes force both growth and compaction.
+    for (int i = 0; i < 1000; ++i)
+    {
+        int in = 1 + ((i * 7) % 50);
+        uint8_t *write = queue.GetWriteBuffer(in);
+        for (int j = 0; j < in; ++j)
+            write[j] = next_in++;
+        queue.Commit(in);
+        max_size = std::max(max_size, queue.Size());
+
+        size_t out = std::min(queue.Size(), static_cast<size_t>(1 + ((i * 5) % 45)));
+        for (size_t j = 0; j < out; ++j, ++next_out)
+            QCOMPARE(queue.Data()[j], next_out);
+        queue.Consume(out);
+    }
+
+    // The block grows at most to four times what was ever queued.
+    QVERIFY(queue.Capacity() <= std::max<size_t>(64, max_size * 4));
+}
+
+void TestMythByteQueue::Throughput_data(void)
+{
+    QTest::addColumn<bool>("queue");
+    QTest::addColumn<bool>("hls");
+
+    // ExternalStreamHandler: pipe reads appended, all complete TS packets
+    // parsed and the partial packet left at the front.
+    QTest::newRow("external-qbytearray") << false << false;
+    QTest::newRow("external-queue")      << true  << false;
+    // HLSReader: whole segments appended, read out in small pieces while
+    // a segment of backlog stays queued.
+    QTest::newRow("hls-qbytearray")      << false << true;
+    QTest::newRow("hls-queue")           << true  << true;
+}
+
+void TestMythByteQueue::Throughput(void)
+{
+    QFETCH(bool, queue);
+    QFETCH(bool, hls);
+
+    const QByteArray second(kSecond, '\x47');
+    const QByteArray read(kReadSize, '\x47');
+    std::vector<uint8_t> out(kReadSize);
+
+    QBENCHMARK {
+        QByteArray array;
+        MythByteQueue bytes;
+        size_t consumed = 0;
+
+        // Two seconds of the stream
+        for (int s = 0; s < 2; ++s)
+        {
+            if (hls)
+            {
+                if (queue)
+                    bytes.Append(second);
+                else
+                    array += second;
+            }
+
+            for (int pos = 0; pos < kSecond; pos += kReadSize)
+            {
+                if (!hls)
+                {
+                    if (queue)
+                        bytes.Append(read);
+                    else
+                        array += read;
+                }
+
+                size_t size = queue ? bytes.Size() : static_cast<size_t>(array.size());
+                size_t len = hls ? std::min<size_t>(kReadSize, size)
+                                 : size - (size % kTSPacket);
+                if (hls && size <= static_cast<size_t>(kSecond))
+                    len = 0;
+
+                if (queue)
+                {
+                    memcpy(out.data(), bytes.Data(), std::min<size_t>(len, kReadSize));
+                    bytes.Consume(len);
+                }
+                else
+                {
+                    memcpy(out.data(), array.constData(), std::min<size_t>(len, kReadSize));
+                    array.remove(0, static_cast<int>(len));
+                }
+                consumed += len;
+            }
+        }
+        QVERIFY(consumed > 0);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestMythByteQueue)
@@ -0,0 +1,227 @@
+/*
+ *  Class TestThreadedFileWriter
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <QFile>
+
+#include "test_threadedfilewriter.h"
+#include "mythcorecontext.h"
+#include "threadedfilewriter.h"
+
+static constexpr int kFiles { 4 };
+
+/// Writes \a count packet sized chunks of varying lengths, joining and
+/// leaving \a group part way through when it is set.
+static QByteArray WriteFile(const QString &name, TFWGroup *group,
+                            uint count, uint seed)
+{
+    QByteArray expected;
+    ThreadedFileWriter tfw(name, O_WRONLY | O_TRUNC | O_CREAT, 0644);
+    if (!tfw.Open())
+        return expected;
+    tfw.SetBlocking(true);
+
+    for (uint i = 0; i < count; i++)
+    {
+        if (group && (i == count / 10))
+            tfw.SetGroup(group);
+        if (group && (i == count / 2))
+            tfw.SetGroup(nullptr);
+        if (group && (i == 3 * count / 4))
+            tfw.SetGroup(group);
+
+        QByteArray chunk(188 * (1 + (i % 21)), Qt::Uninitialized);
+        for (auto & byte : chunk)
+        {
+            seed = (seed * 1664525) + 1013904223;
+            byte = static_cast<char>(seed >> 24);
+        }
+        tfw.Write(chunk.constData(), chunk.size());
+        expected.append(chunk);
+    }
+    return expected;
+}
+
+void TestThreadedFileWriter::initTestCase(void)
+{
+    gCoreContext = new MythCoreContext("bin_version", nullptr);
+}
+
+void TestThreadedFileWriter::cleanupTestCase(void)
+{
+    delete gCoreContext;
+    gCoreContext = nullptr;
+}
+
+void TestThreadedFileWriter::Write_data(void)
+{
+    QTest::addColumn<bool>("grouped");
+    QTest::newRow("own threads") << false;
+    QTest::newRow("group") << true;
+}
+
+// Several files written at once must all end up with what was written
+void TestThreadedFileWriter::Write(void)
+{
+    QFETCH(bool, grouped);
+    QVERIFY(m_dir.isValid());
+
+    auto *group = grouped ? new TFWGroup("test") : nullptr;
+
+    std::vector<QByteArray> expected(kFiles);
+    std::vector<std::thread> threads;
+    for (int n = 0; n < kFiles; n++)
+    {
+        threads.emplace_back([&, n]()
+        {
+            expected[n] = WriteFile(m_dir.filePath(QString("file%1").arg(n)),
+                                    group, 20000, n);
+        });
+    }
+    for (auto & thread : threads)
+        thread.join();
+
+    if (group)
+    {
+        QVERIFY(group->GetStats().empty());
+        group->DecrRef();
+    }
+
+    for (int n = 0; n < kFiles; n++)
+    {
+        QFile file(m_dir.filePath(QString("file%1").arg(n)));
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QCOMPARE(file.size(), expected[n].size());
+        QVERIFY(file.readAll() == expected[n]);
+    }
+}
+
+void TestThreadedFileWriter::GroupStats(void)
+{
+    QVERIFY(m_dir.isValid());
+    auto *group = new TFWGroup("stats");
+
+    {
+        std::vector<std::unique_ptr<ThreadedFileWriter>> writers;
+        for (int n = 0; n < kFiles; n++)
+        {
+            writers.push_back(std::make_unique<ThreadedFileWriter>(
+                m_dir.filePath(QString("stats%1").arg(n)),
+                O_WRONLY | O_TRUNC | O_CREAT, 0644));
+            QVERIFY(writers.back()->Open());
+            writers.back()->SetGroup(group);
+        }
+
+        QByteArray chunk(100000 + 188, 'x');
+        for (int n = 0; n < kFiles; n++)
+        {
+            for (int i = 0; i <= n; i++)
+                writers[n]->Write(chunk.constData(), chunk.size());
+            writers[n]->Flush();
+        }
+
+        auto stats = group->GetStats();
+        QCOMPARE(stats.size(), size_t(kFiles));
+        for (int n = 0; n < kFiles; n++)
+        {
+            QCOMPARE(stats[n].m_filename, m_dir.filePath(QString("stats%1").arg(n)));
+            QCOMPARE(stats[n].m_bytes, uint64_t(chunk.size()) * (n + 1));
+            QVERIFY(stats[n].m_writes > 0);
+        }
+
+        auto total = group->GetTotal();
+        QCOMPARE(total.m_filename, QString("stats"));
+        QCOMPARE(total.m_bytes, uint64_t(chunk.size()) * 10);
+
+        auto all = TFWGroup::GetAllStats();
+        auto it = std::find_if(all.cbegin(), all.cend(),
+            [](const auto & gs) { return gs.m_total.m_filename == "stats"; });
+        QVERIFY(it != all.cend());
+        QCOMPARE(it->m_total.m_bytes, total.m_bytes);
+        QCOMPARE(it->m_files.size(), size_t(kFiles));
+    }
+
+    QVERIFY(group->GetStats().empty());
+    group->DecrRef();
+    QVERIFY(TFWGroup::GetAllStats().empty());
+}
+
+// The end of a file must be written, even though a grouped writer keeps
+// what follows the last 4K boundary back for its next write.
+void TestThreadedFileWriter::GroupDestroy(void)
+{
+    QVERIFY(m_dir.isValid());
+    auto *group = new TFWGroup("destroy");
+
+    for (int n = 0; n < 50; n++)
+    {
+        QString name = m_dir.filePath(QString("destroy%1").arg(n));
+        QByteArray chunk((100000 + (188 * n)) | 1, static_cast<char>(n));
+        {
+            ThreadedFileWriter tfw(name, O_WRONLY | O_TRUNC | O_CREAT, 0644);
+            QVERIFY(tfw.Open());
+            tfw.SetGroup(group);
+            tfw.Write(chunk.constData(), chunk.size());
+            // Land the destructor at different points of the group's write
+            std::this_thread::sleep_for(std::chrono::microseconds(100 * n));
+        }
+
+        QFile file(name);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QVERIFY2(file.readAll() == chunk, qPrintable(name));
+    }
+
+    group->DecrRef();
+}
+
+// Seek() must not move the file while a group write is still running
+void TestThreadedFileWriter::GroupSeek(void)
+{
+    QVERIFY(m_dir.isValid());
+    auto *group = new TFWGroup("seek");
+
+    for (int n = 0; n < 50; n++)
+    {
+        QString name = m_dir.filePath(QString("seek%1").arg(n));
+        QByteArray expected((100000 + (188 * n)) | 1, 'x');
+        QByteArray header(188, static_cast<char>(n));
+        {
+            ThreadedFileWriter tfw(name, O_WRONLY | O_TRUNC | O_CREAT, 0644);
+            QVERIFY(tfw.Open());
+            tfw.SetGroup(group);
+            tfw.Write(expected.constData(), expected.size());
+            std::this_thread::sleep_for(std::chrono::microseconds(100 * n));
+            QCOMPARE(tfw.Seek(0, SEEK_SET), 0LL);
+            tfw.Write(header.constData(), header.size());
+        }
+        expected.replace(0, header.size(), header);
+
+        QFile file(name);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QVERIFY2(file.readAll() == expected, qPrintable(name));
+    }
+
+    group->DecrRef();
+}
+
+QTEST_APPLESS_MAIN(TestThreadedFileWriter)
@@ -1,4 +1,6 @@
 // C++ headers
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <csignal>
 #include <cstdio>
@@ -7,7 +9,11 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
 
 // Qt headers
 #include <QString>
@@ -22,6 +28,7 @@
 #include "mythdate.h"
 
 #define LOC QString("TFW(%1:%2): ").arg(m_filename).arg(m_fd)
+#define LOC_GROUP QString("TFWGroup(%1): ").arg(m_name)
 
 /// \brief Runs ThreadedFileWriter::DiskLoop(void)
 void TFWWriteThread::run(void)
@@ -39,9 +46,26 @@ void TFWSyncThread::run(void)
     RunEpilog();
 }
 
+/// \brief Runs TFWGroup::DiskLoop(void)
+void TFWGroupWriteThread::run(void)
+{
+    RunProlog();
+    m_parent->DiskLoop();
+    RunEpilog();
+}
+
+/// \brief Runs TFWGroup::SyncLoop(void)
+void TFWGroupSyncThread::run(void)
+{
+    RunProlog();
+    m_parent->SyncLoop();
+    RunEpilog();
+}
+
 const uint ThreadedFileWriter::kMaxBufferSize   = 8 * 1024 * 1024;
 const uint ThreadedFileWriter::kMinWriteSize    = 64 * 1024;
 const uint ThreadedFileWriter::kMaxBlockSize    = 1 * 1024 * 1024;
+const uint ThreadedFileWriter::kWriteAlignment  = 4 * 1024;
 
 /** \class ThreadedFileWriter
  *  \brief This class supports the writing of recordings to disk.
@@ -52,6 +76,9 @@ const uint ThreadedFileWriter::kMaxBlockSize    = 1 * 1024 * 1024;
  *   using another thread. The goal here so to block as little as
  *   possible when the classes using this class want to add data
  *   to the stream.
+ *
+ *   Writers may instead join a TFWGroup, see SetGroup(), in which
+ *   case the group's threads do the writing and syncing.
  */
 
 /** \fn ThreadedFileWriter::ReOpen(QString)
@@ -116,6 +143,20 @@ bool ThreadedFileWriter::Open(void)
 #ifdef _WIN32
     _setmode(m_fd, _O_BINARY);
 #endif
+    {
+        QMutexLocker locker(&m_bufLock);
+        m_filePos = std::max<int64_t>(lseek(m_fd, 0, SEEK_CUR), 0);
+    }
+
+    if (!m_group)
+        StartThreads();
+
+    return true;
+}
+
+/// \brief Starts the write and sync threads, if they aren't running.
+void ThreadedFileWriter::StartThreads(void)
+{
     if (!m_writeThread)
     {
         m_writeThread = new TFWWriteThread(this);
@@ -127,8 +168,73 @@ bool ThreadedFileWriter::Open(void)
         m_syncThread = new TFWSyncThread(this);
         m_syncThread->start();
     }
+}
+
+/// \brief Stops the write and sync threads, without closing the file.
+void ThreadedFileWriter::StopThreads(void)
+{
+    {
+        QMutexLocker locker(&m_bufLock);
+        m_stopThreads = true;
+        m_bufferSyncWait.wakeAll();
+        m_bufferHasData.wakeAll();
+    }
 
-    return true;
+    delete m_writeThread;
+    m_writeThread = nullptr;
+    delete m_syncThread;
+    m_syncThread = nullptr;
+
+    QMutexLocker locker(&m_bufLock);
+    m_stopThreads = false;
+}
+
+/** \brief Hands the writing and syncing of the file over to the threads
+ *         of \p group, or takes it back when \p group is nullptr.
+ *
+ *  The buffer is flushed first. The writer holds a reference to the group
+ *  until it leaves it, which it does at the latest when it is deleted.
+ */
+void ThreadedFileWriter::SetGroup(TFWGroup *group)
+{
+    if (group == m_group)
+        return;
+
+    Flush();
+
+    TFWGroup *old = m_group;
+    if (group)
+        group->IncrRef();
+
+    if (old)
+        old->Remove(this);
+    else
+        StopThreads();
+
+    {
+        QMutexLocker locker(&m_bufLock);
+        m_group = group;
+        m_bytesWritten = 0;
+        m_writeCalls = 0;
+        m_minWriteTimer.start();
+        m_registerTimer.start();
+    }
+
+    if (old)
+        old->DecrRef();
+
+    if (group)
+        group->Add(this);
+    else if (m_fd >= 0)
+        StartThreads();
+}
+
+/// \brief Wakes whichever thread writes the buffers. Call with buflock held.
+void ThreadedFileWriter::WakeWriter(void)
+{
+    m_bufferHasData.wakeAll();
+    if (m_group)
+        m_group->Wake();
 }
 
 /** \fn ThreadedFileWriter::~ThreadedFileWriter()
@@ -138,6 +244,13 @@ ThreadedFileWriter::~ThreadedFileWriter()
 {
     Flush();
 
+    if (m_group)
+    {
+        m_group->Remove(this);
+        m_group->DecrRef();
+        m_group = nullptr;
+    }
+
     {  /* tell child threads to exit */
         QMutexLocker locker(&m_bufLock);
         m_inDtor = true;
@@ -270,7 +383,7 @@ int ThreadedFileWriter::Write(const void *data, uint count)
 
         if ((m_writeBuffers.size() > 1) || (buf->data.size() >= kMinWriteSize))
         {
-            m_bufferHasData.wakeAll();
+            WakeWriter();
         }
 
         written += towrite;
@@ -298,9 +411,9 @@ long long ThreadedFileWriter::Seek(long long pos, int whence)
 {
     QMutexLocker locker(&m_bufLock);
     m_flush = true;
-    while (!m_writeBuffers.empty())
+    while (!m_writeBuffers.empty() || m_inFlight)
     {
-        m_bufferHasData.wakeAll();
+        WakeWriter();
         if (!m_bufferEmpty.wait(locker.mutex(), 2000))
         {
             LOG(VB_GENERAL, LOG_WARNING, LOC +
@@ -309,7 +422,10 @@ long long ThreadedFileWriter::Seek(long long pos, int whence)
         }
     }
     m_flush = false;
-    return lseek(m_fd, pos, whence);
+    long long ret = lseek(m_fd, pos, whence);
+    if (ret >= 0)
+        m_filePos = ret;
+    return ret;
 }
 
 /** \fn ThreadedFileWriter::Flush(void)
@@ -319,9 +435,9 @@ void ThreadedFileWriter::Flush(void)
 {
     QMutexLocker locker(&m_bufLock);
     m_flush = true;
-    while (!m_writeBuffers.empty())
+    while (!m_writeBuffers.empty() || m_inFlight)
     {
-        m_bufferHasData.wakeAll();
+        WakeWriter();
         if (!m_bufferEmpty.wait(locker.mutex(), 2000))
         {
             LOG(VB_GENERAL, LOG_WARNING, LOC +
@@ -376,7 +492,7 @@ void ThreadedFileWriter::SetWriteBufferMinWriteSize(uint newMinSize)
     QMutexLocker locker(&m_bufLock);
     if (newMinSize > 0)
         m_tfwMinWriteSize = newMinSize;
-    m_bufferHasData.wakeAll();
+    WakeWriter();
 }
 
 /** \fn ThreadedFileWriter::SyncLoop(void)
@@ -385,24 +501,34 @@ void ThreadedFileWriter::SetWriteBufferMinWriteSize(uint newMinSize)
 void ThreadedFileWriter::SyncLoop(void)
 {
     QMutexLocker locker(&m_bufLock);
-    while (!m_inDtor)
+    while (!m_inDtor && !m_stopThreads)
     {
         locker.unlock();
 
-        Sync();
+        SyncOnce();
 
         locker.relock();
 
-        if (m_ignoreWrites && m_registered)
-        {
-            // we aren't going to write to the disk anymore, so can de-register
-            gCoreContext->UnregisterFileForWrite(m_filename);
-            m_registered = false;
-        }
         m_bufferSyncWait.wait(&m_bufLock, 1000);
     }
 }
 
+/** \fn ThreadedFileWriter::SyncOnce(void)
+ *  \brief Calls Sync(void), and de-registers the file once writes fail.
+ */
+void ThreadedFileWriter::SyncOnce(void)
+{
+    Sync();
+
+    QMutexLocker locker(&m_bufLock);
+    if (m_ignoreWrites && m_registered)
+    {
+        // we aren't going to write to the disk anymore, so can de-register
+        gCoreContext->UnregisterFileForWrite(m_filename);
+        m_registered = false;
+    }
+}
+
 /** \fn ThreadedFileWriter::DiskLoop(void)
  *  \brief The thread run method that actually calls writes to disk.
  */
@@ -425,7 +551,7 @@ void ThreadedFileWriter::DiskLoop(void)
 
     uint64_t total_written = 0LL;
 
-    while (!m_inDtor)
+    while (!m_inDtor && !m_stopThreads)
     {
         if (m_ignoreWrites)
         {
@@ -470,6 +596,7 @@ void ThreadedFileWriter::DiskLoop(void)
         TFWBuffer *buf = m_writeBuffers.front();
         m_writeBuffers.pop_front();
         m_totalBufferUse -= buf->data.size();
+        m_inFlight = buf->data.size();
         m_bufferWasFreed.wakeAll();
         minWriteTimer.start();
 
@@ -525,6 +652,8 @@ void ThreadedFileWriter::DiskLoop(void)
             }
 
             locker.relock();
+            if (ret > 0)
+                m_filePos += ret;
 
             if ((tot < sz) && !m_inDtor)
                 m_bufferHasData.wait(locker.mutex(), 50);
@@ -534,13 +663,16 @@ void ThreadedFileWriter::DiskLoop(void)
 
         if (lastRegisterTimer.elapsed() >= 10s)
         {
-            gCoreContext->RegisterFileForWrite(m_filename, total_written);
+            gCoreContext->RegisterFileForWrite(m_filename, m_filePos);
             m_registered = true;
             lastRegisterTimer.restart();
         }
 
         buf->lastUsed = MythDate::current();
         m_emptyBuffers.push_back(buf);
+        m_inFlight = 0;
+        if (m_writeBuffers.empty())
+            m_bufferEmpty.wakeAll();
 
         if (writeTimer.elapsed() > 1s)
         {
@@ -551,36 +683,255 @@ void ThreadedFileWriter::DiskLoop(void)
         }
 
         if (!write_ok && ((EFBIG == errno) || (ENOSPC == errno)))
+            IgnoreWrites(errno);
+    }
+}
+
+/** \fn ThreadedFileWriter::IgnoreWrites(int)
+ *  \brief Explains why writing failed, and stops any further writing.
+ */
+void ThreadedFileWriter::IgnoreWrites(int err)
+{
+    QString msg;
+    switch (err)
+    {
+        case EFBIG:
+            msg =
+                "Maximum file size exceeded by '%1'"
+                "\n\t\t\t"
+                "You must either change the process ulimits, configure"
+                "\n\t\t\t"
+                "your operating system with \"Large File\" support, "
+                "or use"
+                "\n\t\t\t"
+                "a filesystem which supports 64-bit or 128-bit files."
+                "\n\t\t\t"
+                "HINT: FAT32 is a 32-bit filesystem.";
+            break;
+        case ENOSPC:
+            msg =
+                "No space left on the device for file '%1'"
+                "\n\t\t\t"
+                "file will be truncated, no further writing "
+                "will be done.";
+            break;
+    }
+
+    LOG(VB_GENERAL, LOG_ERR, LOC + msg.arg(m_filename));
+    m_ignoreWrites = true;
+}
+
+/** \fn ThreadedFileWriter::WritePending(void)
+ *  \brief Writes some of the buffered data to disk, if any is due.
+ *
+ *   This is DiskLoop(void) for a writer in a TFWGroup, whose write
+ *   thread calls it for each of the files in the group in turn. Whole
+ *   buffers up to kMaxBlockSize are written with a single system call,
+ *   and unless flushing, the write ends on a kWriteAlignment boundary of
+ *   the file, with the rest kept for the next write.
+ *
+ *  \return true if anything was written.
+ */
+bool ThreadedFileWriter::WritePending(void)
+{
+    QMutexLocker locker(&m_bufLock);
+
+    if (m_ignoreWrites)
+    {
+        while (!m_writeBuffers.empty())
         {
-            QString msg;
-            switch (errno)
-            {
-                case EFBIG:
-                    msg =
-                        "Maximum file size exceeded by '%1'"
-                        "\n\t\t\t"
-                        "You must either change the process ulimits, configure"
-                        "\n\t\t\t"
-                        "your operating system with \"Large File\" support, "
-                        "or use"
-                        "\n\t\t\t"
-                        "a filesystem which supports 64-bit or 128-bit files."
-                        "\n\t\t\t"
-                        "HINT: FAT32 is a 32-bit filesystem.";
-                    break;
-                case ENOSPC:
-                    msg =
-                        "No space left on the device for file '%1'"
-                        "\n\t\t\t"
-                        "file will be truncated, no further writing "
-                        "will be done.";
-                    break;
-            }
+            delete m_writeBuffers.front();
+            m_writeBuffers.pop_front();
+        }
+        while (!m_emptyBuffers.empty())
+        {
+            delete m_emptyBuffers.front();
+            m_emptyBuffers.pop_front();
+        }
+        m_bufferEmpty.wakeAll();
+        return false;
+    }
+
+    if (m_writeBuffers.empty())
+    {
+        m_bufferEmpty.wakeAll();
+        TrimEmptyBuffers();
+        return false;
+    }
+
+    if ((m_fd == -1) ||
+        (!m_flush && (m_minWriteTimer.elapsed() < 250ms) &&
+         (m_totalBufferUse < kMinWriteSize)))
+    {
+        return false;
+    }
+
+    QList<TFWBuffer*> bufs;
+    uint64_t size = 0;
+    while (!m_writeBuffers.empty() &&
+           (bufs.empty() ||
+            (size + m_writeBuffers.front()->data.size() <= kMaxBlockSize)))
+    {
+        bufs.push_back(m_writeBuffers.front());
+        size += bufs.back()->data.size();
+        m_writeBuffers.pop_front();
+    }
+    m_totalBufferUse -= size;
+    m_minWriteTimer.start();
+    // Flush() and Seek() wait for these bytes too, as they are in
+    // neither list while they are being written.
+    m_inFlight = size;
+
+    uint64_t len = size;
+    if (!m_flush)
+    {
+        int64_t end = ((m_filePos + size) / kWriteAlignment) * kWriteAlignment;
+        if (end > m_filePos)
+            len = end - m_filePos;
+    }
+
+    LOG(VB_FILE, LOG_DEBUG, LOC + QString("writev(%1 of %2) cnt %3 total %4")
+            .arg(len).arg(size).arg(m_writeBuffers.size())
+            .arg(m_totalBufferUse));
+
+    int fd = m_fd;
+    locker.unlock();
+
+    MythTimer writeTimer;
+    writeTimer.start();
+
+    uint64_t done = 0;
+    uint calls = 0;
+    uint errcnt = 0;
+    int err = 0;
+    while (done < len)
+    {
+        ssize_t ret = WriteBuffers(fd, bufs, done, len - done);
+        calls++;
 
-            LOG(VB_GENERAL, LOG_ERR, LOC + msg.arg(m_filename));
-            m_ignoreWrites = true;
+        if (ret >= 0)
+        {
+            done += ret;
+            continue;
+        }
+
+        err = errno;
+        if (err == EAGAIN)
+        {
+            LOG(VB_GENERAL, LOG_WARNING, LOC + "Got EAGAIN.");
+        }
+        else
+        {
+            errcnt++;
+            LOG(VB_GENERAL, LOG_ERR, LOC + "File I/O " +
+                QString(" errcnt: %1").arg(errcnt) + ENO);
         }
+
+        if ((errcnt >= 3) || (ENOSPC == err) || (EFBIG == err))
+            break;
+
+        std::this_thread::sleep_for(50ms);
     }
+
+    locker.relock();
+
+    bool write_ok = (done == len);
+    m_filePos      += done;
+    m_bytesWritten += done;
+    m_writeCalls   += calls;
+
+    // Put back what is left over, unless the write failed, when it is
+    // dropped as DiskLoop(void) does.
+    uint64_t skip = write_ok ? len : size;
+    QList<TFWBuffer*> left;
+    for (auto *buf : bufs)
+    {
+        if (skip >= buf->data.size())
+        {
+            skip -= buf->data.size();
+            buf->lastUsed = MythDate::current();
+            m_emptyBuffers.push_back(buf);
+            continue;
+        }
+        buf->data.erase(buf->data.begin(), buf->data.begin() + skip);
+        skip = 0;
+        m_totalBufferUse += buf->data.size();
+        left.push_back(buf);
+    }
+    while (!left.empty())
+    {
+        m_writeBuffers.push_front(left.back());
+        left.pop_back();
+    }
+    m_inFlight = 0;
+    m_bufferWasFreed.wakeAll();
+    // Wake Flush() and Seek() even if a remainder was put back, so they
+    // ask for it to be written straight away.
+    m_bufferEmpty.wakeAll();
+
+    if (m_registerTimer.elapsed() >= 10s)
+    {
+        gCoreContext->RegisterFileForWrite(m_filename, m_filePos);
+        m_registered = true;
+        m_registerTimer.restart();
+    }
+
+    if (writeTimer.elapsed() > 1s)
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("writev(%1) cnt %2 total %3 -- took a long time, %4 ms")
+                .arg(len).arg(m_writeBuffers.size())
+                .arg(m_totalBufferUse).arg(writeTimer.elapsed().count()));
+    }
+
+    if (!write_ok && ((EFBIG == err) || (ENOSPC == err)))
+        IgnoreWrites(err);
+
+    return done > 0;
+}
+
+/** \fn ThreadedFileWriter::WriteBuffers(int,const QList<TFWBuffer*>&,uint64_t,uint64_t)
+ *  \brief Writes up to \p len bytes of \p bufs, starting \p offset bytes
+ *         in, with one system call.
+ *  \return what write() or writev() returned.
+ */
+ssize_t ThreadedFileWriter::WriteBuffers(int fd, const QList<TFWBuffer*> &bufs,
+                                         uint64_t offset, uint64_t len)
+{
+#ifndef _WIN32
+    static constexpr size_t kMaxIov { 64 };
+    std::array<iovec,kMaxIov> iov {};
+    size_t count = 0;
+    for (auto *buf : bufs)
+    {
+        if ((len == 0) || (count == kMaxIov))
+            break;
+        if (offset >= buf->data.size())
+        {
+            offset -= buf->data.size();
+            continue;
+        }
+        size_t n = std::min<uint64_t>(buf->data.size() - offset, len);
+        iov[count].iov_base = buf->data.data() + offset;
+        iov[count].iov_len  = n;
+        count++;
+        offset = 0;
+        len -= n;
+    }
+    return writev(fd, iov.data(), static_cast<int>(count));
+#else
+    for (auto *buf : bufs)
+    {
+        if (offset >= buf->data.size())
+        {
+            offset -= buf->data.size();
+            continue;
+        }
+        size_t n = std::min<uint64_t>(buf->data.size() - offset, len);
+        return write(fd, buf->data.data() + offset, n);
+    }
+    return 0;
+#endif
 }
 
 void ThreadedFileWriter::TrimEmptyBuffers(void)
@@ -616,3 +967,241 @@ bool ThreadedFileWriter::SetBlocking(bool block)
     m_blocking = block;
     return old;
 }
+
+/** \class TFWGroup
+ *  \brief Writes and syncs the files of several ThreadedFileWriters
+ *         using one pair of threads.
+ *
+ *   The recordings made from one multiplex arrive together and usually
+ *   go to the same disk. Rather than each of them having write and sync
+ *   threads of their own, competing with each other for the disk, their
+ *   writers join a group. The group's write thread visits each writer in
+ *   turn, making large aligned writes of whatever is due, see
+ *   ThreadedFileWriter::WritePending(void), and its sync thread syncs the
+ *   files one after another once a second.
+ *
+ *   The group counts what is written to each file, see GetStats(void)
+ *   and GetTotal(void), and logs the total throughput once a minute.
+ *   GetAllStats(void) collects them from every group for the backend
+ *   status.
+ */
+
+QMutex                 TFWGroup::s_groupsLock;
+std::vector<TFWGroup*> TFWGroup::s_groups;
+
+TFWGroup::TFWGroup(const QString &name)
+    : ReferenceCounter(QString("TFWGroup(%1)").arg(name)), m_name(name)
+{
+    m_statsTimer.start();
+    m_logTimer.start();
+
+    m_writeThread = new TFWGroupWriteThread(this);
+    m_writeThread->start();
+    m_syncThread = new TFWGroupSyncThread(this);
+    m_syncThread->start();
+
+    QMutexLocker locker(&s_groupsLock);
+    s_groups.push_back(this);
+}
+
+TFWGroup::~TFWGroup()
+{
+    {
+        QMutexLocker locker(&s_groupsLock);
+        auto it = std::find(s_groups.begin(), s_groups.end(), this);
+        if (it != s_groups.end())
+            s_groups.erase(it);
+    }
+
+    {
+        QMutexLocker locker(&m_lock);
+        m_exit = true;
+        m_hasData.wakeAll();
+        m_syncWait.wakeAll();
+    }
+
+    delete m_writeThread;
+    m_writeThread = nullptr;
+    delete m_syncThread;
+    m_syncThread = nullptr;
+}
+
+/// \brief Called by ThreadedFileWriter::SetGroup(TFWGroup*) on joining.
+void TFWGroup::Add(ThreadedFileWriter *writer)
+{
+    QMutexLocker locker(&m_lock);
+    writer->m_statsBytes = 0;
+    writer->m_rate = 0;
+    m_writers.push_back(writer);
+    m_hasData.wakeAll();
+
+    LOG(VB_FILE, LOG_INFO, LOC_GROUP + QString("Added '%1', %2 files")
+        .arg(writer->m_filename).arg(m_writers.size()));
+}
+
+/** \brief Called by ThreadedFileWriter on leaving, returns once neither
+ *         of the group's threads is using the writer.
+ */
+void TFWGroup::Remove(ThreadedFileWriter *writer)
+{
+    QMutexLocker locker(&m_lock);
+    auto it = std::find(m_writers.begin(), m_writers.end(), writer);
+    if (it != m_writers.end())
+        m_writers.erase(it);
+
+    while ((m_writing == writer) || (m_syncing == writer))
+        m_idle.wait(locker.mutex());
+
+    LOG(VB_FILE, LOG_INFO, LOC_GROUP + QString("Removed '%1', %2 files")
+        .arg(writer->m_filename).arg(m_writers.size()));
+}
+
+/** \brief Lets the write thread know there may be data to write.
+ *
+ *  This is called with the writer's buflock held, which the write thread
+ *  takes while holding the group lock, so it doesn't take the group lock.
+ *  A missed wake up only delays the write thread until its next timeout.
+ */
+void TFWGroup::Wake(void)
+{
+    m_hasData.wakeAll();
+}
+
+/// \brief The write thread's run method.
+void TFWGroup::DiskLoop(void)
+{
+#ifndef _WIN32
+    // don't exit program if file gets larger than quota limit..
+    signal(SIGXFSZ, SIG_IGN);
+#endif
+
+    QMutexLocker locker(&m_lock);
+    while (!m_exit)
+    {
+        bool wrote = false;
+        for (size_t i = 0; (i < m_writers.size()) && !m_exit; i++)
+        {
+            ThreadedFileWriter *writer = m_writers[i];
+            m_writing = writer;
+            locker.unlock();
+
+            wrote |= writer->WritePending();
+
+            locker.relock();
+            m_writing = nullptr;
+            m_idle.wakeAll();
+        }
+
+        if (m_statsTimer.elapsed() >= 10s)
+            UpdateStats();
+
+        // Nothing was due, so wait for data or for the minimum write
+        // interval of some writer to pass.
+        if (!wrote && !m_exit)
+            m_hasData.wait(locker.mutex(), 50);
+    }
+}
+
+/// \brief The sync thread's run method.
+void TFWGroup::SyncLoop(void)
+{
+    QMutexLocker locker(&m_lock);
+    while (!m_exit)
+    {
+        for (size_t i = 0; (i < m_writers.size()) && !m_exit; i++)
+        {
+            ThreadedFileWriter *writer = m_writers[i];
+            m_syncing = writer;
+            locker.unlock();
+
+            writer->SyncOnce();
+
+            locker.relock();
+            m_syncing = nullptr;
+            m_idle.wakeAll();
+        }
+
+        m_syncWait.wait(locker.mutex(), 1000);
+    }
+}
+
+/// \brief Updates the rates of the files, call with the group lock held.
+void TFWGroup::UpdateStats(void)
+{
+    auto elapsed = std::max(m_statsTimer.restart(), 1ms);
+    uint64_t rate = 0;
+    for (auto *writer : m_writers)
+    {
+        QMutexLocker locker(&writer->m_bufLock);
+        writer->m_rate = (writer->m_bytesWritten - writer->m_statsBytes) *
+            1000 / elapsed.count();
+        writer->m_statsBytes = writer->m_bytesWritten;
+        rate += writer->m_rate;
+    }
+
+    if (m_logTimer.elapsed() >= 60s && !m_writers.empty())
+    {
+        LOG(VB_FILE, LOG_INFO, LOC_GROUP + QString("%1 files, %2 KB/s")
+            .arg(m_writers.size()).arg(rate / 1024));
+        m_logTimer.restart();
+    }
+}
+
+/** \brief Returns what has been written to each of the files.
+ *
+ *  The rates are those over the last ten seconds.
+ */
+std::vector<TFWGroup::FileStats> TFWGroup::GetStats(void) const
+{
+    QMutexLocker locker(&m_lock);
+    std::vector<FileStats> stats;
+    stats.reserve(m_writers.size());
+    for (auto *writer : m_writers)
+    {
+        QMutexLocker bufLocker(&writer->m_bufLock);
+        FileStats file;
+        file.m_filename = writer->m_filename;
+        file.m_bytes    = writer->m_bytesWritten;
+        file.m_writes   = writer->m_writeCalls;
+        file.m_rate     = writer->m_rate;
+        stats.push_back(file);
+    }
+    return stats;
+}
+
+/// \brief Returns the sum of GetStats(void), named after the group.
+TFWGroup::FileStats TFWGroup::GetTotal(void) const
+{
+    return Sum(m_name, GetStats());
+}
+
+/// \brief Returns GetTotal(void) and GetStats(void) of every group.
+std::vector<TFWGroup::GroupStats> TFWGroup::GetAllStats(void)
+{
+    QMutexLocker locker(&s_groupsLock);
+    std::vector<GroupStats> stats;
+    stats.reserve(s_groups.size());
+    for (const auto *group : s_groups)
+    {
+        GroupStats gs;
+        gs.m_files = group->GetStats();
+        gs.m_total = Sum(group->m_name, gs.m_files);
+        stats.push_back(gs);
+    }
+    return stats;
+}
+
+TFWGroup::FileStats TFWGroup::Sum(const QString &name,
+                                  const std::vector<FileStats> &files)
+{
+    FileStats total;
+    total.m_filename = name;
+    for (const auto &file : files)
+    {
+        total.m_bytes  += file.m_bytes;
+        total.m_writes += file.m_writes;
+        total.m_rate   += file.m_rate;
+    }
+    return total;
+}
+
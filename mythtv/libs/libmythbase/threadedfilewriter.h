@@ -16,8 +16,11 @@
 // MythTV headers
 #include "mythbaseexp.h"
 #include "mthread.h"
+#include "mythtimer.h"
+#include "referencecounter.h"
 
 class ThreadedFileWriter;
+class TFWGroup;
 
 class TFWWriteThread : public MThread
 {
@@ -39,10 +42,31 @@ class TFWSyncThread : public MThread
     ThreadedFileWriter *m_parent {nullptr};
 };
 
+class TFWGroupWriteThread : public MThread
+{
+  public:
+    explicit TFWGroupWriteThread(TFWGroup *p) : MThread("TFWGroupWrite"), m_parent(p) {}
+    ~TFWGroupWriteThread() override { wait(); m_parent = nullptr; }
+    void run(void) override; // MThread
+  private:
+    TFWGroup *m_parent {nullptr};
+};
+
+class TFWGroupSyncThread : public MThread
+{
+  public:
+    explicit TFWGroupSyncThread(TFWGroup *p) : MThread("TFWGroupSync"), m_parent(p) {}
+    ~TFWGroupSyncThread() override { wait(); m_parent = nullptr; }
+    void run(void) override; // MThread
+  private:
+    TFWGroup *m_parent {nullptr};
+};
+
 class MBASE_PUBLIC ThreadedFileWriter
 {
     friend class TFWWriteThread;
     friend class TFWSyncThread;
+    friend class TFWGroup;
   public:
     /** \fn ThreadedFileWriter::ThreadedFileWriter(const QString&,int,mode_t)
      *  \brief Creates a threaded file writer.
@@ -64,11 +88,21 @@ class MBASE_PUBLIC ThreadedFileWriter
     bool SetBlocking(bool block = true);
     bool WritesFailing(void) const { return m_ignoreWrites; }
 
+    void SetGroup(TFWGroup *group);
+
   protected:
     void DiskLoop(void);
     void SyncLoop(void);
+    void SyncOnce(void);
+    bool WritePending(void);
     void TrimEmptyBuffers(void);
 
+  private:
+    void StartThreads(void);
+    void StopThreads(void);
+    void WakeWriter(void);
+    void IgnoreWrites(int err);
+
   private:
     // file info
     QString         m_filename;
@@ -80,8 +114,10 @@ class MBASE_PUBLIC ThreadedFileWriter
     bool            m_flush              {false};         // protected by buflock
     bool            m_inDtor             {false};         // protected by buflock
     bool            m_ignoreWrites       {false};         // protected by buflock
+    bool            m_stopThreads        {false};         // protected by buflock
     uint            m_tfwMinWriteSize    {kMinWriteSize}; // protected by buflock
     uint            m_totalBufferUse     {0};             // protected by buflock
+    uint64_t        m_inFlight           {0};             // protected by buflock
 
     // buffers
     class TFWBuffer
@@ -94,10 +130,23 @@ class MBASE_PUBLIC ThreadedFileWriter
     QList<TFWBuffer*> m_writeBuffers;     // protected by buflock
     QList<TFWBuffer*> m_emptyBuffers;     // protected by buflock
 
+    static ssize_t WriteBuffers(int fd, const QList<TFWBuffer*> &bufs,
+                                uint64_t offset, uint64_t len);
+
     // threads
     TFWWriteThread *m_writeThread        {nullptr};
     TFWSyncThread  *m_syncThread         {nullptr};
 
+    // group, when the writing and syncing is done by TFWGroup's threads
+    TFWGroup       *m_group              {nullptr};       // protected by buflock
+    int64_t         m_filePos            {0};             // protected by buflock
+    uint64_t        m_bytesWritten       {0};             // protected by buflock
+    uint64_t        m_writeCalls         {0};             // protected by buflock
+    uint64_t        m_statsBytes         {0};             // protected by group lock
+    uint64_t        m_rate               {0};             // protected by group lock
+    MythTimer       m_minWriteTimer;
+    MythTimer       m_registerTimer;
+
     // wait conditions
     QWaitCondition  m_bufferEmpty;
     QWaitCondition  m_bufferHasData;
@@ -110,10 +159,73 @@ class MBASE_PUBLIC ThreadedFileWriter
     static const uint kMinWriteSize;
     /// Maximum block size to write at a time
     static const uint kMaxBlockSize;
+    /// File offset a group write ends on, when not flushing buffer.
+    static const uint kWriteAlignment;
 
     bool m_warned                        {false};
     bool m_blocking                      {false};
     bool m_registered                    {false};
 };
 
+class MBASE_PUBLIC TFWGroup : public ReferenceCounter
+{
+    friend class TFWGroupWriteThread;
+    friend class TFWGroupSyncThread;
+    friend class ThreadedFileWriter;
+  public:
+    struct FileStats
+    {
+        QString  m_filename;
+        uint64_t m_bytes  {0}; ///< bytes written since joining the group
+        uint64_t m_writes {0}; ///< write system calls made
+        uint64_t m_rate   {0}; ///< bytes per second over the last period
+    };
+
+    struct GroupStats
+    {
+        FileStats              m_total; ///< named after the group
+        std::vector<FileStats> m_files;
+    };
+
+    explicit TFWGroup(const QString &name);
+
+    std::vector<FileStats> GetStats(void) const;
+    FileStats GetTotal(void) const;
+
+    static std::vector<GroupStats> GetAllStats(void);
+
+  protected:
+    ~TFWGroup() override;
+
+    void DiskLoop(void);
+    void SyncLoop(void);
+
+  private:
+    void Add(ThreadedFileWriter *writer);
+    void Remove(ThreadedFileWriter *writer);
+    void Wake(void);
+    void UpdateStats(void);
+    static FileStats Sum(const QString &name,
+                         const std::vector<FileStats> &files);
+
+    QString                          m_name;
+    mutable QMutex                   m_lock;
+    std::vector<ThreadedFileWriter*> m_writers;                // protected by lock
+    ThreadedFileWriter              *m_writing      {nullptr}; // protected by lock
+    ThreadedFileWriter              *m_syncing      {nullptr}; // protected by lock
+    bool                             m_exit         {false};   // protected by lock
+    MythTimer                        m_statsTimer;
+    MythTimer                        m_logTimer;
+
+    TFWGroupWriteThread             *m_writeThread  {nullptr};
+    TFWGroupSyncThread              *m_syncThread   {nullptr};
+
+    QWaitCondition                   m_hasData;
+    QWaitCondition                   m_syncWait;
+    QWaitCondition                   m_idle;
+
+    static QMutex                    s_groupsLock;
+    static std::vector<TFWGroup*>    s_groups;                 // protected by groupsLock
+};
+
 #endif
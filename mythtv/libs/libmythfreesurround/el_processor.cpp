@@ -26,7 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <vector>
 extern "C" {
 #include "libavutil/mem.h"
-#include "libavcodec/avfft.h"
+#include "libavutil/tx.h"
 }
 
 using cfloat = std::complex<float>;
@@ -48,22 +48,28 @@ public:
     explicit Impl(unsigned blocksize=8192)
       : m_n(blocksize),
         m_halfN(blocksize/2),
-        // create lavc fft buffers
-        m_dftL((FFTComplex*)av_malloc(sizeof(FFTComplex) * m_n * 2)),
-        m_dftR((FFTComplex*)av_malloc(sizeof(FFTComplex) * m_n * 2)),
-        // TODO only valid because blocksize is always 8192:
-        // (convert blocksize to log_2 (n) instead since FFmpeg only supports sizes that are powers of 2)
-        m_fftContextForward(av_fft_init(13, 0)),
-        m_fftContextReverse(av_fft_init(13, 1)),
-        m_src((FFTComplex*)av_malloc(sizeof(FFTComplex) * m_n * 2))
+        // create lavu real fft buffers, the spectra hold the N/2+1 non-redundant bins
+        m_time((float*)av_malloc(sizeof(float) * m_n)),
+        m_dftL((AVComplexFloat*)av_malloc(sizeof(AVComplexFloat) * (m_halfN + 1))),
+        m_dftR((AVComplexFloat*)av_malloc(sizeof(AVComplexFloat) * (m_halfN + 1))),
+        m_src((AVComplexFloat*)av_malloc(sizeof(AVComplexFloat) * (m_halfN + 1)))
 {
+        // any even block size will do, neither transform is normalized
+        const float scale = 1.0F;
+        av_tx_init(&m_txForward, &m_txForwardFn, AV_TX_FLOAT_RDFT, 0, m_n, &scale, 0);
+        av_tx_init(&m_txReverse, &m_txReverseFn, AV_TX_FLOAT_RDFT, 1, m_n, &scale, 0);
         // resize our own buffers
-        m_frontR.resize(m_n);
-        m_frontL.resize(m_n);
-        m_avg.resize(m_n);
-        m_surR.resize(m_n);
-        m_surL.resize(m_n);
-        m_trueavg.resize(m_n);
+        m_frontLRe.resize(m_halfN);
+        m_frontLIm.resize(m_halfN);
+        m_frontRRe.resize(m_halfN);
+        m_frontRIm.resize(m_halfN);
+        m_avgRe.resize(m_halfN);
+        m_avgIm.resize(m_halfN);
+        m_trueavgRe.resize(m_halfN);
+        m_trueavgIm.resize(m_halfN);
+        m_ampDiff.resize(m_halfN);
+        m_cross.resize(m_halfN);
+        m_dot.resize(m_halfN);
         m_xFs.resize(m_n);
         m_yFs.resize(m_n);
         m_inbuf[0].resize(m_n);
@@ -89,11 +95,12 @@ public:
 
     // destructor
     ~Impl() {
-        av_fft_end(m_fftContextForward);
-        av_fft_end(m_fftContextReverse);
+        av_tx_uninit(&m_txForward);
+        av_tx_uninit(&m_txReverse);
         av_free(m_src);
         av_free(m_dftR);
         av_free(m_dftL);
+        av_free(m_time);
     }
 
     float ** getInputBuffers()
@@ -173,6 +180,9 @@ public:
         const std::array<std::array<float,2>,4> modes {{ {0,0}, {0,PI}, {PI,0}, {-PI/2,PI/2} }};
         m_phaseOffsetL = modes[mode][0];
         m_phaseOffsetR = modes[mode][1];
+        // the surrounds are the fronts rotated by these offsets
+        m_rotateL = std::polar(1.0F, m_phaseOffsetL);
+        m_rotateR = std::polar(1.0F, m_phaseOffsetR);
     }
 
     // what steering mode should be chosen
@@ -185,11 +195,6 @@ public:
     }
 
 private:
-    // polar <-> cartesian coodinates conversion
-    static cfloat polar(float a, float p) { return {a*std::cos(p), a*std::sin(p)}; }
-    static float amplitude(FFTComplex z) { return std::hypot(z.re, z.im); }
-    static float phase(FFTComplex z) { return std::atan2(z.im, z.re); }
-
     /// Clamp the input to the interval [-1, 1], i.e. clamp the magnitude to the unit interval [0, 1]
     static float clamp_unit_mag(float x) { return std::clamp(x, -1.0F, 1.0F); }
 
@@ -200,49 +205,69 @@ private:
         block_decode(input1,input2,out,center_width,dimension,adaption_rate);
     }
 
+    // window the two halves of a block and transform it into the frequency domain
+    void transform(float *input1, float *input2, AVComplexFloat *dft) {
+        // input1 is in the rising half of the window
+        // input2 is in the falling half of the window
+        for (unsigned k = 0; k < m_halfN; k++)
+        {
+            m_time[k]           = input1[k] * m_wnd[k];
+            m_time[k + m_halfN] = input2[k] * m_wnd[k + m_halfN];
+        }
+        m_txForwardFn(m_txForward, dft, m_time, sizeof(float));
+    }
+
     // CORE FUNCTION: decode a block of data
+    //  The bins are processed one quantity at a time over flat arrays so that
+    //  everything apart from the steering itself vectorizes.
     void block_decode(InputBufs input1, InputBufs input2, OutputBufs output, float center_width, float dimension, float adaption_rate) {
+        if (!m_txForward || !m_txReverse)
+            return;
+
         // 1. scale the input by the window function; this serves a dual purpose:
         // - first it improves the FFT resolution b/c boundary discontinuities (and their frequencies) get removed
         // - second it allows for smooth blending of varying filters between the blocks
-
         // the window also includes 1.0/sqrt(n) normalization
-        // concatenate copies of input1 and input2 for some undetermined reason
-        // input1 is in the rising half of the window
-        // input2 is in the falling half of the window
-        for (unsigned k = 0; k < m_halfN; k++)
-        {
-            m_dftL[k]           = (FFTComplex){ .re = input1[0][k] * m_wnd[k], .im = (FFTSample)0 };
-            m_dftR[k]           = (FFTComplex){ .re = input1[1][k] * m_wnd[k], .im = (FFTSample)0 };
-
-            m_dftL[k + m_halfN] = (FFTComplex){ .re = input2[0][k] * m_wnd[k + m_halfN], .im = (FFTSample)0 };
-            m_dftR[k + m_halfN] = (FFTComplex){ .re = input2[1][k] * m_wnd[k + m_halfN], .im = (FFTSample)0 };
-        }
+        transform(input1[0], input2[0], m_dftL);
+        transform(input1[1], input2[1], m_dftR);
 
-        // ... and tranform it into the frequency domain
-        av_fft_permute(m_fftContextForward, m_dftL);
-        av_fft_calc(m_fftContextForward, m_dftL);
+        // 2. get amplitudes and directions of each DFT bin, but dont do the N/2 component
+        //    A zero bin has a phase of 0, i.e. the direction (1,0).
+        for (unsigned f=0;f<m_halfN;f++) {
+            float reL = m_dftL[f].re;
+            float imL = m_dftL[f].im;
+            float reR = m_dftR[f].re;
+            float imR = m_dftR[f].im;
+            float ampL = std::sqrt(reL*reL + imL*imL);
+            float ampR = std::sqrt(reR*reR + imR*imR);
+            float sum = ampL + ampR;
+            float invL = ampL > 0.0F ? 1.0F / ampL : 0.0F;
+            float invR = ampR > 0.0F ? 1.0F / ampR : 0.0F;
+            float unitReL = ampL > 0.0F ? reL * invL : 1.0F;
+            float unitImL = imL * invL;
+            float unitReR = ampR > 0.0F ? reR * invR : 1.0F;
+            float unitImR = imR * invR;
+
+            // calculate the amplitude difference, and the phase difference as an angle between the directions
+            m_ampDiff[f] = clamp_unit_mag((sum < epsilon) ? 0 : (ampR-ampL) / sum);
+            m_cross[f] = (unitImL * unitReR) - (unitReL * unitImR);
+            m_dot[f]   = (unitReL * unitReR) + (unitImL * unitImR);
 
-        av_fft_permute(m_fftContextForward, m_dftR);
-        av_fft_calc(m_fftContextForward, m_dftR);
+            // ... and build the signal which we want to position
+            m_frontLRe[f] = sum * unitReL;
+            m_frontLIm[f] = sum * unitImL;
+            m_frontRRe[f] = sum * unitReR;
+            m_frontRIm[f] = sum * unitImR;
+            m_avgRe[f] = m_frontLRe[f] + m_frontRRe[f];
+            m_avgIm[f] = m_frontLIm[f] + m_frontRIm[f];
+            m_trueavgRe[f] = reL + reR;
+            m_trueavgIm[f] = imL + imR;
+        }
 
-        // 2. compare amplitude and phase of each DFT bin and produce the X/Y coordinates in the sound field
-        //    but dont do DC or N/2 component
+        // 3. produce the X/Y coordinates in the sound field and the filters for each output channel
         for (unsigned f=0;f<m_halfN;f++) {
-            // get left/right amplitudes/phases
-            float ampL = amplitude(m_dftL[f]);
-            float ampR = amplitude(m_dftR[f]);
-            float phaseL = phase(m_dftL[f]);
-            float phaseR = phase(m_dftR[f]);
-//          if (ampL+ampR < epsilon)
-//              continue;       
-
-            // calculate the amplitude/phase difference
-            float ampDiff = clamp_unit_mag((ampL+ampR < epsilon) ? 0 : (ampR-ampL) / (ampR+ampL));
-            float phaseDiff = phaseL - phaseR;
-            if (phaseDiff < -PI) phaseDiff += 2*PI;
-            if (phaseDiff > PI) phaseDiff -= 2*PI;
-            phaseDiff = abs(phaseDiff);
+            float ampDiff = m_ampDiff[f];
+            float phaseDiff = std::abs(std::atan2(m_cross[f], m_dot[f]));
 
             if (m_linearSteering) {
                 // --- this is the fancy new linear mode ---
@@ -257,7 +282,7 @@ private:
                 // add crossfeed control
                 m_xFs[f] = clamp_unit_mag(m_xFs[f] * (m_frontSeparation*(1+m_yFs[f])/2 + m_rearSeparation*(1-m_yFs[f])/2));
 
-                // 3. generate frequency filters for each output channel
+                // generate frequency filters for each output channel
                 float left = (1-m_xFs[f])/2;
                 float right = (1+m_xFs[f])/2;
                 float front = (1+m_yFs[f])/2;
@@ -278,23 +303,16 @@ private:
             } else {
                 // --- this is the old & simple steering mode ---
 
-                // calculate the amplitude/phase difference
-                float ampDiff = clamp_unit_mag((ampL+ampR < epsilon) ? 0 : (ampR-ampL) / (ampR+ampL));
-                float phaseDiff = phaseL - phaseR;
-                if (phaseDiff < -PI) phaseDiff += 2*PI;
-                if (phaseDiff > PI) phaseDiff -= 2*PI;
-                phaseDiff = abs(phaseDiff);
-
                 // determine sound field x-position
                 m_xFs[f] = ampDiff;
 
                 // determine preliminary sound field y-position from phase difference
                 m_yFs[f] = 1 - (phaseDiff/PI)*2;
 
-                if (abs(m_xFs[f]) > m_surroundBalance) {
+                if (std::abs(m_xFs[f]) > m_surroundBalance) {
                     // blend linearly between the surrounds and the fronts if the balance exceeds the surround encoding balance
                     // this is necessary because the sound field is trapezoidal and will be stretched behind the listener
-                    float frontness = (abs(m_xFs[f]) - m_surroundBalance)/(1-m_surroundBalance);
+                    float frontness = (std::abs(m_xFs[f]) - m_surroundBalance)/(1-m_surroundBalance);
                     m_yFs[f]  = (1-frontness) * m_yFs[f] + frontness * 1;
                 }
 
@@ -304,7 +322,7 @@ private:
                 // add crossfeed control
                 m_xFs[f] = clamp_unit_mag(m_xFs[f] * (m_frontSeparation*(1+m_yFs[f])/2 + m_rearSeparation*(1-m_yFs[f])/2));
 
-                // 3. generate frequency filters for each output channel, according to the signal position
+                // generate frequency filters for each output channel, according to the signal position
                 // the sum of all channel volumes must be 1.0
                 float left = (1-m_xFs[f])/2;
                 float right = (1+m_xFs[f])/2;
@@ -323,23 +341,16 @@ private:
                 for (unsigned c=0;c<5;c++)
                     m_filter[c][f] = (1-adaption_rate)*m_filter[c][f] + adaption_rate*volume[c];
             }
-
-            // ... and build the signal which we want to position
-            m_frontL[f] = polar(ampL+ampR,phaseL);
-            m_frontR[f] = polar(ampL+ampR,phaseR);
-            m_avg[f] = m_frontL[f] + m_frontR[f];
-            m_surL[f] = polar(ampL+ampR,phaseL+m_phaseOffsetL);
-            m_surR[f] = polar(ampL+ampR,phaseR+m_phaseOffsetR);
-            m_trueavg[f] = cfloat(m_dftL[f].re + m_dftR[f].re, m_dftL[f].im + m_dftR[f].im);
         }
 
         // 4. distribute the unfiltered reference signals over the channels
-        apply_filter((m_frontL).data(), m_filter[0].data(),&output[0][0]);  // front left
-        apply_filter((m_avg).data(),    m_filter[1].data(),&output[1][0]);  // front center
-        apply_filter((m_frontR).data(), m_filter[2].data(),&output[2][0]);  // front right
-        apply_filter((m_surL).data(),   m_filter[3].data(),&output[3][0]);  // surround left
-        apply_filter((m_surR).data(),   m_filter[4].data(),&output[4][0]);  // surround right
-        apply_filter((m_trueavg).data(),m_filter[5].data(),&output[5][0]);  // lfe
+        static const cfloat straight(1.0F, 0.0F);
+        apply_filter(m_frontLRe.data(),  m_frontLIm.data(),  straight,  m_filter[0].data(),&output[0][0]);  // front left
+        apply_filter(m_avgRe.data(),     m_avgIm.data(),     straight,  m_filter[1].data(),&output[1][0]);  // front center
+        apply_filter(m_frontRRe.data(),  m_frontRIm.data(),  straight,  m_filter[2].data(),&output[2][0]);  // front right
+        apply_filter(m_frontLRe.data(),  m_frontLIm.data(),  m_rotateL, m_filter[3].data(),&output[3][0]);  // surround left
+        apply_filter(m_frontRRe.data(),  m_frontRIm.data(),  m_rotateR, m_filter[4].data(),&output[4][0]);  // surround right
+        apply_filter(m_trueavgRe.data(), m_trueavgIm.data(), straight,  m_filter[5].data(),&output[5][0]);  // lfe
     }
 
 #define FASTER_CALC
@@ -355,7 +366,6 @@ private:
             + (0.09170680403453149*x*x*x) + (0.2617754892323973*tan(x)) - (0.04180413533856156*sqr(tan(x)));
 #endif
     }
-
     // map from amplitude difference and yfs to xfs
     static double get_xfs(double ampDiff, double yfs) {
         double x=ampDiff;
@@ -395,48 +405,56 @@ private:
     @brief Filter the complex source signal in the frequency domain and add it
            to the time domain target signal.
 
-    @param[in]  signal  The signal, in the frequency domain, to be filtered.
+    @param[in]  re      The real parts of the signal, in the frequency domain.
+    @param[in]  im      The imaginary parts of the signal.
+    @param[in]  rotate  A unit phase shift to be applied to the signal.
     @param[in]  flt     The filter, in the frequency domain, to be applied.
     @param[out] target  The signal, in the time domain, to which the filtered signal
                         is added
     */
-    void apply_filter(cfloat *signal, const float *flt, float *target) {
-        // filter the signal
-        for (unsigned f = 0; f <= m_halfN; f++)
-        {
-            m_src[f].re = signal[f].real() * flt[f];
-            m_src[f].im = signal[f].imag() * flt[f];
-        }
-        // enforce odd symmetry
-        for (unsigned f = 1; f < m_halfN; f++)
+    void apply_filter(const float *re, const float *im, cfloat rotate, const float *flt, float *target) {
+        // filter the signal, the N/2 component is left out
+        const float rotRe = rotate.real();
+        const float rotIm = rotate.imag();
+        for (unsigned f = 0; f < m_halfN; f++)
         {
-            m_src[m_n - f].re =  m_src[f].re;
-            m_src[m_n - f].im = -m_src[f].im;   // complex conjugate
+            m_src[f].re = ((re[f] * rotRe) - (im[f] * rotIm)) * flt[f];
+            m_src[f].im = ((re[f] * rotIm) + (im[f] * rotRe)) * flt[f];
         }
-        av_fft_permute(m_fftContextReverse, m_src);
-        av_fft_calc(m_fftContextReverse, m_src);
+        m_src[m_halfN].re = 0;
+        m_src[m_halfN].im = 0;
+        // the real inverse transform implies the odd symmetry
+        m_txReverseFn(m_txReverse, m_time, m_src, sizeof(AVComplexFloat));
 
         // add the result to target, windowed
+        float *first  = &target[m_currentBuf * m_halfN];
+        float *second = &target[(m_currentBuf ^ 1) * m_halfN];
         for (unsigned int k = 0; k < m_halfN; k++)
         {
             // 1st part is overlap add
-            target[(m_currentBuf * m_halfN) + k]      += m_src[k].re * m_wnd[k];
+            first[k] += m_time[k] * m_wnd[k];
             // 2nd part is set as has no history
-            target[((m_currentBuf ^ 1) * m_halfN) + k] = m_src[m_halfN + k].re * m_wnd[m_halfN + k];
+            second[k] = m_time[m_halfN + k] * m_wnd[m_halfN + k];
         }
     }
 
     size_t m_n;                          // the block size
     size_t m_halfN;                      // half block size precalculated
-    FFTContext *m_fftContextForward {nullptr};
-    FFTContext *m_fftContextReverse {nullptr};
-    // FFTs are computed in-place in these buffers on copies of the input
-    FFTComplex *m_dftL {nullptr};
-    FFTComplex *m_dftR {nullptr};
-    FFTComplex *m_src  {nullptr}; ///< Used only in apply_filter
-    // buffers
-    std::vector<cfloat> m_frontL,m_frontR,m_avg,m_surL,m_surR; // the signal (phase-corrected) in the frequency domain
-    std::vector<cfloat> m_trueavg;       // for lfe generation
+    AVTXContext *m_txForward {nullptr};
+    AVTXContext *m_txReverse {nullptr};
+    av_tx_fn m_txForwardFn   {nullptr};
+    av_tx_fn m_txReverseFn   {nullptr};
+    // transform buffers
+    float *m_time {nullptr};             ///< windowed block, in the time domain
+    AVComplexFloat *m_dftL {nullptr};
+    AVComplexFloat *m_dftR {nullptr};
+    AVComplexFloat *m_src  {nullptr};    ///< Used only in apply_filter, overwritten by the transform
+    // buffers, one array per quantity and an element per frequency bin
+    std::vector<float> m_frontLRe,m_frontLIm,m_frontRRe,m_frontRIm; // the signal (phase-corrected) in the frequency domain
+    std::vector<float> m_avgRe,m_avgIm;  // the sum of the front signals
+    std::vector<float> m_trueavgRe,m_trueavgIm; // for lfe generation
+    std::vector<float> m_ampDiff;        // the amplitude difference of each frequency bin
+    std::vector<float> m_cross,m_dot;    // the phase difference, as the angle between the left/right directions
     std::vector<float> m_xFs,m_yFs;      // the feature space positions for each frequency bin
     std::vector<float> m_wnd;            // the window function, precalculated
     std::array<std::vector<float>,6> m_filter;      // a frequency filter for each output channel
@@ -449,6 +467,8 @@ private:
     float m_surroundLevel   {0.0F};      // gain for the surround channels (follows from the coeffs
     float m_phaseOffsetL    {0.0F};      // phase shifts to be applied to the rear channels
     float m_phaseOffsetR    {0.0F};      // phase shifts to be applied to the rear channels
+    cfloat m_rotateL        {1.0F};      // the phase shifts as unit rotations
+    cfloat m_rotateR        {1.0F};      // the phase shifts as unit rotations
     float m_frontSeparation {0.0F};      // front stereo separation
     float m_rearSeparation  {0.0F};      // rear stereo separation
     bool  m_linearSteering  {false};     // whether the steering should be linear or not
@@ -34,7 +34,8 @@ public:
         SurroundModePassiveHall
     };
 public:
-    FreeSurround(uint srate, bool moviemode, SurroundMode mode);
+    FreeSurround(uint srate, bool moviemode, SurroundMode mode,
+                 uint blockSize = SURROUND_BUFSIZE);
     ~FreeSurround();
 
     // put frames in buffer, returns number of frames used
@@ -49,7 +50,7 @@ public:
     long long getLatency();
     uint frameLatency() const;
 
-    static uint framesPerBlock();
+    uint framesPerBlock() const;
 
 protected:
     void process_block();
@@ -75,6 +76,7 @@ private:
 
     // additional settings
     uint m_srate;
+    uint m_blockSize;                             // samples per transform
 
     // info about the current setup
     struct buffers          *m_bufs    {nullptr}; // our buffers
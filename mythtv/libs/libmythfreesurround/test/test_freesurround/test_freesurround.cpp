@@ -0,0 +1,408 @@
+/*
+ *  Class TestFreeSurround
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include <QElapsedTimer>
+
+extern "C" {
+#include "libavutil/tx.h"
+}
+
+#include "test_freesurround.h"
+#include "libmythfreesurround/el_processor.h"
+#include "libmythfreesurround/freesurround.h"
+
+static constexpr int kBlocks { 12 };
+
+/** \class ReferenceDecoder
+ *  \brief The FreeSurround decoder as it was before the real transforms.
+ *
+ *  Each bin is taken apart into amplitude and phase, positioned and put
+ *  back together with std::polar, and the inverse transform runs on the
+ *  whole complex spectrum after mirroring it. Only the steering for the
+ *  default coefficients and separation is kept.
+ */
+class ReferenceDecoder
+{
+  public:
+    explicit ReferenceDecoder(unsigned n)
+      : m_n(n), m_halfN(n / 2),
+        m_dftL(n), m_dftR(n), m_src(n), m_time(n),
+        m_inbuf{std::vector<float>(n), std::vector<float>(n)}
+    {
+        av_tx_init(&m_forward, &m_forwardFn, AV_TX_FLOAT_FFT, 0, n, nullptr, 0);
+        av_tx_init(&m_reverse, &m_reverseFn, AV_TX_FLOAT_FFT, 1, n, nullptr, 0);
+        for (auto & out : m_outbuf)
+            out.resize(n);
+        for (auto & flt : m_filter)
+            flt.resize(n);
+        m_wnd.resize(n);
+        for (unsigned k = 0; k < n; k++)
+            m_wnd[k] = std::sqrt(0.5F * (1 - std::cos(2 * kPi * k / n)) / n);
+        unsigned cutoff = (30 * n) / 48000;
+        for (unsigned f = 0; f <= m_halfN; f++)
+            m_filter[5][f] = f < cutoff ? 0.5F * std::sqrt(0.5F) : 0.0F;
+    }
+
+    ~ReferenceDecoder()
+    {
+        av_tx_uninit(&m_forward);
+        av_tx_uninit(&m_reverse);
+    }
+
+    void phase_mode(unsigned mode)
+    {
+        static const std::array<std::array<float,2>,4> kModes
+            {{ {0,0}, {0,kPi}, {kPi,0}, {-kPi/2,kPi/2} }};
+        m_phaseOffsetL = kModes[mode][0];
+        m_phaseOffsetR = kModes[mode][1];
+    }
+
+    void steering_mode(bool mode) { m_linearSteering = mode; }
+
+    float *Input(int c)  { return &m_inbuf[c][m_currentBuf * m_halfN]; }
+    float *Output(int c) { return &m_outbuf[c][m_currentBuf * m_halfN]; }
+
+    void decode(float center_width, float dimension, float adaption_rate)
+    {
+        unsigned second = m_currentBuf * m_halfN;
+        m_currentBuf ^= 1;
+        unsigned first = m_currentBuf * m_halfN;
+
+        Transform(&m_inbuf[0][first], &m_inbuf[0][second], m_dftL);
+        Transform(&m_inbuf[1][first], &m_inbuf[1][second], m_dftR);
+
+        std::array<std::vector<cfloat>,6> signal;
+        for (auto & s : signal)
+            s.resize(m_halfN + 1);
+
+        for (unsigned f = 0; f < m_halfN; f++)
+        {
+            float ampL = std::hypot(m_dftL[f].re, m_dftL[f].im);
+            float ampR = std::hypot(m_dftR[f].re, m_dftR[f].im);
+            float phaseL = std::atan2(m_dftL[f].im, m_dftL[f].re);
+            float phaseR = std::atan2(m_dftR[f].im, m_dftR[f].re);
+
+            float ampDiff = std::clamp((ampL + ampR < 0.000001F) ? 0 : (ampR - ampL) / (ampR + ampL), -1.0F, 1.0F);
+            float phaseDiff = phaseL - phaseR;
+            if (phaseDiff < -kPi) phaseDiff += 2 * kPi;
+            if (phaseDiff > kPi) phaseDiff -= 2 * kPi;
+            phaseDiff = std::abs(phaseDiff);
+
+            float xfs = 0;
+            float yfs = 0;
+            if (m_linearSteering)
+            {
+                yfs = get_yfs(ampDiff, phaseDiff);
+                xfs = get_xfs(ampDiff, yfs);
+            }
+            else
+            {
+                xfs = ampDiff;
+                yfs = 1 - (phaseDiff / kPi) * 2;
+                if (std::abs(xfs) > kSurroundBalance)
+                {
+                    float frontness = (std::abs(xfs) - kSurroundBalance) / (1 - kSurroundBalance);
+                    yfs = (1 - frontness) * yfs + frontness;
+                }
+            }
+            yfs = std::clamp(yfs - dimension, -1.0F, 1.0F);
+            xfs = std::clamp(xfs * ((1 + yfs) / 2 + (1 - yfs) / 2), -1.0F, 1.0F);
+
+            float left = (1 - xfs) / 2;
+            float right = (1 + xfs) / 2;
+            float front = (1 + yfs) / 2;
+            float back = (1 - yfs) / 2;
+            std::array<float,5> volume
+            {
+                front * (left  * center_width + std::max(0.0F, -xfs) * (1.0F - center_width)),
+                front * 0.5F * std::sqrt(0.5F) * ((1.0F - std::abs(xfs)) * (1.0F - center_width)),
+                front * (right * center_width + std::max(0.0F,  xfs) * (1.0F - center_width)),
+                back * kSurroundLevel * (m_linearSteering ? left :
+                    std::clamp((1.0F - (xfs / kSurroundBalance)) / 2.0F, 0.0F, 1.0F)),
+                back * kSurroundLevel * (m_linearSteering ? right :
+                    std::clamp((1.0F + (xfs / kSurroundBalance)) / 2.0F, 0.0F, 1.0F))
+            };
+            for (unsigned c = 0; c < 5; c++)
+                m_filter[c][f] = (1 - adaption_rate) * m_filter[c][f] + adaption_rate * volume[c];
+
+            signal[0][f] = std::polar(ampL + ampR, phaseL);
+            signal[2][f] = std::polar(ampL + ampR, phaseR);
+            signal[1][f] = signal[0][f] + signal[2][f];
+            signal[3][f] = std::polar(ampL + ampR, phaseL + m_phaseOffsetL);
+            signal[4][f] = std::polar(ampL + ampR, phaseR + m_phaseOffsetR);
+            signal[5][f] = cfloat(m_dftL[f].re + m_dftR[f].re, m_dftL[f].im + m_dftR[f].im);
+        }
+
+        for (unsigned c = 0; c < 6; c++)
+            Filter(signal[c], m_filter[c], m_outbuf[c]);
+    }
+
+  private:
+    using cfloat = std::complex<float>;
+    static constexpr float kPi { 3.141592654F };
+    static constexpr float kSurroundBalance { (0.8165F - 0.5774F) / (0.8165F + 0.5774F) };
+    static constexpr float kSurroundLevel   { 1 / (0.8165F + 0.5774F) };
+
+    void Transform(const float *input1, const float *input2,
+                   std::vector<AVComplexFloat> &dft)
+    {
+        for (unsigned k = 0; k < m_halfN; k++)
+        {
+            m_time[k]           = { input1[k] * m_wnd[k], 0 };
+            m_time[k + m_halfN] = { input2[k] * m_wnd[k + m_halfN], 0 };
+        }
+        m_forwardFn(m_forward, dft.data(), m_time.data(), sizeof(AVComplexFloat));
+    }
+
+    void Filter(const std::vector<cfloat> &signal, const std::vector<float> &flt,
+                std::vector<float> &target)
+    {
+        for (unsigned f = 0; f <= m_halfN; f++)
+            m_src[f] = { signal[f].real() * flt[f], signal[f].imag() * flt[f] };
+        for (unsigned f = 1; f < m_halfN; f++)
+            m_src[m_n - f] = { m_src[f].re, -m_src[f].im };
+        m_reverseFn(m_reverse, m_time.data(), m_src.data(), sizeof(AVComplexFloat));
+
+        for (unsigned k = 0; k < m_halfN; k++)
+        {
+            target[(m_currentBuf * m_halfN) + k] += m_time[k].re * m_wnd[k];
+            target[((m_currentBuf ^ 1) * m_halfN) + k] = m_time[m_halfN + k].re * m_wnd[m_halfN + k];
+        }
+    }
+
+    static double get_yfs(double ampDiff, double phaseDiff)
+    {
+        double x = 1 - (((1 - (ampDiff * ampDiff)) * phaseDiff) / M_PI * 2);
+        double tanX = tan(x);
+        return 0.16468622925824683 + (0.5009268347818189*x) - (0.06462757726992101*x*x)
+            + (0.09170680403453149*x*x*x) + (0.2617754892323973*tanX) - (0.04180413533856156*tanX*tanX);
+    }
+
+    static double get_xfs(double x, double y)
+    {
+        double tanX = tan(x);
+        double tanY = tan(y);
+        double asinX = asin(x);
+        double sinX = sin(x);
+        double sinY = sin(y);
+        double x3 = x*x*x;
+        double y2 = y*y;
+        double y3 = y*y2;
+        return (2.464833559224702*x) - (423.52131153259404*x*y) +
+            (67.8557858606918*x3*y) + (788.2429425544392*x*y2) -
+            (79.97650354902909*x3*y2) - (513.8966153850349*x*y3) +
+            (35.68117670186306*x3*y3) + (13867.406173420834*y*asinX) -
+            (2075.8237075786396*y2*asinX) - (908.2722068360281*y3*asinX) -
+            (12934.654772878019*asinX*sinY) - (13216.736529661162*y*tanX) +
+            (1288.6463247741938*y2*tanX) + (1384.372969378453*y3*tanX) +
+            (12699.231471126128*sinY*tanX) + (95.37131275594336*sinX*tanY) -
+            (91.21223198407546*tanX*tanY);
+    }
+
+    unsigned m_n;
+    unsigned m_halfN;
+    AVTXContext *m_forward {nullptr};
+    AVTXContext *m_reverse {nullptr};
+    av_tx_fn m_forwardFn   {nullptr};
+    av_tx_fn m_reverseFn   {nullptr};
+    std::vector<AVComplexFloat> m_dftL, m_dftR, m_src, m_time;
+    std::vector<float> m_wnd;
+    std::array<std::vector<float>,6> m_filter;
+    std::array<std::vector<float>,2> m_inbuf;
+    std::array<std::vector<float>,6> m_outbuf;
+    float m_phaseOffsetL   {0.0F};
+    float m_phaseOffsetR   {0.0F};
+    bool  m_linearSteering {true};
+    unsigned m_currentBuf  {0};
+};
+
+// A stereo mix with a centered tone, a tone with a phase difference
+// between the channels, an out of phase tone and a little noise.
+static void Fill(float *left, float *right, unsigned count, int64_t &pos,
+                 uint32_t &seed)
+{
+    for (unsigned k = 0; k < count; k++, pos++)
+    {
+        double t = pos / 48000.0;
+        std::array<float,2> noise {};
+        for (auto & n : noise)
+        {
+            seed = (seed * 1664525U) + 1013904223U;
+            n = (((seed >> 8) / 16777216.0F) - 0.5F) * 0.05F;
+        }
+        float common = 0.3F * std::sin(2 * M_PI * 440 * t);
+        float opposite = 0.15F * std::sin(2 * M_PI * 3000 * t);
+        left[k]  = common + 0.2F * std::sin(2 * M_PI * 97 * t) + opposite + noise[0];
+        right[k] = common + 0.2F * std::sin(2 * M_PI * 97 * t + 0.7) - opposite + noise[1];
+    }
+}
+
+void TestFreeSurround::Decoder_data(void)
+{
+    QTest::addColumn<unsigned>("blocksize");
+    QTest::addColumn<bool>("linear");
+    QTest::addColumn<unsigned>("phasemode");
+
+    QTest::newRow("linear")              << 8192U << true  << 0U;
+    QTest::newRow("linear powerdvd")     << 8192U << true  << 1U;
+    QTest::newRow("linear quadrature")   << 8192U << true  << 3U;
+    QTest::newRow("simple")              << 8192U << false << 0U;
+    QTest::newRow("simple besweet")      << 8192U << false << 2U;
+    QTest::newRow("half linear")         << 4096U << true  << 1U;
+    QTest::newRow("half simple")         << 4096U << false << 0U;
+}
+
+// The decoder must produce what it did with amplitudes and phases and a
+// full complex transform.
+void TestFreeSurround::Decoder(void)
+{
+    QFETCH(unsigned, blocksize);
+    QFETCH(bool, linear);
+    QFETCH(unsigned, phasemode);
+
+    fsurround_decoder decoder(blocksize);
+    decoder.flush();
+    decoder.steering_mode(linear);
+    decoder.phase_mode(phasemode);
+    ReferenceDecoder reference(blocksize);
+    reference.steering_mode(linear);
+    reference.phase_mode(phasemode);
+
+    int64_t pos = 0;
+    uint32_t seed = 1;
+    float peak = 0.0F;
+    for (int block = 0; block < kBlocks; block++)
+    {
+        float **inputs = decoder.getInputBuffers();
+        Fill(inputs[0], inputs[1], blocksize / 2, pos, seed);
+        std::copy_n(inputs[0], blocksize / 2, reference.Input(0));
+        std::copy_n(inputs[1], blocksize / 2, reference.Input(1));
+
+        decoder.decode(0.65F, 0.3F, 1.0F);
+        reference.decode(0.65F, 0.3F, 1.0F);
+
+        float **outputs = decoder.getOutputBuffers();
+        for (int c = 0; c < 6; c++)
+        {
+            const float *expected = reference.Output(c);
+            for (unsigned k = 0; k < blocksize / 2; k++)
+            {
+                QVERIFY(std::isfinite(outputs[c][k]));
+                QVERIFY2(std::abs(outputs[c][k] - expected[k]) < 1e-5F,
+                         qPrintable(QString("block %1 channel %2 sample %3: %4 != %5")
+                                    .arg(block).arg(c).arg(k)
+                                    .arg(outputs[c][k]).arg(expected[k])));
+                peak = std::max(peak, std::abs(expected[k]));
+            }
+        }
+    }
+    // Make sure there was something to compare
+    QVERIFY(peak > 0.1F);
+}
+
+// A smaller block halves the frames buffered by the upmixer.
+void TestFreeSurround::BlockSize(void)
+{
+    FreeSurround full(48000, true, FreeSurround::SurroundModeActiveLinear);
+    FreeSurround half(48000, true, FreeSurround::SurroundModeActiveLinear,
+                      SURROUND_BUFSIZE / 2);
+    QCOMPARE(full.framesPerBlock(), SURROUND_BUFSIZE / 2U);
+    QCOMPARE(half.framesPerBlock(), SURROUND_BUFSIZE / 4U);
+
+    std::vector<float> stereo(SURROUND_BUFSIZE * 2);
+    int64_t pos = 0;
+    uint32_t seed = 1;
+    std::vector<float> left(SURROUND_BUFSIZE);
+    std::vector<float> right(SURROUND_BUFSIZE);
+    Fill(left.data(), right.data(), SURROUND_BUFSIZE, pos, seed);
+    for (int k = 0; k < SURROUND_BUFSIZE; k++)
+    {
+        stereo[2 * k] = left[k];
+        stereo[(2 * k) + 1] = right[k];
+    }
+
+    // Each call takes at most the rest of a block
+    QCOMPARE(half.putFrames(stereo.data(), SURROUND_BUFSIZE, 2),
+             SURROUND_BUFSIZE / 4U);
+    QCOMPARE(half.numFrames(), SURROUND_BUFSIZE / 4U);
+    QCOMPARE(full.putFrames(stereo.data(), SURROUND_BUFSIZE, 2),
+             SURROUND_BUFSIZE / 2U);
+    QCOMPARE(full.numFrames(), SURROUND_BUFSIZE / 2U);
+    QVERIFY(half.frameLatency() < full.frameLatency());
+
+    std::vector<float> surround(SURROUND_BUFSIZE * 6);
+    QCOMPARE(half.receiveFrames(surround.data(), SURROUND_BUFSIZE),
+             SURROUND_BUFSIZE / 4U);
+}
+
+void TestFreeSurround::Benchmark_data(void)
+{
+    QTest::addColumn<unsigned>("blocksize");
+    QTest::addColumn<bool>("reference");
+
+    QTest::newRow("complex transform")      << 8192U << true;
+    QTest::newRow("real transform")         << 8192U << false;
+    QTest::newRow("half complex transform") << 4096U << true;
+    QTest::newRow("half real transform")    << 4096U << false;
+}
+
+void TestFreeSurround::Benchmark(void)
+{
+    QFETCH(unsigned, blocksize);
+    QFETCH(bool, reference);
+
+    static constexpr int kRuns { 50 };
+    fsurround_decoder decoder(blocksize);
+    decoder.flush();
+    ReferenceDecoder old(blocksize);
+
+    int64_t pos = 0;
+    uint32_t seed = 1;
+    float **inputs = decoder.getInputBuffers();
+    Fill(inputs[0], inputs[1], blocksize / 2, pos, seed);
+    Fill(old.Input(0), old.Input(1), blocksize / 2, pos, seed);
+
+    QElapsedTimer timer;
+    qint64 samples = 0;
+    timer.start();
+    QBENCHMARK {
+        for (int run = 0; run < kRuns; run++)
+        {
+            if (reference)
+                old.decode(0.65F, 0.3F, 1.0F);
+            else
+                decoder.decode(0.65F, 0.3F, 1.0F);
+        }
+        samples += kRuns * blocksize / 2;
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    if (elapsed > 0)
+    {
+        qInfo() << QString("%1 stereo samples/sec")
+            .arg(samples * 1000000000.0 / elapsed, 0, 'f', 0);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestFreeSurround)
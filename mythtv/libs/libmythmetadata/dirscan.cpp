@@ -1,6 +1,19 @@
+#include <algorithm>
+#include <array>
 #include <map>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+#endif
 
 #include <QDir>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
 #include <QUrl>
 
 #include "libmyth/mythcontext.h"
@@ -43,57 +56,379 @@ namespace
         }
     };
 
-    bool scan_dir(const QString &start_path, DirectoryHandler *handler,
-                  const ext_lookup &ext_settings)
+    /// Options and counts for one call of ScanVideoDirectory
+    struct scan_state
     {
-        QDir d(start_path);
+        bool watch     {false}; //!< Watch local dirs for changes
+        int  listed    {0};     //!< Dirs read from disk
+        int  unchanged {0};     //!< Dirs whose earlier listing was reused
+        QStringList sgDirs;     //!< Dirs of the local Videos Storage Group
+    };
 
-        // Return a fail if directory doesn't exist.
-        if (!d.exists())
+    struct dir_entry
+    {
+        QString name;
+        bool    isDir {false};
+    };
+    using dir_entries = QList<dir_entry>;
+
+    QString child_path(const QString &dir, const QString &name)
+    {
+        return dir.endsWith('/') ? dir + name : dir + '/' + name;
+    }
+
+    /// What a local dir held when it was last read
+    struct dir_listing
+    {
+        quint64     inode   {0};
+        qint64      modTime {0};
+        int         wd      {-1};    //!< inotify watch, if any
+        bool        stale   {false}; //!< Changed since it was read
+        dir_entries entries;
+    };
+
+    /** \brief Listings of the local dirs read by earlier scans.
+     *
+     *  A dir whose inode & modified time are unchanged still holds the same
+     *  entries, so a rescan reuses its listing rather than reading it again.
+     *  On Linux, dirs on local filesystems can also be watched with inotify;
+     *  a watched dir that hasn't reported a change isn't even stat'ed.
+     *
+     *  Only listings are cached, unchanged subtrees aren't skipped: a dir's
+     *  modified time doesn't change when something deeper in the tree does,
+     *  so every dir below an unchanged one is still checked.
+     *
+     *  The cache is shared by every scan in the process, and by concurrent
+     *  scans of different dirs.
+     */
+    class dir_cache
+    {
+      public:
+        static dir_cache &instance()
+        {
+            static dir_cache s_cache;
+            return s_cache;
+        }
+
+        bool list(const QString &path, dir_entries &entries,
+                  scan_state &state);
+
+      private:
+        dir_cache() = default;
+        ~dir_cache();
+
+        static bool stamp(const QString &path, quint64 &inode,
+                          qint64 &modTime);
+        static void readDir(const QString &path, dir_entries &entries);
+        void forget(const QString &path);
+        void removed(const QString &path, const dir_entries &before,
+                     const dir_entries &after);
+        int  addWatch(const QString &path);
+        void readEvents();
+
+        QMutex                      m_lock;
+        QHash<QString, dir_listing> m_listings;    //!< By abs dir path
+        QHash<int, QString>         m_watches;     //!< Watched dir by wd
+        int                         m_inotify {-1};
+        bool                        m_noWatches {false};
+    };
+
+    dir_cache::~dir_cache()
+    {
+#ifdef __linux__
+        if (m_inotify >= 0)
+            close(m_inotify);
+#endif
+    }
+
+    bool dir_cache::stamp(const QString &path, quint64 &inode,
+                          qint64 &modTime)
+    {
+        struct stat status {};
+        if (stat(QFile::encodeName(path).constData(), &status) != 0 ||
+            !S_ISDIR(status.st_mode))
             return false;
-        
+
+        inode   = status.st_ino;
+        modTime = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+        return true;
+    }
+
+    void dir_cache::readDir(const QString &path, dir_entries &entries)
+    {
+        QDir d(path);
         d.setFilter(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
         QFileInfoList list = d.entryInfoList();
-        // An empty directory is fine
-        if (list.isEmpty())
-            return true;
-
-        QDir dir_tester;
 
+        entries.clear();
+        entries.reserve(list.size());
         for (const auto& entry : std::as_const(list))
         {
-            if (entry.fileName() == "Thumbs.db")
+            if (entry.fileName() != "Thumbs.db")
+                entries.push_back({entry.fileName(), entry.isDir()});
+        }
+    }
+
+    /// Drops a dir, and everything below it, from the cache
+    void dir_cache::forget(const QString &path)
+    {
+        QString below = path + '/';
+        auto it = m_listings.begin();
+        while (it != m_listings.end())
+        {
+            if (it.key() != path && !it.key().startsWith(below))
+            {
+                ++it;
                 continue;
+            }
+#ifdef __linux__
+            if (it->wd >= 0 && m_watches.value(it->wd) == it.key())
+            {
+                inotify_rm_watch(m_inotify, it->wd);
+                m_watches.remove(it->wd);
+            }
+#endif
+            it = m_listings.erase(it);
+        }
+    }
 
-            if (!entry.isDir() &&
-                ext_settings.extension_ignored(entry.suffix())) continue;
+    /// Forgets the subdirs of a dir that have been deleted or renamed
+    void dir_cache::removed(const QString &path, const dir_entries &before,
+                            const dir_entries &after)
+    {
+        QSet<QString> current;
+        for (const auto& entry : after)
+            if (entry.isDir)
+                current.insert(entry.name);
 
-            bool add_as_file = true;
+        for (const auto& entry : before)
+        {
+            if (entry.isDir && !current.contains(entry.name))
+                forget(child_path(path, entry.name));
+        }
+    }
 
-            if (entry.isDir())
+    /// Starts watching a dir on a local filesystem. Call with the lock held.
+    int dir_cache::addWatch(const QString &path)
+    {
+#ifdef __linux__
+        if (m_noWatches)
+            return -1;
+
+        // Changes made by other hosts to a network filesystem aren't reported
+        struct statfs statbuf {};
+        if (statfs(QFile::encodeName(path).constData(), &statbuf) != 0)
+            return -1;
+        long fstype = statbuf.f_type;
+        if ((fstype == 0x6969)  ||              // NFS
+            (fstype == 0x517B)  ||              // SMB
+            (fstype == (long)0xFF534D42) ||     // CIFS
+            (fstype == (long)0xFE534D42) ||     // SMB2
+            (fstype == 0x65735546))             // FUSE
+            return -1;
+
+        if (m_inotify < 0)
+        {
+            m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (m_inotify < 0)
             {
-                add_as_file = false;
+                LOG(VB_GENERAL, LOG_WARNING,
+                    "MythVideo::ScanVideoDirectory Can't watch video dirs: " + ENO);
+                m_noWatches = true;
+                return -1;
+            }
+            LOG(VB_GENERAL, LOG_INFO, "MythVideo::ScanVideoDirectory Watching local video dirs");
+        }
+
+        int wd = inotify_add_watch(m_inotify, QFile::encodeName(path).constData(),
+                                   IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                                   IN_MOVED_TO | IN_DELETE_SELF |
+                                   IN_MOVE_SELF | IN_ONLYDIR);
+        if (wd < 0)
+        {
+            if (errno == ENOSPC)
+            {
+                LOG(VB_GENERAL, LOG_WARNING,
+                    "MythVideo::ScanVideoDirectory Out of inotify watches, "
+                    "remaining dirs will be checked when scanned. Raise "
+                    "fs.inotify.max_user_watches to watch them all.");
+                m_noWatches = true;
+            }
+            return -1;
+        }
 
-                dir_tester.setPath(entry.absoluteFilePath() + "/VIDEO_TS");
-                QDir bd_dir_tester;
-                bd_dir_tester.setPath(entry.absoluteFilePath() + "/BDMV");
-                if (dir_tester.exists() || bd_dir_tester.exists())
+        // The same dir reached by another path (a bind mount or symlink)
+        // shares the watch, so its changes are only reported to one of them
+        auto it = m_watches.find(wd);
+        if (it != m_watches.end() && *it != path)
+        {
+            auto old = m_listings.find(*it);
+            if (old != m_listings.end())
+                old->wd = -1;
+        }
+        m_watches[wd] = path;
+        return wd;
+#else
+        Q_UNUSED(path);
+        return -1;
+#endif
+    }
+
+    /// Marks the dirs that inotify reports as changed. Call with the lock held.
+    void dir_cache::readEvents()
+    {
+#ifdef __linux__
+        if (m_inotify < 0)
+            return;
+
+        alignas(struct inotify_event) std::array<char, 4096> buffer {};
+        ssize_t len = 0;
+        while ((len = ::read(m_inotify, buffer.data(), buffer.size())) > 0)
+        {
+            for (ssize_t pos = 0; pos < len; )
+            {
+                const auto *event =
+                    reinterpret_cast<const struct inotify_event *>(&buffer[pos]);
+                pos += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+
+                if (event->mask & IN_Q_OVERFLOW)
                 {
-                    add_as_file = true;
+                    for (auto & listing : m_listings)
+                        listing.stale = true;
+                    continue;
                 }
-                else
+
+                auto it = m_watches.find(event->wd);
+                if (it == m_watches.end())
+                    continue;
+
+                dir_listing &listing = m_listings[*it];
+                listing.stale = true;
+
+                // A moved dir keeps its watch, but not its path
+                if (event->mask & IN_MOVE_SELF)
+                    inotify_rm_watch(m_inotify, event->wd);
+
+                if (event->mask & IN_IGNORED)
+                {
+                    listing.wd = -1;
+                    m_watches.erase(it);
+                }
+            }
+        }
+#endif
+    }
+
+    /**
+     *  \brief Lists a local dir, reading it only if it has changed
+     *  \param path Absolute dir path
+     *  \param[out] entries Its files & dirs, excluding Thumbs.db
+     *  \param state Scan options & counts
+     *  \return False if the dir doesn't exist
+     */
+    bool dir_cache::list(const QString &path, dir_entries &entries,
+                         scan_state &state)
+    {
+        dir_listing previous;
+        {
+            QMutexLocker locker(&m_lock);
+            readEvents();
+
+            // Placeholder collects any change reported whilst it is read
+            dir_listing &listing = m_listings[path];
+            if (state.watch && listing.wd >= 0 && !listing.stale)
+            {
+                entries = listing.entries;
+                ++state.unchanged;
+                return true;
+            }
+            previous = listing;
+            listing.stale = false;
+
+            // Watch before reading so that no change is missed
+            if (state.watch && listing.wd < 0)
+                listing.wd = addWatch(path);
+        }
+
+        dir_listing current;
+        bool exists = stamp(path, current.inode, current.modTime);
+        if (exists)
+        {
+            if (!previous.stale && previous.inode == current.inode &&
+                previous.modTime == current.modTime)
+            {
+                current.entries = previous.entries;
+                ++state.unchanged;
+            }
+            else
+            {
+                readDir(path, current.entries);
+                ++state.listed;
+            }
+        }
+
+        QMutexLocker locker(&m_lock);
+        if (!exists)
+        {
+            forget(path);
+            return false;
+        }
+
+        removed(path, previous.entries, current.entries);
+
+        dir_listing &listing = m_listings[path];
+        current.wd    = listing.wd;
+        current.stale = listing.stale;
+        listing = current;
+
+        entries = current.entries;
+        return true;
+    }
+
+    /// True if a dir is the root of a DVD or Blu-ray file structure
+    bool is_disc(const dir_entries &entries)
+    {
+        return std::any_of(entries.cbegin(), entries.cend(),
+                           [](const dir_entry &entry)
+                           { return entry.isDir &&
+                                    (entry.name == "VIDEO_TS" ||
+                                     entry.name == "BDMV"); });
+    }
+
+    void scan_dir(const QString &start_path, const dir_entries &list,
+                  DirectoryHandler *handler, const ext_lookup &ext_settings,
+                  scan_state &state)
+    {
+        for (const auto& entry : list)
+        {
+            QString fq_name = child_path(start_path, entry.name);
+            QString suffix  = QFileInfo(entry.name).suffix();
+
+            if (!entry.isDir &&
+                ext_settings.extension_ignored(suffix)) continue;
+
+            bool add_as_file = true;
+
+            if (entry.isDir)
+            {
+                // Since we are dealing with a subdirectory failure is fine,
+                // so we'll just ignore the failue and continue
+                dir_entries sub_list;
+                bool readable = dir_cache::instance().list(fq_name, sub_list,
+                                                           state);
+
+                add_as_file = readable && is_disc(sub_list);
+                if (!add_as_file)
                 {
 #if 0
                     LOG(VB_GENERAL, LOG_DEBUG, 
-                        QString(" -- Dir : %1").arg(entry.!absoluteFilePath()));
+                        QString(" -- Dir : %1").arg(fq_name));
 #endif
                     DirectoryHandler *dh =
-                            handler->newDir(entry.fileName(),
-                                            entry.absoluteFilePath());
+                            handler->newDir(entry.name, fq_name);
 
-                    // Since we are dealing with a subdirectory failure is fine,
-                    // so we'll just ignore the failue and continue
-                    (void) scan_dir(entry.absoluteFilePath(), dh, ext_settings);
+                    if (readable)
+                        scan_dir(fq_name, sub_list, dh, ext_settings, state);
                 }
             }
 
@@ -101,19 +436,31 @@ namespace
             {
 #if 0
                 LOG(VB_GENERAL, LOG_DEBUG,
-                    QString(" -- File : %1").arg(entry.fileName()));
+                    QString(" -- File : %1").arg(entry.name));
 #endif
-                handler->handleFile(entry.fileName(), entry.absoluteFilePath(),
-                                    entry.suffix(), "");
+                handler->handleFile(entry.name, fq_name, suffix, "");
             }
         }
+    }
+
+    bool scan_dir(const QString &start_path, DirectoryHandler *handler,
+                  const ext_lookup &ext_settings, scan_state &state)
+    {
+        QString path = QDir(start_path).absolutePath();
+        dir_entries list;
+
+        // Return a fail if directory doesn't exist.
+        if (!dir_cache::instance().list(path, list, state))
+            return false;
 
+        scan_dir(path, list, handler, ext_settings, state);
         return true;
     }
 
     bool scan_sg_dir(const QString &start_path, const QString &host,
                      const QString &base_path, DirectoryHandler *handler,
-                     const ext_lookup &ext_settings, bool isMaster = false)
+                     const ext_lookup &ext_settings, scan_state &state,
+                     bool isMaster = false)
     {
         QString path = start_path;
 
@@ -129,7 +476,29 @@ namespace
         QStringList list;
         bool ok = false;
 
-        if (isMaster)
+        bool inGroup = std::any_of(state.sgDirs.cbegin(), state.sgDirs.cend(),
+                                   [&start_path](const QString &dir)
+                                   { return start_path.startsWith(dir); });
+
+        dir_entries entries;
+        if (isMaster && !start_path.isEmpty() && start_path != "/" && !inGroup)
+        {
+            // Like StorageGroup::GetFileInfoList(), list nothing outside
+            // the group's dirs
+            ok = true;
+        }
+        else if (isMaster && !start_path.isEmpty() && start_path != "/" &&
+                 dir_cache::instance().list(start_path, entries, state))
+        {
+            // The group is local, so its listings can come from the cache
+            for (const auto& entry : std::as_const(entries))
+            {
+                list << QString(entry.isDir ? "dir::%1::0" : "file::%1::0")
+                            .arg(entry.name);
+            }
+            ok = true;
+        }
+        else if (isMaster)
         {
             StorageGroup sg("Videos", host);
             list = sg.GetFileInfoList(start_path);
@@ -182,7 +551,7 @@ namespace
                 // as we reached it once to make it this far than we know the 
                 // SG/Path exists
                 (void) scan_sg_dir(start_path + "/" + fileName, host, base_path,
-                             dh, ext_settings, isMaster);
+                             dh, ext_settings, state, isMaster);
             }
             else
             {
@@ -228,11 +597,15 @@ namespace
 
 bool ScanVideoDirectory(const QString &start_path, DirectoryHandler *handler,
         const FileAssociations::ext_ignore_list &ext_disposition,
-        bool list_unknown_extensions)
+        bool list_unknown_extensions, bool watch_dirs)
 {
     ext_lookup extlookup(ext_disposition, list_unknown_extensions);
 
     bool pathScanned = true;
+    scan_state state;
+    state.watch = watch_dirs;
+    QElapsedTimer timer;
+    timer.start();
 
     if (!start_path.startsWith("myth://"))
     {
@@ -240,7 +613,7 @@ bool ScanVideoDirectory(const QString &start_path, DirectoryHandler *handler,
             QString("MythVideo::ScanVideoDirectory Scanning (%1)")
                 .arg(start_path));
 
-        if (!scan_dir(start_path, handler, extlookup))
+        if (!scan_dir(start_path, handler, extlookup, state))
         {
             LOG(VB_GENERAL, LOG_ERR,
                 QString("MythVideo::ScanVideoDirectory failed to scan %1")
@@ -256,10 +629,12 @@ bool ScanVideoDirectory(const QString &start_path, DirectoryHandler *handler,
         QUrl sgurl = start_path;
         QString host = sgurl.host();
         QString path = sgurl.path();
+        bool isMaster = gCoreContext->IsMasterHost(host) &&
+            (gCoreContext->GetHostName().toLower() == host.toLower());
+        if (isMaster)
+            state.sgDirs = StorageGroup("Videos", host).GetDirList();
 
-        if (!scan_sg_dir(path, host, path, handler, extlookup, 
-                (gCoreContext->IsMasterHost(host) &&
-                 (gCoreContext->GetHostName().toLower() == host.toLower()))))
+        if (!scan_sg_dir(path, host, path, handler, extlookup, state, isMaster))
         {
             LOG(VB_GENERAL, LOG_ERR, 
                 QString("MythVideo::ScanVideoDirectory failed to scan %1 ")
@@ -268,5 +643,11 @@ bool ScanVideoDirectory(const QString &start_path, DirectoryHandler *handler,
         }
     }
 
+    LOG(VB_GENERAL, LOG_INFO,
+        QString("MythVideo::ScanVideoDirectory Scanned %1 in %2 ms: "
+                "%3 dirs read, %4 unchanged")
+            .arg(start_path).arg(timer.elapsed())
+            .arg(state.listed).arg(state.unchanged));
+
     return pathScanned;
 }
@@ -15,8 +15,15 @@ class META_PUBLIC DirectoryHandler
                             const QString &host) = 0;
 };
 
+/** \brief Walks a video dir, or Storage Group, passing its videos to \p handler.
+ *
+ *  Only the listings of local dirs are cached: a rescan still visits and
+ *  stats every dir, and only reads the ones whose modified time has
+ *  changed. With \p watch_dirs, dirs on local filesystems are also watched
+ *  (Linux only) and unchanged ones aren't stat'ed, but are still visited.
+ */
 META_PUBLIC bool ScanVideoDirectory(const QString &start_path, DirectoryHandler *handler,
         const FileAssociations::ext_ignore_list &ext_disposition,
-        bool list_unknown_extensions);
+        bool list_unknown_extensions, bool watch_dirs = false);
 
 #endif // DIRSCAN_H_
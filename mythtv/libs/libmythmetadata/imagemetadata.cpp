@@ -267,6 +267,7 @@ public:
     int         GetOrientation(bool *exists = nullptr) override; // ImageMetaData
     QDateTime   GetOriginalDateTime(bool *exists = nullptr) override; // ImageMetaData
     QString     GetComment(bool *exists = nullptr) override; // ImageMetaData
+    QImage      GetThumbnail() override; // ImageMetaData
 
 protected:
     static QString DecodeComment(std::string rawValue);
@@ -461,6 +462,33 @@ QString PictureMetaData::GetComment(bool *exists)
 }
 
 
+/*!
+   \brief Read the Exif thumbnail
+   \details Cameras usually embed a small JPEG preview of the picture
+   \return The thumbnail or a null image if there isn't one
+ */
+QImage PictureMetaData::GetThumbnail()
+{
+    QImage image;
+    if (!IsValid())
+        return image;
+
+    try
+    {
+        Exiv2::ExifThumbC thumb(m_exifData);
+        Exiv2::DataBuf buffer = thumb.copy();
+        if (buffer.cend() != buffer.cbegin())
+            image.loadFromData(buffer.cbegin(),
+                               static_cast<int>(buffer.cend() - buffer.cbegin()));
+    }
+    catch (Exiv2::Error &e)
+    {
+        LOG(VB_FILE, LOG_DEBUG, LOC + QString("Exiv2 exception %1").arg(e.what()));
+    }
+    return image;
+}
+
+
 /*!
    \brief Decodes charset of UserComment
    \param rawValue Metadata value with optional "[charset=...]" prefix
@@ -14,6 +14,7 @@
 // Qt headers
 #include <QCoreApplication> // for tr()
 #include <QDateTime>
+#include <QImage>
 #include <QStringBuilder>
 #include <QStringList>
 
@@ -124,6 +125,8 @@ public:
     virtual int         GetOrientation(bool *exists = nullptr)      = 0;
     virtual QDateTime   GetOriginalDateTime(bool *exists = nullptr) = 0;
     virtual QString     GetComment(bool *exists = nullptr)          = 0;
+    //! Preview image embedded in the metadata, if any
+    virtual QImage      GetThumbnail() { return {}; }
 
 protected:
     explicit ImageMetaData(QString filePath)
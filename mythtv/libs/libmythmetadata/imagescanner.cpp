@@ -1,5 +1,8 @@
 #include "imagescanner.h"
 
+#include <algorithm>
+#include <sys/stat.h>
+
 #include "libmythbase/mythcorecontext.h"  // for gCoreContext
 #include "libmythbase/mythlogging.h"
 
@@ -105,15 +108,14 @@ void ImageScanThread<DBFS>::EnqueueClear(int devId, const QString &action)
 
 /*!
  \brief Returns number of images scanned & total number to scan
- \return QStringList (scanner id, \#done, \#total)
+ \return QStringList (scanner id, \#done, \#total, \#scanned/sec,
+ \#thumbnails/sec, \#thumbnail tasks pending)
 */
 template <class DBFS>
 QStringList ImageScanThread<DBFS>::GetProgress()
 {
     QMutexLocker locker(&m_mutexProgress);
-    return QStringList() << QString::number(static_cast<int>(gCoreContext->IsBackend()))
-                         << QString::number(m_progressCount)
-                         << QString::number(m_progressTotalCount);
+    return Status(m_progressCount);
 }
 
 /*!
@@ -148,6 +150,7 @@ void ImageScanThread<DBFS>::run()
 
             // Clear Db
             m_dbfs.ClearDb(devId, action);
+            m_dirStamps.clear();
 
             // Pass on to thumb generator now scanning has stopped
             m_thumb.ClearThumbs(devId, action);
@@ -164,6 +167,9 @@ void ImageScanThread<DBFS>::run()
                 break;
 
             bool firstScan = m_dbFileMap.isEmpty();
+            if (firstScan)
+                m_dirStamps.clear();
+            m_unchangedDirs = 0;
 
             // Pause thumb generator so that scans are fast as possible
             m_thumb.PauseBackground(true);
@@ -204,12 +210,15 @@ void ImageScanThread<DBFS>::run()
             m_mutexProgress.lock();
             // (count == total) signals scan end
             Broadcast(m_progressTotalCount);
+            LOG(VB_GENERAL, LOG_INFO,
+                QString("Finished scan of %1 images in %2s, %3 dirs unchanged")
+                .arg(m_progressCount).arg(m_scanTimer.elapsed() / 1000)
+                .arg(m_unchangedDirs));
             // Must reset counts for scan queries
             m_progressCount = m_progressTotalCount = 0;
+            m_scanTimer.invalidate();
             m_mutexProgress.unlock();
 
-            LOG(VB_GENERAL, LOG_INFO,  "Finished scan");
-
             // For initial scans pause briefly to give thumb generator a headstart
             // before being deluged by client requests
             if (firstScan)
@@ -266,6 +275,38 @@ void ImageScanThread<DBFS>::SyncSubTree(const QFileInfo &dirInfo, int parentId,
         return;
     }
 
+    // Files of an unchanged dir are known, they only need checking
+    const DirStamp *unchanged = Unchanged(dirInfo);
+    if (unchanged && AcceptUnchanged(*unchanged, id))
+    {
+        ++m_unchangedDirs;
+        {
+            QMutexLocker locker(&m_mutexProgress);
+            m_progressCount += unchanged->m_entries;
+
+            // Throttle updates
+            if (m_bcastTimer.elapsed() > 250)
+                Broadcast(m_progressCount);
+        }
+
+        // Stamps are added whilst recursing
+        QStringList subDirs = unchanged->m_subDirs;
+        for (const auto & path : std::as_const(subDirs))
+        {
+            if (!IsScanning())
+            {
+                LOG(VB_GENERAL, LOG_INFO,
+                    QString("Scan interrupted in %2").arg(dirInfo.absoluteFilePath()));
+                return;
+            }
+            SyncSubTree(QFileInfo(path), id, devId, base);
+        }
+        return;
+    }
+
+    // Stamp before listing so that later changes are detected by next scan
+    DirStamp stamp = Stamp(dirInfo);
+
     // Sync its contents
     QFileInfoList entries = dir.entryInfoList();
     for (const auto & fileInfo : std::as_const(entries))
@@ -280,11 +321,15 @@ void ImageScanThread<DBFS>::SyncSubTree(const QFileInfo &dirInfo, int parentId,
         if (fileInfo.isDir())
         {
             // Scan this directory
+            stamp.m_subDirs << fileInfo.absoluteFilePath();
             SyncSubTree(fileInfo, id, devId, base);
         }
         else
         {
-            SyncFile(fileInfo, devId, base, id);
+            QString filePath = SyncFile(fileInfo, devId, base, id);
+            if (!filePath.isEmpty())
+                stamp.m_files.insert(filePath, fileInfo.absoluteFilePath());
+            ++stamp.m_entries;
 
             QMutexLocker locker(&m_mutexProgress);
             ++m_progressCount;
@@ -294,6 +339,89 @@ void ImageScanThread<DBFS>::SyncSubTree(const QFileInfo &dirInfo, int parentId,
                 Broadcast(m_progressCount);
         }
     }
+
+    // Completely synced
+    m_dirStamps.insert(dirInfo.absoluteFilePath(), stamp);
+}
+
+
+/*!
+ \brief Identifies the state of a dir
+ \details Adding, removing or renaming files changes the modified time of their
+ dir. Replacing the dir, ie. by remounting a device, changes its inode.
+ \param dirInfo Dir info
+ \return Stamp with no contents
+*/
+template <class DBFS>
+typename ImageScanThread<DBFS>::DirStamp ImageScanThread<DBFS>::Stamp(const QFileInfo &dirInfo)
+{
+    DirStamp stamp;
+    stamp.m_modTime = dirInfo.lastModified().toMSecsSinceEpoch();
+
+    struct stat status {};
+    if (stat(QFile::encodeName(dirInfo.absoluteFilePath()).constData(), &status) == 0)
+        stamp.m_inode = status.st_ino;
+    return stamp;
+}
+
+
+/*!
+ \brief Determines whether a dir is unchanged since it was last synced
+ \param dirInfo Dir info
+ \return The contents of the dir at the last sync, or nullptr if it has changed
+*/
+template <class DBFS>
+const typename ImageScanThread<DBFS>::DirStamp *
+ImageScanThread<DBFS>::Unchanged(const QFileInfo &dirInfo)
+{
+    auto it = m_dirStamps.constFind(dirInfo.absoluteFilePath());
+    if (it == m_dirStamps.constEnd())
+        return nullptr;
+
+    DirStamp stamp = Stamp(dirInfo);
+    if (stamp.m_inode != it->m_inode || stamp.m_modTime != it->m_modTime)
+        return nullptr;
+    return &(*it);
+}
+
+
+/*!
+ \brief Marks the files of an unchanged dir as seen
+ \details Only the listing of the dir is skipped. Files are only accepted if
+ the Db still holds all of them with the modified time and size they have now,
+ as editing a file in place doesn't change its dir. Otherwise the dir must be
+ synced normally.
+ \param stamp Contents of the dir when last synced
+ \param parentId Db id of the dir
+ \return True if the files were accepted
+*/
+template <class DBFS>
+bool ImageScanThread<DBFS>::AcceptUnchanged(const DirStamp &stamp, int parentId)
+{
+    for (auto it = stamp.m_files.cbegin(); it != stamp.m_files.cend(); ++it)
+    {
+        ImagePtrK dbIm = m_dbFileMap.value(it.key());
+        if (!dbIm || dbIm->m_parentId != parentId || m_seenFile.contains(it.key()))
+            return false;
+
+        QFileInfo fileInfo(it.value());
+        if (!fileInfo.exists()
+            || std::chrono::seconds(fileInfo.lastModified().toSecsSinceEpoch()) != dbIm->m_modTime
+            || static_cast<int>(fileInfo.size()) != dbIm->m_size)
+        {
+            LOG(VB_FILE, LOG_INFO, QString("Modified file %1").arg(it.value()));
+            return false;
+        }
+    }
+
+    for (auto it = stamp.m_files.cbegin(); it != stamp.m_files.cend(); ++it)
+    {
+        // Remove it from removed list
+        m_dbFileMap.remove(it.key());
+        // Detect duplicates
+        m_seenFile.insert(it.key(), it.value());
+    }
+    return true;
 }
 
 
@@ -442,15 +570,15 @@ void ImageScanThread<DBFS>::PopulateMetadata(
  \param parentId Db id of the dir's parent
 */
 template <class DBFS>
-void ImageScanThread<DBFS>::SyncFile(const QFileInfo &fileInfo, int devId,
-                               const QString &base, int parentId)
+QString ImageScanThread<DBFS>::SyncFile(const QFileInfo &fileInfo, int devId,
+                                  const QString &base, int parentId)
 {
     // Ignore excluded files
     if (m_exclusions.match(fileInfo.fileName()).hasMatch())
     {
         LOG(VB_FILE, LOG_INFO,
             QString("Excluding file %1").arg(fileInfo.absoluteFilePath()));
-        return;
+        return {};
     }
 
     QString absFilePath = fileInfo.absoluteFilePath();
@@ -458,7 +586,7 @@ void ImageScanThread<DBFS>::SyncFile(const QFileInfo &fileInfo, int devId,
     ImagePtr im(m_dbfs.CreateItem(fileInfo, parentId, devId, base));
     if (!im)
         // Ignore unknown file type
-        return;
+        return {};
 
     if (m_dbFileMap.contains(im->m_filePath))
     {
@@ -472,7 +600,7 @@ void ImageScanThread<DBFS>::SyncFile(const QFileInfo &fileInfo, int devId,
             m_dbFileMap.remove(im->m_filePath);
             // Detect duplicates
             m_seenFile.insert(im->m_filePath, absFilePath);
-            return;
+            return im->m_filePath;
         }
 
         LOG(VB_FILE, LOG_INFO, QString("Modified file %1").arg(absFilePath));
@@ -502,7 +630,7 @@ void ImageScanThread<DBFS>::SyncFile(const QFileInfo &fileInfo, int devId,
     {
         LOG(VB_GENERAL, LOG_WARNING, QString("Ignoring %1 (Duplicate of %2)")
             .arg(absFilePath, m_seenFile.value(im->m_filePath)));
-        return;
+        return {};
     }
     else
     {
@@ -523,12 +651,14 @@ void ImageScanThread<DBFS>::SyncFile(const QFileInfo &fileInfo, int devId,
 
     // Detect duplicate filepaths in SG
     m_seenFile.insert(im->m_filePath, absFilePath);
+    QString filePath = im->m_filePath;
 
     // Populate absolute filename so that thumbgen doesn't need to locate file
     im->m_filePath = absFilePath;
 
     // Ensure thumbnail exists.
     m_thumb.CreateThumbnail(im);
+    return filePath;
 }
 
 
@@ -540,6 +670,21 @@ void ImageScanThread<DBFS>::SyncFile(const QFileInfo &fileInfo, int devId,
 template <class DBFS>
 void ImageScanThread<DBFS>::CountTree(QDir &dir)
 {
+    // Use the count of the last sync for unchanged dirs
+    const DirStamp *unchanged = Unchanged(QFileInfo(dir.absolutePath()));
+    if (unchanged)
+    {
+        m_progressTotalCount += unchanged->m_entries;
+        for (const auto & path : std::as_const(unchanged->m_subDirs))
+        {
+            QDir subDir = dir;
+            if (!m_exclusions.match(QFileInfo(path).fileName()).hasMatch()
+                    && subDir.cd(path))
+                CountTree(subDir);
+        }
+        return;
+    }
+
     QFileInfoList entries = dir.entryInfoList();
     for (const auto & fileInfo : std::as_const(entries))
     {
@@ -582,10 +727,19 @@ void ImageScanThread<DBFS>::CountFiles(const QStringList &paths)
 
     LOG(VB_FILE, LOG_DEBUG, QString("Exclude regexp is \"%1\"").arg(pattern));
 
+    // Stamps only record files that were not excluded
+    if (pattern != m_stampExclusions)
+    {
+        m_dirStamps.clear();
+        m_stampExclusions = pattern;
+    }
+
     // Lock counts until counting complete
     QMutexLocker locker(&m_mutexProgress);
     m_progressCount       = 0;
     m_progressTotalCount  = 0;
+    m_scanTimer.start();
+    m_thumbsAtStart       = m_thumb.ThumbsCreated();
 
     // Use global image filters
     QDir dir = m_dir;
@@ -600,6 +754,35 @@ void ImageScanThread<DBFS>::CountFiles(const QStringList &paths)
 }
 
 
+/*!
+ \brief Describes scan progress & throughput
+ \note Count mutex must be held before calling this
+ \param progress Number of images processed
+ \return QStringList (scanner id, \#done, \#total, \#scanned/sec,
+ \#thumbnails/sec, \#thumbnail tasks pending)
+*/
+template <class DBFS>
+QStringList ImageScanThread<DBFS>::Status(int progress)
+{
+    qint64 scanned = 0;
+    qint64 thumbs  = 0;
+    if (m_scanTimer.isValid())
+    {
+        qint64 elapsed = std::max(m_scanTimer.elapsed(), qint64(1));
+        scanned = m_progressCount * 1000LL / elapsed;
+        thumbs  = (m_thumb.ThumbsCreated() - m_thumbsAtStart) * 1000LL / elapsed;
+    }
+
+    // Only 2 scanners are ever visible (FE & BE) so use bool as scanner id
+    return QStringList() << QString::number(static_cast<int>(gCoreContext->IsBackend()))
+                         << QString::number(progress)
+                         << QString::number(m_progressTotalCount)
+                         << QString::number(scanned)
+                         << QString::number(thumbs)
+                         << QString::number(m_thumb.ThumbsPending());
+}
+
+
 /*!
  \brief Notify listeners of scan progress
  \details
@@ -609,13 +792,7 @@ void ImageScanThread<DBFS>::CountFiles(const QStringList &paths)
 template <class DBFS>
 void ImageScanThread<DBFS>::Broadcast(int progress)
 {
-    // Only 2 scanners are ever visible (FE & BE) so use bool as scanner id
-    QStringList status;
-    status << QString::number(static_cast<int>(gCoreContext->IsBackend()))
-           << QString::number(progress)
-           << QString::number(m_progressTotalCount);
-
-    m_dbfs.Notify("IMAGE_SCAN_STATUS", status);
+    m_dbfs.Notify("IMAGE_SCAN_STATUS", Status(progress));
 
     // Reset broadcast throttle
     m_bcastTimer.start();
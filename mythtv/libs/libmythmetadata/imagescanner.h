@@ -8,6 +8,10 @@
 //!
 //! Clone directories & duplicate files can only occur in a Storage Group/Backend scanner.
 //! They can never occur with local devices/Frontend scanner
+//!
+//! Rescans are incremental: a dir whose inode & modified time haven't changed
+//! since it was last scanned still holds the same files, so they are accepted
+//! from the database without being listed or examined.
 
 #ifndef IMAGESCANNER_H
 #define IMAGESCANNER_H
@@ -41,6 +45,16 @@ protected:
 private:
     Q_DISABLE_COPY(ImageScanThread)
 
+    //! What a dir held when it was last scanned
+    struct DirStamp
+    {
+        quint64     m_inode   {0};
+        qint64      m_modTime {0};
+        int         m_entries {0}; //!< Number of files counted
+        NameHash    m_files;       //!< Db filepath -> abs filepath of its images
+        QStringList m_subDirs;     //!< Abs paths of its dirs
+    };
+
     void SyncSubTree(const QFileInfo &dirInfo, int parentId, int devId,
                      const QString &base);
     int  SyncDirectory(const QFileInfo &dirInfo, int devId,
@@ -48,10 +62,14 @@ private:
     void PopulateMetadata(const QString &path, int type, QString &comment,
                           std::chrono::seconds &time,
                           int &orientation);
-    void SyncFile(const QFileInfo &fileInfo, int devId,
-                  const QString &base, int parentId);
+    QString SyncFile(const QFileInfo &fileInfo, int devId,
+                     const QString &base, int parentId);
+    static DirStamp Stamp(const QFileInfo &dirInfo);
+    const DirStamp *Unchanged(const QFileInfo &dirInfo);
+    bool AcceptUnchanged(const DirStamp &stamp, int parentId);
     void CountTree(QDir &dir);
     void CountFiles(const QStringList &paths);
+    QStringList Status(int progress);
     void Broadcast(int progress);
 
     using ClearTask = QPair<int, QString>;
@@ -73,12 +91,21 @@ private:
     NameHash    m_seenFile;
     //! Ids of dirs/files that have been updates/modified.
     QStringList m_changedImages;
+    //! Dirs completely synced by earlier scans, Map<abs dirpath, Contents>
+    QHash<QString, DirStamp> m_dirStamps;
+    //! Exclusions applied when the stamps were made
+    QString     m_stampExclusions;
+    //! Number of unchanged dirs skipped by current scan
+    int         m_unchangedDirs {0};
 
     //! Elapsed time since last progress event generated
     QElapsedTimer m_bcastTimer;
     int           m_progressCount      {0}; //!< Number of images scanned
     int           m_progressTotalCount {0}; //!< Total number of images to scan
     QMutex        m_mutexProgress;      //!< Progress counts mutex
+    //! Elapsed time since scan started, for throughput
+    QElapsedTimer m_scanTimer;
+    int           m_thumbsAtStart      {0}; //!< Thumbnails created before scan
 
     //! Global working dir for file detection
     QDir m_dir;
@@ -1,7 +1,12 @@
 #include "imagethumbs.h"
 
+#include <algorithm>
+#include <memory>
+
 #include <QDir>
+#include <QImageReader>
 #include <QStringList>
+#include <QThread>
 
 #include "libmythbase/mythcorecontext.h"  // for MYTH_APPNAME_MYTHPREVIEWGEN
 #include "libmythbase/mythdirs.h"         // for GetAppBinDir
@@ -11,6 +16,9 @@
 
 #include "imagemetadata.h"
 
+//! Size that picture thumbnails are scaled to fit
+static const QSize kThumbSize { 240, 180 };
+
 /*!
  \brief Destructor
 */
@@ -113,6 +121,92 @@ void ThumbThread<DBFS>::RemoveTasks(ThumbQueue &queue, int devId)
 }
 
 
+/*!
+ \brief Returns the number of queued tasks
+*/
+template <class DBFS>
+int ThumbThread<DBFS>::QueueSize()
+{
+    QMutexLocker locker(&m_mutex);
+    return static_cast<int>(m_requestQ.size() + m_backgroundQ.size());
+}
+
+
+/*!
+ \brief Takes the most urgent Create task from the queues, for another thread
+ \details Delete and Move tasks are left to their own thread, and so are Creates
+ of images that also have one of those queued, so that the tasks of an image
+ are actioned in the order they were queued. The thief must Return() the task
+ once it is done.
+ \return The task or null if there is nothing to take
+*/
+template <class DBFS>
+TaskPtr ThumbThread<DBFS>::Steal()
+{
+    QMutexLocker locker(&m_mutex);
+
+    // Delete & Move tasks are urgent, so only the request queue holds them
+    QSet<int> pinned;
+    for (const auto & task : std::as_const(m_requestQ))
+    {
+        if (task->m_action != "CREATE")
+            for (const auto & im : std::as_const(task->m_images))
+                pinned.insert(im->m_id);
+    }
+
+    for (ThumbQueue *queue : { &m_requestQ, &m_backgroundQ })
+    {
+        if (queue == &m_backgroundQ && !m_doBackground)
+            break;
+
+        for (auto it = queue->begin(); it != queue->end(); ++it)
+        {
+            TaskPtr task = it.value();
+            if (task->m_action == "CREATE" && !task->m_images.isEmpty()
+                    && !pinned.contains(task->m_images.at(0)->m_id))
+            {
+                queue->erase(it);
+                m_lent.insert(task->m_images.at(0)->m_id);
+                return task;
+            }
+        }
+    }
+    return {};
+}
+
+
+/*!
+ \brief Called by the thief when it has finished a task it stole
+ \param task The task returned by Steal()
+*/
+template <class DBFS>
+void ThumbThread<DBFS>::Return(const TaskPtr &task)
+{
+    QMutexLocker locker(&m_mutex);
+    m_lent.remove(task->m_images.at(0)->m_id);
+    m_lentDone.wakeAll();
+}
+
+
+/*!
+ \brief Waits until no other thread is working on the images of a task
+ \details Called with the queue mutex held, before actioning the task.
+ \param task The next task of this thread
+*/
+template <class DBFS>
+void ThumbThread<DBFS>::WaitForLent(const TaskPtr &task)
+{
+    auto lent = [this, &task]()
+    {
+        return std::any_of(task->m_images.cbegin(), task->m_images.cend(),
+                           [this](const auto & im)
+                           { return m_lent.contains(im->m_id); });
+    };
+    while (lent())
+        m_lentDone.wait(&m_mutex);
+}
+
+
 /*!
  \brief  Handles thumbnail requests by priority
  \details Repeatedly processes next request from highest priority queue until all
@@ -142,11 +236,29 @@ void ThumbThread<DBFS>::run()
                 task = m_requestQ.take(m_requestQ.constBegin().key());
             else if (m_doBackground && !m_backgroundQ.isEmpty())
                 task = m_backgroundQ.take(m_backgroundQ.constBegin().key());
-            else
-                // quit when both queues exhausted
+
+            // Let a thread that stole an earlier task of the image finish it
+            if (task)
+                WaitForLent(task);
+        }
+
+        // Help out busier threads
+        ThumbThread *owner = this;
+        for (auto *sibling : std::as_const(m_siblings))
+        {
+            if (task)
                 break;
+            if (sibling != this)
+            {
+                task = sibling->Steal();
+                owner = sibling;
+            }
         }
 
+        // quit when all queues exhausted
+        if (!task)
+            break;
+
         // Shouldn't receive empty requests
         if (task->m_images.isEmpty())
             continue;
@@ -225,6 +337,9 @@ void ThumbThread<DBFS>::run()
             LOG(VB_GENERAL, LOG_ERR,
                 QString("Unknown task %1").arg(task->m_action));
         }
+
+        if (owner != this)
+            owner->Return(task);
     }
 
     RunEpilog();
@@ -259,11 +374,9 @@ QString ThumbThread<DBFS>::CreateThumbnail(const ImagePtrK &im, int thumbPriorit
     QImage image;
     if (im->m_type == kImageFile)
     {
-        if (!image.load(imagePath))
-            return QString("Failed to open image %1").arg(imagePath);
-
-        // Resize to optimise load/display time by FE's
-        image = image.scaled(QSize(240,180), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        QString err = LoadPicture(imagePath, image);
+        if (!err.isEmpty())
+            return err;
     }
     else if (im->m_type == kVideoFile)
     {
@@ -312,12 +425,64 @@ QString ThumbThread<DBFS>::CreateThumbnail(const ImagePtrK &im, int thumbPriorit
     if (!image.save(im->m_thumbPath))
         return QString("Failed to create thumbnail %1").arg(im->m_thumbPath);
 
+    ++m_created;
     LOG(VB_FILE, LOG_INFO,  QString("[%2] Created %1")
         .arg(im->m_thumbPath).arg(thumbPriority));
     return {};
 }
 
 
+/*!
+ \brief Loads a picture at thumbnail size
+ \details Uses the Exif thumbnail when it is big enough. Otherwise the picture
+ is decoded at reduced size, which for JPEGs is done in the DCT domain by
+ libjpeg, so that the full resolution image is never created.
+ \param[in] path Picture file
+ \param[out] image Picture, scaled to fit the thumbnail size
+ \return Error message or empty on success
+ */
+template <class DBFS>
+QString ThumbThread<DBFS>::LoadPicture(const QString &path, QImage &image)
+{
+    QImageReader reader(path);
+    QSize size = reader.size();
+
+    if (size.isValid())
+    {
+        QSize thumbSize = size.scaled(kThumbSize, Qt::KeepAspectRatio);
+
+        // Previews with a different aspect ratio are letterboxed
+        std::unique_ptr<ImageMetaData> metadata(ImageMetaData::FromPicture(path));
+        QImage embedded = metadata->GetThumbnail();
+        if (embedded.width() >= thumbSize.width()
+                && embedded.height() >= thumbSize.height()
+                && qAbs((qint64(embedded.width()) * size.height())
+                        - (qint64(embedded.height()) * size.width()))
+                   <= qint64(embedded.height()) * size.width() / 100)
+        {
+            LOG(VB_FILE, LOG_DEBUG, QString("Using %1x%2 Exif thumbnail of %3")
+                .arg(embedded.width()).arg(embedded.height()).arg(path));
+            image = embedded.scaled(thumbSize, Qt::IgnoreAspectRatio,
+                                    Qt::SmoothTransformation);
+            return {};
+        }
+
+        // Leave some detail for the final smooth scaling
+        QSize decodeSize = size.scaled(kThumbSize * 2, Qt::KeepAspectRatio);
+        if (decodeSize.width() < size.width())
+            reader.setScaledSize(decodeSize);
+    }
+
+    if (!reader.read(&image))
+        return QString("Failed to open image %1: %2")
+            .arg(path, reader.errorString());
+
+    // Resize to optimise load/display time by FE's
+    image = image.scaled(kThumbSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    return {};
+}
+
+
 /*!
   \brief Pauses or restarts processing of background tasks (scanner requests)
  */
@@ -339,9 +504,21 @@ void ThumbThread<DBFS>::PauseBackground(bool pause)
 template <class DBFS>
 ImageThumb<DBFS>::ImageThumb(DBFS *const dbfs)
     : m_dbfs(*dbfs),
-      m_imageThread(new ThumbThread<DBFS>("ImageThumbs", dbfs)),
       m_videoThread(new ThumbThread<DBFS>("VideoThumbs", dbfs))
-{}
+{
+    // Picture thumbnails are CPU bound
+    int threads = std::max(1, QThread::idealThreadCount());
+    for (int i = 0; i < threads; ++i)
+    {
+        m_imageThreads.append(
+            new ThumbThread<DBFS>(QString("ImageThumbs%1").arg(i), dbfs));
+    }
+    for (auto *thread : std::as_const(m_imageThreads))
+        thread->SetSiblings(m_imageThreads);
+
+    LOG(VB_FILE, LOG_INFO, QString("Using %1 picture thumbnail threads")
+        .arg(threads));
+}
 
 
 /*!
@@ -350,9 +527,30 @@ ImageThumb<DBFS>::ImageThumb(DBFS *const dbfs)
 template <class DBFS>
 ImageThumb<DBFS>::~ImageThumb()
 {
-    delete m_imageThread;
+    // Stop all threads before any are deleted, as they steal from each other
+    for (auto *thread : std::as_const(m_imageThreads))
+        thread->cancel();
+    for (auto *thread : std::as_const(m_imageThreads))
+        thread->wait();
+    qDeleteAll(m_imageThreads);
+    m_imageThreads.clear();
     delete m_videoThread;
-    m_imageThread = m_videoThread = nullptr;
+    m_videoThread = nullptr;
+}
+
+
+/*!
+ \brief Returns the picture thread that handles an image
+ \details All tasks of an image go to the same thread, so that they are actioned
+ in the order they were queued.
+ \param id Image id
+ */
+template <class DBFS>
+ThumbThread<DBFS> *ImageThumb<DBFS>::ImageThread(int id) const
+{
+    if (m_imageThreads.isEmpty())
+        return nullptr;
+    return m_imageThreads.at(static_cast<uint>(id) % m_imageThreads.size());
 }
 
 
@@ -367,8 +565,8 @@ void ImageThumb<DBFS>::ClearThumbs(int devId, const QString &action)
 {
     // Cancel pending requests for the device
     // Waits for current generator task to complete
-    if (m_imageThread)
-        m_imageThread->AbortDevice(devId, action);
+    for (auto *thread : std::as_const(m_imageThreads))
+        thread->AbortDevice(devId, action);
     if (m_videoThread)
         m_videoThread->AbortDevice(devId, action);
 
@@ -399,21 +597,21 @@ QString ImageThumb<DBFS>::DeleteThumbs(const ImageList &images)
     // Determine affected images and redundant images/thumbnails
     QStringList ids;
 
-    // Pictures & videos are deleted by their own threads
-    ImageListK pics;
+    // Pictures & videos are deleted by the threads that made them
+    QMap<ThumbThread<DBFS> *, ImageListK> pics;
     ImageListK videos;
     for (const auto& im : std::as_const(images))
     {
         if (im->m_type == kVideoFile)
             videos.append(im);
-        else
-            pics.append(im);
+        else if (ThumbThread<DBFS> *imageThread = ImageThread(im->m_id))
+            pics[imageThread].append(im);
 
         ids << QString::number(im->m_id);
     }
 
-    if (!pics.isEmpty() && m_imageThread)
-        m_imageThread->Enqueue(TaskPtr(new ThumbTask("DELETE", pics)));
+    for (auto it = pics.cbegin(); it != pics.cend(); ++it)
+        it.key()->Enqueue(TaskPtr(new ThumbTask("DELETE", it.value())));
     if (!videos.isEmpty() && m_videoThread)
         m_videoThread->Enqueue(TaskPtr(new ThumbTask("DELETE", videos)));
     return ids.join(",");
@@ -439,9 +637,10 @@ void ImageThumb<DBFS>::CreateThumbnail(const ImagePtrK &im, int priority,
 
     TaskPtr task(new ThumbTask("CREATE", im, priority, notify));
 
-    if (im->m_type == kImageFile && m_imageThread)
+    ThumbThread<DBFS> *imageThread = ImageThread(im->m_id);
+    if (im->m_type == kImageFile && imageThread)
     {
-        m_imageThread->Enqueue(task);
+        imageThread->Enqueue(task);
     }
     else if (im->m_type == kVideoFile && m_videoThread)
     {
@@ -467,9 +666,10 @@ void ImageThumb<DBFS>::MoveThumbnail(const ImagePtrK &im)
 
     TaskPtr task(new ThumbTask("MOVE", im));
 
-    if (im->m_type == kImageFile && m_imageThread)
+    ThumbThread<DBFS> *imageThread = ImageThread(im->m_id);
+    if (im->m_type == kImageFile && imageThread)
     {
-        m_imageThread->Enqueue(task);
+        imageThread->Enqueue(task);
     }
     else if (im->m_type == kVideoFile && m_videoThread)
     {
@@ -491,13 +691,39 @@ void ImageThumb<DBFS>::PauseBackground(bool pause)
 {
     LOG(VB_FILE, LOG_INFO,  QString("Paused %1").arg(pause));
 
-    if (m_imageThread)
-        m_imageThread->PauseBackground(pause);
+    for (auto *thread : std::as_const(m_imageThreads))
+        thread->PauseBackground(pause);
     if (m_videoThread)
         m_videoThread->PauseBackground(pause);
 }
 
 
+/*!
+  \brief Returns the number of thumbnails generated since startup
+ */
+template <class DBFS>
+int ImageThumb<DBFS>::ThumbsCreated() const
+{
+    int count = m_videoThread ? m_videoThread->CreatedCount() : 0;
+    for (auto *thread : std::as_const(m_imageThreads))
+        count += thread->CreatedCount();
+    return count;
+}
+
+
+/*!
+  \brief Returns the number of queued thumbnail tasks
+ */
+template <class DBFS>
+int ImageThumb<DBFS>::ThumbsPending() const
+{
+    int count = m_videoThread ? m_videoThread->QueueSize() : 0;
+    for (auto *thread : std::as_const(m_imageThreads))
+        count += thread->QueueSize();
+    return count;
+}
+
+
 // Must define the valid template implementations to generate code for the
 // instantiations (as they are defined in the cpp rather than header).
 // Otherwise the linker will fail with undefined references...
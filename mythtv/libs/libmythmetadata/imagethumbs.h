@@ -1,10 +1,13 @@
 //! \file
 //! \brief Creates and manages thumbnails
-//! \details Uses two worker threads to process thumbnail requests that are queued
-//! from the scanner and UI.
-//! One thread generates picture thumbs; the other video thumbs, which are delegated
-//! to previewgenerator and time-consuming.
-//! Both background threads are low-priority to avoid recording issues.
+//! \details Uses a pool of worker threads to process thumbnail requests that are
+//! queued from the scanner and UI.
+//! Picture thumbs are generated by one thread per core. Each image belongs to
+//! one of them, so its requests are handled in order. A thread whose queue runs
+//! dry steals Create requests from the others.
+//! Video thumbs are delegated to previewgenerator, which is time-consuming, and
+//! handled by a single thread.
+//! All background threads are low-priority to avoid recording issues.
 //! Requests are handled by client-assigned priority so that UI display requests
 //! are serviced before background scanner requests.
 //! When images are removed, their thumbnails are also deleted (thumbnail cache is
@@ -14,11 +17,14 @@
 #ifndef IMAGETHUMBS_H
 #define IMAGETHUMBS_H
 
+#include <atomic>
 #include <utility>
 
 // Qt headers
+#include <QList>
 #include <QMap>
 #include <QMutex>
+#include <QSet>
 #include <QWaitCondition>
 
 // MythTV headers
@@ -101,6 +107,13 @@ public:
     void AbortDevice(int devId, const QString &action);
     void PauseBackground(bool pause);
 
+    //! Threads that idle time can be spent helping
+    void SetSiblings(const QList<ThumbThread *> &siblings)
+    { m_siblings = siblings; }
+    int  QueueSize();
+    //! Number of thumbnails generated since construction
+    int  CreatedCount() const { return m_created; }
+
 protected:
     void run() override; // MThread
 
@@ -110,7 +123,11 @@ private:
     //! A priority queue where 0 is highest priority
     using ThumbQueue = QMultiMap<int, TaskPtr>;
 
+    TaskPtr Steal();
+    void    Return(const TaskPtr &task);
+    void    WaitForLent(const TaskPtr &task);
     QString CreateThumbnail(const ImagePtrK& im, int thumbPriority);
+    static QString LoadPicture(const QString &path, QImage &image);
     static void RemoveTasks(ThumbQueue &queue, int devId);
 
     DBFS &m_dbfs;               //!< Database/filesystem adapter
@@ -120,6 +137,11 @@ private:
     ThumbQueue m_backgroundQ;   //!< Priority queue of background tasks
     bool m_doBackground {true}; //!< Whether to process background tasks
     QMutex m_mutex;            //!< Queue protection
+
+    QList<ThumbThread *> m_siblings; //!< Pool members to steal from
+    QSet<int>      m_lent;      //!< Ids of images stolen by other threads
+    QWaitCondition m_lentDone;  //!< Signals a stolen task is finished
+    std::atomic<int>     m_created {0}; //!< Thumbnails generated
 };
 
 
@@ -137,6 +159,8 @@ public:
                             bool notify = false);
     void    MoveThumbnail(const ImagePtrK &im);
     void    PauseBackground(bool pause);
+    int     ThumbsCreated() const;
+    int     ThumbsPending() const;
 
 private:
     Q_DISABLE_COPY(ImageThumb)
@@ -148,12 +172,14 @@ private:
     int Priority(ImageItemK &im)
     { return (im.m_filePath.count('/') * 1000) + im.m_id; }
 
+    ThumbThread<DBFS> *ImageThread(int id) const;
+
     //! Db/filesystem adapter
-    DBFS              &m_dbfs;
-    //! Thread generating picture thumbnails
-    ThumbThread<DBFS> *m_imageThread;
+    DBFS                       &m_dbfs;
+    //! Threads generating picture thumbnails
+    QList<ThumbThread<DBFS> *>  m_imageThreads;
     //! Thread generating video previews
-    ThumbThread<DBFS> *m_videoThread;
+    ThumbThread<DBFS>          *m_videoThread;
 };
 
 #endif // IMAGETHUMBS_H
@@ -5,9 +5,11 @@
 #include <QCoreApplication>
 #include <QEvent>
 #include <QDir>
+#include <QRunnable>
 #include <QUrl>
 
 // myth
+#include "libmythbase/mthreadpool.h"
 #include "libmythbase/mythcorecontext.h"
 #include "libmythbase/mythdirs.h"
 #include "libmythbase/mythlogging.h"
@@ -26,6 +28,24 @@ const QEvent::Type MetadataLookupEvent::kEventType =
 const QEvent::Type MetadataLookupFailure::kEventType =
     (QEvent::Type) QEvent::registerEventType();
 
+class MetadataLookupTask : public QRunnable
+{
+  public:
+    MetadataLookupTask(MetadataDownload *parent, MetadataLookup *lookup)
+      : m_parent(parent), m_lookup(lookup) {}
+
+    void run() override // QRunnable
+    {
+        m_parent->handleLookup(m_lookup);
+        m_parent->lookupDone();
+    }
+
+  private:
+    MetadataDownload *m_parent {nullptr};
+    // Owns the MetadataLookup object until the lookup completes
+    RefCountHandler<MetadataLookup> m_lookup;
+};
+
 MetadataDownload::~MetadataDownload()
 {
     cancel();
@@ -43,6 +63,7 @@ void MetadataDownload::addLookup(MetadataLookup *lookup)
 
     m_lookupList.append(lookup);
     lookup->DecrRef();
+    m_wait.wakeAll();
     if (!isRunning())
         start();
 }
@@ -58,6 +79,7 @@ void MetadataDownload::prependLookup(MetadataLookup *lookup)
 
     m_lookupList.prepend(lookup);
     lookup->DecrRef();
+    m_wait.wakeAll();
     if (!isRunning())
         start();
 }
@@ -70,180 +92,204 @@ void MetadataDownload::cancel()
     m_parent = nullptr;
 }
 
+/**
+ * Runs up to MetaGrabberScript::MaxProcesses() lookups at once. Each is only
+ * taken from the queue when it can start, so lookups prepended by running
+ * ones still go first.
+ */
 void MetadataDownload::run()
 {
     RunProlog();
 
-    while (true)
+    MThreadPool pool("MetadataDownload");
+    int maxLookups = MetaGrabberScript::MaxProcesses();
+    pool.setMaxThreadCount(maxLookups);
+
+    m_mutex.lock();
+    while (!m_lookupList.isEmpty() || m_running > 0)
     {
-        m_mutex.lock();
-        if (m_lookupList.isEmpty())
+        if (m_lookupList.isEmpty() || m_running >= maxLookups)
         {
-            // no more to process, we're done
-            m_mutex.unlock();
-            break;
+            m_wait.wait(&m_mutex);
+            continue;
         }
-        // Ref owns the MetadataLookup object for the duration of the loop
-        // and it will be deleted automatically when the loop completes
+
+        // The task owns the MetadataLookup object, and it will be deleted
+        // automatically when the task completes
         RefCountHandler<MetadataLookup> ref = m_lookupList.takeFirstAndDecr();
-        m_mutex.unlock();
-        MetadataLookup *lookup = ref;
-        MetadataLookupList list;
+        ++m_running;
+        pool.start(new MetadataLookupTask(this, ref), "MetadataLookup");
+    }
+    // no more to process, we're done
+    m_mutex.unlock();
+
+    pool.waitForDone();
+
+    RunEpilog();
+}
+
+void MetadataDownload::lookupDone()
+{
+    QMutexLocker lock(&m_mutex);
+    --m_running;
+    m_wait.wakeAll();
+}
 
-        // Go go gadget Metadata Lookup
-        if (lookup->GetType() == kMetadataVideo ||
-            lookup->GetType() == kMetadataRecording)
+void MetadataDownload::handleLookup(MetadataLookup *lookup)
+{
+    MetadataLookupList list;
+
+    // Go go gadget Metadata Lookup
+    if (lookup->GetType() == kMetadataVideo ||
+        lookup->GetType() == kMetadataRecording)
+    {
+        // First, look for mxml and nfo files in video storage groups
+        if (lookup->GetType() == kMetadataVideo &&
+            !lookup->GetFilename().isEmpty())
         {
-            // First, look for mxml and nfo files in video storage groups
-            if (lookup->GetType() == kMetadataVideo &&
-                !lookup->GetFilename().isEmpty())
-            {
-                QString mxml = getMXMLPath(lookup->GetFilename());
-                QString nfo = getNFOPath(lookup->GetFilename());
+            QString mxml = getMXMLPath(lookup->GetFilename());
+            QString nfo = getNFOPath(lookup->GetFilename());
 
-                if (!mxml.isEmpty())
-                    list = readMXML(mxml, lookup);
-                else if (!nfo.isEmpty())
-                    list = readNFO(nfo, lookup);
-            }
+            if (!mxml.isEmpty())
+                list = readMXML(mxml, lookup);
+            else if (!nfo.isEmpty())
+                list = readNFO(nfo, lookup);
+        }
 
-            // If nothing found, create lookups based on filename
-            if (list.isEmpty())
+        // If nothing found, create lookups based on filename
+        if (list.isEmpty())
+        {
+            if (lookup->GetSubtype() == kProbableTelevision)
             {
-                if (lookup->GetSubtype() == kProbableTelevision)
+                list = handleTelevision(lookup);
+                if ((findExactMatchCount(list, lookup->GetBaseTitle(), true) == 0) ||
+                    (list.size() > 1 && !lookup->GetAutomatic()))
                 {
-                    list = handleTelevision(lookup);
-                    if ((findExactMatchCount(list, lookup->GetBaseTitle(), true) == 0) ||
-                        (list.size() > 1 && !lookup->GetAutomatic()))
-                    {
-                        // There are no exact match prospects with artwork from TV search,
-                        // so add in movies, where we might find a better match.
-                        // In case of manual mode and ambiguous result, add it as well.
-                        list.append(handleMovie(lookup));
-                    }
+                    // There are no exact match prospects with artwork from TV search,
+                    // so add in movies, where we might find a better match.
+                    // In case of manual mode and ambiguous result, add it as well.
+                    list.append(handleMovie(lookup));
                 }
-                else if (lookup->GetSubtype() == kProbableMovie)
-                {
-                    list = handleMovie(lookup);
-                    if ((findExactMatchCount(list, lookup->GetBaseTitle(), true) == 0) ||
-                        (list.size() > 1 && !lookup->GetAutomatic()))
-                    {
-                        // There are no exact match prospects with artwork from Movie search
-                        // so add in television, where we might find a better match.
-                        // In case of manual mode and ambiguous result, add it as well.
-                        list.append(handleTelevision(lookup));
-                    }
-                }
-                else
+            }
+            else if (lookup->GetSubtype() == kProbableMovie)
+            {
+                list = handleMovie(lookup);
+                if ((findExactMatchCount(list, lookup->GetBaseTitle(), true) == 0) ||
+                    (list.size() > 1 && !lookup->GetAutomatic()))
                 {
-                    // will try both movie and TV
-                    list = handleVideoUndetermined(lookup);
+                    // There are no exact match prospects with artwork from Movie search
+                    // so add in television, where we might find a better match.
+                    // In case of manual mode and ambiguous result, add it as well.
+                    list.append(handleTelevision(lookup));
                 }
             }
+            else
+            {
+                // will try both movie and TV
+                list = handleVideoUndetermined(lookup);
+            }
         }
-        else if (lookup->GetType() == kMetadataGame)
+    }
+    else if (lookup->GetType() == kMetadataGame)
+    {
+        list = handleGame(lookup);
+    }
+
+    // inform parent we have lookup ready for it
+    if (m_parent && !list.isEmpty())
+    {
+        // If there's only one result, don't bother asking
+        // our parent about it, just add it to the back of
+        // the queue in kLookupData mode.
+        if (list.count() == 1 && list[0]->GetStep() == kLookupSearch)
         {
-            list = handleGame(lookup);
+            MetadataLookup *newlookup = list.takeFirst();
+
+            newlookup->SetStep(kLookupData);
+            // Type may have changed
+            LookupType ret = GuessLookupType(newlookup);
+            if (ret != kUnknownVideo)
+            {
+                newlookup->SetSubtype(ret);
+            }
+            prependLookup(newlookup);
+            return;
         }
 
-        // inform parent we have lookup ready for it
-        if (m_parent && !list.isEmpty())
+        // If we're in automatic mode, we need to make
+        // these decisions on our own.  Pass to title match.
+        if (list[0]->GetAutomatic() && list.count() > 1
+            && list[0]->GetStep() == kLookupSearch)
         {
-            // If there's only one result, don't bother asking
-            // our parent about it, just add it to the back of
-            // the queue in kLookupData mode.
-            if (list.count() == 1 && list[0]->GetStep() == kLookupSearch)
+            MetadataLookup *bestLookup = findBestMatch(list, lookup->GetBaseTitle());
+            if (bestLookup)
             {
-                MetadataLookup *newlookup = list.takeFirst();
+                MetadataLookup *newlookup = bestLookup;
 
+                // pass through automatic type
+                newlookup->SetAutomatic(true);
+                // bestlookup is owned by list, we need an extra reference
+                newlookup->IncrRef();
                 newlookup->SetStep(kLookupData);
-                prependLookup(newlookup);
                 // Type may have changed
                 LookupType ret = GuessLookupType(newlookup);
                 if (ret != kUnknownVideo)
                 {
                     newlookup->SetSubtype(ret);
                 }
-                continue;
+                prependLookup(newlookup);
+                return;
             }
 
-            // If we're in automatic mode, we need to make
-            // these decisions on our own.  Pass to title match.
-            if (list[0]->GetAutomatic() && list.count() > 1
-                && list[0]->GetStep() == kLookupSearch)
+            // Experimental:
+            // If nothing matches, always return the first found item
+            if (qEnvironmentVariableIsSet("EXPERIMENTAL_METADATA_GRAB"))
             {
-                MetadataLookup *bestLookup = findBestMatch(list, lookup->GetBaseTitle());
-                if (bestLookup)
-                {
-                    MetadataLookup *newlookup = bestLookup;
-
-                    // pass through automatic type
-                    newlookup->SetAutomatic(true);
-                    // bestlookup is owned by list, we need an extra reference
-                    newlookup->IncrRef();
-                    newlookup->SetStep(kLookupData);
-                    // Type may have changed
-                    LookupType ret = GuessLookupType(newlookup);
-                    if (ret != kUnknownVideo)
-                    {
-                        newlookup->SetSubtype(ret);
-                    }
-                    prependLookup(newlookup);
-                    continue;
-                }
+                MetadataLookup *newlookup = list.takeFirst();
 
-                // Experimental:
-                // If nothing matches, always return the first found item
-                if (qEnvironmentVariableIsSet("EXPERIMENTAL_METADATA_GRAB"))
+                // pass through automatic type
+                newlookup->SetAutomatic(true);   // ### XXX RER
+                newlookup->SetStep(kLookupData);
+                // Type may have changed
+                LookupType ret = GuessLookupType(newlookup);
+                if (ret != kUnknownVideo)
                 {
-                    MetadataLookup *newlookup = list.takeFirst();
-
-                    // pass through automatic type
-                    newlookup->SetAutomatic(true);   // ### XXX RER
-                    newlookup->SetStep(kLookupData);
-                    // Type may have changed
-                    LookupType ret = GuessLookupType(newlookup);
-                    if (ret != kUnknownVideo)
-                    {
-                        newlookup->SetSubtype(ret);
-                    }
-                    prependLookup(newlookup);
-                    continue;
+                    newlookup->SetSubtype(ret);
                 }
-
-                // nothing more we can do in automatic mode
-                QCoreApplication::postEvent(m_parent,
-                    new MetadataLookupFailure(MetadataLookupList() << lookup));
-                continue;
+                prependLookup(newlookup);
+                return;
             }
 
+            // nothing more we can do in automatic mode
+            QCoreApplication::postEvent(m_parent,
+                new MetadataLookupFailure(MetadataLookupList() << lookup));
+            return;
+        }
+
+        LOG(VB_GENERAL, LOG_INFO,
+            QString("Returning Metadata Results: %1 %2 %3")
+                .arg(lookup->GetBaseTitle()).arg(lookup->GetSeason())
+                .arg(lookup->GetEpisode()));
+        QCoreApplication::postEvent(m_parent,
+            new MetadataLookupEvent(list));
+    }
+    else
+    {
+        if (list.isEmpty())
+        {
             LOG(VB_GENERAL, LOG_INFO,
-                QString("Returning Metadata Results: %1 %2 %3")
+                QString("Metadata Lookup Failed: No Results %1 %2 %3")
                     .arg(lookup->GetBaseTitle()).arg(lookup->GetSeason())
                     .arg(lookup->GetEpisode()));
-            QCoreApplication::postEvent(m_parent,
-                new MetadataLookupEvent(list));
         }
-        else
+        if (m_parent)
         {
-            if (list.isEmpty())
-            {
-                LOG(VB_GENERAL, LOG_INFO,
-                    QString("Metadata Lookup Failed: No Results %1 %2 %3")
-                        .arg(lookup->GetBaseTitle()).arg(lookup->GetSeason())
-                        .arg(lookup->GetEpisode()));
-            }
-            if (m_parent)
-            {
-                // list is always empty here
-                list.append(lookup);
-                QCoreApplication::postEvent(m_parent,
-                    new MetadataLookupFailure(list));
-            }
+            // list is always empty here
+            list.append(lookup);
+            QCoreApplication::postEvent(m_parent,
+                new MetadataLookupFailure(list));
         }
     }
-
-    RunEpilog();
 }
 
 unsigned int MetadataDownload::findExactMatchCount(MetadataLookupList list,
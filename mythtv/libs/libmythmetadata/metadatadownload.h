@@ -4,6 +4,7 @@
 #include <QStringList>
 #include <QMutex>
 #include <QEvent>
+#include <QWaitCondition>
 
 #include "libmythbase/mthread.h"
 #include "libmythmetadata/metadatacommon.h"
@@ -60,6 +61,10 @@ class META_PUBLIC MetadataDownload : public MThread
     static QString getNFOPath(const QString& filename);
 
   private:
+    friend class MetadataLookupTask;
+    void                       handleLookup(MetadataLookup* lookup);
+    void                       lookupDone();
+
     // Video handling
     static MetadataLookupList  handleMovie(MetadataLookup* lookup);
     static MetadataLookupList  handleTelevision(MetadataLookup* lookup);
@@ -86,6 +91,8 @@ class META_PUBLIC MetadataDownload : public MThread
     QObject            *m_parent {nullptr};
     MetadataLookupList  m_lookupList;
     QMutex              m_mutex;
+    QWaitCondition      m_wait;         //!< Lookup queued or finished
+    int                 m_running {0};  //!< Lookups in progress
 };
 
 #endif /* METADATADOWNLOAD_H */
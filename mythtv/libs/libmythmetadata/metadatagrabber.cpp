@@ -1,10 +1,17 @@
 // Qt headers
+#include <QCryptographicHash>
 #include <QDateTime>
 #include <QDir>
+#include <QHash>
 #include <QMap>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QRegularExpression>
+#include <QSaveFile>
+#include <QSemaphore>
+#include <QWaitCondition>
+#include <algorithm>
+#include <memory>
 #include <utility>
 
 // MythTV headers
@@ -27,6 +34,21 @@ static GrabberList     s_grabberList;
 static QMutex          s_grabberLock;
 static QDateTime       s_grabberAge;
 
+// A grabber run, its output is handed to the identical lookups waiting for it
+struct GrabberRun
+{
+    bool       m_done {false};
+    bool       m_ok   {false};
+    QByteArray m_result;
+};
+
+// Grabber output, shared by identical lookups and cached on disk
+static QMutex          s_outputLock;
+static QWaitCondition  s_outputReady;
+static QHash<QString, std::shared_ptr<GrabberRun> > s_outputRuns; // by key
+static QSemaphore     *s_processes  {nullptr};  // limits grabbers running
+static bool            s_cachePruned {false};
+
 struct GrabberOpts {
     QString     m_path;
     QString     m_setting;
@@ -379,6 +401,161 @@ bool MetaGrabberScript::Test(void)
     return grabber.Wait() == GENERIC_EXIT_OK;
 }
 
+/**
+ * \brief Identifies the output of a grabber run.
+ *
+ * Search terms are case folded and have their whitespace simplified, so
+ * that recordings whose titles differ only in that way share a result.
+ */
+QString MetaGrabberScript::CacheKey(const QString &command,
+                                    const QStringList &args)
+{
+    QStringList key { command };
+    bool search = false;
+    for (const auto& arg : std::as_const(args))
+    {
+        if (arg.startsWith('-'))
+        {
+            search = (arg == "-M" || arg == "-N");
+            key << arg;
+        }
+        else
+        {
+            key << (search ? arg.simplified().toCaseFolded() : arg);
+        }
+    }
+    return key.join(QChar(0x1F));
+}
+
+/// The number of grabber processes that may run at once
+int MetaGrabberScript::MaxProcesses(void)
+{
+    return std::clamp(gCoreContext->GetNumSetting("MetadataGrabberProcesses", 4),
+                      1, 16);
+}
+
+static QString CachePath(void)
+{
+    return GetCacheDir() + "/metadata/";
+}
+
+/// Removes cached grabber output that has expired. Call with the lock held.
+static void PruneCache(std::chrono::hours expiry)
+{
+    QDateTime oldest = MythDate::current().addSecs(
+        -std::chrono::duration_cast<std::chrono::seconds>(expiry).count());
+    QDir dir(CachePath());
+    const QFileInfoList files = dir.entryInfoList({ "*.xml" }, QDir::Files);
+    int removed = 0;
+    for (const auto& file : files)
+    {
+        if (file.lastModified() < oldest && QFile::remove(file.absoluteFilePath()))
+            ++removed;
+    }
+    if (removed > 0)
+    {
+        LOG(VB_GENERAL, LOG_INFO, LOC +
+            QString("Removed %1 expired results from cache").arg(removed));
+    }
+}
+
+/**
+ * \brief Gets the output of the grabber for \p args.
+ *
+ * Output less than MetadataGrabberCacheHours old is read from the cache.
+ * Otherwise the grabber is run, and no more than MaxProcesses() grabbers run
+ * at once. Lookups that want the same output while it is being fetched wait
+ * for that run and get its result, empty or failed results included.
+ */
+bool MetaGrabberScript::GrabberOutput(const QStringList &args,
+                                      QByteArray &result) const
+{
+    QString key = CacheKey(m_fullcommand, args);
+    QString path = CachePath() + QCryptographicHash::hash(
+        key.toUtf8(), QCryptographicHash::Sha1).toHex() + ".xml";
+    auto expiry = gCoreContext->GetDurSetting<std::chrono::hours>(
+        "MetadataGrabberCacheHours", 168h);
+    std::shared_ptr<GrabberRun> run;
+
+    {
+        QMutexLocker locker(&s_outputLock);
+        if (!s_processes)
+            s_processes = new QSemaphore(MaxProcesses());
+        if (!s_cachePruned && expiry > 0h)
+        {
+            QDir().mkpath(CachePath());
+            PruneCache(expiry);
+            s_cachePruned = true;
+        }
+
+        // Wait for an identical grab to finish, then use its result
+        auto it = s_outputRuns.constFind(key);
+        if (it != s_outputRuns.constEnd())
+        {
+            std::shared_ptr<GrabberRun> other = *it;
+            while (!other->m_done)
+                s_outputReady.wait(&s_outputLock);
+            result = other->m_result;
+            return other->m_ok;
+        }
+        run = std::make_shared<GrabberRun>();
+        s_outputRuns.insert(key, run);
+    }
+
+    bool ok = false;
+    QFileInfo cached(path);
+    if (expiry > 0h && cached.exists() &&
+        cached.lastModified().secsTo(MythDate::current()) <
+            std::chrono::duration_cast<std::chrono::seconds>(expiry).count())
+    {
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly))
+        {
+            result = file.readAll();
+            ok = true;
+            LOG(VB_GENERAL, LOG_INFO, QString("Cached Grabber: %1 %2")
+                .arg(m_fullcommand, args.join(" ")));
+        }
+    }
+
+    if (!ok)
+    {
+        s_processes->acquire();
+
+        MythSystemLegacy grabber(m_fullcommand, args, kMSStdOut);
+
+        LOG(VB_GENERAL, LOG_INFO, QString("Running Grabber: %1 %2")
+            .arg(m_fullcommand, args.join(" ")));
+
+        grabber.Run();
+        ok = grabber.Wait(180s) == GENERIC_EXIT_OK;
+        if (ok)
+            result = grabber.ReadAll();
+
+        s_processes->release();
+
+        // Empty results aren't kept, a new show may soon be listed
+        if (ok && !result.isEmpty() && expiry > 0h)
+        {
+            QSaveFile file(path);
+            if (!file.open(QIODevice::WriteOnly) ||
+                file.write(result) != result.size() || !file.commit())
+            {
+                LOG(VB_GENERAL, LOG_WARNING, LOC +
+                    QString("Unable to cache result in %1").arg(path));
+            }
+        }
+    }
+
+    QMutexLocker locker(&s_outputLock);
+    run->m_ok = ok;
+    run->m_result = result;
+    run->m_done = true;
+    s_outputRuns.remove(key);
+    s_outputReady.wakeAll();
+    return ok;
+}
+
 // TODO
 // using the MetadataLookup object as both argument input, and parsed output,
 // is clumsy. break the inputs out into a separate object, and spawn a new
@@ -387,17 +564,12 @@ bool MetaGrabberScript::Test(void)
 MetadataLookupList MetaGrabberScript::RunGrabber(const QStringList &args,
                         MetadataLookup *lookup, bool passseas)
 {
-    MythSystemLegacy grabber(m_fullcommand, args, kMSStdOut);
     MetadataLookupList list;
 
-    LOG(VB_GENERAL, LOG_INFO, QString("Running Grabber: %1 %2")
-        .arg(m_fullcommand, args.join(" ")));
-
-    grabber.Run();
-    if (grabber.Wait(180s) != GENERIC_EXIT_OK)
+    QByteArray result;
+    if (!GrabberOutput(args, result))
         return list;
 
-    QByteArray result = grabber.ReadAll();
     if (!result.isEmpty())
     {
         QDomDocument doc;
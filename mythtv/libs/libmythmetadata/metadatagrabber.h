@@ -51,6 +51,9 @@ class META_PUBLIC MetaGrabberScript
     static MetaGrabberScript    FromInetref(const QString &inetref,
                                             bool absolute=false);
     static QString              CleanedInetref(const QString &inetref);
+    static QString              CacheKey(const QString &command,
+                                         const QStringList &args);
+    static int                  MaxProcesses(void);
 
     bool          IsValid(void) const         { return m_valid; }
 
@@ -92,6 +95,7 @@ class META_PUBLIC MetaGrabberScript
 
     void ParseGrabberVersion(const QDomElement &item);
     MetadataLookupList RunGrabber(const QStringList &args, MetadataLookup *lookup, bool passseas);
+    bool GrabberOutput(const QStringList &args, QByteArray &result) const;
     static void SetDefaultArgs(QStringList &args);
 };
 
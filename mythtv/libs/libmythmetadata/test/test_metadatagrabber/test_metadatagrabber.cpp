@@ -55,6 +55,26 @@ void TestMetadataGrabber::test_fromInetref(void)
 #endif
 }
 
+void TestMetadataGrabber::test_cacheKey(void)
+{
+    QString cmd { "/usr/share/mythtv/metadata/Television/ttvdb4.py" };
+    QString key = MetaGrabberScript::CacheKey(cmd, {"-l", "en", "-M", "Doctor Who"});
+
+    // Search terms differing in case or spacing share a result
+    QCOMPARE(MetaGrabberScript::CacheKey(cmd, {"-l", "en", "-M", "doctor  WHO "}), key);
+    QCOMPARE(MetaGrabberScript::CacheKey(cmd, {"-l", "en", "-N", "Doctor Who", "Rose"}),
+             MetaGrabberScript::CacheKey(cmd, {"-l", "en", "-N", "DOCTOR WHO", "rose"}));
+
+    // Anything else has to match exactly
+    QVERIFY(MetaGrabberScript::CacheKey(cmd, {"-l", "EN", "-M", "Doctor Who"}) != key);
+    QVERIFY(MetaGrabberScript::CacheKey(cmd, {"-l", "en", "-D", "Doctor Who"}) != key);
+    QVERIFY(MetaGrabberScript::CacheKey("tmdb3.py", {"-l", "en", "-M", "Doctor Who"}) != key);
+    QVERIFY(MetaGrabberScript::CacheKey(cmd, {"-l", "en", "-D", "ABC1"}) !=
+            MetaGrabberScript::CacheKey(cmd, {"-l", "en", "-D", "abc1"}));
+    QVERIFY(MetaGrabberScript::CacheKey(cmd, {"-l", "en", "-D", "76107", "1", "2"}) !=
+            MetaGrabberScript::CacheKey(cmd, {"-l", "en", "-D", "76107", "12"}));
+}
+
 void TestMetadataGrabber::cleanupTestCase()
 {
 }
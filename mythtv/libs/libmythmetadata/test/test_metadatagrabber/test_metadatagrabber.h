@@ -33,5 +33,6 @@ private slots:
     static void initTestCase();
     static void test_inetref(void);
     static void test_fromInetref(void);
+    static void test_cacheKey(void);
     static void cleanupTestCase();
 };
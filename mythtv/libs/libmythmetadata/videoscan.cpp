@@ -3,11 +3,17 @@
 
 #include <QApplication>
 #include <QImageReader>
+#include <QRunnable>
+#include <QThread>
 #include <QUrl>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <utility>
 
 // mythtv
 #include "libmyth/mythcontext.h"
+#include "libmythbase/mthreadpool.h"
 #include "libmythbase/mythdate.h"
 #include "libmythbase/mythevent.h"
 #include "libmythbase/mythlogging.h"
@@ -69,6 +75,16 @@ namespace
         image_ext    m_imageExt;
         DirListType &m_videoFiles;
     };
+
+    class ScanTask : public QRunnable
+    {
+      public:
+        explicit ScanTask(std::function<void()> task) : m_task(std::move(task)) {}
+        void run() override { m_task(); } // QRunnable
+
+      private:
+        std::function<void()> m_task;
+    };
 }
 
 class VideoMetadataListManager;
@@ -81,6 +97,7 @@ VideoScannerThread::VideoScannerThread(QObject *parent) :
     m_dbMetadata(new VideoMetadataListManager)
 {
     m_listUnknown = gCoreContext->GetBoolSetting("VideoListUnknownFiletypes", false);
+    m_watchDirs = gCoreContext->GetBoolSetting("VideoScanWatchDirs", false);
 }
 
 VideoScannerThread::~VideoScannerThread()
@@ -170,29 +187,57 @@ void VideoScannerThread::run()
 
     LOG(VB_GENERAL, LOG_INFO, QString("Beginning Video Scan."));
 
-    uint counter = 0;
+    FileAssociations::ext_ignore_list ext_list;
+    FileAssociations::getFileAssociation().getExtensionIgnoreList(ext_list);
+
+    std::atomic<uint> counter {0};
     FileCheckList fs_files;
 
     if (m_hasGUI)
         SendProgressEvent(counter, (uint)m_directories.size(),
                           tr("Searching for video files"));
-    for (const auto & dir : std::as_const(m_directories))
+
+    // Walk the dirs concurrently, as most of the time goes on waiting for
+    // the disks, network filesystems & other backends to answer
+    auto count = static_cast<size_t>(m_directories.size());
+    std::vector<FileCheckList> dir_files(count);
+    std::vector<char> scanned(count, 0);
     {
-        if (!buildFileList(dir, imageExtensions, fs_files))
+        MThreadPool pool("VideoScanPool");
+        pool.setMaxThreadCount(std::clamp(QThread::idealThreadCount(), 1,
+                                          std::max(1, static_cast<int>(count))));
+        for (size_t i = 0; i < count; ++i)
         {
-            if (dir.startsWith("myth://"))
+            pool.start(new ScanTask([&, i]()
             {
-                QUrl sgurl = dir;
-                QString host = sgurl.host().toLower();
+                scanned[i] = static_cast<char>(
+                    buildFileList(m_directories[i], imageExtensions, ext_list,
+                                  dir_files[i]));
+                if (m_hasGUI)
+                    SendProgressEvent(++counter);
+            }), "VideoScanDir");
+        }
+        pool.waitForDone();
+    }
+
+    // Merge in order so that, as before, a file seen in several dirs takes
+    // the host of the last one
+    for (size_t i = 0; i < count; ++i)
+    {
+        const QString &dir = m_directories[i];
+        if (!scanned[i] && dir.startsWith("myth://"))
+        {
+            QUrl sgurl = dir;
+            QString host = sgurl.host().toLower();
 
-                m_liveSGHosts.removeAll(host);
+            m_liveSGHosts.removeAll(host);
 
-                LOG(VB_GENERAL, LOG_ERR,
-                    QString("Failed to scan :%1:").arg(dir));
-            }
+            LOG(VB_GENERAL, LOG_ERR,
+                QString("Failed to scan :%1:").arg(dir));
         }
-        if (m_hasGUI)
-            SendProgressEvent(++counter);
+
+        for (auto & file : dir_files[i])
+            fs_files[file.first] = std::move(file.second);
     }
 
     PurgeList db_remove;
@@ -383,6 +428,7 @@ bool VideoScannerThread::updateDB(const FileCheckList &add, const PurgeList &rem
 
 bool VideoScannerThread::buildFileList(const QString &directory,
                                        const QStringList &imageExtensions,
+                                       const FileAssociations::ext_ignore_list &ext_list,
                                        FileCheckList &filelist) const
 {
     // TODO: FileCheckList is a std::map, keyed off the filename. In the event
@@ -393,11 +439,10 @@ bool VideoScannerThread::buildFileList(const QString &directory,
 
     LOG(VB_GENERAL,LOG_INFO, QString("buildFileList directory = %1")
                                  .arg(directory));
-    FileAssociations::ext_ignore_list ext_list;
-    FileAssociations::getFileAssociation().getExtensionIgnoreList(ext_list);
 
     dirhandler<FileCheckList> dh(filelist, imageExtensions);
-    return ScanVideoDirectory(directory, &dh, ext_list, m_listUnknown);
+    return ScanVideoDirectory(directory, &dh, ext_list, m_listUnknown,
+                              m_watchDirs);
 }
 
 void VideoScannerThread::SendProgressEvent(uint progress, uint total,
@@ -14,6 +14,7 @@
 
 // MythTV headers
 #include "libmythbase/mthread.h"
+#include "libmythmetadata/dbaccess.h"
 #include "libmythmetadata/mythmetaexp.h"
 #include "libmythui/mythprogressdialog.h"
 
@@ -90,8 +91,9 @@ class META_PUBLIC VideoScannerThread : public MThread
     void verifyFiles(FileCheckList &files, PurgeList &remove);
     bool updateDB(const FileCheckList &add, const PurgeList &remove);
     bool buildFileList(const QString &directory,
-                                        const QStringList &imageExtensions,
-                                        FileCheckList &filelist) const;
+                       const QStringList &imageExtensions,
+                       const FileAssociations::ext_ignore_list &ext_list,
+                       FileCheckList &filelist) const;
 
     void SendProgressEvent(uint progress, uint total = 0,
             QString messsage = QString());
@@ -99,6 +101,7 @@ class META_PUBLIC VideoScannerThread : public MThread
     QObject *m_parent    {nullptr};
 
     bool m_listUnknown   {false};
+    bool m_watchDirs     {false};
     bool m_removeAll     {false};
     bool m_keepAll       {false};
     bool m_hasGUI        {false};
@@ -21,7 +21,7 @@
 
 #include "bytereader.h"
 
-#include <algorithm>
+#include "mpeg/tskernels.h"
 
 const uint8_t* ByteReader::find_start_code(const uint8_t * p,
                                            const uint8_t * const end,
@@ -34,35 +34,14 @@ const uint8_t* ByteReader::find_start_code(const uint8_t * p,
         return end;
     }
 
-    p += 3; // offset for negative indices in while loop
-
     /* with memory address increasing left to right, we are looking for (in hexadecimal):
      * 00 00 01 XX
-     * p points at the address which should have the value of XX
+     * where XX must be before end as well
      */
-    while (p < end)
-    {
-        if      (/* UU UU UU */ p[-1]  < 1) // equivalently p[-1] == 0
-        {
-            p++;
-            // could be in a start code, so check next byte
-        }
-        else if (/* UU UU UN */ p[-1]  > 1 ||
-                 /* UU UU 01 */ p[-2] != 0 ||
-                 /* UU 00 01 */ p[-3] != 0)
-        {
-            // start check over with 3 new bytes
-            p += 3;
-        }
-        else /* 00 00 01 */
-        {
-            p++;
-            // p now points at the address following the start code value XX
-            break;
-        }
-    }
+    const uint8_t *prefix = TSKernels::Get().m_findStartCode(p, end - 1);
+    // p now points at the address following the start code value XX, or end
+    p = (prefix == end - 1) ? end : prefix + 4;
 
-    p = std::min(p, end);
     // read the previous 4 bytes, i.e. bytes {p - 4, p - 3, p - 2, p - 1}
     *start_code = static_cast<uint32_t>(p[-4]) << 24 |
                   static_cast<uint32_t>(p[-3]) << 16 |
@@ -344,6 +344,8 @@ bool ChannelScanSM::ScanExistingTransports(uint sourceid, bool follow_nit)
     for (uint multiplex : multiplexes)
         AddToList(multiplex);
 
+    PartitionTransports();
+
     m_extendScanList = follow_nit;
     m_waitingForTables  = false;
     m_transportsScanned = 0;
@@ -491,7 +493,7 @@ void ChannelScanSM::HandleSDT(uint /*tsid*/, const ServiceDescriptionTable *sdt)
     }
 
     uint id = sdt->OriginalNetworkID() << 16 | sdt->TSID();
-    m_tsScanned.insert(id);
+    AddScannedTS(id);
 
     for (uint i = 0; !m_currentTestingDecryption && i < sdt->ServiceCount(); ++i)
     {
@@ -739,7 +741,7 @@ void ChannelScanSM::UpdateScanTransports(uint nit_frequency, const NetworkInform
         uint32_t netid = nit->OriginalNetworkID(i);
         uint32_t id    = netid << 16 | tsid;
 
-        if (m_tsScanned.contains(id) || m_extendTransports.contains(id))
+        if (IsScannedTS(id) || m_extendTransports.contains(id))
             continue;
 
         const desc_list_t& list =
@@ -1906,6 +1908,12 @@ ScanDTVTransportList ChannelScanSM::GetChannelList(bool addFullTS) const
         }
     }
 
+    for (const auto *helper : std::as_const(m_helpers))
+    {
+        ScanDTVTransportList helper_list = helper->GetChannelList(addFullTS);
+        list.insert(list.end(), helper_list.begin(), helper_list.end());
+    }
+
     return list;
 }
 
@@ -1986,6 +1994,109 @@ void ChannelScanSM::StartScanner(void)
     m_threadExit = false;
     m_scannerThread = new MThread("Scanner", this);
     m_scannerThread->start();
+
+    for (auto *helper : std::as_const(m_helpers))
+        helper->StartScanner();
+}
+
+/**
+ *  \brief Adds a scanner on another tuner of the same video source.
+ *
+ *   Full scans and scans of the existing transports are then split
+ *   between this scanner and its helpers, which all tune at the same
+ *   time. The helpers report through this scanner; their channels are
+ *   returned by GetChannelList() and scan completion waits for them.
+ *   The helper must be deleted after this scanner.
+ */
+void ChannelScanSM::AddHelper(ChannelScanSM *helper)
+{
+    QMutexLocker locker(&m_lock);
+
+    helper->m_primary          = this;
+    helper->m_scanDTVTunerType = m_scanDTVTunerType;
+    m_helpers.push_back(helper);
+
+    LOG(VB_CHANSCAN, LOG_INFO, LOC + QString("Added helper on input %1")
+        .arg(helper->m_channel->GetInputID()));
+}
+
+/**
+ *  \brief Deals the transport list out round robin between this
+ *         scanner and its helpers.
+ *
+ *   Only this scanner follows the NIT, the helpers record the transports
+ *   they have seen so they are not scanned again.
+ */
+void ChannelScanSM::PartitionTransports(void)
+{
+    if (m_helpers.empty())
+        return;
+
+    std::vector<transport_scan_items_t> parts(m_helpers.size() + 1);
+    size_t i = 0;
+    for (const auto & item : m_scanTransports)
+        parts[i++ % parts.size()].push_back(item);
+
+    m_scanTransports.swap(parts[0]);
+
+    for (i = 1; i < parts.size(); ++i)
+    {
+        ChannelScanSM *helper = m_helpers[i - 1];
+        QMutexLocker locker(&helper->m_lock);
+
+        helper->m_scanTransports.swap(parts[i]);
+        helper->m_extendScanList    = false;
+        helper->m_waitingForTables  = false;
+        helper->m_transportsScanned = 0;
+        helper->m_transportsToScan  = helper->m_scanTransports.size();
+        helper->m_timer.start();
+        helper->m_current = helper->m_scanTransports.end();
+        helper->m_nextIt  = helper->m_scanTransports.begin();
+        helper->m_scanning = !helper->m_scanTransports.empty();
+
+        LOG(VB_CHANSCAN, LOG_INFO, LOC +
+            QString("Input %1 will scan %2 transports")
+                .arg(helper->m_channel->GetInputID())
+                .arg(helper->m_scanTransports.size()));
+    }
+}
+
+bool ChannelScanSM::HelpersScanning(void) const
+{
+    return std::any_of(m_helpers.cbegin(), m_helpers.cend(),
+                       [](const ChannelScanSM *helper)
+                           { return helper->m_scanning.load(); });
+}
+
+void ChannelScanSM::AddScannedTS(uint32_t id)
+{
+    ChannelScanSM *owner = m_primary ? m_primary : this;
+    QMutexLocker locker(&owner->m_tsLock);
+    owner->m_tsScanned.insert(id);
+}
+
+bool ChannelScanSM::IsScannedTS(uint32_t id) const
+{
+    const ChannelScanSM *owner = m_primary ? m_primary : this;
+    QMutexLocker locker(&owner->m_tsLock);
+    return owner->m_tsScanned.contains(id);
+}
+
+void ChannelScanSM::UpdateScanPercentCompleted(void)
+{
+    // The helpers' progress is reported by the primary scanner
+    if (m_primary)
+        return;
+
+    int scanned = m_transportsScanned;
+    int total   = m_scanTransports.size() + m_extendTransports.size();
+    for (const auto *helper : std::as_const(m_helpers))
+    {
+        scanned += helper->m_transportsScanned;
+        total   += helper->m_transportsToScan;
+    }
+    if (total > 0)
+        m_scanMonitor->ScanPercentComplete(std::min(scanned * 100 / total, 100));
 }
 
 /** \fn ChannelScanSM::run(void)
@@ -2097,6 +2208,14 @@ void ChannelScanSM::HandleActiveScan(void)
     if (!HasTimedOut())
         return;
 
+    if (m_waitingForHelpers)
+    {
+        UpdateScanPercentCompleted();
+        if (HelpersScanning())
+            return;
+        m_waitingForHelpers = false;
+    }
+
     if (0 == m_nextIt.offset() && m_nextIt == m_scanTransports.begin())
     {
         m_channelList.clear();
@@ -2135,19 +2254,27 @@ void ChannelScanSM::HandleActiveScan(void)
         m_nextIt = m_current;
         ++m_nextIt;
     }
+    else if (HelpersScanning())
+    {
+        // Transports found in the NIT may be in the other tuners' lists,
+        // so wait for them before extending the scan.
+        LOG(VB_CHANSCAN, LOG_INFO, LOC +
+            "Transport list done, waiting for the other tuners");
+        m_waitingForHelpers = true;
+    }
     else if (!m_extendTransports.isEmpty())
     {
         --m_current;
         QMap<uint32_t,DTVMultiplex>::iterator it = m_extendTransports.begin();
         while (it != m_extendTransports.end())
         {
-            if (!m_tsScanned.contains(it.key()))
+            if (!IsScannedTS(it.key()))
             {
                 QString name = QString("TransportID %1").arg(it.key() & 0xffff);
                 TransportScanItem item(m_sourceID, name, *it, m_signalTimeout);
                 LOG(VB_CHANSCAN, LOG_INFO, LOC + "Adding " + name + ' ' + item.m_tuning.toString());
                 m_scanTransports.push_back(item);
-                m_tsScanned.insert(it.key());
+                AddScannedTS(it.key());
             }
             ++it;
         }
@@ -2157,7 +2284,15 @@ void ChannelScanSM::HandleActiveScan(void)
     }
     else
     {
-        m_scanMonitor->ScanComplete();
+        if (m_primary)
+        {
+            LOG(VB_CHANSCAN, LOG_INFO, LOC + "Transport list done");
+        }
+        else
+        {
+            m_scanMonitor->ScanPercentComplete(100);
+            m_scanMonitor->ScanComplete();
+        }
         m_scanning = false;
         m_current = m_nextIt = m_scanTransports.end();
     }
@@ -2285,6 +2420,9 @@ void ChannelScanSM::StopScanner(void)
 
     if (m_signalMonitor)
         m_signalMonitor->Stop();
+
+    for (auto *helper : std::as_const(m_helpers))
+        helper->StopScanner();
 }
 
 /**
@@ -2371,6 +2509,8 @@ bool ChannelScanSM::ScanTransports(
         tables.pop_back();
     }
 
+    PartitionTransports();
+
     m_extendScanList = true;
     m_timer.start();
     m_waitingForTables = false;
@@ -30,6 +30,9 @@
 #ifndef SISCAN_H
 #define SISCAN_H
 
+// C++ includes
+#include <atomic>
+
 // Qt includes
 #include <QElapsedTimer>
 #include <QList>
@@ -100,6 +103,7 @@ class ChannelScanSM : public MPEGStreamListener,
 
     void StartScanner(void);
     void StopScanner(void);
+    void AddHelper(ChannelScanSM *helper);
 
     bool ScanTransports(
         int SourceID, const QString &std, const QString &mod, const QString &country,
@@ -176,7 +180,13 @@ class ChannelScanSM : public MPEGStreamListener,
     static void LogLines(const QString& string);
 
     // Updates Transport Scan progress bar
-    inline void UpdateScanPercentCompleted(void);
+    void UpdateScanPercentCompleted(void);
+
+    // Splitting the scan over several tuners
+    void PartitionTransports(void);
+    bool HelpersScanning(void) const;
+    void AddScannedTS(uint32_t id);
+    bool IsScannedTS(uint32_t id) const;
 
     bool CheckImportedList(const DTVChannelInfoList &channels,
                            uint mpeg_program_num,
@@ -232,14 +242,16 @@ class ChannelScanSM : public MPEGStreamListener,
     mutable QMutex    m_lock;
 
     // State
-    bool              m_scanning          {false};
+    std::atomic<bool> m_scanning          {false};
     volatile bool     m_threadExit        {false};
     bool              m_waitingForTables  {false};
     QElapsedTimer     m_timer;
 
     // Transports List
-    int                         m_transportsScanned {0};
-    QSet<uint32_t>              m_tsScanned;
+    std::atomic<int>            m_transportsScanned {0};
+    std::atomic<int>            m_transportsToScan  {0};
+    QSet<uint32_t>              m_tsScanned;        ///< Shared with helpers
+    mutable QMutex              m_tsLock;           ///< Protects m_tsScanned
     QMap<uint32_t,DTVMultiplex> m_extendTransports;
     transport_scan_items_t      m_scanTransports;
     transport_scan_items_it_t   m_current;
@@ -261,17 +273,16 @@ class ChannelScanSM : public MPEGStreamListener,
     // Scanner thread, runs ChannelScanSM::run()
     MThread             *m_scannerThread       {nullptr};
 
+    // Other tuners on this video source scanning part of the transport
+    // list for us, or the scanner we are helping. Not owned.
+    QList<ChannelScanSM*> m_helpers;
+    ChannelScanSM       *m_primary             {nullptr};
+    bool                 m_waitingForHelpers   {false};
+
     // Protect UpdateChannelInfo
     QMutex               m_mutex;
 };
 
-inline void ChannelScanSM::UpdateScanPercentCompleted(void)
-{
-    int tmp = (m_transportsScanned * 100) /
-              (m_scanTransports.size() + m_extendTransports.size());
-    m_scanMonitor->ScanPercentComplete(tmp);
-}
-
 void AnalogSignalHandler::AllGood(void)
 {
     m_siScan->HandleAllGood();
@@ -32,6 +32,7 @@
 #include "cardutil.h"
 #include "channelscan_sm.h"
 #include "channelscanner.h"
+#include "inputinfo.h"
 #include "iptvchannelfetcher.h"
 #include "recorders/ExternalChannel.h"
 #include "recorders/analogsignalmonitor.h"
@@ -46,9 +47,20 @@
 #include "recorders/v4lchannel.h"
 #include "scanmonitor.h"
 #include "scanwizardconfig.h"
+#include "tvremoteutil.h"
 
 #define LOC QString("ChScan: ")
 
+/// \brief Returns true if the backend is using the input's tuner.
+static bool is_tuner_busy(uint inputid)
+{
+    std::vector<uint> inputids = CardUtil::GetConflictingInputs(inputid);
+    inputids.push_back(inputid);
+    InputInfo busy_input;
+    return std::any_of(inputids.cbegin(), inputids.cend(),
+        [&busy_input](uint id) { return RemoteIsBusy(id, busy_input); });
+}
+
 ChannelScanner::~ChannelScanner()
 {
     ChannelScanner::Teardown();
@@ -68,6 +80,19 @@ void ChannelScanner::Teardown(void)
         m_sigmonScanner = nullptr;
     }
 
+    // Helpers are deleted after the scanner they help
+    while (!m_helperScanners.empty())
+    {
+        delete m_helperScanners.back();
+        m_helperScanners.pop_back();
+    }
+
+    while (!m_helperChannels.empty())
+    {
+        delete m_helperChannels.back();
+        m_helperChannels.pop_back();
+    }
+
     if (m_channel)
     {
         delete m_channel;
@@ -150,6 +175,16 @@ void ChannelScanner::Scan(
         return;
     }
 
+    // Split scans of a list of transports between all the free tuners
+    if ((ScanTypeSetting::FullScan_ATSC   == scantype) ||
+        (ScanTypeSetting::FullScan_DVBC   == scantype) ||
+        (ScanTypeSetting::FullScan_DVBT   == scantype) ||
+        (ScanTypeSetting::FullScan_DVBT2  == scantype) ||
+        (ScanTypeSetting::FullTransportScan == scantype))
+    {
+        AddScanHelpers(cardid, sourceid, do_test_decryption);
+    }
+
     m_sigmonScanner->StartScanner();
     m_scanMonitor->ScanUpdateStatusText("");
 
@@ -429,6 +464,123 @@ bool ChannelScanner::ImportHDHR([[maybe_unused]] uint cardid,
 #endif
 }
 
+ChannelBase *ChannelScanner::CreateChannel(const QString &card_type,
+                                           [[maybe_unused]] const QString &device)
+{
+#ifdef USING_DVB
+    if ("DVB" == card_type)
+        return new DVBChannel(device);
+#endif
+
+#ifdef USING_V4L2
+    if (("V4L" == card_type) || ("MPEG" == card_type))
+        return new V4LChannel(nullptr, device);
+#endif
+
+#ifdef USING_HDHOMERUN
+    if ("HDHOMERUN" == card_type)
+        return new HDHRChannel(nullptr, device);
+#endif // USING_HDHOMERUN
+
+#ifdef USING_SATIP
+    if ("SATIP" == card_type)
+        return new SatIPChannel(nullptr, device);
+#endif
+
+#ifdef USING_ASI
+    if ("ASI" == card_type)
+        return new ASIChannel(nullptr, device);
+#endif // USING_ASI
+
+#ifdef USING_IPTV
+    if ("FREEBOX" == card_type)
+        return new IPTVChannel(nullptr, device);
+#endif
+
+#ifdef USING_VBOX
+    if ("VBOX" == card_type)
+        return new IPTVChannel(nullptr, device);
+#endif
+
+#if !defined( USING_MINGW ) && !defined( _MSC_VER )
+    if ("EXTERNAL" == card_type)
+        return new ExternalChannel(nullptr, device);
+#endif
+
+    return nullptr;
+}
+
+/**
+ *  \brief Opens the other tuners of the video source so a full scan can
+ *         be split between them.
+ *
+ *   Only tuners of the same type on a different device than the inputs
+ *   already in use are taken, so two inputs of one physical tuner are
+ *   never used. Tuners the backend is using are skipped, and so are
+ *   those that can't be opened.
+ */
+void ChannelScanner::AddScanHelpers(uint cardid, uint sourceid,
+                                    bool do_test_decryption)
+{
+    QString     card_type = CardUtil::GetRawInputType(cardid);
+    QStringList devices { CardUtil::GetVideoDevice(cardid) };
+
+    // Analog scanning doesn't go through the transport list
+    if (!CardUtil::IsTuningDigital(card_type))
+        return;
+
+    std::vector<uint> inputs = CardUtil::GetInputIDs(sourceid);
+    for (uint inputid : inputs)
+    {
+        if (inputid == cardid ||
+            CardUtil::GetRawInputType(inputid) != card_type)
+            continue;
+
+        QString device = CardUtil::GetVideoDevice(inputid);
+        if (device.isEmpty() || devices.contains(device))
+            continue;
+
+        // Opening a DVB device succeeds even while a recorder holds
+        // it, since the inputs of a tuner share the open device.
+        if (is_tuner_busy(inputid))
+        {
+            LOG(VB_CHANSCAN, LOG_INFO, LOC +
+                QString("Input %1 is in use, not using it to scan").arg(inputid));
+            continue;
+        }
+
+        ChannelBase *channel = CreateChannel(card_type, device);
+        if (!channel)
+            continue;
+
+        channel->SetInputID(inputid);
+        if (!channel->Open())
+        {
+            LOG(VB_CHANSCAN, LOG_INFO, LOC +
+                QString("Input %1 is busy, not using it to scan").arg(inputid));
+            delete channel;
+            continue;
+        }
+        devices.push_back(device);
+
+        auto *helper = new ChannelScanSM(
+            m_scanMonitor, card_type, channel, sourceid,
+            m_sigmonScanner->GetSignalTimeout(),
+            m_sigmonScanner->GetChannelTimeout(),
+            CardUtil::GetInputName(inputid), do_test_decryption);
+
+        m_sigmonScanner->AddHelper(helper);
+        m_helperScanners.push_back(helper);
+        m_helperChannels.push_back(channel);
+    }
+
+    if (!m_helperScanners.empty())
+    {
+        LOG(VB_CHANSCAN, LOG_INFO, LOC +
+            QString("Scanning with %1 tuners").arg(m_helperScanners.size() + 1));
+    }
+}
+
 void ChannelScanner::PreScanCommon(
     int scantype,
     uint cardid,
@@ -479,58 +631,15 @@ void ChannelScanner::PreScanCommon(
         // at least one SDT section. kDVBTableTimeout in ChannelScanSM
         // ensures that we catch the NIT then.
         channel_timeout = std::max(channel_timeout, static_cast<int>(need_nit) * 7 * 1000ms);
-
-        m_channel = new DVBChannel(device);
     }
 #endif
 
-#ifdef USING_V4L2
-    if (("V4L" == card_type) || ("MPEG" == card_type))
-        m_channel = new V4LChannel(nullptr, device);
-#endif
-
 #ifdef USING_HDHOMERUN
     if ("HDHOMERUN" == card_type)
-    {
-        m_channel = new HDHRChannel(nullptr, device);
         monitor_snr = true;
-    }
 #endif // USING_HDHOMERUN
 
-#ifdef USING_SATIP
-    if ("SATIP" == card_type)
-    {
-        m_channel = new SatIPChannel(nullptr, device);
-    }
-#endif
-
-#ifdef USING_ASI
-    if ("ASI" == card_type)
-    {
-        m_channel = new ASIChannel(nullptr, device);
-    }
-#endif // USING_ASI
-
-#ifdef USING_IPTV
-    if ("FREEBOX" == card_type)
-    {
-        m_channel = new IPTVChannel(nullptr, device);
-    }
-#endif
-
-#ifdef USING_VBOX
-    if ("VBOX" == card_type)
-    {
-        m_channel = new IPTVChannel(nullptr, device);
-    }
-#endif
-
-#if !defined( USING_MINGW ) && !defined( _MSC_VER )
-    if ("EXTERNAL" == card_type)
-    {
-        m_channel = new ExternalChannel(nullptr, device);
-    }
-#endif
+    m_channel = CreateChannel(card_type, device);
 
     if (!m_channel)
     {
@@ -30,6 +30,9 @@
 #ifndef CHANNEL_SCANNER_H
 #define CHANNEL_SCANNER_H
 
+// C++ headers
+#include <vector>
+
 // Qt headers
 #include <QCoreApplication>
 
@@ -111,6 +114,10 @@ class MTV_PUBLIC ChannelScanner
   protected:
     virtual void Teardown(void);
 
+    static ChannelBase *CreateChannel(const QString &card_type,
+                                      const QString &device);
+    void AddScanHelpers(uint cardid, uint sourceid, bool do_test_decryption);
+
     virtual void PreScanCommon(
         int scantype, uint cardid,
         const QString &inputname,
@@ -129,6 +136,9 @@ class MTV_PUBLIC ChannelScanner
 
     // Low level channel scanners
     ChannelScanSM           *m_sigmonScanner       {nullptr};
+    // Scanners on the other tuners of the source, helping m_sigmonScanner
+    std::vector<ChannelScanSM*> m_helperScanners;
+    std::vector<ChannelBase*>   m_helperChannels;
     IPTVChannelFetcher      *m_iptvScanner         {nullptr};
 
     /// imported channels
@@ -77,6 +77,8 @@ target_sources(
           tv_rec.h
           recordingquality.h
           recordingquality.cpp
+          tuningtrace.h
+          tuningtrace.cpp
           tv_rec.cpp
           # Recorder base and util classes
           recorders/recorderbase.h
@@ -107,6 +109,7 @@ target_sources(
           recorders/rtp/rtpdatapacket.h
           recorders/rtp/rtpfecpacket.h
           recorders/rtp/rtcpdatapacket.h
+          recorders/rtp/udpbatchreader.h
           recorders/cetonrtsp.cpp
           recorders/iptvchannel.cpp
           recorders/iptvrecorder.cpp
@@ -115,6 +118,7 @@ target_sources(
           recorders/streamhandler.cpp
           recorders/rtp/packetbuffer.cpp
           recorders/rtp/rtppacketbuffer.cpp
+          recorders/rtp/udpbatchreader.cpp
           # Support for HTTP TS streams
           recorders/httptsstreamhandler.h
           recorders/httptsstreamhandler.cpp
@@ -124,11 +128,13 @@ target_sources(
           recorders/HLS/HLSPlaylistWorker.h
           recorders/HLS/HLSReader.h
           recorders/HLS/HLSSegment.h
+          recorders/HLS/HLSSegmentFetcher.h
           recorders/HLS/HLSStream.h
           recorders/HLS/HLSStreamWorker.h
           recorders/HLS/HLSPlaylistWorker.cpp
           recorders/HLS/HLSReader.cpp
           recorders/HLS/HLSSegment.cpp
+          recorders/HLS/HLSSegmentFetcher.cpp
           recorders/HLS/HLSStream.cpp
           recorders/HLS/HLSStreamWorker.cpp
           # External recorder
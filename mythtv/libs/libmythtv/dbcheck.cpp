@@ -4064,6 +4064,27 @@ static bool doUpgradeTVDatabaseSchema(void)
             return false;
     }
 
+    if (dbver == "1380")
+    {
+        DBUpdates updates {
+            R"(CREATE TABLE recordedtsstats (
+              recordedid INT UNSIGNED NOT NULL,
+              pid SMALLINT UNSIGNED NOT NULL,
+              packets BIGINT UNSIGNED NOT NULL DEFAULT 0,
+              bitrate BIGINT UNSIGNED NOT NULL DEFAULT 0,
+              ccerrors BIGINT UNSIGNED NOT NULL DEFAULT 0,
+              teierrors BIGINT UNSIGNED NOT NULL DEFAULT 0,
+              scrambled BIGINT UNSIGNED NOT NULL DEFAULT 0,
+              pcrjitteravg INT UNSIGNED NOT NULL DEFAULT 0,
+              pcrjittermax INT UNSIGNED NOT NULL DEFAULT 0,
+              PRIMARY KEY (recordedid, pid)
+            ) ENGINE=MyISAM DEFAULT CHARSET=utf8;)",
+        };
+        if (!performActualUpdate("MythTV", "DBSchemaVer",
+                                 updates, "1381", dbver))
+            return false;
+    }
+
     return true;
 }
 
@@ -11,6 +11,7 @@
 #include "decoderbase.h"
 #include "mythcodeccontext.h"
 #include "mythplayer.h"
+#include "seekindexfile.h"
 
 #define LOC QString("Dec: ")
 
@@ -101,6 +102,19 @@ bool DecoderBase::PosMapFromDb(void)
     frm_pos_map_t posMap;
     frm_pos_map_t durMap;
 
+    // Prefer the seek index stored next to the recording, which avoids
+    // pulling every recordedseek row for long recordings.
+    SeekIndexFile seekIndex;
+    if (m_ringBuffer && !m_ringBuffer->IsDisc())
+        seekIndex.Load(m_ringBuffer->GetFilename());
+    auto queryPositionMap = [&](frm_pos_map_t &map, MarkTypes type)
+    {
+        if (seekIndex.IsLoaded())
+            seekIndex.Get(type, map);
+        else
+            m_playbackInfo->QueryPositionMap(map, type);
+    };
+
     if (m_ringBuffer && m_ringBuffer->IsDVD())
     {
         m_keyframeDist = 15;
@@ -131,7 +145,7 @@ bool DecoderBase::PosMapFromDb(void)
     else if ((m_positionMapType == MARK_UNSET) ||
         (m_keyframeDist == -1))
     {
-        m_playbackInfo->QueryPositionMap(posMap, MARK_GOP_BYFRAME);
+        queryPositionMap(posMap, MARK_GOP_BYFRAME);
         if (!posMap.empty())
         {
             m_positionMapType = MARK_GOP_BYFRAME;
@@ -140,7 +154,7 @@ bool DecoderBase::PosMapFromDb(void)
         }
         else
         {
-            m_playbackInfo->QueryPositionMap(posMap, MARK_GOP_START);
+            queryPositionMap(posMap, MARK_GOP_START);
             if (!posMap.empty())
             {
                 m_positionMapType = MARK_GOP_START;
@@ -153,7 +167,7 @@ bool DecoderBase::PosMapFromDb(void)
             }
             else
             {
-                m_playbackInfo->QueryPositionMap(posMap, MARK_KEYFRAME);
+                queryPositionMap(posMap, MARK_KEYFRAME);
                 if (!posMap.empty())
                 {
                     // keyframedist should be set in the fileheader so no
@@ -165,13 +179,13 @@ bool DecoderBase::PosMapFromDb(void)
     }
     else
     {
-        m_playbackInfo->QueryPositionMap(posMap, m_positionMapType);
+        queryPositionMap(posMap, m_positionMapType);
     }
 
     if (posMap.empty())
         return false; // no position map in recording
 
-    m_playbackInfo->QueryPositionMap(durMap, MARK_DURATION_MS);
+    queryPositionMap(durMap, MARK_DURATION_MS);
 
     QMutexLocker locker(&m_positionMapLock);
     m_positionMap.clear();
@@ -2,6 +2,8 @@
 
 // Std C++ headers
 #include <algorithm>
+#include <map>
+#include <vector>
 
 // MythTV includes
 #include "libmythbase/compat.h"  // for gmtime_r on windows.
@@ -79,7 +81,8 @@ bool EITHelper::EventQueueFull(void) const
  *  \brief Get events from queue and insert into DB after processing.
  *
  * Process a maximum of kChunkSize events at a time
- * to avoid clogging the machine.
+ * to avoid clogging the machine. The events are grouped per channel
+ * so that the existing programs of a channel are read only once.
  *
  *  \return Returns number of events inserted into DB.
  */
@@ -90,10 +93,8 @@ uint EITHelper::ProcessEvents(void)
     if (m_dbEvents.empty())
         return 0;
 
-    MSqlQuery query(MSqlQuery::InitCon());
-
+    std::map<uint, std::vector<DBEvent> > chanEvents;
     uint eventCount = 0;
-    uint insertCount = 0;
     for (; (eventCount < m_chunkSize) && (!m_dbEvents.empty()); eventCount++)
     {
         DBEventEIT *event = m_dbEvents.dequeue();
@@ -101,12 +102,21 @@ uint EITHelper::ProcessEvents(void)
 
         EITFixUp::Fix(*event);
 
-        insertCount += event->UpdateDB(query, 1000);
         m_maxStarttime = std::max (m_maxStarttime, event->m_starttime);
+        chanEvents[event->m_chanid].emplace_back(*event);
 
         delete event;
         m_eitListLock.lock();
     }
+    m_eitListLock.unlock();
+
+    MSqlQuery query(MSqlQuery::InitCon());
+
+    uint insertCount = 0;
+    for (const auto & [chanid, events] : chanEvents)
+        insertCount += DBEvent::UpdateDBBatch(query, chanid, events, 1000);
+
+    m_eitListLock.lock();
 
     if (!insertCount)
         return 0;
@@ -1719,6 +1719,16 @@ bool MythMediaBuffer::WriterSetBlocking(bool Lock)
     return false;
 }
 
+/** \fn MythMediaBuffer::WriterSetGroup(TFWGroup*)
+ *  \brief Calls ThreadedFileWriter::SetGroup(TFWGroup*)
+ */
+void MythMediaBuffer::WriterSetGroup(TFWGroup *Group)
+{
+    QReadLocker lock(&m_rwLock);
+    if (m_tfw)
+        m_tfw->SetGroup(Group);
+}
+
 /** \brief Tell RingBuffer if this is an old file or not.
  *
  *  Normally the RingBuffer determines that the file is old
@@ -40,6 +40,7 @@ static inline QString seek2string(int Whence)
 }
 
 class ThreadedFileWriter;
+class TFWGroup;
 class MythDVDBuffer;
 class MythBDBuffer;
 class LiveTVChain;
@@ -128,6 +129,7 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     void      Sync                 (void);
     long long WriterSeek           (long long Position, int Whence, bool HasLock = false);
     bool      WriterSetBlocking    (bool Lock = true);
+    void      WriterSetGroup       (TFWGroup *Group);
 
     virtual long long GetReadPosition   (void) const = 0;
     virtual bool      IsOpen            (void) const = 0;
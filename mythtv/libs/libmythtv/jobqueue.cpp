@@ -2252,6 +2252,11 @@ void *JobQueue::FlagCommercialsThread(void *param)
     return nullptr;
 }
 
+// Runs a commercial detection job. Caption extraction is an option of
+// this job rather than a job type of its own: with JobCommFlagCaptions
+// set, mythcommflag also writes the recording's captions and subtitles
+// in the same pass over the video when the recording is local. A custom
+// JobQueueCommFlagCommand doesn't get that option.
 void JobQueue::DoFlagCommercialsThread(int jobID)
 {
     // We can't currently commflag non-recording files w/o a ProgramInfo
@@ -2303,6 +2308,8 @@ void JobQueue::DoFlagCommercialsThread(int jobID)
         path = GetAppBinDir() + "mythcommflag";
         command = QString("%1 -j %2 --noprogress")
                           .arg(path).arg(jobID);
+        if (gCoreContext->GetBoolSetting("JobCommFlagCaptions", false))
+            command += " --captions";
         command += logPropagateArgs;
     }
     else
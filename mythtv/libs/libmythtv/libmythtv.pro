@@ -131,6 +131,7 @@ HEADERS += signalmonitorvalue.h     signalmonitorlistener.h
 HEADERS += livetvchain.h            playgroup.h
 HEADERS += channelsettings.h
 HEADERS += previewgenerator.h       previewgeneratorqueue.h
+HEADERS += trickplaygenerator.h
 HEADERS += transporteditor.h        listingsources.h
 HEADERS += restoredata.h
 HEADERS += channelgroup.h
@@ -145,6 +146,7 @@ HEADERS += io/mythopticalbuffer.h
 HEADERS += metadataimagehelper.h
 HEADERS += mythavutil.h
 HEADERS += recordingfile.h
+HEADERS += seekindexfile.h
 HEADERS += driveroption.h
 HEADERS += mythhdrvideometadata.h
 HEADERS += mythhdrtracker.h
@@ -172,6 +174,7 @@ SOURCES += signalmonitorvalue.cpp
 SOURCES += livetvchain.cpp          playgroup.cpp
 SOURCES += channelsettings.cpp
 SOURCES += previewgenerator.cpp     previewgeneratorqueue.cpp
+SOURCES += trickplaygenerator.cpp
 SOURCES += transporteditor.cpp
 SOURCES += restoredata.cpp
 SOURCES += channelgroup.cpp
@@ -187,6 +190,7 @@ SOURCES += metadataimagehelper.cpp
 SOURCES += mythframe.cpp
 SOURCES += mythavutil.cpp
 SOURCES += recordingfile.cpp
+SOURCES += seekindexfile.cpp
 SOURCES += mythhdrvideometadata.cpp
 SOURCES += mythhdrtracker.cpp
 
@@ -227,6 +231,7 @@ HEADERS += mpeg/iso6937tables.h
 HEADERS += mpeg/tsstats.h           mpeg/streamlisteners.h
 HEADERS += mpeg/H2645Parser.h mpeg/AVCParser.h mpeg/HEVCParser.h
 HEADERS += mpeg/tablestatus.h
+HEADERS += mpeg/tskernels.h
 HEADERS += mpeg/tsstreamdata.h
 
 SOURCES += mpeg/tspacket.cpp        mpeg/pespacket.cpp
@@ -244,6 +249,8 @@ SOURCES += mpeg/freesat_huffman.cpp
 SOURCES += mpeg/iso6937tables.cpp
 SOURCES += mpeg/H2645Parser.cpp mpeg/AVCParser.cpp mpeg/HEVCParser.cpp
 SOURCES += mpeg/tablestatus.cpp
+SOURCES += mpeg/tskernels.cpp
+SOURCES += mpeg/tsstats.cpp
 SOURCES += mpeg/tsstreamdata.cpp
 
 # Channels, and the multiplexes that transmit them
@@ -803,7 +810,9 @@ using_backend {
 
     # TVRec stuff
     HEADERS += tv_rec.h                    recordingquality.h
+    HEADERS += tuningtrace.h
     SOURCES += tv_rec.cpp                  recordingquality.cpp
+    SOURCES += tuningtrace.cpp
 
     # Recorder base and util classes
     HEADERS += recorders/recorderbase.h
@@ -912,6 +921,7 @@ using_backend {
     HEADERS += recorders/rtp/rtpdatapacket.h
     HEADERS += recorders/rtp/rtpfecpacket.h
     HEADERS += recorders/rtp/rtcpdatapacket.h
+    HEADERS += recorders/rtp/udpbatchreader.h
 
     SOURCES += recorders/cetonrtsp.cpp
     SOURCES += recorders/iptvchannel.cpp
@@ -922,6 +932,7 @@ using_backend {
 
     SOURCES += recorders/rtp/packetbuffer.cpp
     SOURCES += recorders/rtp/rtppacketbuffer.cpp
+    SOURCES += recorders/rtp/udpbatchreader.cpp
 
     # Support for HTTP TS streams
     HEADERS += recorders/httptsstreamhandler.h
@@ -934,12 +945,14 @@ using_backend {
     HEADERS += recorders/HLS/HLSPlaylistWorker.h
     HEADERS += recorders/HLS/HLSReader.h
     HEADERS += recorders/HLS/HLSSegment.h
+    HEADERS += recorders/HLS/HLSSegmentFetcher.h
     HEADERS += recorders/HLS/HLSStream.h
     HEADERS += recorders/HLS/HLSStreamWorker.h
 
     SOURCES += recorders/HLS/HLSPlaylistWorker.cpp
     SOURCES += recorders/HLS/HLSReader.cpp
     SOURCES += recorders/HLS/HLSSegment.cpp
+    SOURCES += recorders/HLS/HLSSegmentFetcher.cpp
     SOURCES += recorders/HLS/HLSStream.cpp
     SOURCES += recorders/HLS/HLSStreamWorker.cpp
 
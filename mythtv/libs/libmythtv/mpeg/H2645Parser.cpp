@@ -6,7 +6,9 @@
 #include "recorders/dtvrecorder.h" // for FrameRate and ScanType
 #include "bitreader.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <strings.h>
 
 /*
@@ -137,7 +139,9 @@ bool H2645Parser::fillRBSP(const uint8_t *byteP, uint32_t byte_count,
     uint32_t required_size = m_rbspIndex + byte_count;
     if (m_rbspBufferSize < required_size)
     {
-        // Round up to packet size
+        // Round up to packet size, and at least double the size so
+        // that long NALs aren't copied over and over
+        required_size = std::max(required_size, m_rbspBufferSize * 2);
         required_size = ((required_size / 188) + 1) * 188;
 
         /* Need a bigger buffer */
@@ -169,20 +173,34 @@ bool H2645Parser::fillRBSP(const uint8_t *byteP, uint32_t byte_count,
 
 
     /* Fill rbsp while we have data */
-    while (byte_count)
+    const uint8_t *endP = byteP + byte_count;
+    while (byteP < endP)
     {
         /* Copy the byte into the rbsp, unless it
          * is the 0x03 in a 0x000003 */
-        if (m_consecutiveZeros < 2 || *byteP != 0x03)
-            m_rbspBuffer[m_rbspIndex++] = *byteP;
-
         if (*byteP == 0)
+        {
+            m_rbspBuffer[m_rbspIndex++] = 0;
             ++m_consecutiveZeros;
-        else
+            ++byteP;
+            continue;
+        }
+
+        if (m_consecutiveZeros >= 2 && *byteP == 0x03)
+        {
             m_consecutiveZeros = 0;
+            ++byteP;
+            continue;
+        }
 
-        ++byteP;
-        --byte_count;
+        /* Nothing up to the next zero byte needs to be removed */
+        const auto *zeroP = static_cast<const uint8_t *>(
+            memchr(byteP, 0, endP - byteP));
+        const uint8_t *runEndP = zeroP ? zeroP : endP;
+        memcpy(m_rbspBuffer + m_rbspIndex, byteP, runEndP - byteP);
+        m_rbspIndex += runEndP - byteP;
+        m_consecutiveZeros = 0;
+        byteP = runEndP;
     }
 
     /* If we've found the next start code then that, plus the first byte of
@@ -462,8 +462,15 @@ void HEVCParser::processRBSP(bool rbsp_complete)
         m_nalUnitType == VPS_NUT ||
         NALisVCL(m_nalUnitType))
     {
-        /* Best wait until we have the whole thing */
-        if (!rbsp_complete)
+        /* Parsed already, the rest of the NAL is not needed */
+        if (!m_haveUnfinishedNAL)
+            return;
+
+        /* Best wait until we have the whole parameter set. Only the
+         * slice segment header is needed, so don't copy whole pictures
+         * into the rbsp buffer. */
+        if (!rbsp_complete &&
+            (!NALisVCL(m_nalUnitType) || m_rbspIndex < kMaxSliceHeaderSize))
             return;
 
         if (!m_seenSPS)
@@ -12,6 +12,7 @@
 // MythTV headers
 #include "mpegstreamdata.h"
 #include "mpegtables.h"
+#include "tskernels.h"
 
 #include "atscstreamdata.h"
 #include "atsctables.h"
@@ -961,9 +962,20 @@ int MPEGStreamData::ProcessData(const unsigned char *buffer, int len)
         return 0;
     }
 
+    // Packets from pos on known to start with a sync byte
+    const TSKernels &kernels = TSKernels::Get();
+    size_t synced = 0;
+
     while (pos + int(TSPacket::kSize) <= len)
     { // while we have a whole packet left...
-        if (buffer[pos] != SYNC_BYTE || resync)
+        if (!synced && !resync)
+        {
+            synced = kernels.m_scanPackets(&buffer[pos],
+                                           (len - pos) / TSPacket::kSize,
+                                           nullptr);
+        }
+
+        if (!synced || resync)
         {
             int newpos = ResyncStream(buffer, pos+1, len);
             LOG(VB_RECORD, LOG_DEBUG, LOC +
@@ -974,11 +986,14 @@ int MPEGStreamData::ProcessData(const unsigned char *buffer, int len)
             if (newpos == -2)
                 return TSPacket::kSize;
             pos = newpos;
+            synced = 1;
         }
 
         const auto *pkt = reinterpret_cast<const TSPacket*>(&buffer[pos]);
         pos += TSPacket::kSize; // Advance to next TS packet
+        synced--;
         resync = false;
+        m_tsStats.AddPacket(*pkt);
         if (!ProcessTSPacket(*pkt))
         {
             if (pos + int(TSPacket::kSize) > len)
@@ -1087,15 +1102,12 @@ int MPEGStreamData::ResyncStream(const unsigned char *buffer, int curr_pos,
     if (nextpos >= len)
         return -1; // not enough bytes; caller should try again
 
-    while (buffer[pos] != SYNC_BYTE || buffer[nextpos] != SYNC_BYTE)
-    {
-        pos++;
-        nextpos++;
-        if (nextpos == len)
-            return -2; // not found
-    }
+    const unsigned char *end = buffer + len;
+    const unsigned char *found = TSKernels::Get().m_findSync(buffer + pos, end);
+    if (found == end)
+        return -2; // not found
 
-    return pos;
+    return static_cast<int>(found - buffer);
 }
 
 bool MPEGStreamData::IsConditionalAccessPID(uint pid) const
@@ -17,6 +17,7 @@
 #include "streamlisteners.h"
 #include "tablestatus.h"
 #include "tspacket.h"
+#include "tsstats.h"
 
 class EITHelper;
 class PSIPTable;
@@ -116,6 +117,10 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     virtual int  ProcessData(const unsigned char *buffer, int len);
     inline  void HandleAdaptationFieldControl(const TSPacket* tspacket);
 
+    // Per PID statistics
+    TSStats &GetTSStats(void) { return m_tsStats; }
+    const TSStats &GetTSStats(void) const { return m_tsStats; }
+
     // Listening
     virtual void AddListeningPID(
         uint pid, PIDPriority priority = kPIDPriorityNormal)
@@ -350,6 +355,9 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     // PSIP construction
     pid_psip_map_t            m_partialPsipPacketCache;
 
+    // Statistics on every packet passed to ProcessData()
+    TSStats                   m_tsStats;
+
     // Caching
     bool                             m_cacheTables;
     mutable QRecursiveMutex          m_cacheLock;
@@ -0,0 +1,304 @@
+#include "tskernels.h"
+
+#include <QtGlobal>
+
+#include "libmythbase/mythconfig.h"
+#include "libmythbase/mythlogging.h"
+
+extern "C" {
+#include "libavutil/cpu.h"
+}
+
+#if defined(Q_PROCESSOR_X86)
+#   include <immintrin.h>
+#   if defined(__GNUC__) || defined(__clang__)
+#       define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#   else
+#       define KERNEL_TARGET(isa)
+#   endif
+#   define HAVE_KERNELS_X86 1
+#elif defined(Q_PROCESSOR_ARM_64) && HAVE_INTRINSICS_NEON
+#   include <arm_neon.h>
+#   define HAVE_KERNELS_NEON 1
+#endif
+
+#define LOC QString("TSKernels: ")
+
+static constexpr uint8_t  kSyncByte   { 0x47 };
+static constexpr ptrdiff_t kPacketSize { 188 };
+
+// The C kernels are the reference, the SIMD ones finish off with them.
+
+static const uint8_t *c_findSync(const uint8_t *p, const uint8_t *end)
+{
+    for (; end - p > kPacketSize; p++)
+    {
+        if (p[0] == kSyncByte && p[kPacketSize] == kSyncByte)
+            return p;
+    }
+    return end;
+}
+
+static size_t c_scanPackets(const uint8_t *buf, size_t count, uint16_t *pids)
+{
+    size_t i = 0;
+    for (; i < count; i++, buf += kPacketSize)
+    {
+        if (buf[0] != kSyncByte)
+            break;
+        if (pids)
+            pids[i] = static_cast<uint16_t>(((buf[1] & 0x1f) << 8) | buf[2]);
+    }
+    return i;
+}
+
+static const uint8_t *c_findStartCode(const uint8_t *p, const uint8_t *end)
+{
+    if (end - p < 3)
+        return end;
+
+    // q is the last byte of a possible prefix. A byte above 1 can't be any
+    // part of one, nor can a 1 that doesn't end one, so skip past it.
+    for (const uint8_t *q = p + 2; q < end; )
+    {
+        if (*q > 1)
+            q += 3;
+        else if (*q == 0)
+            q++;
+        else if (q[-1] == 0 && q[-2] == 0)
+            return q - 2;
+        else
+            q += 3;
+    }
+    return end;
+}
+
+static const TSKernels s_cKernels
+{
+    "C",
+    c_findSync, c_scanPackets, c_findStartCode
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+static inline int first_bit(uint64_t mask) { return __builtin_ctzll(mask); }
+#else
+static inline int first_bit(uint64_t mask)
+{
+    int n = 0;
+    for (; !(mask & 1); mask >>= 1)
+        n++;
+    return n;
+}
+#endif
+
+#if HAVE_KERNELS_X86
+/*
+ * SSE2
+ *
+ * There is no gather, so scanPackets uses the C kernel.
+ */
+
+KERNEL_TARGET("sse2")
+static const uint8_t *sse2_findSync(const uint8_t *p, const uint8_t *end)
+{
+    const __m128i sync = _mm_set1_epi8(static_cast<char>(kSyncByte));
+    for (; end - p >= kPacketSize + 16; p += 16)
+    {
+        __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), sync);
+        __m128i b = _mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + kPacketSize)), sync);
+        int mask = _mm_movemask_epi8(_mm_and_si128(a, b));
+        if (mask)
+            return p + first_bit(static_cast<uint32_t>(mask));
+    }
+    return c_findSync(p, end);
+}
+
+KERNEL_TARGET("sse2")
+static const uint8_t *sse2_findStartCode(const uint8_t *p, const uint8_t *end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one  = _mm_set1_epi8(1);
+    for (; end - p >= 16 + 2; p += 16)
+    {
+        // Most blocks have no 01 byte in them at all
+        __m128i c = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2)), one);
+        if (!_mm_movemask_epi8(c))
+            continue;
+        __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), zero);
+        __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1)), zero);
+        int mask = _mm_movemask_epi8(_mm_and_si128(_mm_and_si128(a, b), c));
+        if (mask)
+            return p + first_bit(static_cast<uint32_t>(mask));
+    }
+    return c_findStartCode(p, end);
+}
+
+static const TSKernels s_sse2Kernels
+{
+    "SSE2",
+    sse2_findSync, c_scanPackets, sse2_findStartCode
+};
+
+/*
+ * AVX2
+ */
+
+KERNEL_TARGET("avx2")
+static const uint8_t *avx2_findSync(const uint8_t *p, const uint8_t *end)
+{
+    const __m256i sync = _mm256_set1_epi8(static_cast<char>(kSyncByte));
+    for (; end - p >= kPacketSize + 32; p += 32)
+    {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), sync);
+        __m256i b = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + kPacketSize)), sync);
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(a, b)));
+        if (mask)
+            return p + first_bit(mask);
+    }
+    return sse2_findSync(p, end);
+}
+
+KERNEL_TARGET("avx2")
+static size_t avx2_scanPackets(const uint8_t *buf, size_t count, uint16_t *pids)
+{
+    // The first four bytes of eight packets at a time
+    const __m256i offsets = _mm256_setr_epi32(0, 188, 2 * 188, 3 * 188, 4 * 188,
+                                              5 * 188, 6 * 188, 7 * 188);
+    const __m256i byte   = _mm256_set1_epi32(0xff);
+    const __m256i sync   = _mm256_set1_epi32(kSyncByte);
+    const __m256i pidHi  = _mm256_set1_epi32(0x1f00);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8, buf += 8 * kPacketSize)
+    {
+        __m256i hdr = _mm256_i32gather_epi32(reinterpret_cast<const int*>(buf), offsets, 1);
+        __m256i ok = _mm256_cmpeq_epi32(_mm256_and_si256(hdr, byte), sync);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(ok));
+
+        if (pids)
+        {
+            // The low 5 bits of byte 1, then byte 2
+            __m256i pid = _mm256_or_si256(
+                _mm256_and_si256(hdr, pidHi),
+                _mm256_and_si256(_mm256_srli_epi32(hdr, 16), byte));
+            __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(pid),
+                                              _mm256_extracti128_si256(pid, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pids + i), packed);
+        }
+
+        if (mask != 0xff)
+            return i + first_bit(static_cast<uint32_t>(~mask));
+    }
+    return i + c_scanPackets(buf, count - i, pids ? pids + i : nullptr);
+}
+
+KERNEL_TARGET("avx2")
+static const uint8_t *avx2_findStartCode(const uint8_t *p, const uint8_t *end)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one  = _mm256_set1_epi8(1);
+    for (; end - p >= 32 + 2; p += 32)
+    {
+        __m256i c = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 2)), one);
+        if (!_mm256_movemask_epi8(c))
+            continue;
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), zero);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1)), zero);
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_and_si256(a, b), c)));
+        if (mask)
+            return p + first_bit(mask);
+    }
+    return sse2_findStartCode(p, end);
+}
+
+static const TSKernels s_avx2Kernels
+{
+    "AVX2",
+    avx2_findSync, avx2_scanPackets, avx2_findStartCode
+};
+#endif // HAVE_KERNELS_X86
+
+#if HAVE_KERNELS_NEON
+/*
+ * NEON
+ *
+ * There is no movemask, narrowing the compare result leaves four bits per
+ * byte in a 64 bit value instead. There is no gather either, so
+ * scanPackets uses the C kernel.
+ */
+
+static inline uint64_t neon_mask(uint8x16_t cmp)
+{
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+static const uint8_t *neon_findSync(const uint8_t *p, const uint8_t *end)
+{
+    const uint8x16_t sync = vdupq_n_u8(kSyncByte);
+    for (; end - p >= kPacketSize + 16; p += 16)
+    {
+        uint8x16_t a = vceqq_u8(vld1q_u8(p), sync);
+        uint8x16_t b = vceqq_u8(vld1q_u8(p + kPacketSize), sync);
+        uint64_t mask = neon_mask(vandq_u8(a, b));
+        if (mask)
+            return p + (first_bit(mask) >> 2);
+    }
+    return c_findSync(p, end);
+}
+
+static const uint8_t *neon_findStartCode(const uint8_t *p, const uint8_t *end)
+{
+    const uint8x16_t zero = vdupq_n_u8(0);
+    const uint8x16_t one  = vdupq_n_u8(1);
+    for (; end - p >= 16 + 2; p += 16)
+    {
+        uint8x16_t c = vceqq_u8(vld1q_u8(p + 2), one);
+        if (!vmaxvq_u8(c))
+            continue;
+        uint8x16_t a = vceqq_u8(vld1q_u8(p), zero);
+        uint8x16_t b = vceqq_u8(vld1q_u8(p + 1), zero);
+        uint64_t mask = neon_mask(vandq_u8(vandq_u8(a, b), c));
+        if (mask)
+            return p + (first_bit(mask) >> 2);
+    }
+    return c_findStartCode(p, end);
+}
+
+static const TSKernels s_neonKernels
+{
+    "NEON",
+    neon_findSync, c_scanPackets, neon_findStartCode
+};
+#endif // HAVE_KERNELS_NEON
+
+std::vector<const TSKernels*> TSKernels::Available(void)
+{
+    std::vector<const TSKernels*> kernels { &s_cKernels };
+    [[maybe_unused]] int flags = av_get_cpu_flags();
+#if HAVE_KERNELS_X86
+    if (flags & AV_CPU_FLAG_SSE2)
+        kernels.push_back(&s_sse2Kernels);
+    if (flags & AV_CPU_FLAG_AVX2)
+        kernels.push_back(&s_avx2Kernels);
+#elif HAVE_KERNELS_NEON
+    if (flags & AV_CPU_FLAG_NEON)
+        kernels.push_back(&s_neonKernels);
+#endif
+    return kernels;
+}
+
+const TSKernels &TSKernels::Get(void)
+{
+    static const TSKernels &s_kernels = []() -> const TSKernels &
+    {
+        const TSKernels *best = Available().back();
+        LOG(VB_RECORD, LOG_INFO, LOC + QString("Using %1 kernels")
+            .arg(best->m_name));
+        return *best;
+    }();
+    return s_kernels;
+}
@@ -0,0 +1,43 @@
+// -*- Mode: c++ -*-
+#ifndef TSKERNELS_H
+#define TSKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "libmythtv/mythtvexp.h"
+
+/** \struct TSKernels
+ *  \brief The byte scanning loops of transport stream and elementary
+ *         stream parsing.
+ *
+ *  There is a plain C version of every routine and, depending on the
+ *  processor, SSE2, AVX2 or NEON versions. The best set the CPU supports
+ *  is picked the first time Get() is called. All versions return the
+ *  same results.
+ *
+ *  \sa ByteReader::find_start_code(), MPEGStreamData::ProcessData()
+ */
+struct MTV_PUBLIC TSKernels
+{
+    const char *m_name;
+
+    /// Returns the first \a p such that both \a p and \a p + 188 hold a
+    /// sync byte and \a p + 188 < \a end, or \a end if there is none.
+    const uint8_t *(*m_findSync)(const uint8_t *p, const uint8_t *end);
+
+    /// Returns the number of packets, of the \a count packets starting at
+    /// \a buf, before the first one that does not start with a sync byte.
+    /// When \a pids isn't null the PIDs of those packets are stored in it.
+    size_t (*m_scanPackets)(const uint8_t *buf, size_t count, uint16_t *pids);
+
+    /// Returns the first \a p such that \a p holds <tt>00 00 01</tt> and
+    /// \a p + 3 <= \a end, or \a end if there is none.
+    const uint8_t *(*m_findStartCode)(const uint8_t *p, const uint8_t *end);
+
+    static const TSKernels &Get(void);
+    static std::vector<const TSKernels*> Available(void);
+};
+
+#endif // TSKERNELS_H
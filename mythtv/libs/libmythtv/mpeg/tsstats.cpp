@@ -0,0 +1,295 @@
+// -*- Mode: c++ -*-
+
+// C++ headers
+#include <algorithm>
+#include <cstdlib>
+
+// MythTV headers
+#include "libmythbase/mythdb.h"
+#include "libmythbase/mythdbcon.h"
+
+#include "tspacket.h"
+#include "tsstats.h"
+
+/// Packets between checks of whether a new snapshot is due
+static constexpr uint kCheckPackets { 1024 };
+
+/// The PCR wraps around after 2^33 ticks of the 90kHz base clock
+static constexpr int64_t kPCRWrap { (1LL << 33) * 300 };
+
+/// PCRs further apart than this are treated as a discontinuity. ISO
+/// 13818-1 allows 100ms, the rest leaves room for a few lost PCRs.
+static constexpr int64_t kMaxPCRGap { 27'000'000 };
+
+TSStats::TSStats(void)
+  : m_windowStart(Clock::now())
+{
+    m_pids.reserve(64);
+}
+
+TSStats::PIDState &TSStats::GetState(uint pid)
+{
+    uint slot = m_slots[pid];
+    if (slot)
+        return m_pids[slot - 1];
+
+    m_pids.emplace_back();
+    m_pids.back().m_pid = pid;
+    m_slots[pid] = static_cast<uint16_t>(m_pids.size());
+    return m_pids.back();
+}
+
+/// \brief Adds one packet to the statistics of its PID.
+void TSStats::AddPacket(const TSPacket &packet)
+{
+    QMutexLocker locker(&m_lock);
+
+    PIDState &state = GetState(packet.PID());
+
+    if (state.m_packets++ == 0)
+        state.m_firstPacket = Clock::now();
+
+    if (packet.ScramblingControl())
+        state.m_scrambled++;
+
+    if (packet.TransportError())
+    {
+        // The rest of the header can't be trusted, so don't check the
+        // continuity counter of the next packet against this one.
+        state.m_teiErrors++;
+        state.m_lastCC = 0xFF;
+    }
+    else
+    {
+        // The null PID has no continuity counter
+        if (state.m_pid != 0x1fff)
+        {
+            uint cc = packet.ContinuityCounter();
+            if ((state.m_lastCC != 0xFF) && !packet.GetDiscontinuityIndicator())
+            {
+                // The counter only advances on packets with a payload,
+                // and a packet may be sent twice.
+                uint expected = packet.HasPayload() ?
+                    ((state.m_lastCC + 1) & 0xf) : state.m_lastCC;
+                if ((cc != expected) && (cc != state.m_lastCC))
+                    state.m_ccErrors++;
+            }
+            state.m_lastCC = cc;
+        }
+
+        if (packet.HasPCR())
+        {
+            if (packet.GetDiscontinuityIndicator())
+                state.m_lastPcr = -1;
+            AddPCR(state, packet.GetPCRraw());
+        }
+    }
+
+    if (++m_sinceCheck >= kCheckPackets)
+    {
+        m_sinceCheck = 0;
+        if (Clock::now() - m_windowStart >= kPublishInterval)
+            PublishLocked();
+    }
+}
+
+void TSStats::AddPCR(PIDState &state, int64_t pcr)
+{
+    Clock::time_point now = Clock::now();
+    state.m_pcrCount++;
+
+    if (state.m_lastPcr >= 0)
+    {
+        int64_t pcrDelta = pcr - state.m_lastPcr;
+        if (pcrDelta < 0)
+            pcrDelta += kPCRWrap;
+
+        if (pcrDelta <= kMaxPCRGap)
+        {
+            auto arrival = std::chrono::duration_cast<std::chrono::microseconds>(
+                now - state.m_lastPcrArrival);
+            auto jitter = static_cast<uint64_t>(
+                std::llabs(arrival.count() - (pcrDelta / 27)));
+            state.m_jitterCount++;
+            state.m_jitterSumUs += jitter;
+            state.m_jitterMaxUs = std::max(state.m_jitterMaxUs, jitter);
+        }
+    }
+
+    state.m_lastPcr = pcr;
+    state.m_lastPcrArrival = now;
+}
+
+/** \brief Makes the statistics gathered so far available to GetSnapshot(),
+ *         and starts a new bitrate measurement interval.
+ *
+ *   This is called by AddPacket() every kPublishInterval, and should be
+ *   called once more when the stream ends.
+ */
+void TSStats::Publish(void)
+{
+    QMutexLocker locker(&m_lock);
+    PublishLocked();
+}
+
+/// \brief Publish(), with m_lock already held.
+void TSStats::PublishLocked(void)
+{
+    Clock::time_point now = Clock::now();
+    auto toBitrate = [](uint64_t packets, Clock::duration elapsed) -> uint64_t
+    {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        if (us <= 0us)
+            return 0;
+        return packets * TSPacket::kSize * 8 * 1000000 / us.count();
+    };
+
+    m_published.clear();
+    for (auto & state : m_pids)
+    {
+        uint64_t windowPackets = state.m_packets - state.m_windowStart;
+        state.m_windowStart = state.m_packets;
+        if (!state.m_packets)
+            continue;
+
+        PIDStats stats;
+        stats.m_pid        = state.m_pid;
+        stats.m_packets    = state.m_packets;
+        stats.m_ccErrors   = state.m_ccErrors;
+        stats.m_teiErrors  = state.m_teiErrors;
+        stats.m_scrambled  = state.m_scrambled;
+        stats.m_pcrCount   = state.m_pcrCount;
+        stats.m_bitrate    = toBitrate(windowPackets, now - m_windowStart);
+        stats.m_avgBitrate = toBitrate(state.m_packets, now - state.m_firstPacket);
+        if (state.m_jitterCount)
+        {
+            stats.m_pcrJitterAvg = std::chrono::microseconds(
+                state.m_jitterSumUs / state.m_jitterCount);
+            stats.m_pcrJitterMax = std::chrono::microseconds(state.m_jitterMaxUs);
+        }
+        m_published.push_back(stats);
+    }
+
+    m_windowStart = now;
+}
+
+/// \brief Clears the statistics, keeping the PIDs seen so far.
+void TSStats::Reset(void)
+{
+    QMutexLocker locker(&m_lock);
+
+    for (auto & state : m_pids)
+    {
+        uint pid = state.m_pid;
+        state = PIDState();
+        state.m_pid = pid;
+    }
+    m_published.clear();
+    m_sinceCheck = 0;
+    m_windowStart = Clock::now();
+}
+
+/// \brief Returns the PIDs seen, as of the last Publish().
+TSStats::PIDStatsList TSStats::GetSnapshot(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_published;
+}
+
+QString TSStats::PIDStats::toStringXML(void) const
+{
+    return QString(R"(<PID pid="0x%1" packets="%2" bitrate="%3" )"
+                   R"(cc_errors="%4" tei_errors="%5" scrambled_ratio="%6" )"
+                   R"(pcr_jitter_avg_us="%7" pcr_jitter_max_us="%8" />)")
+        .arg(m_pid, 4, 16, QChar('0'))
+        .arg(m_packets).arg(m_avgBitrate)
+        .arg(m_ccErrors).arg(m_teiErrors)
+        .arg(ScrambledRatio(), 0, 'f', 4)
+        .arg(m_pcrJitterAvg.count()).arg(m_pcrJitterMax.count());
+}
+
+/** \brief Replaces the saved statistics of a recording.
+ *
+ *   The bitrate saved is the average over the whole recording.
+ */
+bool TSStats::SaveSummary(uint recordedid, const PIDStatsList &stats)
+{
+    if (!recordedid)
+        return false;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("DELETE FROM recordedtsstats "
+                  "WHERE recordedid = :RECORDEDID");
+    query.bindValue(":RECORDEDID", recordedid);
+    if (!query.exec())
+    {
+        MythDB::DBError("TSStats::SaveSummary delete", query);
+        return false;
+    }
+
+    query.prepare("INSERT INTO recordedtsstats "
+                  " ( recordedid,  pid,  packets,  bitrate,  ccerrors, "
+                  "   teierrors,  scrambled,  pcrjitteravg,  pcrjittermax) "
+                  "VALUES "
+                  " (:RECORDEDID, :PID, :PACKETS, :BITRATE, :CCERRORS, "
+                  "  :TEIERRORS, :SCRAMBLED, :PCRJITTERAVG, :PCRJITTERMAX)");
+    for (const auto & pid : stats)
+    {
+        query.bindValue(":RECORDEDID",   recordedid);
+        query.bindValue(":PID",          pid.m_pid);
+        query.bindValue(":PACKETS",      static_cast<qulonglong>(pid.m_packets));
+        query.bindValue(":BITRATE",      static_cast<qulonglong>(pid.m_avgBitrate));
+        query.bindValue(":CCERRORS",     static_cast<qulonglong>(pid.m_ccErrors));
+        query.bindValue(":TEIERRORS",    static_cast<qulonglong>(pid.m_teiErrors));
+        query.bindValue(":SCRAMBLED",    static_cast<qulonglong>(pid.m_scrambled));
+        query.bindValue(":PCRJITTERAVG", static_cast<qlonglong>(pid.m_pcrJitterAvg.count()));
+        query.bindValue(":PCRJITTERMAX", static_cast<qlonglong>(pid.m_pcrJitterMax.count()));
+        if (!query.exec())
+        {
+            MythDB::DBError("TSStats::SaveSummary insert", query);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/** \brief Returns the statistics saved for a recording.
+ *
+ *   Both bitrates are set to the average over the whole recording, and
+ *   the PCR count is not saved.
+ */
+TSStats::PIDStatsList TSStats::LoadSummary(uint recordedid)
+{
+    PIDStatsList stats;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("SELECT pid, packets, bitrate, ccerrors, teierrors, "
+                  "       scrambled, pcrjitteravg, pcrjittermax "
+                  "FROM recordedtsstats "
+                  "WHERE recordedid = :RECORDEDID "
+                  "ORDER BY pid");
+    query.bindValue(":RECORDEDID", recordedid);
+    if (!query.exec())
+    {
+        MythDB::DBError("TSStats::LoadSummary", query);
+        return stats;
+    }
+
+    while (query.next())
+    {
+        PIDStats pid;
+        pid.m_pid          = query.value(0).toUInt();
+        pid.m_packets      = query.value(1).toULongLong();
+        pid.m_avgBitrate   = query.value(2).toULongLong();
+        pid.m_bitrate      = pid.m_avgBitrate;
+        pid.m_ccErrors     = query.value(3).toULongLong();
+        pid.m_teiErrors    = query.value(4).toULongLong();
+        pid.m_scrambled    = query.value(5).toULongLong();
+        pid.m_pcrJitterAvg = std::chrono::microseconds(query.value(6).toLongLong());
+        pid.m_pcrJitterMax = std::chrono::microseconds(query.value(7).toLongLong());
+        stats.push_back(pid);
+    }
+
+    return stats;
+}
@@ -1,38 +1,112 @@
 // -*- Mode: c++ -*-
 // This file, "tsstats.h" is in the public domain, written by Daniel Kristjansson, 2004 CE
-#ifndef __TS_STATS__
-#define __TS_STATS__
+#ifndef TS_STATS_H
+#define TS_STATS_H
 
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <QMutex>
 #include <QString>
-#include <QMap>
+
+#include "libmythbase/mythchrono.h"
+#include "libmythtv/mythtvexp.h"
+
+class TSPacket;
 
 /** \class TSStats
- *  \brief Collects statistics on the number of TSPacket's seen on each PID.
+ *  \brief Collects per PID statistics on a transport stream.
+ *
+ *   For every PID this counts packets, continuity counter errors,
+ *   packets with the transport error indicator set and scrambled
+ *   packets, and measures the bitrate and the PCR jitter. The work
+ *   done for each packet is constant.
  *
- *  \sa TSPacket, HDTVRecorder
+ *   AddPacket() is called by the thread reading the stream, while the
+ *   recorder calls Reset() and Publish() from its own thread, so the
+ *   per PID state is guarded by a mutex. It is only ever contended
+ *   when a recording starts or finishes. Every kPublishInterval
+ *   AddPacket() publishes a snapshot that GetSnapshot() can read from
+ *   any thread.
+ *
+ *   The PCR jitter is the difference between the time elapsed between
+ *   two PCRs and the time between the arrival of the packets carrying
+ *   them. It includes any burstiness in how the driver or network
+ *   delivers packets, which is what matters when hunting for
+ *   reception problems.
+ *
+ *  \sa TSPacket, DTVRecorder
  */
-class TSStats
+class MTV_PUBLIC TSStats
 {
   public:
-    TSStats() : _tspacket_count(0) { ; }
-    void IncrPIDCount(int pid)  { _pid_counts[pid]++;  }
-    void IncrTSPacketCount() { _tspacket_count++; }
-    long long TSPacketCount() { return _tspacket_count; }
-    void Reset() { _tspacket_count = 0; _pid_counts.clear(); }
-    inline QString toString();
+    static constexpr std::chrono::milliseconds kPublishInterval { 1s };
+
+    struct PIDStats
+    {
+        uint     m_pid          {0};
+        uint64_t m_packets      {0};
+        uint64_t m_ccErrors     {0};
+        uint64_t m_teiErrors    {0};
+        uint64_t m_scrambled    {0};
+        uint64_t m_pcrCount     {0};
+        /// Bitrate over the last publish interval, in bits per second
+        uint64_t m_bitrate      {0};
+        /// Bitrate since the statistics were reset, in bits per second
+        uint64_t m_avgBitrate   {0};
+        std::chrono::microseconds m_pcrJitterAvg {0us};
+        std::chrono::microseconds m_pcrJitterMax {0us};
+
+        double ScrambledRatio(void) const
+            { return m_packets ? double(m_scrambled) / m_packets : 0.0; }
+        QString toStringXML(void) const;
+    };
+    using PIDStatsList = std::vector<PIDStats>;
+
+    TSStats(void);
+
+    void AddPacket(const TSPacket &packet);
+    void Publish(void);
+    void Reset(void);
+
+    PIDStatsList GetSnapshot(void) const;
+
+    static bool SaveSummary(uint recordedid, const PIDStatsList &stats);
+    static PIDStatsList LoadSummary(uint recordedid);
+
   private:
-    long long _tspacket_count;
-    QMap<int, long long> _pid_counts;
+    using Clock = std::chrono::steady_clock;
+
+    struct PIDState
+    {
+        uint     m_pid          {0};
+        uint8_t  m_lastCC       {0xFF};
+        uint64_t m_packets      {0};
+        Clock::time_point m_firstPacket;
+        uint64_t m_windowStart  {0};
+        uint64_t m_ccErrors     {0};
+        uint64_t m_teiErrors    {0};
+        uint64_t m_scrambled    {0};
+        int64_t  m_lastPcr      {-1};
+        Clock::time_point m_lastPcrArrival;
+        uint64_t m_pcrCount     {0};
+        uint64_t m_jitterCount  {0};
+        uint64_t m_jitterSumUs  {0};
+        uint64_t m_jitterMaxUs  {0};
+    };
+
+    PIDState &GetState(uint pid);
+    void AddPCR(PIDState &state, int64_t pcr);
+    void PublishLocked(void);
+
+    mutable QMutex                 m_lock;
+    std::array<uint16_t,0x1fff + 1> m_slots       {0}; // protected by m_lock
+    std::vector<PIDState>          m_pids;            // protected by m_lock
+    uint                           m_sinceCheck  {0}; // protected by m_lock
+    Clock::time_point              m_windowStart;     // protected by m_lock
+    PIDStatsList                   m_published;       // protected by m_lock
 };
 
-inline QString TSStats::toString() {
-    QString str("Transport Stream Statistics\n");
-    str.append(QString("TSPacket Count: %1").arg((long)_tspacket_count));
-    QMapIterator<int, long long> it = _pid_counts.begin();
-    for (; it != _pid_counts.end(); it++)
-        str.append(QString("\nPID 0x%1 Count: %2").
-                   arg((int)it.key(),0,16).arg((long)it.data(),10,10));
-    return str;
-}
-
-#endif // __TS_STATS__
+#endif // TS_STATS_H
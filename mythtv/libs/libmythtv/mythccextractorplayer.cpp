@@ -47,28 +47,97 @@ CC708Stuff::~CC708Stuff() { delete m_reader; }
 TeletextStuff::~TeletextStuff() { delete m_reader; }
 DVBSubStuff::~DVBSubStuff() { delete m_reader; }
 
-MythCCExtractorPlayer::MythCCExtractorPlayer(PlayerContext *Context, PlayerFlags flags, bool showProgress,
-                                             QString fileName,
-                                             const QString &destdir) :
-    MythPlayer(Context, flags),
-    m_showProgress(showProgress),
-    m_fileName(std::move(fileName))
+MythCCExtractor::MythCCExtractor(MythPlayer *Player, const QString &FileName,
+                                 const QString &DestDir) :
+    m_player(Player)
 {
     // Determine where we will put extracted info.
-    QStringList comps = QFileInfo(m_fileName).fileName().split(".");
+    QStringList comps = QFileInfo(FileName).fileName().split(".");
     if (!comps.empty())
         comps.removeLast();
-    if (destdir.isEmpty())
-        m_workingDir = QDir(QFileInfo(m_fileName).path());
+    if (DestDir.isEmpty())
+        m_workingDir = QDir(QFileInfo(FileName).path());
     else
     {
-        m_workingDir = QDir(destdir);
+        m_workingDir = QDir(DestDir);
         if (!m_workingDir.exists())
-            m_workingDir = QDir(QFileInfo(m_fileName).path());
+            m_workingDir = QDir(QFileInfo(FileName).path());
     }
     m_baseName = comps.join(".");
 }
 
+/**
+ * Call it when you got new video frame to process subtitles if any.
+ * \param Duration How long the frame is shown for.
+ */
+void MythCCExtractor::ProcessFrame(std::chrono::microseconds Duration)
+{
+    m_playedTime += Duration;
+    m_curTime = std::chrono::duration_cast<std::chrono::milliseconds>(m_playedTime);
+
+    Ingest608Captions();  Process608Captions(kProcessNormal);
+    Ingest708Captions();  Process708Captions(kProcessNormal);
+    IngestTeletext();     ProcessTeletext(kProcessNormal);
+    IngestDVBSubtitles(); ProcessDVBSubtitles(kProcessNormal);
+}
+
+/**
+ * Call it when the frames passed in jump, so that later subtitles keep
+ * their times. Whatever the readers have buffered is dropped.
+ * \param Position Time at the end of the frame jumped to.
+ */
+void MythCCExtractor::Seek(std::chrono::microseconds Position)
+{
+    Reset();
+    m_playedTime = Position;
+    m_curTime = std::chrono::duration_cast<std::chrono::milliseconds>(m_playedTime);
+}
+
+/**
+ * Call it after the last frame, to write out the subtitles still pending.
+ */
+void MythCCExtractor::Finish(void)
+{
+    Process608Captions(kProcessFinalize);
+    Process708Captions(kProcessFinalize);
+    ProcessTeletext(kProcessFinalize);
+    ProcessDVBSubtitles(kProcessFinalize);
+}
+
+/**
+ * Drops whatever the readers have buffered, for use after the player
+ * has seeked to frames that are not part of the pass being extracted.
+ */
+void MythCCExtractor::Reset(void)
+{
+    for (auto & info : m_cc608Info)
+        if (info.m_reader)
+            info.m_reader->ClearBuffers(true, true);
+    for (auto & info : m_cc708Info)
+        if (info.m_reader)
+            info.m_reader->ClearBuffers();
+    for (auto & info : m_ttxInfo)
+        if (info.m_reader)
+            info.m_reader->Reset();
+    for (auto & info : m_dvbsubInfo)
+    {
+        if (info.m_reader)
+        {
+            info.m_reader->ClearAVSubtitles();
+            info.m_reader->ClearRawTextSubtitles();
+        }
+    }
+}
+
+MythCCExtractorPlayer::MythCCExtractorPlayer(PlayerContext *Context, PlayerFlags flags, bool showProgress,
+                                             const QString &fileName,
+                                             const QString &destdir) :
+    MythPlayer(Context, flags),
+    m_extractor(this, fileName, destdir),
+    m_showProgress(showProgress)
+{
+}
+
 /**
  * Call it when you got new video frame to process subtitles if any.
  */
@@ -77,20 +146,18 @@ void MythCCExtractorPlayer::OnGotNewFrame(void)
 {
     m_myFramesPlayed = m_decoder->GetFramesRead();
     m_videoOutput->StartDisplayingFrame();
+    std::chrono::microseconds duration = 0us;
     {
         MythVideoFrame *frame = m_videoOutput->GetLastShownFrame();
         double fps = frame->m_frameRate;
         if (fps <= 0)
             fps = GetDecoder()->GetFPS();
-        double duration = (1 / fps) + (static_cast<double>(frame->m_repeatPic) * 0.5 / fps);
-        m_curTime += secondsFromFloat(duration);
+        duration = microsecondsFromFloat(
+            ((1 / fps) + (static_cast<double>(frame->m_repeatPic) * 0.5 / fps)) * 1000000.0);
         m_videoOutput->DoneDisplayingFrame(frame);
     }
 
-    Ingest608Captions();  Process608Captions(kProcessNormal);
-    Ingest708Captions();  Process708Captions(kProcessNormal);
-    IngestTeletext();     ProcessTeletext(kProcessNormal);
-    IngestDVBSubtitles(); ProcessDVBSubtitles(kProcessNormal);
+    m_extractor.ProcessFrame(duration);
 }
 
 static QString progress_string(
@@ -149,8 +216,6 @@ bool MythCCExtractorPlayer::run(void)
     inuse_timer.start();
     save_timer.start();
 
-    m_curTime = 0ms;
-
     if (DecoderGetFrame(kDecodeVideo))
         OnGotNewFrame();
 
@@ -193,10 +258,7 @@ bool MythCCExtractorPlayer::run(void)
         std::cout << qPrintable(str) << std::endl;
     }
 
-    Process608Captions(kProcessFinalize);
-    Process708Captions(kProcessFinalize);
-    ProcessTeletext(kProcessFinalize);
-    ProcessDVBSubtitles(kProcessFinalize);
+    m_extractor.Finish();
 
     SetPlaying(false);
     m_killDecoder = true;
@@ -211,7 +273,7 @@ bool MythCCExtractorPlayer::run(void)
  * @param list Queue of subtitles we modify.
  */
 
-void MythCCExtractorPlayer::IngestSubtitle(
+void MythCCExtractor::IngestSubtitle(
     QList<OneSubtitle> &list, const QStringList &content) const
 {
     bool update_last =
@@ -254,7 +316,7 @@ void MythCCExtractorPlayer::IngestSubtitle(
  * @param content Content of the new subtitle (may be empty).
  * We're going to use it's m_img & m_startTime fields.
  */
-void MythCCExtractorPlayer::IngestSubtitle(
+void MythCCExtractor::IngestSubtitle(
     QList<OneSubtitle> &list, const OneSubtitle &content)
 {
     bool update_last =
@@ -289,7 +351,7 @@ void MythCCExtractorPlayer::IngestSubtitle(
     }
 }
 
-void MythCCExtractorPlayer::Ingest608Captions(void)
+void MythCCExtractor::Ingest608Captions(void)
 {
     static constexpr std::array<int,7> kCcIndexTbl
     {
@@ -340,7 +402,7 @@ void MythCCExtractorPlayer::Ingest608Captions(void)
 }
 
 // Note: GetCaptionLanguage() will not return valid if there are multiple videos
-void MythCCExtractorPlayer::Process608Captions(uint flags)
+void MythCCExtractor::Process608Captions(uint flags)
 {
     int i = 0;
     // NOLINTNEXTLINE(modernize-loop-convert)
@@ -362,7 +424,7 @@ void MythCCExtractorPlayer::Process608Captions(uint flags)
             if (!(*cc608it).m_srtWriters[idx])
             {
                 int langCode = 0;
-                auto *avd = dynamic_cast<AvFormatDecoder *>(m_decoder);
+                auto *avd = dynamic_cast<AvFormatDecoder *>(m_player->GetDecoder());
                 if (avd)
                     langCode = avd->GetCaptionLanguage(
                         kTrackTypeCC608, idx + 1);
@@ -400,7 +462,7 @@ void MythCCExtractorPlayer::Process608Captions(uint flags)
     }
 }
 
-void MythCCExtractorPlayer::Ingest708Captions(void)
+void MythCCExtractor::Ingest708Captions(void)
 {
     // For each window of each service of each video...
     for (auto it = m_cc708Info.cbegin(); it != m_cc708Info.cend(); ++it)
@@ -429,7 +491,7 @@ void MythCCExtractorPlayer::Ingest708Captions(void)
     }
 }
 
-void MythCCExtractorPlayer::Ingest708Caption(
+void MythCCExtractor::Ingest708Caption(
     uint streamId, uint serviceIdx,
     uint windowIdx, uint start_row, uint start_column,
     const CC708Window &win,
@@ -460,7 +522,7 @@ void MythCCExtractorPlayer::Ingest708Caption(
 }
 
 // Note: GetCaptionLanguage() will not return valid if there are multiple videos
-void MythCCExtractorPlayer::Process708Captions(uint flags)
+void MythCCExtractor::Process708Captions(uint flags)
 {
     int i = 0;
     // NOLINTNEXTLINE(modernize-loop-convert)
@@ -482,7 +544,7 @@ void MythCCExtractorPlayer::Process708Captions(uint flags)
             if (!(*cc708it).m_srtWriters[idx])
             {
                 int langCode = 0;
-                auto *avd = dynamic_cast<AvFormatDecoder*>(m_decoder);
+                auto *avd = dynamic_cast<AvFormatDecoder*>(m_player->GetDecoder());
                 if (avd)
                     langCode = avd->GetCaptionLanguage(kTrackTypeCC708, idx);
 
@@ -532,7 +594,7 @@ static QStringList to_string_list(const TeletextSubPage &subPage)
     return content;
 }
 
-void MythCCExtractorPlayer::IngestTeletext(void)
+void MythCCExtractor::IngestTeletext(void)
 {
     // NOLINTNEXTLINE(modernize-loop-convert)
     for (auto ttxit = m_ttxInfo.begin(); ttxit != m_ttxInfo.end(); ++ttxit)
@@ -557,7 +619,7 @@ void MythCCExtractorPlayer::IngestTeletext(void)
     }
 }
 
-void MythCCExtractorPlayer::ProcessTeletext(uint flags)
+void MythCCExtractor::ProcessTeletext(uint flags)
 {
     int i = 0;
     // NOLINTNEXTLINE(modernize-loop-convert)
@@ -579,7 +641,7 @@ void MythCCExtractorPlayer::ProcessTeletext(uint flags)
             if (!(*ttxit).m_srtWriters[page])
             {
                 int langCode = 0;
-                auto *avd = dynamic_cast<AvFormatDecoder *>(m_decoder);
+                auto *avd = dynamic_cast<AvFormatDecoder *>(m_player->GetDecoder());
 
                 if (avd)
                     langCode = avd->GetTeletextLanguage(page);
@@ -615,7 +677,7 @@ void MythCCExtractorPlayer::ProcessTeletext(uint flags)
     }
 }
 
-void MythCCExtractorPlayer::IngestDVBSubtitles(void)
+void MythCCExtractor::IngestDVBSubtitles(void)
 {
     // NOLINTNEXTLINE(modernize-loop-convert)
     for (auto subit = m_dvbsubInfo.begin(); subit != m_dvbsubInfo.end(); ++subit)
@@ -716,14 +778,14 @@ void MythCCExtractorPlayer::IngestDVBSubtitles(void)
     }
 }
 
-void MythCCExtractorPlayer::ProcessDVBSubtitles(uint flags)
+void MythCCExtractor::ProcessDVBSubtitles(uint flags)
 {
     // Process (DVB) subtitle streams.
     int subtitleStreamCount = 0;
     for (auto subit = m_dvbsubInfo.begin(); subit != m_dvbsubInfo.end(); ++subit)
     {
         int langCode = 0;
-        auto *avd = dynamic_cast<AvFormatDecoder *>(m_decoder);
+        auto *avd = dynamic_cast<AvFormatDecoder *>(m_player->GetDecoder());
         int idx = subit.key();
         if (avd)
             langCode = avd->GetSubtitleLanguage(subtitleStreamCount, idx);
@@ -784,42 +846,62 @@ void MythCCExtractorPlayer::ProcessDVBSubtitles(uint flags)
 }
 
 
-CC708Reader *MythCCExtractorPlayer::GetCC708Reader(uint id)
+CC708Reader *MythCCExtractor::GetCC708Reader(uint id)
 {
     if (!m_cc708Info[id].m_reader)
     {
-        m_cc708Info[id].m_reader = new CC708Reader(this);
+        m_cc708Info[id].m_reader = new CC708Reader(m_player);
         m_cc708Info[id].m_reader->SetEnabled(true);
         LOG(VB_GENERAL, LOG_INFO, "Created CC708Reader");
     }
     return m_cc708Info[id].m_reader;
 }
 
-CC608Reader *MythCCExtractorPlayer::GetCC608Reader(uint id)
+CC608Reader *MythCCExtractor::GetCC608Reader(uint id)
 {
     if (!m_cc608Info[id].m_reader)
     {
-        m_cc608Info[id].m_reader = new CC608Reader(this);
+        m_cc608Info[id].m_reader = new CC608Reader(m_player);
         m_cc608Info[id].m_reader->SetEnabled(true);
     }
     return m_cc608Info[id].m_reader;
 }
 
-TeletextReader *MythCCExtractorPlayer::GetTeletextReader(uint id)
+TeletextReader *MythCCExtractor::GetTeletextReader(uint id)
 {
     if (!m_ttxInfo[id].m_reader)
         m_ttxInfo[id].m_reader = new TeletextExtractorReader();
     return m_ttxInfo[id].m_reader;
 }
 
-SubtitleReader *MythCCExtractorPlayer::GetSubReader(uint id)
+SubtitleReader *MythCCExtractor::GetSubReader(uint id)
 {
     if (!m_dvbsubInfo[id].m_reader)
     {
-        m_dvbsubInfo[id].m_reader = new SubtitleReader(this);
+        m_dvbsubInfo[id].m_reader = new SubtitleReader(m_player);
         m_dvbsubInfo[id].m_reader->EnableAVSubtitles(true);
         m_dvbsubInfo[id].m_reader->EnableTextSubtitles(true);
         m_dvbsubInfo[id].m_reader->EnableRawTextSubtitles(true);
     }
     return m_dvbsubInfo[id].m_reader;
 }
+
+CC708Reader *MythCCExtractorPlayer::GetCC708Reader(uint id)
+{
+    return m_extractor.GetCC708Reader(id);
+}
+
+CC608Reader *MythCCExtractorPlayer::GetCC608Reader(uint id)
+{
+    return m_extractor.GetCC608Reader(id);
+}
+
+TeletextReader *MythCCExtractorPlayer::GetTeletextReader(uint id)
+{
+    return m_extractor.GetTeletextReader(id);
+}
+
+SubtitleReader *MythCCExtractorPlayer::GetSubReader(uint id)
+{
+    return m_extractor.GetSubReader(id);
+}
@@ -109,20 +109,27 @@ using DVBSubInfo = QHash<uint, DVBSubStuff>;
 
 using SubtitleReaders = QHash<uint, SubtitleReader*>;
 
-class MTV_PUBLIC MythCCExtractorPlayer : public MythPlayer
+/**
+ * Collects the captions and subtitles that a player's decoder finds, and
+ * writes them next to the recording, as SRT files or as images for DVB
+ * subtitles. It is fed one decoded video frame at a time, so any player
+ * that decodes the whole video can extract captions in the same pass.
+ */
+class MTV_PUBLIC MythCCExtractor
 {
   public:
-    MythCCExtractorPlayer(PlayerContext* Context, PlayerFlags flags, bool showProgress,
-                          QString fileName, const QString & destdir);
-    MythCCExtractorPlayer(const MythCCExtractorPlayer& rhs);
-    ~MythCCExtractorPlayer() override = default;
+    MythCCExtractor(MythPlayer *Player, const QString &FileName,
+                    const QString &DestDir);
 
-    bool run(void);
+    void ProcessFrame(std::chrono::microseconds Duration);
+    void Seek(std::chrono::microseconds Position);
+    void Finish(void);
+    void Reset(void);
 
-    CC708Reader    *GetCC708Reader(uint id=0) override; // MythPlayer
-    CC608Reader    *GetCC608Reader(uint id=0) override; // MythPlayer
-    SubtitleReader *GetSubReader(uint id=0) override; // MythPlayer
-    TeletextReader *GetTeletextReader(uint id=0) override; // MythPlayer
+    CC708Reader    *GetCC708Reader(uint id=0);
+    CC608Reader    *GetCC608Reader(uint id=0);
+    SubtitleReader *GetSubReader(uint id=0);
+    TeletextReader *GetTeletextReader(uint id=0);
 
   private:
     void IngestSubtitle(QList<OneSubtitle> &list, const QStringList &content) const;
@@ -145,9 +152,8 @@ class MTV_PUBLIC MythCCExtractorPlayer : public MythPlayer
     void IngestDVBSubtitles(void);
     void ProcessDVBSubtitles(uint flags);
 
-    void OnGotNewFrame(void);
+    MythPlayer     *m_player {nullptr};
 
-  protected:
     CC608Info       m_cc608Info;
     CC708Info       m_cc708Info;
     TeletextInfo    m_ttxInfo;
@@ -166,14 +172,37 @@ class MTV_PUBLIC MythCCExtractorPlayer : public MythPlayer
     QHash<uint, WindowsOnService > m_cc708Windows;
 
     /// Keeps track for decoding time to make timestamps for subtitles.
+    std::chrono::microseconds  m_playedTime {0us};
     std::chrono::milliseconds  m_curTime {0ms};
-    uint64_t m_myFramesPlayed {0};
-    bool    m_showProgress    {false};
-    QString m_fileName;
     QDir    m_workingDir;
     QString m_baseName;
 };
 
+class MTV_PUBLIC MythCCExtractorPlayer : public MythPlayer
+{
+  public:
+    MythCCExtractorPlayer(PlayerContext* Context, PlayerFlags flags, bool showProgress,
+                          const QString &fileName, const QString & destdir);
+    MythCCExtractorPlayer(const MythCCExtractorPlayer& rhs);
+    ~MythCCExtractorPlayer() override = default;
+
+    bool run(void);
+
+    CC708Reader    *GetCC708Reader(uint id=0) override; // MythPlayer
+    CC608Reader    *GetCC608Reader(uint id=0) override; // MythPlayer
+    SubtitleReader *GetSubReader(uint id=0) override; // MythPlayer
+    TeletextReader *GetTeletextReader(uint id=0) override; // MythPlayer
+
+  private:
+    void OnGotNewFrame(void);
+
+  protected:
+    MythCCExtractor m_extractor;
+
+    uint64_t m_myFramesPlayed {0};
+    bool    m_showProgress    {false};
+};
+
 #endif // MYTHCCEXTRACTORPLAYER_H
 
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
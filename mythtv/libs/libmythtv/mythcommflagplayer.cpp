@@ -4,7 +4,10 @@
 // MythTV
 #include "libmythbase/mthreadpool.h"
 #include "libmythbase/mythlogging.h"
+#include "io/mythmediabuffer.h"
+#include "mythccextractorplayer.h"
 #include "mythcommflagplayer.h"
+#include "seekindexfile.h"
 
 // Std
 #include <unistd.h>
@@ -57,6 +60,8 @@ MythCommFlagPlayer::MythCommFlagPlayer(PlayerContext* Context, PlayerFlags Flags
 {
 }
 
+MythCommFlagPlayer::~MythCommFlagPlayer() = default;
+
 bool MythCommFlagPlayer::RebuildSeekTable(bool ShowPercentage, StatusCallback Callback, void* Opaque)
 {
     uint64_t myFramesPlayed = 0;
@@ -76,6 +81,8 @@ bool MythCommFlagPlayer::RebuildSeekTable(bool ShowPercentage, StatusCallback Ca
         m_playerCtx->m_playingInfo->ClearPositionMap(MARK_DURATION_MS);
     }
     m_playerCtx->UnlockPlayingInfo(__FILE__, __LINE__);
+    if (m_playerCtx->m_buffer)
+        SeekIndexFile::Remove(m_playerCtx->m_buffer->GetFilename());
 
     if (OpenFile() < 0)
         return false;
@@ -231,7 +238,11 @@ MythVideoFrame* MythCommFlagPlayer::GetRawVideoFrame(long long FrameNumber)
     m_playerCtx->UnlockPlayingInfo(__FILE__, __LINE__);
 
     if (!m_decoderThread)
+    {
+        if (m_ccExtractor)
+            m_decoder->SetDecodeAllSubtitles(true);
         DecoderStart(false);
+    }
 
     if (FrameNumber >= 0)
     {
@@ -249,6 +260,77 @@ MythVideoFrame* MythCommFlagPlayer::GetRawVideoFrame(long long FrameNumber)
     }
 
     m_videoOutput->StartDisplayingFrame();
-    return m_videoOutput->GetLastShownFrame();
+    MythVideoFrame *frame = m_videoOutput->GetLastShownFrame();
+    if (m_ccExtractor && frame)
+        ExtractFrameCaptions(frame);
+    return frame;
+}
+
+/*! \brief Extracts the captions and subtitles to files next to FileName
+ *         while the video is decoded for flagging.
+ *
+ *   This saves running mythccextractor, and decoding the whole video
+ *   again, after flagging. Call before the first GetRawVideoFrame(), and
+ *   call FinishCaptions() once flagging is done.
+ */
+void MythCommFlagPlayer::ExtractCaptions(const QString &FileName)
+{
+    m_ccExtractor = std::make_unique<MythCCExtractor>(this, FileName, QString());
+    m_ccLastFrame = -1;
+}
+
+void MythCommFlagPlayer::FinishCaptions(void)
+{
+    if (m_ccExtractor)
+        m_ccExtractor->Finish();
+}
+
+/*! \brief Passes the captions decoded with Frame to the extractor.
+ *
+ *   Subtitle times are counted from the frames passed in. When flagging
+ *   seeks, e.g. to search for a logo, or frames go missing, whatever was
+ *   decoded on the way is dropped and extraction carries on from the new
+ *   frame, with the clock set to its position.
+ */
+void MythCommFlagPlayer::ExtractFrameCaptions(const MythVideoFrame *Frame)
+{
+    double fps = Frame->m_frameRate;
+    if (fps <= 0)
+        fps = m_decoder->GetFPS();
+
+    if (Frame->m_frameNumber != m_ccLastFrame + 1)
+    {
+        LOG(VB_COMMFLAG, LOG_INFO, LOC +
+            QString("Captions: frame %1 follows frame %2, resyncing")
+                .arg(Frame->m_frameNumber).arg(m_ccLastFrame));
+        m_ccExtractor->Seek(microsecondsFromFloat(
+            static_cast<double>(Frame->m_frameNumber + 1) / fps * 1000000.0));
+        m_ccLastFrame = Frame->m_frameNumber;
+        return;
+    }
+    m_ccLastFrame = Frame->m_frameNumber;
+
+    m_ccExtractor->ProcessFrame(microsecondsFromFloat(
+        ((1 / fps) + (static_cast<double>(Frame->m_repeatPic) * 0.5 / fps)) * 1000000.0));
+}
+
+CC708Reader *MythCommFlagPlayer::GetCC708Reader(uint id)
+{
+    return m_ccExtractor ? m_ccExtractor->GetCC708Reader(id) : MythPlayer::GetCC708Reader(id);
+}
+
+CC608Reader *MythCommFlagPlayer::GetCC608Reader(uint id)
+{
+    return m_ccExtractor ? m_ccExtractor->GetCC608Reader(id) : MythPlayer::GetCC608Reader(id);
+}
+
+SubtitleReader *MythCommFlagPlayer::GetSubReader(uint id)
+{
+    return m_ccExtractor ? m_ccExtractor->GetSubReader(id) : MythPlayer::GetSubReader(id);
+}
+
+TeletextReader *MythCommFlagPlayer::GetTeletextReader(uint id)
+{
+    return m_ccExtractor ? m_ccExtractor->GetTeletextReader(id) : MythPlayer::GetTeletextReader(id);
 }
 
@@ -1,9 +1,14 @@
 #ifndef MYTHCOMMFLAGPLAYER_H
 #define MYTHCOMMFLAGPLAYER_H
 
+// Std
+#include <memory>
+
 // MythTV
 #include "mythplayer.h"
 
+class MythCCExtractor;
+
 class MythRebuildSaver : public QRunnable
 {
   public:
@@ -26,8 +31,23 @@ class MTV_PUBLIC MythCommFlagPlayer : public MythPlayer
 {
   public:
     explicit MythCommFlagPlayer(PlayerContext* Context, PlayerFlags Flags = kNoFlags);
+    ~MythCommFlagPlayer() override;
     bool RebuildSeekTable(bool ShowPercentage = true, StatusCallback Callback = nullptr, void* Opaque = nullptr);
     MythVideoFrame* GetRawVideoFrame(long long FrameNumber = -1);
+
+    void ExtractCaptions(const QString &FileName);
+    void FinishCaptions(void);
+
+    CC708Reader    *GetCC708Reader(uint id=0) override; // MythPlayer
+    CC608Reader    *GetCC608Reader(uint id=0) override; // MythPlayer
+    SubtitleReader *GetSubReader(uint id=0) override; // MythPlayer
+    TeletextReader *GetTeletextReader(uint id=0) override; // MythPlayer
+
+  private:
+    void ExtractFrameCaptions(const MythVideoFrame *Frame);
+
+    std::unique_ptr<MythCCExtractor> m_ccExtractor;
+    long long m_ccLastFrame { -1 };
 };
 
 #endif
@@ -54,20 +54,88 @@ char *MythPreviewPlayer::GetScreenGrabAtFrame(uint64_t FrameNum, bool Absolute,
     FrameWidth = FrameHeight = 0;
     AspectRatio = 0;
 
+    bool unsupported = false;
+    if (!OpenForScreenGrab(unsupported))
+        return nullptr;
+
+    if (unsupported)
+    {
+        FrameWidth = 640;
+        FrameHeight = 480;
+        AspectRatio = 4.0F / 3.0F;
+        BufferSize = FrameWidth * FrameHeight * 4;
+        char* result = new char[static_cast<size_t>(BufferSize)];
+        memset(result, 0x3f, static_cast<size_t>(BufferSize) * sizeof(char));
+        return result;
+    }
+
+    ClearAfterSeek();
+    if (!m_decoderThread)
+        DecoderStart(true /*start paused*/);
+    uint64_t dummy = 0;
+    SeekForScreenGrab(dummy, FrameNum, Absolute);
+    return GrabDecodedFrame(BufferSize, FrameWidth, FrameHeight, AspectRatio);
+}
+
+/*! \brief Returns one RGB frame grab of the keyframe at or before FrameNum
+ *
+ *   Unlike GetScreenGrabAtFrame() the file is only opened on the first call
+ *   and the seek stops at the keyframe, so a caller can walk the seek table
+ *   grabbing many frames without decoding the GOPs in between.
+ *
+ *   User is responsible for freeing the buffer with av_free().
+ *
+ *  \param FrameNum    [in]  Keyframe number to capture, normally from the seek table
+ *  \param BufferSize  [out] Size of buffer returned in bytes
+ *  \param FrameWidth  [out] Width of buffer returned
+ *  \param FrameHeight [out] Height of buffer returned
+ *  \param AspectRatio [out] Aspect of buffer returned
+ */
+char *MythPreviewPlayer::GetKeyframeGrab(uint64_t FrameNum, int& BufferSize,
+                                         int& FrameWidth, int& FrameHeight, float& AspectRatio)
+{
+    BufferSize = 0;
+    FrameWidth = FrameHeight = 0;
+    AspectRatio = 0;
+
+    bool unsupported = false;
+    if (!OpenForScreenGrab(unsupported) || unsupported)
+        return nullptr;
+
+    if (!m_decoderThread)
+    {
+        ClearAfterSeek();
+        DecoderStart(true /*start paused*/);
+    }
+    DiscardVideoFrame(m_videoOutput->GetLastDecodedFrame());
+    DoJumpToFrame(std::min(FrameNum, m_totalFrames ? m_totalFrames - 1 : 0), kInaccuracyFull);
+    return GrabDecodedFrame(BufferSize, FrameWidth, FrameHeight, AspectRatio);
+}
+
+/// \brief Opens the file and video output on the first screen grab.
+/// \param Unsupported [out] Set when the file has no video that can be grabbed
+bool MythPreviewPlayer::OpenForScreenGrab(bool& Unsupported)
+{
+    if (m_screenGrabOpen)
+    {
+        Unsupported = false;
+        return true;
+    }
+
     if (OpenFile(0) < 0)
     {
         LOG(VB_GENERAL, LOG_ERR, LOC + "Could not open file for preview.");
-        return nullptr;
+        return false;
     }
 
-    bool fail = false;
+    Unsupported = false;
 
     // No video to grab
     if ((m_videoDim.width() <= 0) || (m_videoDim.height() <= 0))
     {
         LOG(VB_GENERAL, LOG_WARNING, LOC + QString("No video for preview in file '%1'")
             .arg(m_playerCtx->m_buffer->GetSafeFilename()));
-        fail = true;
+        Unsupported = true;
     }
 
     // We may have a BluRay or DVD buffer but this class does not inherit
@@ -76,38 +144,32 @@ char *MythPreviewPlayer::GetScreenGrabAtFrame(uint64_t FrameNum, bool Absolute,
     {
         LOG(VB_GENERAL, LOG_WARNING, LOC + QString("Cannot generate preview for BluRay file '%1'")
             .arg(m_playerCtx->m_buffer->GetSafeFilename()));
-        fail = true;
+        Unsupported = true;
     }
 
     if (m_playerCtx->m_buffer->IsDVD())
     {
         LOG(VB_GENERAL, LOG_WARNING, LOC + QString("Cannot generate preview for DVD file '%1'")
             .arg(m_playerCtx->m_buffer->GetSafeFilename()));
-        fail = true;
+        Unsupported = true;
     }
 
-    if (fail)
-    {
-        FrameWidth = 640;
-        FrameHeight = 480;
-        AspectRatio = 4.0F / 3.0F;
-        BufferSize = FrameWidth * FrameHeight * 4;
-        char* result = new char[static_cast<size_t>(BufferSize)];
-        memset(result, 0x3f, static_cast<size_t>(BufferSize) * sizeof(char));
-        return result;
-    }
+    if (Unsupported)
+        return true;
 
     if (!InitVideo())
     {
         LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to initialize video for screen grab.");
-        return nullptr;
+        return false;
     }
 
-    ClearAfterSeek();
-    if (!m_decoderThread)
-        DecoderStart(true /*start paused*/);
-    uint64_t dummy = 0;
-    SeekForScreenGrab(dummy, FrameNum, Absolute);
+    m_screenGrabOpen = true;
+    return true;
+}
+
+char *MythPreviewPlayer::GrabDecodedFrame(int& BufferSize, int& FrameWidth,
+                                          int& FrameHeight, float& AspectRatio)
+{
     int tries = 0;
     while (!m_videoOutput->ValidVideoFrames() && (tries < 500))
     {
@@ -140,6 +202,8 @@ char *MythPreviewPlayer::GetScreenGrabAtFrame(uint64_t FrameNum, bool Absolute,
     FrameWidth = m_videoDispDim.width();
     FrameHeight = m_videoDispDim.height();
     AspectRatio = frame->m_aspect;
+    BufferSize = static_cast<int>(MythVideoFrame::GetBufferSize(FMT_RGB32, m_videoDim.width(),
+                                                               m_videoDim.height()));
 
     DiscardVideoFrame(frame);
     return reinterpret_cast<char*>(result);
@@ -12,9 +12,15 @@ class MythPreviewPlayer : public MythPlayer
                                int& FrameWidth, int& FrameHeight, float& AspectRatio);
     char* GetScreenGrab       (std::chrono::seconds SecondsIn, int& BufferSize, int& FrameWidth,
                                int& FrameHeight, float& AspectRatio);
+    char* GetKeyframeGrab     (uint64_t FrameNum, int& BufferSize, int& FrameWidth,
+                               int& FrameHeight, float& AspectRatio);
 
   private:
+    bool  OpenForScreenGrab(bool& Unsupported);
+    char* GrabDecodedFrame(int& BufferSize, int& FrameWidth, int& FrameHeight, float& AspectRatio);
     void  SeekForScreenGrab(uint64_t& Number, uint64_t FrameNum, bool Absolute);
+
+    bool  m_screenGrabOpen { false };
 };
 
 #endif
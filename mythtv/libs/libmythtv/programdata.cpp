@@ -2,6 +2,7 @@
 
 // C++ includes
 #include <algorithm>
+#include <array>
 #include <climits>
 #include <utility>
 
@@ -403,6 +404,57 @@ uint DBEvent::UpdateDB(
     return UpdateDB(query, chanid, programs, -1);
 }
 
+// Read a program row selected with the column list used by
+// DBEvent::GetOverlappingPrograms() and load_program_window().
+static DBEvent read_program(const MSqlQuery &query)
+{
+    ProgramInfo::CategoryType category_type =
+        string_to_myth_category_type(query.value(4).toString());
+
+    DBEvent prog(
+        query.value(0).toString(),
+        query.value(1).toString(),
+        query.value(2).toString(),
+        query.value(3).toString(),
+        category_type,
+        MythDate::as_utc(query.value(5).toDateTime()),
+        MythDate::as_utc(query.value(6).toDateTime()),
+        query.value(7).toUInt(),
+        query.value(8).toUInt(),
+        query.value(9).toUInt(),
+        query.value(19).toDouble(),
+        query.value(10).toString(),
+        query.value(11).toString(),
+        query.value(18).toUInt(),
+        query.value(20).toUInt(),  // Season
+        query.value(21).toUInt(),  // Episode
+        query.value(22).toUInt()); // Total Episodes
+
+    prog.m_inetref    = query.value(23).toString();
+    prog.m_partnumber = query.value(12).toUInt();
+    prog.m_parttotal  = query.value(13).toUInt();
+    prog.m_syndicatedepisodenumber = query.value(14).toString();
+    prog.m_airdate    = query.value(15).toUInt();
+    prog.m_originalairdate  = query.value(16).toDate();
+    prog.m_previouslyshown  = query.value(17).toBool();
+
+    return prog;
+}
+
+static const QString kProgramColumns =
+        "SELECT title,          subtitle,      description, "
+        "       category,       category_type, "
+        "       starttime,      endtime, "
+        "       subtitletypes+0,audioprop+0,   videoprop+0, "
+        "       seriesid,       programid, "
+        "       partnumber,     parttotal, "
+        "       syndicatedepisodenumber, "
+        "       airdate,        originalairdate, "
+        "       previouslyshown,listingsource, "
+        "       stars+0, "
+        "       season,         episode,       totalepisodes, "
+        "       inetref ";
+
 // Get all programs in the database that overlap with our new program.
 // We check for three ways in which we can have an overlap:
 // (1)   Start of old program is inside our new program:
@@ -430,19 +482,7 @@ uint DBEvent::GetOverlappingPrograms(
     MSqlQuery &query, uint chanid, std::vector<DBEvent> &programs) const
 {
     uint count = 0;
-    query.prepare(
-        "SELECT title,          subtitle,      description, "
-        "       category,       category_type, "
-        "       starttime,      endtime, "
-        "       subtitletypes+0,audioprop+0,   videoprop+0, "
-        "       seriesid,       programid, "
-        "       partnumber,     parttotal, "
-        "       syndicatedepisodenumber, "
-        "       airdate,        originalairdate, "
-        "       previouslyshown,listingsource, "
-        "       stars+0, "
-        "       season,         episode,       totalepisodes, "
-        "       inetref "
+    query.prepare(kProgramColumns +
         "FROM program "
         "WHERE chanid   = :CHANID AND "
         "      manualid = 0       AND "
@@ -465,37 +505,7 @@ uint DBEvent::GetOverlappingPrograms(
 
     while (query.next())
     {
-        ProgramInfo::CategoryType category_type =
-            string_to_myth_category_type(query.value(4).toString());
-
-        DBEvent prog(
-            query.value(0).toString(),
-            query.value(1).toString(),
-            query.value(2).toString(),
-            query.value(3).toString(),
-            category_type,
-            MythDate::as_utc(query.value(5).toDateTime()),
-            MythDate::as_utc(query.value(6).toDateTime()),
-            query.value(7).toUInt(),
-            query.value(8).toUInt(),
-            query.value(9).toUInt(),
-            query.value(19).toDouble(),
-            query.value(10).toString(),
-            query.value(11).toString(),
-            query.value(18).toUInt(),
-            query.value(20).toUInt(),  // Season
-            query.value(21).toUInt(),  // Episode
-            query.value(22).toUInt()); // Total Episodes
-
-        prog.m_inetref    = query.value(23).toString();
-        prog.m_partnumber = query.value(12).toUInt();
-        prog.m_parttotal  = query.value(13).toUInt();
-        prog.m_syndicatedepisodenumber = query.value(14).toString();
-        prog.m_airdate    = query.value(15).toUInt();
-        prog.m_originalairdate  = query.value(16).toDate();
-        prog.m_previouslyshown  = query.value(17).toBool();
-
-        programs.push_back(prog);
+        programs.push_back(read_program(query));
         count++;
     }
 
@@ -694,6 +704,7 @@ uint DBEvent::UpdateDB(
 // when the starttime of a program is changed.
 //
 // Return the number of rows affected:
+// -1   if the update failed
 // 0    if program is not found in table record
 // 1    if program is found and updated
 //
@@ -721,6 +732,7 @@ static int change_record(MSqlQuery &query, uint chanid,
     if (!query.exec() || !query.isActive())
     {
         MythDB::DBError("Updating record", query);
+        rows = -1;
     }
     else
     {
@@ -738,158 +750,163 @@ static int change_record(MSqlQuery &query, uint chanid,
     return rows;
 }
 
-// Update matched item with current data.
+// Update the program row with database key "oldstart" with the contents
+// of "prog" as built by DBEvent::Merge().
 //
-uint DBEvent::UpdateDB(
-    MSqlQuery &query, uint chanid, const DBEvent &match)  const
+static bool update_program(MSqlQuery &query, uint chanid,
+                           const QDateTime &oldstart, const DBEvent &prog)
 {
-    QString  ltitle           = m_title;
-    QString  lsubtitle        = m_subtitle;
-    QString  ldesc            = m_description;
-    QString  lcategory        = m_category;
-    uint16_t lairdate         = m_airdate;
-    QString  lprogramId       = m_programId;
-    QString  lseriesId        = m_seriesId;
-    QString  linetref         = m_inetref;
-    QDate    loriginalairdate = m_originalairdate;
+    query.prepare(
+        "UPDATE program "
+        "SET title          = :TITLE,     subtitle      = :SUBTITLE, "
+        "    description    = :DESC, "
+        "    category       = :CATEGORY,  category_type = :CATTYPE, "
+        "    starttime      = :STARTTIME, endtime       = :ENDTIME, "
+        "    closecaptioned = :CC,        subtitled     = :HASSUBTITLES, "
+        "    stereo         = :STEREO,    hdtv          = :HDTV, "
+        "    subtitletypes  = :SUBTYPE, "
+        "    audioprop      = :AUDIOPROP, videoprop     = :VIDEOPROP, "
+        "    season         = :SEASON,  "
+        "    episode        = :EPISODE,   totalepisodes = :TOTALEPS, "
+        "    partnumber     = :PARTNO,    parttotal     = :PARTTOTAL, "
+        "    syndicatedepisodenumber = :SYNDICATENO, "
+        "    airdate        = :AIRDATE,   originalairdate=:ORIGAIRDATE, "
+        "    listingsource  = :LSOURCE, "
+        "    seriesid       = :SERIESID,  programid     = :PROGRAMID, "
+        "    previouslyshown = :PREVSHOWN, inetref      = :INETREF "
+        "WHERE chanid    = :CHANID AND "
+        "      starttime = :OLDSTART ");
 
-    // Update starttime also in database table record so that
-    // tables program and record remain consistent.
-    if (m_starttime != match.m_starttime)
-    {
-        QDateTime const &old_starttime = match.m_starttime;
-        QDateTime const &new_starttime = m_starttime;
-        change_record(query, chanid, old_starttime, new_starttime);
+    query.bindValue(":CHANID",      chanid);
+    query.bindValue(":OLDSTART",    oldstart);
+    query.bindValue(":TITLE",       denullify(prog.m_title));
+    query.bindValue(":SUBTITLE",    denullify(prog.m_subtitle));
+    query.bindValue(":DESC",        denullify(prog.m_description));
+    query.bindValue(":CATEGORY",    denullify(prog.m_category));
+    query.bindValue(":CATTYPE",     myth_category_type_to_string(prog.m_categoryType));
+    query.bindValue(":STARTTIME",   prog.m_starttime);
+    query.bindValue(":ENDTIME",     prog.m_endtime);
+    query.bindValue(":CC",          (prog.m_subtitleType & SUB_HARDHEAR) != 0);
+    query.bindValue(":HASSUBTITLES",(prog.m_subtitleType & SUB_NORMAL) != 0);
+    query.bindValue(":STEREO",      (prog.m_audioProps   & AUD_STEREO) != 0);
+    query.bindValue(":HDTV",        (prog.m_videoProps   & VID_HDTV) != 0);
+    query.bindValue(":SUBTYPE",     prog.m_subtitleType);
+    query.bindValue(":AUDIOPROP",   prog.m_audioProps);
+    query.bindValue(":VIDEOPROP",   prog.m_videoProps);
+    query.bindValue(":SEASON",      prog.m_season);
+    query.bindValue(":EPISODE",     prog.m_episode);
+    query.bindValue(":TOTALEPS",    prog.m_totalepisodes);
+    query.bindValue(":PARTNO",      prog.m_partnumber);
+    query.bindValue(":PARTTOTAL",   prog.m_parttotal);
+    query.bindValue(":SYNDICATENO", denullify(prog.m_syndicatedepisodenumber));
+    query.bindValue(":AIRDATE",     prog.m_airdate ? QString::number(prog.m_airdate) : "0000");
+    query.bindValue(":ORIGAIRDATE", prog.m_originalairdate);
+    query.bindValue(":LSOURCE",     prog.m_listingsource);
+    query.bindValue(":SERIESID",    denullify(prog.m_seriesId));
+    query.bindValue(":PROGRAMID",   denullify(prog.m_programId));
+    query.bindValue(":PREVSHOWN",   prog.m_previouslyshown);
+    query.bindValue(":INETREF",     prog.m_inetref);
 
-        LOG(VB_EIT, LOG_DEBUG,
-            QString("EIT: (U) change starttime from %1 to %2 for chanid:%3 program '%4' ")
-                    .arg(old_starttime.toString(Qt::ISODate),
-                         new_starttime.toString(Qt::ISODate),
-                         QString::number(chanid),
-                         m_title.left(35)));
+    if (!query.exec())
+    {
+        MythDB::DBError("UpdateDB", query);
+        return false;
     }
+    return true;
+}
 
-    if (ltitle.isEmpty() && !match.m_title.isEmpty())
-        ltitle = match.m_title;
+// Combine our new program with the matching program from the database.
+// The result holds the program table columns of the updated row;
+// columns that UpdateDB() does not write (e.g. stars) keep the value
+// from the match.
+//
+DBEvent DBEvent::Merge(const DBEvent &match) const
+{
+    DBEvent prog(match);
 
-    if (lsubtitle.isEmpty() && !match.m_subtitle.isEmpty())
-        lsubtitle = match.m_subtitle;
+    prog.m_starttime = m_starttime;
+    prog.m_endtime   = m_endtime;
 
-    if (ldesc.isEmpty() && !match.m_description.isEmpty())
-        ldesc = match.m_description;
+    if (!m_title.isEmpty() || match.m_title.isEmpty())
+        prog.m_title = m_title;
 
-    if (lcategory.isEmpty() && !match.m_category.isEmpty())
-        lcategory = match.m_category;
+    if (!m_subtitle.isEmpty() || match.m_subtitle.isEmpty())
+        prog.m_subtitle = m_subtitle;
 
-    if (!lairdate && match.m_airdate)
-        lairdate = match.m_airdate;
+    if (!m_description.isEmpty() || match.m_description.isEmpty())
+        prog.m_description = m_description;
 
-    if (!loriginalairdate.isValid() && match.m_originalairdate.isValid())
-        loriginalairdate = match.m_originalairdate;
+    if (!m_category.isEmpty() || match.m_category.isEmpty())
+        prog.m_category = m_category;
 
-    if (lprogramId.isEmpty() && !match.m_programId.isEmpty())
-        lprogramId = match.m_programId;
+    if (m_airdate || !match.m_airdate)
+        prog.m_airdate = m_airdate;
 
-    if (lseriesId.isEmpty() && !match.m_seriesId.isEmpty())
-        lseriesId = match.m_seriesId;
+    if (m_originalairdate.isValid() || !match.m_originalairdate.isValid())
+        prog.m_originalairdate = m_originalairdate;
 
-    if (linetref.isEmpty() && !match.m_inetref.isEmpty())
-        linetref= match.m_inetref;
+    if (!m_programId.isEmpty() || match.m_programId.isEmpty())
+        prog.m_programId = m_programId;
 
-    ProgramInfo::CategoryType tmp = m_categoryType;
-    if (!m_categoryType && match.m_categoryType)
-        tmp = match.m_categoryType;
+    if (!m_seriesId.isEmpty() || match.m_seriesId.isEmpty())
+        prog.m_seriesId = m_seriesId;
 
-    QString lcattype = myth_category_type_to_string(tmp);
+    if (!m_inetref.isEmpty() || match.m_inetref.isEmpty())
+        prog.m_inetref = m_inetref;
 
-    unsigned char lsubtype = m_subtitleType | match.m_subtitleType;
-    unsigned char laudio   = m_audioProps   | match.m_audioProps;
-    unsigned char lvideo   = m_videoProps   | match.m_videoProps;
+    if (m_categoryType || !match.m_categoryType)
+        prog.m_categoryType = m_categoryType;
 
-    uint lseason = match.m_season;
-    uint lepisode = match.m_episode;
-    uint lepisodeTotal = match.m_totalepisodes;
+    prog.m_subtitleType = m_subtitleType | match.m_subtitleType;
+    prog.m_audioProps   = m_audioProps   | match.m_audioProps;
+    prog.m_videoProps   = m_videoProps   | match.m_videoProps;
 
     if (m_season || m_episode || m_totalepisodes)
     {
-        lseason = m_season;
-        lepisode = m_episode;
-        lepisodeTotal = m_totalepisodes;
+        prog.m_season        = m_season;
+        prog.m_episode       = m_episode;
+        prog.m_totalepisodes = m_totalepisodes;
     }
 
-    uint lpartnumber = match.m_partnumber;
-    uint lparttotal = match.m_parttotal;
-
     if (m_partnumber || m_parttotal)
     {
-        lpartnumber = m_partnumber;
-        lparttotal  = m_parttotal;
+        prog.m_partnumber = m_partnumber;
+        prog.m_parttotal  = m_parttotal;
     }
 
-    bool lpreviouslyshown = m_previouslyshown || match.m_previouslyshown;
+    prog.m_previouslyshown = m_previouslyshown || match.m_previouslyshown;
 
-    uint32_t llistingsource = m_listingsource | match.m_listingsource;
+    prog.m_listingsource = m_listingsource | match.m_listingsource;
 
-    QString lsyndicatedepisodenumber = m_syndicatedepisodenumber;
-    if (lsyndicatedepisodenumber.isEmpty() &&
-        !match.m_syndicatedepisodenumber.isEmpty())
-        lsyndicatedepisodenumber = match.m_syndicatedepisodenumber;
+    if (!m_syndicatedepisodenumber.isEmpty() ||
+        match.m_syndicatedepisodenumber.isEmpty())
+        prog.m_syndicatedepisodenumber = m_syndicatedepisodenumber;
 
-    query.prepare(
-        "UPDATE program "
-        "SET title          = :TITLE,     subtitle      = :SUBTITLE, "
-        "    description    = :DESC, "
-        "    category       = :CATEGORY,  category_type = :CATTYPE, "
-        "    starttime      = :STARTTIME, endtime       = :ENDTIME, "
-        "    closecaptioned = :CC,        subtitled     = :HASSUBTITLES, "
-        "    stereo         = :STEREO,    hdtv          = :HDTV, "
-        "    subtitletypes  = :SUBTYPE, "
-        "    audioprop      = :AUDIOPROP, videoprop     = :VIDEOPROP, "
-        "    season         = :SEASON,  "
-        "    episode        = :EPISODE,   totalepisodes = :TOTALEPS, "
-        "    partnumber     = :PARTNO,    parttotal     = :PARTTOTAL, "
-        "    syndicatedepisodenumber = :SYNDICATENO, "
-        "    airdate        = :AIRDATE,   originalairdate=:ORIGAIRDATE, "
-        "    listingsource  = :LSOURCE, "
-        "    seriesid       = :SERIESID,  programid     = :PROGRAMID, "
-        "    previouslyshown = :PREVSHOWN, inetref      = :INETREF "
-        "WHERE chanid    = :CHANID AND "
-        "      starttime = :OLDSTART ");
+    return prog;
+}
 
-    query.bindValue(":CHANID",      chanid);
-    query.bindValue(":OLDSTART",    match.m_starttime);
-    query.bindValue(":TITLE",       denullify(ltitle));
-    query.bindValue(":SUBTITLE",    denullify(lsubtitle));
-    query.bindValue(":DESC",        denullify(ldesc));
-    query.bindValue(":CATEGORY",    denullify(lcategory));
-    query.bindValue(":CATTYPE",     lcattype);
-    query.bindValue(":STARTTIME",   m_starttime);
-    query.bindValue(":ENDTIME",     m_endtime);
-    query.bindValue(":CC",          (lsubtype & SUB_HARDHEAR) != 0);
-    query.bindValue(":HASSUBTITLES",(lsubtype & SUB_NORMAL) != 0);
-    query.bindValue(":STEREO",      (laudio   & AUD_STEREO) != 0);
-    query.bindValue(":HDTV",        (lvideo   & VID_HDTV) != 0);
-    query.bindValue(":SUBTYPE",     lsubtype);
-    query.bindValue(":AUDIOPROP",   laudio);
-    query.bindValue(":VIDEOPROP",   lvideo);
-    query.bindValue(":SEASON",      lseason);
-    query.bindValue(":EPISODE",     lepisode);
-    query.bindValue(":TOTALEPS",    lepisodeTotal);
-    query.bindValue(":PARTNO",      lpartnumber);
-    query.bindValue(":PARTTOTAL",   lparttotal);
-    query.bindValue(":SYNDICATENO", denullify(lsyndicatedepisodenumber));
-    query.bindValue(":AIRDATE",     lairdate ? QString::number(lairdate) : "0000");
-    query.bindValue(":ORIGAIRDATE", loriginalairdate);
-    query.bindValue(":LSOURCE",     llistingsource);
-    query.bindValue(":SERIESID",    denullify(lseriesId));
-    query.bindValue(":PROGRAMID",   denullify(lprogramId));
-    query.bindValue(":PREVSHOWN",   lpreviouslyshown);
-    query.bindValue(":INETREF",     linetref);
+// Update matched item with current data.
+//
+uint DBEvent::UpdateDB(
+    MSqlQuery &query, uint chanid, const DBEvent &match)  const
+{
+    if (!update_program(query, chanid, match.m_starttime, Merge(match)))
+        return 0;
 
-    if (!query.exec())
+    // Update starttime also in database table record so that
+    // tables program and record remain consistent.
+    if (m_starttime != match.m_starttime)
     {
-        MythDB::DBError("UpdateDB", query);
-        return 0;
+        QDateTime const &old_starttime = match.m_starttime;
+        QDateTime const &new_starttime = m_starttime;
+        change_record(query, chanid, old_starttime, new_starttime);
+
+        LOG(VB_EIT, LOG_DEBUG,
+            QString("EIT: (U) change starttime from %1 to %2 for chanid:%3 program '%4' ")
+                    .arg(old_starttime.toString(Qt::ISODate),
+                         new_starttime.toString(Qt::ISODate),
+                         QString::number(chanid),
+                         m_title.left(35)));
     }
 
     if (m_credits)
@@ -1229,6 +1246,555 @@ uint DBEvent::InsertDB(MSqlQuery &query, uint chanid,
     return 1;
 }
 
+// Strip credits, ratings and genres, leaving the program table columns.
+static DBEvent program_columns(const DBEvent &event)
+{
+    DBEvent prog(event);
+    delete prog.m_credits;
+    prog.m_credits = nullptr;
+    prog.m_ratings.clear();
+    prog.m_genres.clear();
+    return prog;
+}
+
+void ProgramWindow::AddRow(const DBEvent &program)
+{
+    Row row(program_columns(program), kRowUnchanged);
+    row.m_origStarttime = program.m_starttime;
+    m_rows.insert_or_assign(program.m_starttime, row);
+}
+
+void ProgramWindow::AddManualRow(const QDateTime &starttime)
+{
+    m_manual.push_back(starttime);
+}
+
+bool ProgramWindow::Exists(const QDateTime &starttime) const
+{
+    return (m_rows.find(starttime) != m_rows.end()) ||
+        (std::find(m_manual.cbegin(), m_manual.cend(), starttime) !=
+         m_manual.cend());
+}
+
+/** \brief Apply a new event to the window.
+ *
+ *  This follows DBEvent::UpdateDB(MSqlQuery&,uint,int) step by step,
+ *  with the overlapping programs taken from the window instead of
+ *  the database.
+ *
+ *  \return 1 if the event was inserted or updated a program, 0 otherwise
+ */
+uint ProgramWindow::Apply(const DBEvent &event, int match_threshold,
+                          const QDateTime &now)
+{
+    LOG(VB_EIT, LOG_DEBUG,
+        QString("EIT: new program: %1 %2 '%3'")
+                .arg(event.m_starttime.toString(Qt::ISODate),
+                     event.m_endtime.toString(Qt::ISODate),
+                     event.m_title.left(35)));
+
+    if (event.m_endtime < now)
+    {
+        LOG(VB_EIT, LOG_DEBUG,
+            QString("EIT: skip '%1' endtime is in the past")
+                    .arg(event.m_title.left(35)));
+        return 0;
+    }
+
+    // Same conditions as DBEvent::GetOverlappingPrograms()
+    std::vector<DBEvent> programs;
+    for (const auto & [starttime, row] : m_rows)
+    {
+        const DBEvent &prog = row.m_program;
+        if ((prog.m_starttime >= event.m_starttime &&
+             prog.m_starttime <  event.m_endtime) ||
+            (prog.m_endtime   >  event.m_starttime &&
+             prog.m_endtime   <= event.m_endtime) ||
+            (prog.m_starttime <  event.m_starttime &&
+             prog.m_endtime   >  event.m_endtime))
+        {
+            programs.push_back(prog);
+        }
+    }
+
+    if (programs.empty())
+    {
+        Insert(event);
+        return 1;
+    }
+
+    int i = -1;
+    int match = event.GetMatch(programs, i);
+    if (match < match_threshold)
+        i = -1;
+
+    for (size_t j = 0; j < programs.size(); ++j)
+    {
+        if (j != (uint)i)
+            MoveOutOfTheWay(event, programs[j]);
+    }
+
+    if (i < 0)
+    {
+        LOG(VB_EIT, LOG_DEBUG,
+            QString("EIT: insert '%1'").arg(event.m_title.left(35)));
+        Insert(event);
+        return 1;
+    }
+
+    const DBEvent &prog = programs[i];
+    if (event.m_starttime != prog.m_starttime &&
+        event.m_starttime < now && event.m_endtime <= prog.m_endtime)
+    {
+        LOG(VB_EIT, LOG_DEBUG,
+            QString("EIT:  skip '%1' starttime is in the past")
+                    .arg(event.m_title.left(35)));
+        return 0;
+    }
+
+    LOG(VB_EIT, LOG_DEBUG,
+        QString("EIT: update '%1' with '%2'")
+                .arg(prog.m_title.left(35), event.m_title.left(35)));
+    return Update(event, prog);
+}
+
+// REPLACE INTO semantics: a program with the same start time is replaced.
+void ProgramWindow::Insert(const DBEvent &event)
+{
+    Remove(event.m_starttime);
+    Row row(program_columns(event), kRowInserted);
+    row.m_events.push_back(&event);
+    m_rows.emplace(event.m_starttime, row);
+}
+
+uint ProgramWindow::Update(const DBEvent &event, const DBEvent &match)
+{
+    if (event.m_starttime != match.m_starttime &&
+        m_rows.find(event.m_starttime) != m_rows.end())
+    {
+        LOG(VB_GENERAL, LOG_ERR,
+            QString("ProgramWindow: cannot move '%1' to %2, "
+                    "start time is in use")
+                .arg(match.m_title.left(35),
+                     event.m_starttime.toString(Qt::ISODate)));
+        return 0;
+    }
+
+    auto it = m_rows.find(match.m_starttime);
+    if (it == m_rows.end())
+        return 0;
+
+    if (event.m_starttime != match.m_starttime)
+        m_recordChanges.emplace_back(match.m_starttime, event.m_starttime);
+
+    auto node = m_rows.extract(it);
+    node.key() = event.m_starttime;
+    Row &row = node.mapped();
+    row.m_program = event.Merge(row.m_program);
+    if (row.m_state != kRowInserted)
+        row.m_state = kRowUpdated;
+    row.m_events.push_back(&event);
+    m_rows.insert(std::move(node));
+    return 1;
+}
+
+// Same decisions as DBEvent::MoveOutOfTheWayDB()
+void ProgramWindow::MoveOutOfTheWay(const DBEvent &event, const DBEvent &prog)
+{
+    if (prog.m_starttime >= event.m_starttime &&
+        prog.m_endtime   <= event.m_endtime)
+    {
+        Delete(prog.m_starttime);
+    }
+    else if (prog.m_starttime < event.m_starttime &&
+             prog.m_endtime   > event.m_starttime)
+    {
+        Move(prog.m_starttime, prog.m_starttime, event.m_starttime);
+    }
+    else if (prog.m_starttime < event.m_endtime &&
+             prog.m_endtime   > event.m_endtime)
+    {
+        if (Exists(event.m_endtime))
+        {
+            Delete(prog.m_starttime);
+            return;
+        }
+        m_recordChanges.emplace_back(prog.m_starttime, event.m_endtime);
+        Move(prog.m_starttime, event.m_endtime, prog.m_endtime);
+    }
+}
+
+// delete_program() semantics, this also deletes manual programs
+void ProgramWindow::Delete(const QDateTime &starttime)
+{
+    Remove(starttime);
+    m_manual.erase(std::remove(m_manual.begin(), m_manual.end(), starttime),
+                   m_manual.end());
+}
+
+void ProgramWindow::Remove(const QDateTime &starttime)
+{
+    auto it = m_rows.find(starttime);
+    if (it == m_rows.end())
+        return;
+    if (it->second.m_origStarttime.isValid())
+        m_deleted.push_back(it->second.m_origStarttime);
+    m_rows.erase(it);
+}
+
+void ProgramWindow::Move(const QDateTime &starttime,
+                         const QDateTime &newstart, const QDateTime &newend)
+{
+    auto it = m_rows.find(starttime);
+    if (it == m_rows.end())
+        return;
+
+    auto node = m_rows.extract(it);
+    node.key() = newstart;
+    Row &row = node.mapped();
+    row.m_program.m_starttime = newstart;
+    row.m_program.m_endtime   = newend;
+    if (row.m_state == kRowUnchanged)
+        row.m_state = kRowMoved;
+    m_rows.insert(std::move(node));
+}
+
+/** \brief Steps that move and update the changed rows in the database.
+ *
+ *  A row can only be moved to its new start time after the row that is
+ *  still stored under that start time in the database has been moved
+ *  out of the way. When the moves form a cycle, e.g. two programs that
+ *  swap start times, one row of the cycle is first parked under a
+ *  temporary start time in 1900, where no listings are stored, and moved
+ *  to its own start time once that is free.
+ */
+std::vector<ProgramWindow::WriteStep> ProgramWindow::GetWriteOrder(void) const
+{
+    static const QDateTime kParking { QDate(1900, 1, 1), QTime(0, 0), Qt::UTC };
+
+    // Rows that still have to be written, with their current database key
+    std::vector<std::pair<const Row*,QDateTime> > pending;
+    for (const auto & [starttime, row] : m_rows)
+    {
+        if (row.m_state == kRowMoved || row.m_state == kRowUpdated)
+            pending.emplace_back(&row, row.m_origStarttime);
+    }
+
+    // The pending row that is stored under the new start time of "row"
+    auto blocker = [&pending](const Row *row)
+    {
+        return std::find_if(pending.begin(), pending.end(),
+            [row](const auto &other)
+            {
+                return (other.first != row) &&
+                    (other.second == row->m_program.m_starttime);
+            });
+    };
+
+    std::vector<WriteStep> order;
+    while (!pending.empty())
+    {
+        auto it = std::find_if(pending.begin(), pending.end(),
+            [&pending, &blocker](const auto &entry)
+            { return blocker(entry.first) == pending.end(); });
+        if (it == pending.end())
+        {
+            // Every row waits for another one. Park the row that
+            // blocks the first one, so that one can be written next.
+            auto parked = blocker(pending.front().first);
+            QDateTime parking = kParking.addSecs(static_cast<qint64>(order.size()));
+            order.push_back({ parked->first, parked->second, parking, false });
+            parked->second = parking;
+            continue;
+        }
+        order.push_back({ it->first, it->second,
+                          it->first->m_program.m_starttime, true });
+        pending.erase(it);
+    }
+    return order;
+}
+
+static constexpr size_t kMaxBatchRows { 100 };
+
+// Execute "statement VALUES (...),(...)" with one tuple per entry in rows,
+// at most kMaxBatchRows tuples per query.
+static bool exec_multirow(MSqlQuery &query, const QString &statement,
+                          const std::vector<QVariantList> &rows,
+                          const QString &context)
+{
+    for (size_t first = 0; first < rows.size(); first += kMaxBatchRows)
+    {
+        size_t last = std::min(rows.size(), first + kMaxBatchRows);
+        QStringList tuples;
+        MSqlBindings bindings;
+        for (size_t r = first; r < last; ++r)
+        {
+            QStringList names;
+            for (int c = 0; c < rows[r].size(); ++c)
+            {
+                QString name = QString(":V%1_%2").arg(r - first).arg(c);
+                names << name;
+                bindings.insert(name, rows[r][c]);
+            }
+            tuples << QString("(%1)").arg(names.join(", "));
+        }
+
+        query.prepare(statement + " VALUES " + tuples.join(", "));
+        query.bindValues(bindings);
+        if (!query.exec())
+        {
+            MythDB::DBError(context, query);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Delete the programs, credits, ratings and genres stored under the
+// given start times.
+static bool delete_programs(MSqlQuery &query, uint chanid,
+                            const std::vector<QDateTime> &starttimes)
+{
+    static const std::array<const QString,4> kTables
+        { "program", "credits", "programrating", "programgenres" };
+
+    bool ok = true;
+    for (size_t first = 0; first < starttimes.size(); first += kMaxBatchRows)
+    {
+        size_t last = std::min(starttimes.size(), first + kMaxBatchRows);
+        QStringList names;
+        for (size_t i = first; i < last; ++i)
+            names << QString(":ST%1").arg(i - first);
+
+        for (const auto & table : kTables)
+        {
+            query.prepare(QString("DELETE FROM %1 "
+                                  "WHERE chanid    = :CHANID AND "
+                                  "      starttime IN (%2)")
+                          .arg(table, names.join(", ")));
+            query.bindValue(":CHANID", chanid);
+            for (size_t i = first; i < last; ++i)
+                query.bindValue(names[i - first], starttimes[i]);
+
+            if (!query.exec())
+            {
+                MythDB::DBError("delete_programs " + table, query);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+static bool load_program_window(MSqlQuery &query, uint chanid,
+                                const QDateTime &minstart,
+                                const QDateTime &maxend,
+                                ProgramWindow &window)
+{
+    // Every program that can overlap with a program between minstart
+    // and maxend, or that starts at maxend.
+    query.prepare(kProgramColumns +
+        "       , manualid "
+        "FROM program "
+        "WHERE chanid     = :CHANID AND "
+        "      starttime <= :MAXEND AND "
+        "      ( endtime >= :MINSTART1 OR starttime >= :MINSTART2 ) "
+        "ORDER BY starttime");
+    query.bindValue(":CHANID",    chanid);
+    query.bindValue(":MAXEND",    maxend);
+    query.bindValue(":MINSTART1", minstart);
+    query.bindValue(":MINSTART2", minstart);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("load_program_window", query);
+        return false;
+    }
+
+    while (query.next())
+    {
+        if (query.value(24).toUInt())
+            window.AddManualRow(MythDate::as_utc(query.value(5).toDateTime()));
+        else
+            window.AddRow(read_program(query));
+    }
+    return true;
+}
+
+// Write the changes in the window to the database. Every step depends
+// on the ones before it, so this stops at the first failure; the program
+// tables are not written in a transaction, so the earlier steps stay.
+static bool write_program_window(MSqlQuery &query, uint chanid,
+                                 const ProgramWindow &window)
+{
+    if (!delete_programs(query, chanid, window.GetDeleted()))
+        return false;
+
+    for (const auto & step : window.GetWriteOrder())
+    {
+        const ProgramWindow::Row *row = step.m_row;
+        const DBEvent &prog = row->m_program;
+        if ((row->m_state == ProgramWindow::kRowMoved ||
+             step.m_from != step.m_to) &&
+            !change_program(query, chanid, step.m_from, step.m_to,
+                            prog.m_endtime))
+        {
+            return false;
+        }
+        if (step.m_final && row->m_state == ProgramWindow::kRowUpdated &&
+            !update_program(query, chanid, prog.m_starttime, prog))
+        {
+            return false;
+        }
+    }
+
+    for (const auto & [oldstart, newstart] : window.GetRecordChanges())
+    {
+        if (change_record(query, chanid, oldstart, newstart) < 0)
+            return false;
+    }
+
+    std::vector<QVariantList> programs;
+    std::vector<QVariantList> ratings;
+    std::vector<QVariantList> genres;
+    static const QString kRelevance = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    for (const auto & [starttime, row] : window.GetRows())
+    {
+        const DBEvent &prog = row.m_program;
+        if (row.m_state == ProgramWindow::kRowInserted)
+        {
+            programs.push_back({
+                chanid, denullify(prog.m_title), denullify(prog.m_subtitle),
+                denullify(prog.m_description), denullify(prog.m_category),
+                myth_category_type_to_string(prog.m_categoryType),
+                prog.m_starttime, prog.m_endtime,
+                (prog.m_subtitleType & SUB_HARDHEAR) != 0,
+                (prog.m_audioProps   & AUD_STEREO) != 0,
+                (prog.m_videoProps   & VID_HDTV) != 0,
+                (prog.m_subtitleType & SUB_NORMAL) != 0,
+                prog.m_subtitleType, prog.m_audioProps, prog.m_videoProps,
+                prog.m_stars, prog.m_partnumber, prog.m_parttotal,
+                denullify(prog.m_syndicatedepisodenumber),
+                prog.m_airdate ? QString::number(prog.m_airdate) : "0000",
+                prog.m_originalairdate, prog.m_listingsource,
+                denullify(prog.m_seriesId), denullify(prog.m_programId),
+                prog.m_previouslyshown,
+                prog.m_season, prog.m_episode, prog.m_totalepisodes,
+                prog.m_inetref });
+        }
+
+        for (const auto *event : row.m_events)
+        {
+            for (const auto & rating : std::as_const(event->m_ratings))
+            {
+                ratings.push_back({ chanid, starttime,
+                                    rating.m_system, rating.m_rating });
+            }
+            for (int i = 0; i < event->m_genres.size() &&
+                     i < kRelevance.size(); ++i)
+            {
+                genres.push_back({ chanid, starttime,
+                                   event->m_genres[i], kRelevance.at(i) });
+            }
+        }
+    }
+
+    if (!exec_multirow(query,
+        "REPLACE INTO program ("
+        "  chanid,         title,          subtitle,        description, "
+        "  category,       category_type, "
+        "  starttime,      endtime, "
+        "  closecaptioned, stereo,         hdtv,            subtitled, "
+        "  subtitletypes,  audioprop,      videoprop, "
+        "  stars,          partnumber,     parttotal, "
+        "  syndicatedepisodenumber, "
+        "  airdate,        originalairdate,listingsource, "
+        "  seriesid,       programid,      previouslyshown, "
+        "  season,         episode,        totalepisodes, "
+        "  inetref ) ", programs, "program batch insert"))
+    {
+        return false;
+    }
+    if (!exec_multirow(query,
+        "INSERT IGNORE INTO programrating "
+        "  ( chanid, starttime, `system`, rating) ",
+        ratings, "programrating batch insert"))
+    {
+        return false;
+    }
+    if (!exec_multirow(query,
+        "INSERT IGNORE INTO programgenres "
+        "  ( chanid, starttime, genre, relevance) ",
+        genres, "programgenres batch insert"))
+    {
+        return false;
+    }
+
+    // Credits need the person and role ids, these stay per credit.
+    for (const auto & [starttime, row] : window.GetRows())
+    {
+        for (const auto *event : row.m_events)
+        {
+            if (!event->m_credits)
+                continue;
+            for (const auto & credit : *event->m_credits)
+            {
+                if (!credit.InsertDB(query, chanid, starttime))
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/** \brief Update the database with a batch of new events for one channel.
+ *
+ *  The result is the same as calling UpdateDB(MSqlQuery&,uint,int) for
+ *  each event in turn, but the existing programs are read with a single
+ *  query, matches and overlaps are resolved in a ProgramWindow and
+ *  deletions and insertions are written with grouped statements.
+ *
+ *  \param query  Any MSqlQuery; its contents are ignored and replaced.
+ *  \param chanid Channel of all the events.
+ *  \param events New events, in the order they would have been processed.
+ *  \param match_threshold Minimum GetMatch() score to update a program.
+ *  \return Number of events that were inserted or updated a program.
+ */
+uint DBEvent::UpdateDBBatch(MSqlQuery &query, uint chanid,
+                            const std::vector<DBEvent> &events,
+                            int match_threshold)
+{
+    if (events.empty())
+        return 0;
+
+    QDateTime minstart = events.front().m_starttime;
+    QDateTime maxend   = events.front().m_endtime;
+    for (const auto & event : events)
+    {
+        minstart = std::min(minstart, event.m_starttime);
+        maxend   = std::max(maxend,   event.m_endtime);
+    }
+
+    ProgramWindow window;
+    if (!load_program_window(query, chanid, minstart, maxend, window))
+        return 0;
+
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    uint count = 0;
+    for (const auto & event : events)
+        count += window.Apply(event, match_threshold, now);
+
+    if (!write_program_window(query, chanid, window))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Batch update of %1 events for chanid %2 incomplete")
+                .arg(events.size()).arg(chanid));
+    }
+
+    return count;
+}
+
 ProgInfo::ProgInfo(const ProgInfo &other) :
     DBEvent(other.m_listingsource)
 {
@@ -3,6 +3,7 @@
 
 // C++ headers
 #include <cstdint>
+#include <map>
 #include <utility>
 #include <vector>
 
@@ -81,10 +82,15 @@ class MTV_PUBLIC EventRating
 
 class MTV_PUBLIC DBEvent
 {
+    friend class ProgramWindow;
+    friend class TestProgramData;
   public:
     explicit DBEvent(uint listingsource) :
         m_listingsource(listingsource) {}
 
+    DBEvent(const DBEvent &other) :
+        m_listingsource(other.m_listingsource) { *this = other; }
+
     DBEvent(QString   _title,     QString _subtitle,
             QString   _desc,
             QString   _category,  ProgramInfo::CategoryType _category_type,
@@ -122,6 +128,9 @@ class MTV_PUBLIC DBEvent
                    int priority = 0, const QString &character = "");
 
     uint UpdateDB(MSqlQuery &query, uint chanid, int match_threshold) const;
+    static uint UpdateDBBatch(MSqlQuery &query, uint chanid,
+                              const std::vector<DBEvent> &events,
+                              int match_threshold);
 
     bool HasCredits(void) const { return m_credits; }
     bool HasTimeConflict(const DBEvent &other) const;
@@ -137,6 +146,7 @@ class MTV_PUBLIC DBEvent
         MSqlQuery &q, uint chanid, const std::vector<DBEvent> &p, int match) const;
     uint UpdateDB(
         MSqlQuery &query, uint chanid, const DBEvent &match) const;
+    DBEvent Merge(const DBEvent &match) const;
     bool MoveOutOfTheWayDB(
         MSqlQuery &query, uint chanid, const DBEvent &prog) const;
     virtual uint InsertDB(MSqlQuery &query, uint chanid,
@@ -174,6 +184,76 @@ class MTV_PUBLIC DBEvent
     uint                      m_totalepisodes   {0};
 };
 
+/** \brief In-memory copy of the program rows of one channel in a time window.
+ *
+ *  DBEvent::UpdateDBBatch() loads the window once, applies each event to it
+ *  with the same overlap, match and move-out-of-the-way rules that
+ *  DBEvent::UpdateDB() applies to the database, and then writes the net
+ *  result back. The window only holds program table columns; credits,
+ *  ratings and genres are referenced through the events that produced a row.
+ */
+class MTV_PUBLIC ProgramWindow
+{
+  public:
+    enum RowState : std::uint8_t
+    {
+        kRowUnchanged = 0, ///< as loaded from the database
+        kRowMoved,         ///< start and/or end time changed
+        kRowUpdated,       ///< updated from a matching event
+        kRowInserted,      ///< not in the database yet
+    };
+
+    struct Row
+    {
+        explicit Row(const DBEvent &program, RowState state) :
+            m_program(program), m_state(state) {}
+
+        DBEvent   m_program;       ///< program columns, no credits etc.
+        QDateTime m_origStarttime; ///< key in the database, invalid if new
+        RowState  m_state;
+        std::vector<const DBEvent*> m_events; ///< credits/ratings/genres
+    };
+    using RowMap = std::map<QDateTime, Row>;
+
+    void AddRow(const DBEvent &program);
+    void AddManualRow(const QDateTime &starttime);
+
+    uint Apply(const DBEvent &event, int match_threshold,
+               const QDateTime &now);
+
+    const RowMap &GetRows(void) const { return m_rows; }
+    /// Database keys of rows that must be deleted
+    const std::vector<QDateTime> &GetDeleted(void) const { return m_deleted; }
+    /// Start time changes that must be applied to the record table, in order
+    const std::vector<std::pair<QDateTime,QDateTime> > &GetRecordChanges(void) const
+        { return m_recordChanges; }
+
+    /// One change of the database key of a row, see GetWriteOrder()
+    struct WriteStep
+    {
+        const Row *m_row;
+        QDateTime  m_from;  ///< database key before this step
+        QDateTime  m_to;    ///< database key after this step
+        bool       m_final; ///< m_to is the start time of the row
+    };
+    std::vector<WriteStep> GetWriteOrder(void) const;
+
+  private:
+    bool Exists(const QDateTime &starttime) const;
+    void Insert(const DBEvent &event);
+    uint Update(const DBEvent &event, const DBEvent &match);
+    void MoveOutOfTheWay(const DBEvent &event, const DBEvent &prog);
+    void Delete(const QDateTime &starttime);
+    void Remove(const QDateTime &starttime);
+    void Move(const QDateTime &starttime,
+              const QDateTime &newstart, const QDateTime &newend);
+
+    RowMap                  m_rows;
+    std::vector<QDateTime>  m_manual;
+    std::vector<QDateTime>  m_deleted;
+    std::vector<std::pair<QDateTime,QDateTime> > m_recordChanges;
+};
+
 class MTV_PUBLIC DBEventEIT : public DBEvent
 {
   public:
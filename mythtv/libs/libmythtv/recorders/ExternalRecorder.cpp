@@ -81,6 +81,7 @@ void ExternalRecorder::run(void)
 
     m_streamData->AddAVListener(this);
     m_streamData->AddWritingListener(this);
+    SetWriterGroup(m_streamHandler->GetWriterGroup());
     m_streamHandler->AddListener(m_streamData, false, true);
 
     StartStreaming();
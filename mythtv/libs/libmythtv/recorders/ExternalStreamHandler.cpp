@@ -72,7 +72,6 @@ ExternIO::~ExternIO(void)
     close(m_appErr);
 
     // waitpid(m_pid, &status, 0);
-    delete[] m_buffer;
 }
 
 bool ExternIO::Ready([[maybe_unused]] int fd,
@@ -109,7 +108,7 @@ bool ExternIO::Ready([[maybe_unused]] int fd,
     return false;
 }
 
-int ExternIO::Read(QByteArray & buffer, int maxlen, std::chrono::milliseconds timeout)
+int ExternIO::Read(MythByteQueue & buffer, int maxlen, std::chrono::milliseconds timeout)
 {
     if (Error())
     {
@@ -122,14 +121,8 @@ int ExternIO::Read(QByteArray & buffer, int maxlen, std::chrono::milliseconds ti
     if (!Ready(m_appOut, timeout, "data"))
         return 0;
 
-    if (m_bufSize < maxlen)
-    {
-        m_bufSize = maxlen;
-        delete [] m_buffer;
-        m_buffer = new char[m_bufSize];
-    }
-
-    int len = read(m_appOut, m_buffer, maxlen);
+    // Read straight into the queue
+    int len = read(m_appOut, buffer.GetWriteBuffer(maxlen), maxlen);
 
     if (len < 0)
     {
@@ -160,14 +153,14 @@ int ExternIO::Read(QByteArray & buffer, int maxlen, std::chrono::milliseconds ti
         m_errCnt = 0;
     }
 
-    if (len == 0)
+    if (len <= 0)
         return 0;
 
-    buffer.append(m_buffer, len);
+    buffer.Commit(len);
 
     LOG(VB_RECORD, LOG_DEBUG,
         QString("ExternIO::Read '%1' bytes, buffer size %2")
-        .arg(len).arg(buffer.size()));
+        .arg(len).arg(buffer.Size()));
 
     return len;
 }
@@ -580,7 +573,7 @@ void ExternalStreamHandler::run(void)
 {
     QString    result;
     QString    ready_cmd;
-    QByteArray buffer;
+    MythByteQueue buffer;
     int        sz = 0;
     uint       len = 0;
     uint       read_len = 0;
@@ -631,7 +624,7 @@ void ExternalStreamHandler::run(void)
 
         if (!m_xon || m_pollMode)
         {
-            if (buffer.size() > TOO_FAST_SIZE)
+            if (buffer.Size() > TOO_FAST_SIZE)
             {
                 LOG(VB_RECORD, LOG_WARNING, LOC +
                     "Internal buffer too full to accept more data from "
@@ -686,7 +679,7 @@ void ExternalStreamHandler::run(void)
                 status_timer.restart();
             }
 
-            if (buffer.size() > TOO_FAST_SIZE)
+            if (buffer.Size() > TOO_FAST_SIZE)
             {
                 if (!m_pollMode)
                 {
@@ -743,7 +736,7 @@ void ExternalStreamHandler::run(void)
             std::this_thread::sleep_for(50ms);
 
             // HLS type streams may only produce data every ~10 seconds
-            if (nodata_timer.elapsed() < 12s && buffer.size() < TS_PACKET_SIZE)
+            if (nodata_timer.elapsed() < 12s && buffer.Size() < TS_PACKET_SIZE)
                 continue;
         }
         else
@@ -768,7 +761,7 @@ void ExternalStreamHandler::run(void)
             break;
         }
 
-        len = remainder = buffer.size();
+        len = remainder = buffer.Size();
 
         if (len == 0)
             continue;
@@ -800,22 +793,20 @@ void ExternalStreamHandler::run(void)
         for (auto sit = m_streamDataList.cbegin();
              sit != m_streamDataList.cend(); ++sit)
         {
-            remainder = sit.key()->ProcessData
-                        (reinterpret_cast<const uint8_t *>
-                         (buffer.constData()), buffer.size());
+            remainder = sit.key()->ProcessData(buffer.Data(), buffer.Size());
         }
 
         m_listenerLock.unlock();
 
         if (m_replay)
         {
-            m_replayBuffer += buffer.left(len - remainder);
-            if (m_replayBuffer.size() > (50 * PACKET_SIZE))
+            m_replayBuffer.Append(buffer.Data(), len - remainder);
+            if (m_replayBuffer.Size() > (50 * PACKET_SIZE))
             {
-                m_replayBuffer.remove(0, len - remainder);
+                m_replayBuffer.Consume(len - remainder);
                 LOG(VB_RECORD, LOG_WARNING, LOC +
                     QString("Replay size truncated to %1 bytes")
-                    .arg(m_replayBuffer.size()));
+                    .arg(m_replayBuffer.Size()));
             }
         }
 
@@ -823,12 +814,12 @@ void ExternalStreamHandler::run(void)
 
         if (remainder == 0)
         {
-            buffer.clear();
+            buffer.Clear();
             good_data = (len != 0U);
         }
         else if (len > remainder) // leftover bytes
         {
-            buffer.remove(0, len - remainder);
+            buffer.Consume(len - remainder);
             good_data = (len != 0U);
         }
         else if (len == remainder)
@@ -1109,14 +1100,13 @@ void ExternalStreamHandler::ReplayStream(void)
             for (auto sit = m_streamDataList.cbegin();
                  sit != m_streamDataList.cend(); ++sit)
             {
-                sit.key()->ProcessData(reinterpret_cast<const uint8_t *>
-                                       (m_replayBuffer.constData()),
-                                       m_replayBuffer.size());
+                sit.key()->ProcessData(m_replayBuffer.Data(),
+                                       m_replayBuffer.Size());
             }
         }
         LOG(VB_RECORD, LOG_INFO, LOC + QString("Replayed %1 bytes")
-            .arg(m_replayBuffer.size()));
-        m_replayBuffer.clear();
+            .arg(m_replayBuffer.Size()));
+        m_replayBuffer.Clear();
         m_replay = false;
 
         // Let the external app know that we are ready
@@ -1720,7 +1710,7 @@ void ExternalStreamHandler::PurgeBuffer(void)
 {
     if (m_io)
     {
-        QByteArray buffer;
+        MythByteQueue buffer;
         m_io->Read(buffer, PACKET_SIZE, 1ms);
         m_io->GetStatus(1ms);
     }
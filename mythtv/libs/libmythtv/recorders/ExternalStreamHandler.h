@@ -19,6 +19,7 @@
 #include <QStringList>
 #include <QTextStream>
 
+#include "libmythbase/mythbytequeue.h"
 #include "libmythbase/mythchrono.h"
 
 #include "streamhandler.h"
@@ -35,7 +36,7 @@ class ExternIO
     ~ExternIO(void);
 
     bool Ready(int fd, std::chrono::milliseconds timeout, const QString & what);
-    int Read(QByteArray & buffer, int maxlen, std::chrono::milliseconds timeout = 2500ms);
+    int Read(MythByteQueue & buffer, int maxlen, std::chrono::milliseconds timeout = 2500ms);
     QByteArray GetStatus(std::chrono::milliseconds timeout = 2500ms);
     int Write(const QByteArray & buffer);
     bool Run(void);
@@ -56,9 +57,6 @@ class ExternIO
     pid_t       m_pid     {-1};
     QString     m_error;
 
-    int         m_bufSize {0};
-    char       *m_buffer  {nullptr};
-
     QString     m_statusBuf;
     QTextStream m_status;
     int         m_errCnt  {0};
@@ -141,7 +139,7 @@ class ExternalStreamHandler : public StreamHandler
     bool          m_hasTuner             {false};
     bool          m_hasPictureAttributes {false};
 
-    QByteArray    m_replayBuffer;
+    MythByteQueue m_replayBuffer;
     bool          m_replay               {false};
     bool          m_xon                  {false};
 
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <sys/time.h>
 #include <unistd.h>
 
@@ -11,6 +13,10 @@
 
 #define LOC QString("%1: ").arg(m_curstream ? m_curstream->M3U8Url() : "HLSReader")
 
+// Only pick a variant whose bitrate fits in this share of the measured
+// download throughput, to leave room for variation in segment sizes.
+static constexpr uint64_t kThroughputHeadroom { 80 };
+
 /**
  * Handles relative URLs without breaking URI encoded parameters by avoiding
  * storing the decoded URL in a QString.
@@ -130,6 +136,14 @@ bool HLSReader::Open(const QString & m3u, int bitrate_index)
 
     QMutexLocker worker_lock(&m_workerLock);
 
+    m_throughput = 0;
+    for (int i = 1; i < m_fetchCount; ++i)
+    {
+        auto *fetcher = new HLSSegmentFetcher(i);
+        fetcher->start();
+        m_fetchers.push_back(fetcher);
+    }
+
     m_playlistWorker = new HLSPlaylistWorker(this);
     m_playlistWorker->start();
 
@@ -160,6 +174,9 @@ void HLSReader::Close(bool quiet)
     m_streamWorker = nullptr;
     delete m_playlistWorker;
     m_playlistWorker = nullptr;
+    for (auto *fetcher : m_fetchers)
+        delete fetcher;
+    m_fetchers.clear();
 
     LOG(VB_RECORD, (quiet ? LOG_DEBUG : LOG_INFO), LOC + "Close -- end");
 }
@@ -182,6 +199,10 @@ void HLSReader::Cancel(bool quiet)
     if (m_playlistWorker)
         m_playlistWorker->Cancel();
 
+    // The stream worker may be waiting for these
+    for (auto *fetcher : m_fetchers)
+        fetcher->Cancel();
+
     if (m_streamWorker)
         m_streamWorker->Cancel();
 
@@ -222,19 +243,12 @@ qint64 HLSReader::Read(uint8_t* buffer, qint64 maxlen)
 
     QMutexLocker lock(&m_bufLock);
 
-    qint64 len = m_buffer.size() < maxlen ? m_buffer.size() : maxlen;
+    qint64 len = std::min(static_cast<qint64>(m_buffer.Size()), maxlen);
     LOG(VB_RECORD, LOG_DEBUG, LOC + QString("Reading %1 of %2 bytes")
-        .arg(len).arg(m_buffer.size()));
+        .arg(len).arg(m_buffer.Size()));
 
-    memcpy(buffer, m_buffer.constData(), len);
-    if (len < m_buffer.size())
-    {
-        m_buffer.remove(0, len);
-    }
-    else
-    {
-        m_buffer.clear();
-    }
+    memcpy(buffer, m_buffer.Data(), len);
+    m_buffer.Consume(len);
 
     return len;
 }
@@ -622,6 +636,8 @@ bool HLSReader::ParseM3U8(const QByteArray& buffer, HLSRecStream* stream)
             m_workerLock.lock();
             if (m_streamWorker)
                 m_streamWorker->CancelCurrentDownload();
+            for (auto *fetcher : m_fetchers)
+                fetcher->CancelCurrentDownload();
             m_workerLock.unlock();
 
             EnableDebugging();
@@ -658,8 +674,27 @@ bool HLSReader::LoadMetaPlaylists(MythSingleDownload& downloader)
     if (m_bandwidthCheck /* && !m_segments.empty() */)
     {
         int buffered = PercentBuffered();
+        uint64_t throughput = m_throughput;
 
-        if (buffered < 15)
+        if (m_bitrateIndex == 0 && throughput > 0 && m_streams.size() > 1)
+        {
+            // Pick the variant the measured throughput can sustain. Drop
+            // to it straight away, but only move up with a healthy buffer.
+            HLSRecStream *hls = StreamForThroughput(m_curstream->Id(),
+                                                    throughput);
+            uint64_t bitrate = m_curstream->Bitrate();
+            if (hls && hls != m_curstream &&
+                (hls->Bitrate() < bitrate || buffered >= 50))
+            {
+                LOG(VB_RECORD, LOG_INFO, LOC +
+                    QString("Switching bitrate %1 -> %2, throughput %3kiB/s")
+                    .arg(bitrate).arg(hls->Bitrate())
+                    .arg(throughput / 8192));
+                m_curstream = hls;
+            }
+            m_bandwidthCheck = false;
+        }
+        else if (buffered < 15)
         {
             // It is taking too long to download the segments
             LOG(VB_RECORD, LOG_WARNING, LOC +
@@ -787,6 +822,27 @@ void HLSReader::IncreaseBitrate(int progid)
     }
 }
 
+HLSRecStream *HLSReader::StreamForThroughput(int progid,
+                                             uint64_t throughput) const
+{
+    HLSRecStream *best = nullptr;
+    HLSRecStream *lowest = nullptr;
+    uint64_t usable = throughput * kThroughputHeadroom / 100;
+
+    for (auto *stream : std::as_const(m_streams))
+    {
+        if (stream->Id() != progid)
+            continue;
+        if (stream->Bitrate() <= usable &&
+            (best == nullptr || stream->Bitrate() > best->Bitrate()))
+            best = stream;
+        if (lowest == nullptr || stream->Bitrate() < lowest->Bitrate())
+            lowest = stream;
+    }
+
+    return best ? best : lowest;
+}
+
 bool HLSReader::LoadSegments(MythSingleDownload& downloader)
 {
     LOG(VB_RECORD, LOG_DEBUG, LOC + "LoadSegment -- start");
@@ -798,7 +854,7 @@ bool HLSReader::LoadSegments(MythSingleDownload& downloader)
         return false;
     }
 
-    HLSRecSegment seg;
+    SegmentContainer batch;
     for (;;)
     {
         m_seqLock.lock();
@@ -808,20 +864,25 @@ bool HLSReader::LoadSegments(MythSingleDownload& downloader)
             break;
         }
 
-        seg = m_segments.front();
+        // Download the next few segments at the same time. They are
+        // appended to the buffer in playlist order once all are done.
+        int count = std::min(static_cast<int>(m_segments.size()),
+                             static_cast<int>(m_fetchers.size()) + 1);
+        batch = m_segments.mid(0, count);
+        const HLSRecSegment &seg = batch.front();
         if (m_segments.size() > m_playlistSize)
         {
             LOG(VB_RECORD, (m_debug ? LOG_INFO : LOG_DEBUG), LOC +
-                QString("Downloading segment %1 (1 of %2) with %3 behind")
-                .arg(seg.Sequence())
+                QString("Downloading segments %1-%2 (1 of %3) with %4 behind")
+                .arg(seg.Sequence()).arg(batch.back().Sequence())
                 .arg(m_segments.size() + m_playlistSize)
                 .arg(m_segments.size() - m_playlistSize));
         }
         else
         {
             LOG(VB_RECORD, (m_debug ? LOG_INFO : LOG_DEBUG), LOC +
-                QString("Downloading segment %1 (%2 of %3)")
-                .arg(seg.Sequence())
+                QString("Downloading segments %1-%2 (%3 of %4)")
+                .arg(seg.Sequence()).arg(batch.back().Sequence())
                 .arg(m_playlistSize - m_segments.size() + 1)
                 .arg(m_playlistSize));
         }
@@ -836,25 +897,64 @@ bool HLSReader::LoadSegments(MythSingleDownload& downloader)
             return false;
         }
 
-        long throttle = DownloadSegmentData(downloader,hls,seg,m_playlistSize);
+        auto start = nowAsDuration<std::chrono::milliseconds>();
+        for (int i = 1; i < batch.size(); ++i)
+            m_fetchers[i - 1]->Fetch(batch[i]);
 
-        m_seqLock.lock();
-        if (throttle < 0)
+        QVector<QByteArray> buffers(batch.size());
+        QVector<bool> fetched(batch.size(), false);
+        fetched[0] = FetchSegment(downloader, seg, buffers[0]);
+        for (int i = 1; i < batch.size(); ++i)
+            fetched[i] = m_fetchers[i - 1]->Wait(buffers[i]);
+
+        uint64_t bytes = 0;
+        for (int i = 0; i < batch.size() && fetched[i]; ++i)
+            bytes += buffers[i].size();
+        UpdateThroughput(hls, bytes,
+                         nowAsDuration<std::chrono::milliseconds>() - start);
+
+        long throttle = 0;
+        for (int i = 0; i < batch.size(); ++i)
         {
-            if (m_segments.size() > m_playlistSize)
+            // Stop at the first failure so the output has no gaps; the
+            // stream worker retries from that segment.
+            int slow = fetched[i] ?
+                AppendSegment(downloader, hls, batch[i], buffers[i],
+                              m_playlistSize) : -1;
+
+            m_seqLock.lock();
+            if (slow < 0)
             {
-                SegmentContainer::iterator Iseg = m_segments.begin() +
+                if (m_segments.size() > m_playlistSize)
+                {
+                    SegmentContainer::iterator Iseg = m_segments.begin() +
                                           (m_segments.size() - m_playlistSize);
-                m_segments.erase(m_segments.begin(), Iseg);
+                    m_segments.erase(m_segments.begin(), Iseg);
+                }
+                m_seqLock.unlock();
+                return false;
             }
+
+            // The playlist worker may have skipped past this segment.
+            while (!m_segments.empty() &&
+                   m_segments.front().Sequence() <= batch[i].Sequence())
+                m_segments.pop_front();
+            m_curSeq = batch[i].Sequence();
+
             m_seqLock.unlock();
-            return false;
-        }
 
-        m_curSeq = m_segments.front().Sequence();
-        m_segments.pop_front();
+            throttle = std::max(throttle, static_cast<long>(slow));
 
-        m_seqLock.unlock();
+            if (m_prebufferCnt == 0)
+            {
+                m_bandwidthCheck = (m_bitrateIndex == 0);
+                m_prebufferCnt = 2;
+            }
+            else
+            {
+                --m_prebufferCnt;
+            }
+        }
 
         if (m_throttle && throttle == 0)
             throttle = 2;
@@ -876,16 +976,6 @@ bool HLSReader::LoadSegments(MythSingleDownload& downloader)
         {
             usleep(5000);
         }
-
-        if (m_prebufferCnt == 0)
-        {
-            m_bandwidthCheck = (m_bitrateIndex == 0);
-            m_prebufferCnt = 2;
-        }
-        else
-        {
-            --m_prebufferCnt;
-        }
     }
 
     LOG(VB_RECORD, LOG_DEBUG, LOC + "LoadSegment -- end");
@@ -900,14 +990,57 @@ uint HLSReader::PercentBuffered(void) const
             static_cast<float>(m_playlistSize)) * 100.0F;
 }
 
-int HLSReader::DownloadSegmentData(MythSingleDownload& downloader,
-                                   HLSRecStream* hls,
-                                   const HLSRecSegment& segment, int playlist_size)
+bool HLSReader::FetchSegment(MythSingleDownload& downloader,
+                             const HLSRecSegment& segment, QByteArray& buffer)
+{
+#ifdef HLS_USE_MYTHDOWNLOADMANAGER // MythDownloadManager leaks memory
+                                   // and can only handle six download at a time
+    if (!HLSReader::DownloadURL(segment.Url(), &buffer))
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC +
+            QString("%1 failed").arg(segment.Sequence()));
+        return false;
+    }
+#else
+    if (!downloader.DownloadURL(segment.Url(), &buffer))
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC + QString("%1 failed: %2")
+            .arg(segment.Sequence()).arg(downloader.ErrorString()));
+        return false;
+    }
+#endif
+    return true;
+}
+
+void HLSReader::UpdateThroughput(HLSRecStream* hls, uint64_t bytes,
+                                 std::chrono::milliseconds elapsed)
+{
+    if (bytes == 0)
+        return;
+    if (elapsed < 1ms)
+        elapsed = 1ms;
+
+    /* bits/sec, over all the segments downloaded together */
+    uint64_t bandwidth = 8 * 1000ULL * bytes / elapsed.count();
+    hls->AverageBandwidth(bandwidth);
+
+    uint64_t previous = m_throughput;
+    m_throughput = previous ? ((previous * 3) + bandwidth) / 4 : bandwidth;
+
+    LOG(VB_RECORD, (m_debug ? LOG_INFO : LOG_DEBUG), LOC +
+        QString("%1 bytes took %2ms: bandwidth:%3kiB/s")
+        .arg(bytes).arg(elapsed.count()).arg(bandwidth / 8192.0));
+}
+
+int HLSReader::AppendSegment(MythSingleDownload& downloader,
+                             HLSRecStream* hls,
+                             const HLSRecSegment& segment, QByteArray& buffer,
+                             int playlist_size)
 {
     uint64_t bandwidth = hls->AverageBandwidth();
 
     LOG(VB_RECORD, LOG_DEBUG, LOC +
-        QString("Downloading %1 bandwidth %2 bitrate %3")
+        QString("Appending %1 bandwidth %2 bitrate %3")
         .arg(segment.Sequence()).arg(bandwidth).arg(hls->Bitrate()));
 
     /* sanity check - can we download this segment on time? */
@@ -927,38 +1060,6 @@ int HLSReader::DownloadSegmentData(MythSingleDownload& downloader,
         }
     }
 
-    QByteArray buffer;
-    auto start = nowAsDuration<std::chrono::milliseconds>();
-
-#ifdef HLS_USE_MYTHDOWNLOADMANAGER // MythDownloadManager leaks memory
-                                   // and can only handle six download at a time
-    if (!HLSReader::DownloadURL(segment.Url(), &buffer))
-    {
-        LOG(VB_RECORD, LOG_ERR, LOC +
-            QString("%1 failed").arg(segment.Sequence()));
-        if (estimated_time * 2 < segment.Duration())
-        {
-            if (!HLSReader::DownloadURL(segment.Url(), &buffer))
-            {
-                LOG(VB_RECORD, LOG_ERR, LOC + QString("%1 failed")
-                    .arg(segment.Sequence()));
-                return -1;
-            }
-        }
-        else
-            return 0;
-    }
-#else
-    if (!downloader.DownloadURL(segment.Url(), &buffer))
-    {
-        LOG(VB_RECORD, LOG_ERR, LOC + QString("%1 failed: %2")
-            .arg(segment.Sequence()).arg(downloader.ErrorString()));
-        return -1;
-    }
-#endif
-
-    auto downloadduration = nowAsDuration<std::chrono::milliseconds>() - start;
-
 #ifdef USING_LIBCRYPTO
     /* If the segment is encrypted, decode it */
     if (segment.HasKeyPath())
@@ -968,21 +1069,25 @@ int HLSReader::DownloadSegmentData(MythSingleDownload& downloader,
                              buffer, segment.Sequence()))
             return 0;
     }
+#else
+    (void) downloader;
 #endif
 
     int segment_len = buffer.size();
 
     m_bufLock.lock();
-    if (m_buffer.size() > segment_len * playlist_size)
+    auto buffered = static_cast<int64_t>(m_buffer.Size());
+    if (buffered > static_cast<int64_t>(segment_len) * playlist_size)
     {
         LOG(VB_RECORD, LOG_WARNING, LOC +
             QString("streambuffer is not reading fast enough. "
-                    "buffer size %1").arg(m_buffer.size()));
+                    "buffer size %1").arg(buffered));
         EnableDebugging();
         if (++m_slowCnt > 15)
         {
             m_slowCnt = 15;
             m_fatal = true;
+            m_bufLock.unlock();
             return -1;
         }
     }
@@ -991,16 +1096,16 @@ int HLSReader::DownloadSegmentData(MythSingleDownload& downloader,
         --m_slowCnt;
     }
 
-    if (m_buffer.size() >= segment_len * playlist_size * 2)
+    if (buffered >= static_cast<int64_t>(segment_len) * playlist_size * 2)
     {
         LOG(VB_RECORD, LOG_WARNING, LOC +
             QString("streambuffer is not reading fast enough. "
                     "buffer size %1.  Dropping %2 bytes")
-            .arg(m_buffer.size()).arg(segment_len));
-        m_buffer.remove(0, segment_len);
+            .arg(buffered).arg(segment_len));
+        m_buffer.Consume(segment_len);
     }
 
-    m_buffer += buffer;
+    m_buffer.Append(buffer);
     m_bufLock.unlock();
 
     if (hls->Bitrate() == 0 && segment.Duration() > 0s)
@@ -1010,23 +1115,16 @@ int HLSReader::DownloadSegmentData(MythSingleDownload& downloader,
                                    ((double)segment.Duration().count())));
     }
 
-    if (downloadduration < 1ms)
-        downloadduration = 1ms;
-
-    /* bits/sec */
-    bandwidth = 8 * 1000ULL * segment_len / downloadduration.count();
-    hls->AverageBandwidth(bandwidth);
-    hls->SetCurrentByteRate(static_cast<uint64_t>
-                            ((static_cast<double>(segment_len) /
-                              static_cast<double>(segment.Duration().count()))));
+    if (segment.Duration() > 0s)
+    {
+        hls->SetCurrentByteRate(static_cast<uint64_t>
+                                ((static_cast<double>(segment_len) /
+                                  static_cast<double>(segment.Duration().count()))));
+    }
 
     LOG(VB_RECORD, (m_debug ? LOG_INFO : LOG_DEBUG), LOC +
-        QString("%1 took %3ms for %4 bytes: "
-                "bandwidth:%5kiB/s")
-        .arg(segment.Sequence())
-        .arg(downloadduration.count())
-        .arg(segment_len)
-        .arg(bandwidth / 8192.0));
+        QString("%1 appended %2 bytes")
+        .arg(segment.Sequence()).arg(segment_len));
 
     return m_slowCnt;
 }
@@ -1,6 +1,10 @@
 #ifndef HLS_READER_H
 #define HLS_READER_H
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include <QObject>
 #include <QString>
 #include <QUrl>
@@ -22,10 +26,12 @@
 #include "libmythbase/mythsingledownload.h"
 #endif
 
+#include "libmythbase/mythbytequeue.h"
 #include "libmythbase/mythlogging.h"
 #include "libmythtv/mythtvexp.h"
 
 #include "HLSSegment.h"
+#include "HLSSegmentFetcher.h"
 #include "HLSStream.h"
 #include "HLSStreamWorker.h"
 #include "HLSPlaylistWorker.h"
@@ -40,6 +46,8 @@ class MTV_PUBLIC  HLSReader
     using StreamContainer = QMap<QString, HLSRecStream* >;
     using SegmentContainer = QVector<HLSRecSegment>;
 
+    static constexpr int kMaxConcurrentFetches { 8 };
+
     HLSReader(void) = default;
     ~HLSReader(void);
 
@@ -48,6 +56,10 @@ class MTV_PUBLIC  HLSReader
     qint64 Read(uint8_t* buffer, qint64 len);
     void Throttle(bool val);
     bool IsThrottled(void) const { return m_throttle; }
+    /// Number of segments downloaded at the same time. Takes effect
+    /// the next time a stream is opened.
+    void SetConcurrentFetches(int count)
+    { m_fetchCount = std::clamp(count, 1, kMaxConcurrentFetches); }
     bool IsOpen(const QString& url) const
     { return m_curstream && m_m3u8 == url; }
     bool FatalError(void) const { return m_fatal; }
@@ -85,11 +97,17 @@ class MTV_PUBLIC  HLSReader
     bool ParseM3U8(const QByteArray & buffer, HLSRecStream* stream = nullptr);
     void DecreaseBitrate(int progid);
     void IncreaseBitrate(int progid);
+    HLSRecStream *StreamForThroughput(int progid, uint64_t throughput) const;
 
     // Downloading
     bool LoadSegments(HLSRecStream & hlsstream);
-    int DownloadSegmentData(MythSingleDownload& downloader, HLSRecStream* hls,
-			    const HLSRecSegment& segment, int playlist_size);
+    bool FetchSegment(MythSingleDownload& downloader,
+                      const HLSRecSegment& segment, QByteArray& buffer);
+    int AppendSegment(MythSingleDownload& downloader, HLSRecStream* hls,
+                      const HLSRecSegment& segment, QByteArray& buffer,
+                      int playlist_size);
+    void UpdateThroughput(HLSRecStream* hls, uint64_t bytes,
+                          std::chrono::milliseconds elapsed);
 
     // Debug
     void EnableDebugging(void);
@@ -111,6 +129,8 @@ class MTV_PUBLIC  HLSReader
 
     HLSPlaylistWorker *m_playlistWorker {nullptr};
     HLSStreamWorker   *m_streamWorker   {nullptr};
+    std::vector<HLSSegmentFetcher*> m_fetchers;
+    int                m_fetchCount     {3};
 
     int                m_playlistSize   {0};
     bool               m_bandwidthCheck {false};
@@ -125,7 +145,9 @@ class MTV_PUBLIC  HLSReader
 
     // Downloading
     int                m_slowCnt        {0};
-    QByteArray         m_buffer;
+    // Download throughput over all concurrent fetches (bits/sec)
+    std::atomic<uint64_t> m_throughput  {0};
+    MythByteQueue      m_buffer;
     QMutex             m_bufLock;
 };
 
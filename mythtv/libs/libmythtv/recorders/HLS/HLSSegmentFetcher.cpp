@@ -0,0 +1,113 @@
+#include "HLSSegmentFetcher.h"
+
+#include "libmythbase/mythlogging.h"
+
+#define LOC QString("HLSFetcher[%1]: ").arg(m_id)
+
+HLSSegmentFetcher::HLSSegmentFetcher(int id)
+    : MThread(QString("HLSFetch%1").arg(id)),
+      m_id(id)
+{
+    LOG(VB_RECORD, LOG_DEBUG, LOC + "ctor");
+}
+
+HLSSegmentFetcher::~HLSSegmentFetcher(void)
+{
+    LOG(VB_RECORD, LOG_DEBUG, LOC + "dtor");
+}
+
+void HLSSegmentFetcher::Fetch(const HLSRecSegment &segment)
+{
+    QMutexLocker lock(&m_lock);
+    m_segment = segment;
+    m_buffer.clear();
+    m_pending = true;
+    m_done = false;
+    m_ok = false;
+    m_waitCond.wakeAll();
+}
+
+bool HLSSegmentFetcher::Wait(QByteArray &buffer)
+{
+    QMutexLocker lock(&m_lock);
+    while (m_pending && !m_done && !m_cancel)
+        m_waitCond.wait(&m_lock);
+
+    bool ok = m_pending && m_done && m_ok;
+    if (ok)
+        buffer = std::move(m_buffer);
+    m_buffer.clear();
+    m_pending = false;
+    return ok;
+}
+
+void HLSSegmentFetcher::Cancel(void)
+{
+    LOG(VB_RECORD, LOG_DEBUG, LOC + "Cancel -- begin");
+    m_lock.lock();
+    m_cancel = true;
+    m_waitCond.wakeAll();
+    m_lock.unlock();
+    CancelCurrentDownload();
+    wait();
+    LOG(VB_RECORD, LOG_DEBUG, LOC + "Cancel -- end");
+}
+
+void HLSSegmentFetcher::CancelCurrentDownload(void)
+{
+    QMutexLocker locker(&m_downloaderLock);
+    if (m_downloader)
+        m_downloader->Cancel();
+}
+
+void HLSSegmentFetcher::run(void)
+{
+    RunProlog();
+
+    m_downloaderLock.lock();
+    m_downloader = new MythSingleDownload;
+    m_downloaderLock.unlock();
+
+    for (;;)
+    {
+        m_lock.lock();
+        while (!m_cancel && (!m_pending || m_done))
+            m_waitCond.wait(&m_lock);
+        if (m_cancel)
+        {
+            m_lock.unlock();
+            break;
+        }
+        HLSRecSegment segment = m_segment;
+        m_lock.unlock();
+
+        QByteArray buffer;
+        bool ok = m_downloader->DownloadURL(segment.Url(), &buffer);
+        if (!ok)
+        {
+            LOG(VB_RECORD, LOG_WARNING, LOC + QString("%1 failed: %2")
+                .arg(segment.Sequence()).arg(m_downloader->ErrorString()));
+
+            // As in HLSStreamWorker, a fresh instance is needed to
+            // download anything after a failure.
+            m_downloaderLock.lock();
+            delete m_downloader;
+            m_downloader = new MythSingleDownload;
+            m_downloaderLock.unlock();
+        }
+
+        m_lock.lock();
+        m_buffer = std::move(buffer);
+        m_ok = ok;
+        m_done = true;
+        m_waitCond.wakeAll();
+        m_lock.unlock();
+    }
+
+    m_downloaderLock.lock();
+    delete m_downloader;
+    m_downloader = nullptr;
+    m_downloaderLock.unlock();
+
+    RunEpilog();
+}
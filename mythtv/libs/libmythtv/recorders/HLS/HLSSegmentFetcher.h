@@ -0,0 +1,53 @@
+#ifndef HLS_SEGMENT_FETCHER_H
+#define HLS_SEGMENT_FETCHER_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "libmythbase/mthread.h"
+#include "libmythbase/mythsingledownload.h"
+
+#include "HLSSegment.h"
+
+/** \class HLSSegmentFetcher
+ *  \brief Downloads one segment at a time ahead of the stream worker.
+ *
+ *  The stream worker hands the segments that follow the one it is
+ *  downloading itself to a few of these, then collects the data in
+ *  playlist order. Each fetcher keeps its MythSingleDownload between
+ *  segments so the HTTP connection to the server is reused.
+ */
+class HLSSegmentFetcher : public MThread
+{
+  public:
+    explicit HLSSegmentFetcher(int id);
+    ~HLSSegmentFetcher(void) override;
+
+    /// Starts downloading \p segment. The previous result must have
+    /// been collected with Wait().
+    void Fetch(const HLSRecSegment &segment);
+    /// Blocks until the download started by Fetch() ends.
+    bool Wait(QByteArray &buffer);
+
+    void Cancel(void);
+    void CancelCurrentDownload(void);
+
+  protected:
+    void run() override; // MThread
+
+  private:
+    int                 m_id         {0};
+    MythSingleDownload *m_downloader {nullptr};
+    HLSRecSegment       m_segment;
+    QByteArray          m_buffer;
+    bool                m_pending    {false};
+    bool                m_done       {false};
+    bool                m_ok         {false};
+    bool                m_cancel     {false};
+    QMutex              m_lock;
+    QMutex              m_downloaderLock;
+    QWaitCondition      m_waitCond;
+};
+
+#endif // HLS_SEGMENT_FETCHER_H
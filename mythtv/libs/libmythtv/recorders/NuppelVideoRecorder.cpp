@@ -1834,6 +1834,8 @@ void NuppelVideoRecorder::Reset(void)
 
     if (m_curRecording)
         m_curRecording->ClearPositionMap(MARK_KEYFRAME);
+
+    ResetSeekIndex();
 }
 
 void NuppelVideoRecorder::doAudioThread(void)
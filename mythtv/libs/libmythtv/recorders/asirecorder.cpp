@@ -121,6 +121,7 @@ void ASIRecorder::run(void)
 
     m_streamData->AddAVListener(this);
     m_streamData->AddWritingListener(this);
+    SetWriterGroup(m_streamHandler->GetWriterGroup());
     m_streamHandler->AddListener(
         m_streamData, false, true,
         (m_recordMpts) ? m_ringBuffer->GetFilename() : QString());
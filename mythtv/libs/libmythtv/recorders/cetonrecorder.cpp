@@ -74,6 +74,7 @@ void CetonRecorder::run(void)
 
     m_streamData->AddAVListener(this);
     m_streamData->AddWritingListener(this);
+    SetWriterGroup(m_streamHandler->GetWriterGroup());
     m_streamHandler->AddListener(m_streamData);
 
     while (IsRecordingRequested() && !IsErrored())
@@ -18,6 +18,8 @@
  *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
+#include <algorithm>
+
 #include "libmythbase/mythlogging.h"
 #include "libmythbase/programinfo.h"
 #include "libmythbase/sizetliteral.h"
@@ -134,6 +136,9 @@ void DTVRecorder::FinishRecording(void)
         SetTotalFrames(m_framesWrittenCount);
     }
 
+    if (m_streamData)
+        m_streamData->GetTSStats().Publish();
+
     RecorderBase::FinishRecording();
 }
 
@@ -191,6 +196,8 @@ void DTVRecorder::ClearStatistics(void)
     //m_tsFirst_dt -- doesn't need to be cleared only used if m_tsFirst>=0
     m_packetCount.fetchAndStoreRelaxed(0);
     m_continuityErrorCount.fetchAndStoreRelaxed(0);
+    if (m_streamData)
+        m_streamData->GetTSStats().Reset();
     m_framesSeenCount            = 0;
     m_framesWrittenCount         = 0;
     m_totalDuration              = 0;
@@ -213,6 +220,7 @@ void DTVRecorder::Reset(void)
         m_curRecording->ClearPositionMap(MARK_GOP_BYFRAME);
         m_curRecording->ClearPositionMap(MARK_DURATION_MS);
     }
+    ResetSeekIndex();
 }
 
 void DTVRecorder::SetStreamData(MPEGStreamData *data)
@@ -271,6 +279,9 @@ void DTVRecorder::BufferedWrite(const TSPacket &tspacket, bool insert)
             m_timeOfFirstData = MythDate::current();
             m_timeOfLatestData = MythDate::current();
             m_timeOfLatestDataTimer.start();
+            locker.unlock();
+            if (m_tvrec)
+                m_tvrec->GetTuningTrace()->Mark(TuningTrace::kFirstWrite);
         }
 
         int val = m_timeOfLatestDataCount.fetchAndAddRelaxed(1);
@@ -841,6 +852,8 @@ void DTVRecorder::HandleKeyframe(int64_t extra)
     {
         m_firstKeyframe = frameNum;
         SendMythSystemRecEvent("REC_STARTED_WRITING", m_curRecording);
+        if (m_tvrec)
+            m_tvrec->GetTuningTrace()->Mark(TuningTrace::kFirstKeyframe);
     }
 
     // Add key frame to position map
@@ -1708,7 +1721,32 @@ RecordingQuality *DTVRecorder::GetRecordingQuality(const RecordingInfo *r) const
     recq->AddTSStatistics(
         m_continuityErrorCount.fetchAndAddRelaxed(0),
         m_packetCount.fetchAndAddRelaxed(0));
+
+    // On a multirec input the stream data sees every packet of the
+    // multiplex, only keep the PIDs that went into this recording.
+    TSStats::PIDStatsList stats = GetTSStatistics();
+    if (m_streamData && !m_recordMptsOnly)
+    {
+        auto unused = [this](const TSStats::PIDStats &pid)
+        {
+            return !m_streamData->IsVideoPID(pid.m_pid) &&
+                   !m_streamData->IsAudioPID(pid.m_pid) &&
+                   !m_streamData->IsWritingPID(pid.m_pid) &&
+                   !m_streamData->IsListeningPID(pid.m_pid);
+        };
+        stats.erase(std::remove_if(stats.begin(), stats.end(), unused),
+                    stats.end());
+    }
+    recq->AddPIDStatistics(stats);
     return recq;
 }
 
+/// \brief Returns the per PID statistics of the stream being recorded.
+TSStats::PIDStatsList DTVRecorder::GetTSStatistics(void) const
+{
+    if (!m_streamData)
+        return {};
+    return m_streamData->GetTSStats().GetSnapshot();
+}
+
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
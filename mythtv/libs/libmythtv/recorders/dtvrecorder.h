@@ -16,6 +16,7 @@
 
 #include "libmythtv/mpeg/H2645Parser.h"
 #include "libmythtv/mpeg/streamlisteners.h"
+#include "libmythtv/mpeg/tsstats.h"
 #include "libmythtv/recorders/recorderbase.h"
 #include "libmythtv/scantype.h"
 
@@ -60,6 +61,7 @@ class DTVRecorder :
     void Reset(void) override; // RecorderBase
     void ClearStatistics(void) override; // RecorderBase
     RecordingQuality *GetRecordingQuality(const RecordingInfo *r) const override; // RecorderBase
+    TSStats::PIDStatsList GetTSStatistics(void) const;
 
     // MPEG Stream Listener
     void HandlePAT(const ProgramAssociationTable *_pat) override; // MPEGStreamListener
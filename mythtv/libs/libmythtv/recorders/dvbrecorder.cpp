@@ -124,6 +124,7 @@ void DVBRecorder::run(void)
 
     m_streamData->AddAVListener(this);
     m_streamData->AddWritingListener(this);
+    SetWriterGroup(m_streamHandler->GetWriterGroup());
     m_streamHandler->AddListener(m_streamData, false, true,
                          (m_recordMpts) ? m_ringBuffer->GetFilename() : QString());
 
@@ -105,6 +105,7 @@ void HDHRRecorder::run(void)
 
     m_streamData->AddAVListener(this);
     m_streamData->AddWritingListener(this);
+    SetWriterGroup(m_streamHandler->GetWriterGroup());
     m_streamHandler->AddListener(m_streamData, false, false,
                          (m_recordMpts) ? m_ringBuffer->GetFilename() : QString());
 
@@ -10,6 +10,7 @@
 
 // MythTV headers
 #include "hlsstreamhandler.h"
+#include "libmythbase/mythcorecontext.h"
 #include "libmythbase/mythlogging.h"
 #include "recorders/HLS/HLSReader.h"
 
@@ -102,6 +103,8 @@ HLSStreamHandler::HLSStreamHandler(const IPTVTuningData& tuning, int inputid)
 {
     LOG(VB_GENERAL, LOG_INFO, LOC + "ctor");
     m_hls        = new HLSReader();
+    m_hls->SetConcurrentFetches(
+        gCoreContext->GetNumSetting("HLSConcurrentFetches", 3));
     m_readbuffer = new uint8_t[BUFFER_SIZE];
 }
 
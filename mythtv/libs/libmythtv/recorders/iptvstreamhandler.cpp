@@ -14,6 +14,7 @@
 #include <QUdpSocket>
 #include <QByteArray>
 #include <QHostInfo>
+#include <QSocketNotifier>
 
 // MythTV headers
 #include "libmythbase/mythlogging.h"
@@ -25,6 +26,7 @@
 #include "rtp/rtpfecpacket.h"
 #include "rtp/rtppacketbuffer.h"
 #include "rtp/rtptsdatapacket.h"
+#include "rtp/udpbatchreader.h"
 #include "rtp/udppacketbuffer.h"
 
 #define LOC QString("IPTVSH[%1](%2): ").arg(m_inputId).arg(m_device)
@@ -218,7 +220,6 @@ void IPTVStreamHandler::run(void)
             // the requested server
             m_sender[i] = dest_addr;
         }
-        m_readHelpers[i] = new IPTVStreamHandlerReadHelper(this,m_sockets[i],i);
 
         // we need to open the descriptor ourselves so we
         // can set some socket options
@@ -240,6 +241,27 @@ void IPTVStreamHandler::run(void)
                 QString("Increasing buffer size to %1 failed")
                 .arg(buf_size) + ENO);
         }
+        else
+        {
+            // The kernel silently caps the size at net.core.rmem_max, and
+            // on Linux reports back twice the usable size.
+            int actual = 0;
+            socklen_t len = sizeof(actual);
+            if (!getsockopt(fd, SOL_SOCKET, SO_RCVBUF, (char *)&actual, &len))
+            {
+#ifdef __linux__
+                actual /= 2;
+#endif
+                if (actual < buf_size)
+                {
+                    LOG(VB_GENERAL, LOG_WARNING, LOC +
+                        QString("Receive buffer limited to %1 of %2 bytes "
+                                "requested, consider raising "
+                                "net.core.rmem_max")
+                        .arg(actual).arg(buf_size));
+                }
+            }
+        }
 
         m_sockets[i]->setSocketDescriptor(
             fd, QAbstractSocket::UnconnectedState, QIODevice::ReadOnly);
@@ -268,6 +290,8 @@ void IPTVStreamHandler::run(void)
                 .arg(dest_addr.toString()));
         }
 
+        m_readHelpers[i] = new IPTVStreamHandlerReadHelper(this,m_sockets[i],i);
+
         if (!is_multicast && rtsp && i == 1)
         {
             m_rtcpDest = dest_addr;
@@ -339,14 +363,86 @@ IPTVStreamHandlerReadHelper::IPTVStreamHandlerReadHelper(
     m_parent(p), m_socket(s), m_sender(p->m_sender[stream]),
     m_stream(stream)
 {
+    int fd = static_cast<int>(m_socket->socketDescriptor());
+    if (UDPBatchReader::IsAvailable() && fd >= 0)
+    {
+        // Read the socket directly, QUdpSocket only hands out one
+        // datagram per system call. The reader has its own descriptor
+        // for the socket, the QUdpSocket's is watched by Qt already.
+        m_batchReader = new UDPBatchReader(
+            fd, QString("%1:%2").arg(m_parent->m_device).arg(m_stream));
+        if (m_batchReader->IsOK())
+        {
+            m_notifier = new QSocketNotifier(m_batchReader->Descriptor(),
+                                             QSocketNotifier::Read, this);
+            connect(m_notifier, &QSocketNotifier::activated,
+                    this,       &IPTVStreamHandlerReadHelper::ReadPending);
+            return;
+        }
+        delete m_batchReader;
+        m_batchReader = nullptr;
+    }
+
     connect(m_socket, &QIODevice::readyRead,
             this,     &IPTVStreamHandlerReadHelper::ReadPending);
 }
 
+IPTVStreamHandlerReadHelper::~IPTVStreamHandlerReadHelper()
+{
+    delete m_notifier;
+    delete m_batchReader;
+}
+
 #define LOC_WH QString("IPTVSH(%1): ").arg(m_parent->m_device)
 
+void IPTVStreamHandlerReadHelper::ReadBatches(void)
+{
+    PacketBuffer *buffer = m_parent->m_buffer;
+    if (!buffer)
+        return;
+
+    bool sender_null = m_sender.isNull();
+
+    int count = 0;
+    while ((count = m_batchReader->Read(buffer)) > 0)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            UDPPacket &packet = m_batchReader->Packet(i);
+            if (!sender_null)
+            {
+                QHostAddress sender = m_batchReader->Sender(i);
+                if (sender != m_sender)
+                {
+                    LOG(VB_RECORD, LOG_WARNING, LOC_WH +
+                        QString("Received on socket(%1) %2 bytes from non "
+                                "expected sender:%3 (expected:%4) ignoring")
+                        .arg(m_stream).arg(packet.GetDataReference().size())
+                        .arg(sender.toString(), m_sender.toString()));
+                    buffer->FreePacket(packet);
+                    continue;
+                }
+            }
+
+            if (0 == m_stream)
+                buffer->PushDataPacket(packet);
+            else
+                buffer->PushFECPacket(packet, m_stream - 1);
+        }
+
+        if (count < UDPBatchReader::kBatchSize)
+            break;
+    }
+}
+
 void IPTVStreamHandlerReadHelper::ReadPending(void)
 {
+    if (m_batchReader)
+    {
+        ReadBatches();
+        return;
+    }
+
     QHostAddress sender;
     quint16 senderPort = 0;
     bool sender_null = m_sender.isNull();
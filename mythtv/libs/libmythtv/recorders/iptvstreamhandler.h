@@ -24,6 +24,8 @@ class DTVSignalMonitor;
 class MPEGStreamData;
 class PacketBuffer;
 class IPTVChannel;
+class QSocketNotifier;
+class UDPBatchReader;
 
 class IPTVStreamHandlerReadHelper : public QObject
 {
@@ -31,15 +33,20 @@ class IPTVStreamHandlerReadHelper : public QObject
 
   public:
     IPTVStreamHandlerReadHelper(IPTVStreamHandler *p, QUdpSocket *s, uint stream);
+    ~IPTVStreamHandlerReadHelper() override;
 
   public slots:
     void ReadPending(void);
 
   private:
-    IPTVStreamHandler *m_parent {nullptr};
-    QUdpSocket        *m_socket {nullptr};
+    void ReadBatches(void);
+
+    IPTVStreamHandler *m_parent      {nullptr};
+    QUdpSocket        *m_socket      {nullptr};
     QHostAddress       m_sender;
     uint               m_stream;
+    UDPBatchReader    *m_batchReader {nullptr};
+    QSocketNotifier   *m_notifier    {nullptr};
 };
 
 class IPTVStreamHandlerWriteHelper : QObject
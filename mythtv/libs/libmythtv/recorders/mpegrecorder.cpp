@@ -1239,6 +1239,7 @@ void MpegRecorder::Reset(void)
     {
         m_curRecording->ClearPositionMap(MARK_GOP_BYFRAME);
     }
+    ResetSeekIndex();
     if (m_streamData)
         m_streamData->Reset(m_streamData->DesiredProgram());
 }
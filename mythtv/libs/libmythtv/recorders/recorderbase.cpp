@@ -1,9 +1,11 @@
 #include <algorithm> // for min
 #include <cstdint>
 
+#include "libmythbase/mythcorecontext.h"
 #include "libmythbase/mythdate.h"
 #include "libmythbase/mythlogging.h"
 #include "libmythbase/programinfo.h"
+#include "libmythbase/threadedfilewriter.h"
 
 #include "firewirerecorder.h"
 #include "recordingprofile.h"
@@ -70,6 +72,11 @@ RecorderBase::~RecorderBase(void)
         delete m_nextRecording;
         m_nextRecording = nullptr;
     }
+    if (m_writerGroup)
+    {
+        m_writerGroup->DecrRef();
+        m_writerGroup = nullptr;
+    }
 }
 
 void RecorderBase::SetRingBuffer(MythMediaBuffer *Buffer)
@@ -84,6 +91,21 @@ void RecorderBase::SetRingBuffer(MythMediaBuffer *Buffer)
     }
     m_ringBuffer = Buffer;
     m_weMadeBuffer = false;
+    if (m_ringBuffer && m_writerGroup)
+        m_ringBuffer->WriterSetGroup(m_writerGroup);
+}
+
+void RecorderBase::SetWriterGroup(TFWGroup *Group)
+{
+    if (Group == m_writerGroup)
+        return;
+    if (Group)
+        Group->IncrRef();
+    if (m_ringBuffer)
+        m_ringBuffer->WriterSetGroup(Group);
+    if (m_writerGroup)
+        m_writerGroup->DecrRef();
+    m_writerGroup = Group;
 }
 
 void RecorderBase::SetRecording(const RecordingInfo *pginfo)
@@ -492,6 +514,7 @@ void RecorderBase::FinishRecording(void)
         }
 
         SavePositionMap(true, true); // Save Position Map only, not file size
+        FinishSeekIndex();
 
         if (m_ringBuffer)
             m_curRecording->SaveFilesize(m_ringBuffer->GetRealFileSize());
@@ -628,11 +651,14 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
             m_positionMapDelta.clear();
             frm_pos_map_t durationDeltaCopy(m_durationMapDelta);
             m_durationMapDelta.clear();
+            bool fromStart = m_positionMap.empty() ||
+                m_positionMap.firstKey() >= deltaCopy.firstKey();
             m_positionMapLock.unlock();
 
             m_curRecording->SavePositionMapDelta(deltaCopy, m_positionMapType);
             m_curRecording->SavePositionMapDelta(durationDeltaCopy,
                                                MARK_DURATION_MS);
+            SaveSeekIndex(deltaCopy, durationDeltaCopy, fromStart);
 
             TryWriteProgStartMark(durationDeltaCopy);
         }
@@ -664,6 +690,99 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
     }
 }
 
+/**
+ *  \brief Appends a seektable delta to the seek index file kept next to
+ *         the recording, when seek index files are enabled.
+ *
+ *  \param fromStart False if the seektable already had entries older than
+ *         this delta. An index opened then is marked incomplete, and is
+ *         rebuilt from the database when the recording finishes.
+ */
+void RecorderBase::SaveSeekIndex(const frm_pos_map_t &posMap,
+                                 const frm_pos_map_t &durMap, bool fromStart)
+{
+    if (!m_ringBuffer)
+        return;
+
+    QMutexLocker locker(&m_seekIndexLock);
+
+    QString filename = m_ringBuffer->GetFilename();
+    if (filename != m_seekIndexFilename)
+    {
+        m_seekIndex.Close();
+        m_seekIndexFilename = filename;
+        m_seekIndexRebuild = false;
+        if (!gCoreContext->GetBoolSetting("SeekIndexFiles", false))
+            return;
+
+        if (!fromStart)
+        {
+            LOG(VB_RECORD, LOG_INFO, LOC +
+                QString("Seek index for '%1' started mid-recording, "
+                        "it will be rebuilt when the recording finishes")
+                .arg(filename));
+            m_seekIndexRebuild = true;
+        }
+
+        // The seektable of a new file starts out empty, so drop any index
+        // left behind by an earlier recording with the same name.
+        SeekIndexFile::Remove(filename);
+        if (!m_seekIndex.OpenForAppend(filename, fromStart))
+            return;
+    }
+
+    if (!m_seekIndex.IsOpenForAppend())
+        return;
+
+    if (!m_seekIndex.Append(posMap, m_positionMapType) ||
+        !m_seekIndex.Append(durMap, MARK_DURATION_MS))
+    {
+        // The index now misses part of the seektable; don't let players
+        // use it before it has been rebuilt.
+        SeekIndexFile::Remove(filename);
+        m_seekIndexRebuild = true;
+    }
+}
+
+/**
+ *  \brief Rewrites an incomplete seek index from the seektable in the
+ *         database once the recording has finished.
+ */
+void RecorderBase::FinishSeekIndex(void)
+{
+    QMutexLocker locker(&m_seekIndexLock);
+
+    m_seekIndex.Close();
+    if (!m_seekIndexRebuild || !m_curRecording)
+        return;
+    m_seekIndexRebuild = false;
+
+    QMap<MarkTypes, frm_pos_map_t> maps;
+    m_curRecording->QueryPositionMap(maps[m_positionMapType], m_positionMapType);
+    m_curRecording->QueryPositionMap(maps[MARK_DURATION_MS], MARK_DURATION_MS);
+    if (maps[m_positionMapType].isEmpty())
+        return;
+
+    LOG(VB_RECORD, LOG_INFO, LOC + QString("Rebuilding seek index for '%1'")
+        .arg(m_seekIndexFilename));
+    SeekIndexFile::Write(m_seekIndexFilename, maps);
+}
+
+/**
+ *  \brief Drops the seek index of the current file, for when the recorder
+ *         clears its seektable and starts again.
+ */
+void RecorderBase::ResetSeekIndex(void)
+{
+    QMutexLocker locker(&m_seekIndexLock);
+
+    m_seekIndex.Close();
+    if (!m_seekIndexFilename.isEmpty())
+        SeekIndexFile::Remove(m_seekIndexFilename);
+    m_seekIndexFilename.clear();
+    m_seekIndexRebuild = false;
+}
+
 void RecorderBase::TryWriteProgStartMark(const frm_pos_map_t &durationDeltaCopy)
 {
     // Note: all log strings contain "progstart mark" for searching.
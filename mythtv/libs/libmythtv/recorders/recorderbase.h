@@ -19,6 +19,7 @@
 #include "libmythtv/recordingfile.h"
 #include "libmythtv/recordingquality.h"
 #include "libmythtv/scantype.h"
+#include "libmythtv/seekindexfile.h"
 
 extern "C"
 {
@@ -33,6 +34,7 @@ class DVBDBOptions;
 class RecorderBase;
 class ChannelBase;
 class MythMediaBuffer;
+class TFWGroup;
 class TVRec;
 
 class FrameRate
@@ -100,6 +102,14 @@ class MTV_PUBLIC RecorderBase : public QRunnable
      */
     void SetRingBuffer(MythMediaBuffer *Buffer);
 
+    /** \brief Has the ringbuffer, and any it is switched to, write using
+     *         the threads of a writer group shared with other recorders.
+     *
+     *   The recorder keeps a reference to the group. Passing nullptr
+     *   gives the current ringbuffer its own writer threads back.
+     */
+    void SetWriterGroup(TFWGroup *Group);
+
     /** \brief Set an specific option.
      *
      *   Base options include: codec, videodevice,
@@ -305,10 +315,15 @@ class MTV_PUBLIC RecorderBase : public QRunnable
     void SetTotalFrames(uint64_t total_frames);
 
     void TryWriteProgStartMark(const frm_pos_map_t &durationDeltaCopy);
+    void SaveSeekIndex(const frm_pos_map_t &posMap,
+                       const frm_pos_map_t &durMap, bool fromStart);
+    void FinishSeekIndex(void);
+    void ResetSeekIndex(void);
 
     TVRec         *m_tvrec                {nullptr};
     MythMediaBuffer *m_ringBuffer         {nullptr};
     bool           m_weMadeBuffer         {true};
+    TFWGroup      *m_writerGroup          {nullptr};
 
     AVContainer    m_containerFormat      {formatUnknown};
     AVCodecID      m_primaryVideoCodec    {AV_CODEC_ID_NONE};
@@ -355,6 +370,10 @@ class MTV_PUBLIC RecorderBase : public QRunnable
     frm_pos_map_t  m_durationMap;
     frm_pos_map_t  m_durationMapDelta;
     MythTimer      m_positionMapTimer;
+    QMutex         m_seekIndexLock;
+    SeekIndexFile  m_seekIndex;
+    QString        m_seekIndexFilename;
+    bool           m_seekIndexRebuild     {false};
 
     // ProgStart mark support
     qint64         m_estimatedProgStartMS {0};
@@ -0,0 +1,244 @@
+/* -*- Mode: c++ -*-
+ * UDPBatchReader
+ * Distributed as part of MythTV under GPL v2 and later.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// MythTV headers
+#include "libmythbase/mythlogging.h"
+#include "packetbuffer.h"
+#include "udpbatchreader.h"
+
+#define LOC QString("UDPBatch(%1): ").arg(m_name)
+
+static constexpr std::chrono::seconds kStatsInterval { 10s };
+/// Lag behind the network worth a warning; the receive buffer is
+/// usually no more than a second or two deep.
+static constexpr int64_t kLagWarningUs { 250000 };
+
+#ifdef __linux__
+static constexpr size_t kControlSize =
+    CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(sizeof(uint32_t));
+
+struct UDPBatchState
+{
+    std::vector<struct mmsghdr>          m_msgs;
+    std::vector<struct iovec>            m_iovs;
+    std::vector<struct sockaddr_storage> m_addrs;
+    std::vector<char>                    m_control;
+};
+#else
+struct UDPBatchState {};
+#endif
+
+UDPBatchReader::UDPBatchReader(int fd, QString name)
+  : m_name(std::move(name)),
+    m_packets(kBatchSize)
+{
+#ifdef __linux__
+    if (fd < 0)
+        return;
+
+    m_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (m_fd < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to duplicate socket" + ENO);
+        return;
+    }
+
+    m_state = new UDPBatchState;
+    m_state->m_msgs.resize(kBatchSize);
+    m_state->m_iovs.resize(kBatchSize);
+    m_state->m_addrs.resize(kBatchSize);
+    m_state->m_control.resize(kBatchSize * kControlSize);
+
+    // Kernel receive timestamps and the count of datagrams dropped
+    // because the receive buffer was full. Both are optional.
+    int on = 1;
+    if (setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) < 0)
+        LOG(VB_RECORD, LOG_DEBUG, LOC + "No kernel timestamps" + ENO);
+    if (setsockopt(m_fd, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on)) < 0)
+        LOG(VB_RECORD, LOG_DEBUG, LOC + "No drop counter" + ENO);
+
+    m_ok = true;
+    m_statsTimer.start();
+#endif
+}
+
+UDPBatchReader::~UDPBatchReader()
+{
+    delete m_state;
+#ifdef __linux__
+    if (m_fd >= 0)
+        close(m_fd);
+#endif
+}
+
+bool UDPBatchReader::IsAvailable(void)
+{
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+int UDPBatchReader::Read(PacketBuffer *buffer)
+{
+#ifdef __linux__
+    if (!m_ok)
+        return -1;
+
+    for (int i = 0; i < kBatchSize; ++i)
+    {
+        if (buffer && i < m_handedOut)
+            m_packets[i] = buffer->GetEmptyPacket();
+
+        QByteArray &data = m_packets[i].GetDataReference();
+        if (data.size() != m_slotSize)
+            data.resize(m_slotSize);
+
+        m_state->m_iovs[i].iov_base = data.data();
+        m_state->m_iovs[i].iov_len  = m_slotSize;
+
+        struct msghdr &hdr = m_state->m_msgs[i].msg_hdr;
+        hdr.msg_name       = &m_state->m_addrs[i];
+        hdr.msg_namelen    = sizeof(struct sockaddr_storage);
+        hdr.msg_iov        = &m_state->m_iovs[i];
+        hdr.msg_iovlen     = 1;
+        hdr.msg_control    = &m_state->m_control[i * kControlSize];
+        hdr.msg_controllen = kControlSize;
+        hdr.msg_flags      = 0;
+    }
+    m_handedOut = 0;
+
+    int count = recvmmsg(m_fd, m_state->m_msgs.data(), kBatchSize,
+                         MSG_DONTWAIT, nullptr);
+    if (count < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
+        LOG(VB_GENERAL, LOG_ERR, LOC + "recvmmsg failed" + ENO);
+        return -1;
+    }
+
+    int kept = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        const struct mmsghdr &msg = m_state->m_msgs[i];
+        ParseControl(i);
+        if (msg.msg_hdr.msg_flags & MSG_TRUNC)
+        {
+            // Drop the truncated datagram and make room for the largest
+            // possible one from now on.
+            LOG(VB_GENERAL, LOG_WARNING, LOC +
+                QString("Dropped a datagram larger than %1 bytes")
+                    .arg(m_slotSize));
+            m_slotSize = kMaxDatagram;
+            continue;
+        }
+        if (kept != i)
+        {
+            std::swap(m_packets[kept], m_packets[i]);
+            std::swap(m_state->m_addrs[kept], m_state->m_addrs[i]);
+        }
+        m_packets[kept].GetDataReference().resize(static_cast<int>(msg.msg_len));
+        kept++;
+    }
+
+    // Every slot that received a datagram is replaced on the next call,
+    // including dropped ones, which are now at the end of the batch.
+    m_handedOut = count;
+    count = kept;
+    m_received += count;
+    m_batches++;
+
+    if (m_statsTimer.elapsed() >= kStatsInterval)
+        ReportStatistics();
+
+    return count;
+#else
+    (void) buffer;
+    return -1;
+#endif
+}
+
+QHostAddress UDPBatchReader::Sender(int index) const
+{
+#ifdef __linux__
+    return QHostAddress(reinterpret_cast<const struct sockaddr *>(
+                            &m_state->m_addrs[index]));
+#else
+    (void) index;
+    return {};
+#endif
+}
+
+void UDPBatchReader::ParseControl([[maybe_unused]] int index)
+{
+#ifdef __linux__
+    auto *hdr = &m_state->m_msgs[index].msg_hdr;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg;
+         cmsg = CMSG_NXTHDR(hdr, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET)
+            continue;
+
+        if (cmsg->cmsg_type == SCM_TIMESTAMPNS)
+        {
+            struct timespec received {};
+            memcpy(&received, CMSG_DATA(cmsg), sizeof(received));
+            struct timespec now {};
+            clock_gettime(CLOCK_REALTIME, &now);
+            int64_t lag = ((now.tv_sec - received.tv_sec) * 1000000LL) +
+                          ((now.tv_nsec - received.tv_nsec) / 1000);
+            m_maxLagUs = std::max(m_maxLagUs, lag);
+        }
+        else if (cmsg->cmsg_type == SO_RXQ_OVFL)
+        {
+            memcpy(&m_dropCount, CMSG_DATA(cmsg), sizeof(m_dropCount));
+        }
+    }
+#endif
+}
+
+void UDPBatchReader::ReportStatistics(void)
+{
+    uint32_t dropped = m_dropCount - m_dropsSeen;
+    m_dropsSeen = m_dropCount;
+
+    if (dropped)
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("%1 datagrams dropped by the kernel, the socket receive "
+                    "buffer is too small (check net.core.rmem_max)")
+                .arg(dropped));
+    }
+    if (m_maxLagUs > kLagWarningUs)
+    {
+        LOG(VB_RECORD, LOG_WARNING, LOC +
+            QString("Reads lag up to %1 ms behind the network")
+                .arg(m_maxLagUs / 1000));
+    }
+
+    LOG(VB_RECORD, LOG_DEBUG, LOC +
+        QString("%1 datagrams in %2 batches, max lag %3 us")
+            .arg(m_received).arg(m_batches).arg(m_maxLagUs));
+
+    m_received = 0;
+    m_batches = 0;
+    m_maxLagUs = 0;
+    m_statsTimer.start();
+}
@@ -0,0 +1,96 @@
+/* -*- Mode: c++ -*-
+ * UDPBatchReader
+ * Distributed as part of MythTV under GPL v2 and later.
+ */
+
+#ifndef UDP_BATCH_READER_H
+#define UDP_BATCH_READER_H
+
+#include <vector>
+
+#include <QHostAddress>
+#include <QString>
+
+#include "libmythbase/mythtimer.h"
+#include "libmythtv/mythtvexp.h"
+#include "udppacket.h"
+
+class PacketBuffer;
+struct UDPBatchState;
+
+/** \class UDPBatchReader
+ *  \brief Receives datagrams from a UDP socket in batches using recvmmsg().
+ *
+ *  Datagrams are received straight into UDPPackets, taken from the
+ *  PacketBuffer when one is given, so a steady stream costs one system
+ *  call per batch and no allocations. Kernel receive timestamps are used
+ *  to report how far the reader lags behind the network, and the socket
+ *  drop counter to report datagrams lost to a full receive buffer.
+ *
+ *  The reader works on a duplicate of the socket descriptor, which it
+ *  owns. Qt allows only one read notifier per descriptor, and the
+ *  QUdpSocket the socket usually belongs to already has one, so callers
+ *  watch Descriptor() rather than the socket's own descriptor.
+ *
+ *  Batched reads are only available on Linux. Elsewhere IsAvailable()
+ *  returns false and callers keep using QUdpSocket::readDatagram().
+ */
+class MTV_PUBLIC UDPBatchReader
+{
+  public:
+    static constexpr int kBatchSize   { 64 };
+    /// Initial packet size, enough for any datagram that fits in an
+    /// Ethernet frame. Grows to kMaxDatagram if a larger one arrives.
+    static constexpr int kSlotSize    { 2048 };
+    static constexpr int kMaxDatagram { 65536 };
+
+    UDPBatchReader(int fd, QString name);
+    ~UDPBatchReader();
+    UDPBatchReader(const UDPBatchReader &) = delete;            // not copyable
+    UDPBatchReader &operator=(const UDPBatchReader &) = delete; // not copyable
+
+    static bool IsAvailable(void);
+
+    /// False if the socket can't be read in batches.
+    bool IsOK(void) const { return m_ok; }
+
+    /// The reader's own descriptor for the socket, for a QSocketNotifier.
+    int Descriptor(void) const { return m_fd; }
+
+    /** \brief Receives up to kBatchSize pending datagrams without blocking.
+     *
+     *  When \p buffer is given, the packets handed out by the previous
+     *  call are replaced with empty packets from it, so the caller may
+     *  keep those packets. Packets the caller doesn't keep should be
+     *  returned with PacketBuffer::FreePacket().
+     *
+     *  \return number of datagrams received, 0 if none were pending, or
+     *          -1 on error
+     */
+    int Read(PacketBuffer *buffer = nullptr);
+
+    UDPPacket &Packet(int index) { return m_packets[index]; }
+    QHostAddress Sender(int index) const;
+
+  private:
+    void ParseControl(int index);
+    void ReportStatistics(void);
+
+    int                     m_fd        {-1};
+    QString                 m_name;
+    bool                    m_ok        {false};
+    UDPBatchState          *m_state     {nullptr};
+    std::vector<UDPPacket>  m_packets;
+    int                     m_handedOut {kBatchSize};
+    int                     m_slotSize  {kSlotSize};
+
+    // Statistics
+    MythTimer               m_statsTimer;
+    uint64_t                m_received  {0};
+    uint64_t                m_batches   {0};
+    uint32_t                m_dropCount {0};
+    uint32_t                m_dropsSeen {0};
+    int64_t                 m_maxLagUs  {0};
+};
+
+#endif // UDP_BATCH_READER_H
@@ -9,6 +9,7 @@
 #include <QMap>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QSocketNotifier>
 #include <QUdpSocket>
 
 // MythTV headers
@@ -17,6 +18,7 @@
 #include "cardutil.h"
 #include "dtvsignalmonitor.h"
 #include "rtp/rtptsdatapacket.h"
+#include "rtp/udpbatchreader.h"
 #include "satiputils.h"
 #include "satipchannel.h"
 #include "satipstreamhandler.h"
@@ -528,9 +530,33 @@ SatIPDataReadHelper::SatIPDataReadHelper(SatIPStreamHandler* handler)
     LOG(VB_RECORD, LOG_INFO, LOC_DRH +
         QString("Starting data read helper for RTP UDP socket"));
 
-    // Call ReadPending when there are RTP data packets received on m_socket
-    connect(m_socket, &QIODevice::readyRead,
-            this,     &SatIPDataReadHelper::ReadPending);
+    // Call ReadPending when there are RTP data packets received on m_socket.
+    // Where possible read the socket directly in batches, QUdpSocket
+    // only hands out one datagram per system call. The batch reader has
+    // its own descriptor for the socket, Qt watches the QUdpSocket's.
+    int fd = static_cast<int>(m_socket->socketDescriptor());
+    if (UDPBatchReader::IsAvailable() && fd >= 0)
+    {
+        m_batchReader = new UDPBatchReader(
+            fd, QString("SatIP%1").arg(m_streamHandler->m_inputId));
+        if (m_batchReader->IsOK())
+        {
+            m_notifier = new QSocketNotifier(m_batchReader->Descriptor(),
+                                             QSocketNotifier::Read, this);
+            connect(m_notifier, &QSocketNotifier::activated,
+                    this,       &SatIPDataReadHelper::ReadPending);
+        }
+        else
+        {
+            delete m_batchReader;
+            m_batchReader = nullptr;
+        }
+    }
+    if (!m_batchReader)
+    {
+        connect(m_socket, &QIODevice::readyRead,
+                this,     &SatIPDataReadHelper::ReadPending);
+    }
 
     // Number of RTP packets to discard at start.
     // This is to flush the RTP packets that might still be in transit
@@ -544,8 +570,16 @@ SatIPDataReadHelper::SatIPDataReadHelper(SatIPStreamHandler* handler)
 SatIPDataReadHelper::~SatIPDataReadHelper()
 {
     LOG(VB_RECORD, LOG_INFO, LOC_DRH + QString("%1").arg(__func__));
-    disconnect(m_socket, &QIODevice::readyRead,
-               this,     &SatIPDataReadHelper::ReadPending);
+    if (m_batchReader)
+    {
+        delete m_notifier;
+        delete m_batchReader;
+    }
+    else
+    {
+        disconnect(m_socket, &QIODevice::readyRead,
+                   this,     &SatIPDataReadHelper::ReadPending);
+    }
 }
 
 void SatIPDataReadHelper::ReadPending()
@@ -554,6 +588,20 @@ void SatIPDataReadHelper::ReadPending()
     LOG(VB_RECORD, LOG_INFO, LOC_RH + QString("%1").arg(__func__));
 #endif
 
+    if (m_batchReader)
+    {
+        int count = 0;
+        while ((count = m_batchReader->Read()) > 0)
+        {
+            for (int i = 0; i < count; ++i)
+                ProcessPacket(RTPDataPacket(m_batchReader->Packet(i)));
+
+            if (count < UDPBatchReader::kBatchSize)
+                break;
+        }
+        return;
+    }
+
     RTPDataPacket pkt;
 
     while (m_socket->hasPendingDatagrams())
@@ -568,65 +616,70 @@ void SatIPDataReadHelper::ReadPending()
         data.resize(m_socket->pendingDatagramSize());
         m_socket->readDatagram(data.data(), data.size(), &sender, &senderPort);
 
-        if (pkt.GetPayloadType() == RTPDataPacket::kPayLoadTypeTS)
-        {
-            RTPTSDataPacket ts_packet(pkt);
+        ProcessPacket(pkt);
+    }
+}
 
-            if (!ts_packet.IsValid())
-            {
-                continue;
-            }
+void SatIPDataReadHelper::ProcessPacket(const RTPDataPacket &pkt)
+{
+    if (pkt.GetPayloadType() != RTPDataPacket::kPayLoadTypeTS)
+        return;
 
-            // Check the packet sequence number
-            uint expectedSequenceNumber = (m_sequenceNumber + 1) & 0xFFFF;
-            m_sequenceNumber = ts_packet.GetSequenceNumber();
-            if ((expectedSequenceNumber != m_sequenceNumber) && m_valid)
-            {
-                LOG(VB_RECORD, LOG_ERR, LOC_DRH +
-                    QString("Sequence number error -- Expected:%1 Received:%2")
-                        .arg(expectedSequenceNumber).arg(m_sequenceNumber));
-            }
+    RTPTSDataPacket ts_packet(pkt);
 
-            // Flush the first few packets after start
-            if (m_count > 0)
-            {
-                LOG(VB_RECORD, LOG_INFO, LOC_DRH + QString("Flushing RTP packet, %1 to do").arg(m_count));
-                m_count--;
-            }
-            else
-            {
-                m_valid = true;
-            }
+    if (!ts_packet.IsValid())
+    {
+        return;
+    }
 
-            // Send the packet data to all listeners
-            if (m_valid)
+    // Check the packet sequence number
+    uint expectedSequenceNumber = (m_sequenceNumber + 1) & 0xFFFF;
+    m_sequenceNumber = ts_packet.GetSequenceNumber();
+    if ((expectedSequenceNumber != m_sequenceNumber) && m_valid)
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC_DRH +
+            QString("Sequence number error -- Expected:%1 Received:%2")
+                .arg(expectedSequenceNumber).arg(m_sequenceNumber));
+    }
+
+    // Flush the first few packets after start
+    if (m_count > 0)
+    {
+        LOG(VB_RECORD, LOG_INFO, LOC_DRH + QString("Flushing RTP packet, %1 to do").arg(m_count));
+        m_count--;
+    }
+    else
+    {
+        m_valid = true;
+    }
+
+    // Send the packet data to all listeners
+    if (m_valid)
+    {
+        int remainder = 0;
+        {
+            QMutexLocker locker(&m_streamHandler->m_listenerLock);
+            auto streamDataList = m_streamHandler->m_streamDataList;
+            if (!streamDataList.isEmpty())
             {
-                int remainder = 0;
-                {
-                    QMutexLocker locker(&m_streamHandler->m_listenerLock);
-                    auto streamDataList = m_streamHandler->m_streamDataList;
-                    if (!streamDataList.isEmpty())
-                    {
-                        const unsigned char *data_buffer = ts_packet.GetTSData();
-                        size_t data_length = ts_packet.GetTSDataSize();
-
-                        for (auto sit = streamDataList.cbegin(); sit != streamDataList.cend(); ++sit)
-                        {
-                            remainder = sit.key()->ProcessData(data_buffer, data_length);
-                        }
-
-                        m_streamHandler->WriteMPTS(data_buffer, data_length - remainder);
-                    }
-                }
+                const unsigned char *data_buffer = ts_packet.GetTSData();
+                size_t data_length = ts_packet.GetTSDataSize();
 
-                if (remainder != 0)
+                for (auto sit = streamDataList.cbegin(); sit != streamDataList.cend(); ++sit)
                 {
-                    LOG(VB_RECORD, LOG_INFO, LOC_DRH +
-                        QString("RTP data_length = %1 remainder = %2")
-                        .arg(ts_packet.GetTSDataSize()).arg(remainder));
+                    remainder = sit.key()->ProcessData(data_buffer, data_length);
                 }
+
+                m_streamHandler->WriteMPTS(data_buffer, data_length - remainder);
             }
         }
+
+        if (remainder != 0)
+        {
+            LOG(VB_RECORD, LOG_INFO, LOC_DRH +
+                QString("RTP data_length = %1 remainder = %2")
+                .arg(ts_packet.GetTSDataSize()).arg(remainder));
+        }
     }
 }
 
@@ -18,6 +18,9 @@
 
 class SatIPDataReadHelper;
 class SatIPControlReadHelper;
+class QSocketNotifier;
+class RTPDataPacket;
+class UDPBatchReader;
 
 class SatIPStreamHandler : public StreamHandler
 {
@@ -107,8 +110,12 @@ class SatIPDataReadHelper : public QObject
     void ReadPending(void);
 
   private:
+    void ProcessPacket(const RTPDataPacket &pkt);
+
     SatIPStreamHandler *m_streamHandler   {nullptr};
     QUdpSocket         *m_socket          {nullptr};
+    UDPBatchReader     *m_batchReader     {nullptr};
+    QSocketNotifier    *m_notifier        {nullptr};
     int                 m_timer           {0};
     uint                m_sequenceNumber  {0};
     uint                m_count           {0};
@@ -6,6 +6,7 @@
 // MythTV headers
 #include "streamhandler.h"
 
+#include "libmythbase/mythcorecontext.h"
 #include "libmythbase/threadedfilewriter.h"
 
 #ifndef O_LARGEFILE
@@ -30,6 +31,9 @@ StreamHandler::~StreamHandler()
     // This should never be triggered.. just to be safe..
     if (m_running)
         Stop();
+
+    if (m_writerGroup)
+        m_writerGroup->DecrRef();
 }
 
 void StreamHandler::AddListener(MPEGStreamData *data,
@@ -160,6 +164,26 @@ void StreamHandler::Stop(void)
     LOG(VB_RECORD, LOG_DEBUG, LOC + "Stopped");
 }
 
+/** \brief Returns the writer group for the recordings made from this
+ *         stream, creating it on first use.
+ *
+ *   The recorders take their own references, the group lives until the
+ *   last of them, and this handler, are done with it.
+ *
+ *   \return nullptr unless the RecordingWriterGroups setting is enabled,
+ *           in which case each recording keeps its own writer threads.
+ */
+TFWGroup *StreamHandler::GetWriterGroup(void)
+{
+    if (!gCoreContext->GetBoolSetting("RecordingWriterGroups", false))
+        return nullptr;
+
+    QMutexLocker locker(&m_writerGroupLock);
+    if (!m_writerGroup)
+        m_writerGroup = new TFWGroup(m_device);
+    return m_writerGroup;
+}
+
 bool StreamHandler::IsRunning(void) const
 {
     // This used to use QMutexLocker, but that sometimes left the
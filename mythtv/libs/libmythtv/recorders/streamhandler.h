@@ -21,6 +21,7 @@
 #include "mpeg/mpegstreamdata.h" // for PIDPriority
 
 class ThreadedFileWriter;
+class TFWGroup;
 
 //#define DEBUG_PID_FILTERS
 
@@ -69,6 +70,10 @@ class StreamHandler : protected MThread, public DeviceReaderCB
     /// Called with _listener_lock locked just before removing old output file.
     virtual void RemoveNamedOutputFile(const QString &filename);
 
+    /// The writer group shared by the recordings made from this stream,
+    /// if the RecordingWriterGroups setting is enabled.
+    TFWGroup *GetWriterGroup(void);
+
   protected:
     explicit StreamHandler(QString device, int inputid)
         : MThread("StreamHandler"), m_device(std::move(device)), m_inputId(inputid) {}
@@ -140,6 +145,9 @@ class StreamHandler : protected MThread, public DeviceReaderCB
     QString             m_mptsBaseFile;
     QMutex              m_mptsLock;
 
+    TFWGroup           *m_writerGroup           {nullptr};
+    QMutex              m_writerGroupLock;
+
     using StreamDataList = QHash<MPEGStreamData*,QString>;
     mutable QRecursiveMutex m_listenerLock;
     StreamDataList      m_streamDataList;
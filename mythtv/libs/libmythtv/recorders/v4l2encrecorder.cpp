@@ -174,6 +174,7 @@ void V4L2encRecorder::run(void)
         m_streamData->AddPSStreamListener(this);
     }
 
+    SetWriterGroup(m_streamHandler->GetWriterGroup());
     m_streamHandler->AddListener(m_streamData, false, true);
 
     StartEncoding();
@@ -123,11 +123,14 @@ QString RecordingQuality::toStringXML(void) const
             .arg(m_continuityErrorCount).arg(m_packetCount);
     }
 
-    if (m_recordingGaps.empty())
+    if (m_recordingGaps.empty() && m_pidStatistics.empty())
         return str + " />";
 
     str += ">\n";
 
+    for (const auto & pid : m_pidStatistics)
+        str += StringUtil::indentSpaces(1) + pid.toStringXML() + "\n";
+
     auto add_gap = [](const QString& s, const auto & gap) {
         return s + StringUtil::indentSpaces(1) +
             QString("<Gap start=\"%1\" end=\"%2\" duration=\"%3\" />\n")
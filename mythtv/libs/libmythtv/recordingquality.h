@@ -8,6 +8,7 @@
 
 
 #include "mythtvexp.h"
+#include "mpeg/tsstats.h"
 
 class RecordingInfo;
 
@@ -41,6 +42,10 @@ class MTV_PUBLIC RecordingQuality
         const QDateTime &firstData, const QDateTime &latestData);
 
     void AddTSStatistics(int continuity_error_count, int packet_count);
+    void AddPIDStatistics(const TSStats::PIDStatsList &stats)
+        { m_pidStatistics = stats; }
+    const TSStats::PIDStatsList &GetPIDStatistics(void) const
+        { return m_pidStatistics; }
     bool IsDamaged(void) const;
     QString toStringXML(void) const;
 
@@ -50,6 +55,7 @@ class MTV_PUBLIC RecordingQuality
     QString       m_programKey;
     double        m_overallScore         {1.0};
     RecordingGaps m_recordingGaps;
+    TSStats::PIDStatsList m_pidStatistics;
 };
 
 #endif // RECORDING_QUALITY_H
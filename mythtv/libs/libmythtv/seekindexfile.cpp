@@ -0,0 +1,394 @@
+// C++
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// Qt
+#include <QtEndian>
+
+// MythTV
+#include "libmythbase/mythlogging.h"
+#include "libmythbase/remotefile.h"
+#include "seekindexfile.h"
+
+#define LOC QString("SeekIndex: ")
+
+// File header: 8 byte magic followed by a 32 bit version and 32 bit flags.
+static constexpr const char *kMagic       { "MYTHSEEK" };
+static constexpr qint64      kMagicSize   { 8 };
+static constexpr quint32     kVersion     { 2 };
+static constexpr qint64      kHeaderSize  { kMagicSize + 8 };
+// The index holds the seek table from the start of the recording.
+static constexpr quint32     kFlagComplete { 0x1 };
+// Block header: type, entry count and payload length, all 32 bit.
+static constexpr qint64      kBlockHeader { 12 };
+
+static void put_varint(QByteArray &buf, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buf.append(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buf.append(static_cast<char>(value));
+}
+
+static bool get_varint(const uchar *&ptr, const uchar *end, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; ptr < end && shift < 64; shift += 7)
+    {
+        uchar byte = *ptr++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+static uint64_t zigzag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^
+           static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+static void put_u32(QByteArray &buf, quint32 value)
+{
+    value = qToLittleEndian<quint32>(value);
+    buf.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static quint32 get_u32(const uchar *ptr)
+{
+    return qFromLittleEndian<quint32>(ptr);
+}
+
+static QByteArray make_header(bool complete)
+{
+    QByteArray header(kMagic, kMagicSize);
+    put_u32(header, kVersion);
+    put_u32(header, complete ? kFlagComplete : 0);
+    return header;
+}
+
+SeekIndexFile::~SeekIndexFile()
+{
+    Close();
+}
+
+QString SeekIndexFile::IndexName(const QString &filename)
+{
+    return filename + ".seek";
+}
+
+bool SeekIndexFile::Exists(const QString &filename)
+{
+    QString name = IndexName(filename);
+    if (name.startsWith("myth://"))
+        return RemoteFile::Exists(name);
+    return QFile::exists(name);
+}
+
+bool SeekIndexFile::Remove(const QString &filename)
+{
+    QString name = IndexName(filename);
+    if (name.startsWith("myth://"))
+        return RemoteFile::DeleteFile(name);
+    if (!QFile::exists(name))
+        return true;
+    if (QFile::remove(name))
+        return true;
+    LOG(VB_GENERAL, LOG_ERR, LOC + QString("Unable to remove '%1'").arg(name));
+    return false;
+}
+
+QByteArray SeekIndexFile::EncodeBlock(const frm_pos_map_t &posMap,
+                                      MarkTypes type)
+{
+    QByteArray payload;
+    payload.reserve(posMap.size() * 4);
+
+    long long lastMark = 0;
+    long long lastOffset = 0;
+    for (auto it = posMap.cbegin(); it != posMap.cend(); ++it)
+    {
+        put_varint(payload, zigzag(it.key() - lastMark));
+        put_varint(payload, zigzag(*it - lastOffset));
+        lastMark = it.key();
+        lastOffset = *it;
+    }
+
+    QByteArray block;
+    block.reserve(kBlockHeader + payload.size());
+    put_u32(block, static_cast<quint32>(type));
+    put_u32(block, static_cast<quint32>(posMap.size()));
+    put_u32(block, static_cast<quint32>(payload.size()));
+    block.append(payload);
+    return block;
+}
+
+/// Returns the length of the header plus all complete blocks, or -1 if
+/// the data does not start with a seek index header.
+qint64 SeekIndexFile::ValidLength(const uchar *data, qint64 size)
+{
+    if (size < kHeaderSize || memcmp(data, kMagic, kMagicSize) != 0 ||
+        get_u32(data + kMagicSize) != kVersion)
+        return -1;
+
+    qint64 pos = kHeaderSize;
+    while (pos + kBlockHeader <= size)
+    {
+        quint32 count  = get_u32(data + pos + 4);
+        quint32 length = get_u32(data + pos + 8);
+        if ((static_cast<qint64>(count) * 2 > length) ||
+            (pos + kBlockHeader + length > size))
+            break;
+        pos += kBlockHeader + length;
+    }
+    return pos;
+}
+
+bool SeekIndexFile::Write(const QString &filename,
+                          const QMap<MarkTypes, frm_pos_map_t> &maps)
+{
+    QString name = IndexName(filename);
+    QString tmpname = name + ".tmp";
+
+    QFile file(tmpname);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to create '%1'").arg(tmpname));
+        return false;
+    }
+
+    QByteArray header = make_header(true);
+    bool ok = file.write(header) == header.size();
+    for (auto it = maps.cbegin(); ok && it != maps.cend(); ++it)
+    {
+        if (it->isEmpty())
+            continue;
+        QByteArray block = EncodeBlock(*it, it.key());
+        ok = file.write(block) == block.size();
+    }
+    ok = file.flush() && ok;
+    file.close();
+
+    // Replace any existing index in one step so that a reader never sees
+    // a partially written file.
+    if (!ok || rename(tmpname.toLocal8Bit().constData(),
+                      name.toLocal8Bit().constData()) != 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to write '%1'").arg(name) + ENO);
+        QFile::remove(tmpname);
+        return false;
+    }
+    return true;
+}
+
+bool SeekIndexFile::Load(const QString &filename)
+{
+    Close();
+
+    QString name = IndexName(filename);
+    if (name.startsWith("myth://"))
+    {
+        if (!RemoteFile::Exists(name))
+            return false;
+        RemoteFile remote(name, false, false);
+        if (!remote.isOpen() || !remote.SaveAs(m_buffer))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to read '%1'").arg(name));
+            m_buffer.clear();
+            return false;
+        }
+        m_data = reinterpret_cast<const uchar*>(m_buffer.constData());
+        m_size = m_buffer.size();
+    }
+    else
+    {
+        m_file.setFileName(name);
+        if (!m_file.exists() || !m_file.open(QIODevice::ReadOnly))
+            return false;
+        m_size = m_file.size();
+        m_data = m_file.map(0, m_size);
+        if (m_data)
+        {
+            m_mapped = true;
+        }
+        else
+        {
+            // Fall back to a plain read on filesystems that can't mmap.
+            m_buffer = m_file.readAll();
+            m_data = reinterpret_cast<const uchar*>(m_buffer.constData());
+            m_size = m_buffer.size();
+        }
+    }
+
+    if (ValidLength(m_data, m_size) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("'%1' is not a seek index").arg(name));
+        Close();
+        return false;
+    }
+
+    if ((get_u32(m_data + kMagicSize + 4) & kFlagComplete) == 0)
+    {
+        LOG(VB_FILE, LOG_INFO, LOC +
+            QString("'%1' was started part way through the recording, "
+                    "not using it").arg(name));
+        Close();
+        return false;
+    }
+
+    LOG(VB_FILE, LOG_INFO, LOC + QString("Loaded '%1' (%2 bytes)")
+        .arg(name).arg(m_size));
+    return true;
+}
+
+bool SeekIndexFile::Get(MarkTypes type, frm_pos_map_t &posMap) const
+{
+    posMap.clear();
+    if (!m_data)
+        return false;
+
+    const uchar *end = m_data + m_size;
+    qint64 pos = kHeaderSize;
+    while (pos + kBlockHeader <= m_size)
+    {
+        auto    btype  = static_cast<MarkTypes>(
+            static_cast<qint32>(get_u32(m_data + pos)));
+        quint32 count  = get_u32(m_data + pos + 4);
+        quint32 length = get_u32(m_data + pos + 8);
+        if (pos + kBlockHeader + length > m_size)
+            break;
+
+        if (btype == type)
+        {
+            const uchar *ptr = m_data + pos + kBlockHeader;
+            const uchar *bend = std::min(ptr + length, end);
+            long long mark = 0;
+            long long offset = 0;
+            for (quint32 i = 0; i < count; ++i)
+            {
+                uint64_t dmark = 0;
+                uint64_t doffset = 0;
+                if (!get_varint(ptr, bend, dmark) ||
+                    !get_varint(ptr, bend, doffset))
+                    break;
+                mark += unzigzag(dmark);
+                offset += unzigzag(doffset);
+                posMap[mark] = offset;
+            }
+        }
+        pos += kBlockHeader + length;
+    }
+
+    return !posMap.isEmpty();
+}
+
+/// Opens the index for Append(), creating it if needed. Pass \p complete
+/// as false when the first block appended will not start at the beginning
+/// of the recording.
+bool SeekIndexFile::OpenForAppend(const QString &filename, bool complete)
+{
+    Close();
+
+    QString name = IndexName(filename);
+    m_file.setFileName(name);
+    if (!m_file.open(QIODevice::ReadWrite))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to open '%1' for writing").arg(name));
+        return false;
+    }
+
+    // Drop a trailing block left incomplete by an earlier crash, or
+    // start over if the file isn't a seek index at all.
+    qint64 length = -1;
+    if (m_file.size() > 0)
+    {
+        QByteArray existing = m_file.readAll();
+        length = ValidLength(reinterpret_cast<const uchar*>(existing.constData()),
+                             existing.size());
+    }
+
+    if (length < 0)
+    {
+        QByteArray header = make_header(complete);
+        if (!m_file.resize(0) || m_file.write(header) != header.size())
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to initialise '%1'").arg(name));
+            m_file.close();
+            return false;
+        }
+    }
+    else if (length != m_file.size())
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("Truncating '%1' from %2 to %3 bytes")
+                .arg(name).arg(m_file.size()).arg(length));
+        m_file.resize(length);
+    }
+
+    // Appending to a complete index from somewhere other than the start of
+    // the recording leaves a gap, so the index is no longer complete.
+    if (length >= 0 && !complete)
+    {
+        QByteArray flags;
+        put_u32(flags, 0);
+        if (!m_file.seek(kMagicSize + 4) || m_file.write(flags) != flags.size())
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to update '%1'").arg(name));
+            m_file.close();
+            return false;
+        }
+    }
+
+    m_file.seek(m_file.size());
+    m_file.flush();
+    m_appending = true;
+    return true;
+}
+
+bool SeekIndexFile::Append(const frm_pos_map_t &posMap, MarkTypes type)
+{
+    if (!m_appending)
+        return false;
+    if (posMap.isEmpty())
+        return true;
+
+    QByteArray block = EncodeBlock(posMap, type);
+    if (m_file.write(block) != block.size() || !m_file.flush())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to append to '%1'").arg(m_file.fileName()));
+        // Stop here; the partial block is dropped on the next open.
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void SeekIndexFile::Close(void)
+{
+    if (m_mapped)
+        m_file.unmap(const_cast<uchar*>(m_data));
+    if (m_file.isOpen())
+        m_file.close();
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_appending = false;
+}
@@ -0,0 +1,67 @@
+#ifndef SEEKINDEXFILE_H
+#define SEEKINDEXFILE_H
+
+// Qt
+#include <QByteArray>
+#include <QFile>
+#include <QMap>
+#include <QString>
+
+// MythTV
+#include "libmythbase/programtypes.h"
+#include "mythtvexp.h"
+
+/** \class SeekIndexFile
+ *  \brief Compact copy of a recording's seek table kept next to the
+ *         recording as "<recording>.seek".
+ *
+ *  The file starts with a short header followed by self contained blocks,
+ *  one per Append() call. The header records whether the index holds the
+ *  seek table from the start of the recording; an index that was started
+ *  part way through is not loaded, so readers use the database until it
+ *  is rebuilt with Write(). A block holds the mark type, the number of
+ *  entries and the payload length, then the (mark, offset) pairs as
+ *  varint encoded deltas. The recorder can extend the index while it is
+ *  recording without rewriting it, and a block cut short by a crash is
+ *  dropped the next time the index is opened for appending.
+ *
+ *  Local indexes are memory mapped for reading. Indexes held by another
+ *  backend are fetched with a single RemoteFile read.
+ */
+class MTV_PUBLIC SeekIndexFile
+{
+  public:
+    SeekIndexFile() = default;
+    ~SeekIndexFile();
+    SeekIndexFile(const SeekIndexFile &) = delete;            // not copyable
+    SeekIndexFile &operator=(const SeekIndexFile &) = delete; // not copyable
+
+    static QString IndexName(const QString &filename);
+    static bool Exists(const QString &filename);
+    static bool Remove(const QString &filename);
+    static bool Write(const QString &filename,
+                      const QMap<MarkTypes, frm_pos_map_t> &maps);
+
+    bool Load(const QString &filename);
+    bool Get(MarkTypes type, frm_pos_map_t &posMap) const;
+    bool IsLoaded(void) const { return m_data != nullptr; }
+
+    bool OpenForAppend(const QString &filename, bool complete = true);
+    bool Append(const frm_pos_map_t &posMap, MarkTypes type);
+    bool IsOpenForAppend(void) const { return m_appending; }
+
+    void Close(void);
+
+  private:
+    static QByteArray EncodeBlock(const frm_pos_map_t &posMap, MarkTypes type);
+    static qint64 ValidLength(const uchar *data, qint64 size);
+
+    QFile        m_file;
+    QByteArray   m_buffer;
+    const uchar *m_data      {nullptr};
+    qint64       m_size      {0};
+    bool         m_mapped    {false};
+    bool         m_appending {false};
+};
+
+#endif // SEEKINDEXFILE_H
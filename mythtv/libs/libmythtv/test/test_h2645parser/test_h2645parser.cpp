@@ -0,0 +1,231 @@
+/*
+ *  Class TestH2645Parser
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "test_h2645parser.h"
+#include "libmythtv/mpeg/AVCParser.h"
+#include "libmythtv/mpeg/HEVCParser.h"
+
+// The payload of a TS packet without an adaptation field
+static constexpr size_t kPayloadSize { 184 };
+
+using Frames = std::vector<std::pair<uint64_t,bool>>;
+
+// Gives access to the rbsp buffer
+class RBSPParser : public HEVCParser
+{
+  public:
+    using H2645Parser::fillRBSP;
+
+    std::vector<uint8_t> RBSP(void) const
+        { return { m_rbspBuffer, m_rbspBuffer + m_rbspIndex }; }
+};
+
+/// Random bytes below \a range, or any bytes when it is 0. Small ranges
+/// make lots of zeros, and so lots of emulation prevention bytes.
+static std::vector<uint8_t> Bytes(size_t len, uint32_t seed, uint range = 0)
+{
+    std::vector<uint8_t> buffer(len);
+    for (auto & byte : buffer)
+    {
+        seed = (seed * 1664525) + 1013904223;
+        byte = static_cast<uint8_t>(range ? (seed >> 24) % range : seed >> 24);
+    }
+    // rbsp_trailing_bits, so the NAL doesn't end in a zero
+    if (len)
+        buffer.back() = 0x80;
+    return buffer;
+}
+
+/// Adds emulation prevention bytes to an rbsp
+static std::vector<uint8_t> Escape(const std::vector<uint8_t> &rbsp)
+{
+    std::vector<uint8_t> nal;
+    uint zeros = 0;
+    for (uint8_t byte : rbsp)
+    {
+        if (zeros >= 2 && byte <= 0x03)
+        {
+            nal.push_back(0x03);
+            zeros = 0;
+        }
+        nal.push_back(byte);
+        zeros = byte ? 0 : zeros + 1;
+    }
+    return nal;
+}
+
+/// Appends a NAL, returning the stream offset the parser should give the
+/// access unit it starts, if it does.
+static uint64_t AddNAL(std::vector<uint8_t> &stream,
+                       const std::vector<uint8_t> &header,
+                       const std::vector<uint8_t> &rbsp)
+{
+    // The parser sees the start code once it has the first header byte
+    uint64_t offset = ((stream.size() + 3) / kPayloadSize) * 188;
+    stream.insert(stream.end(), { 0x00, 0x00, 0x01 });
+    stream.insert(stream.end(), header.cbegin(), header.cend());
+    auto nal = Escape(rbsp);
+    stream.insert(stream.end(), nal.cbegin(), nal.cend());
+    return offset;
+}
+
+/** \brief An elementary stream of \a count pictures with two slices each,
+ *         and a keyframe every ten pictures.
+ *
+ *  There are no parameter sets, so the parsers only find the access units
+ *  from the delimiters and the keyframes from the NAL types.
+ */
+static std::vector<uint8_t> Stream(bool hevc, uint count, size_t sliceSize,
+                                   uint range, Frames *frames = nullptr)
+{
+    std::vector<uint8_t> stream;
+    for (uint i = 0; i < count; i++)
+    {
+        bool key = (i % 10) == 0;
+        // Every fourth picture starts with a slice shorter than what the
+        // parsers need to look at before knowing what it is.
+        size_t first = (i % 4 == 3) ? 100 : sliceSize + ((i * 731) % 5000);
+
+        uint64_t offset = 0;
+        if (hevc)
+        {
+            auto nalType = key ? HEVCParser::IDR_W_RADL : HEVCParser::TAIL_R;
+            offset = AddNAL(stream, { HEVCParser::AUD_NUT << 1, 1 }, { 0x50 });
+            AddNAL(stream, { HEVCParser::PREFIX_SEI_NUT << 1, 1 }, Bytes(20, i, range));
+            AddNAL(stream, { static_cast<uint8_t>(nalType << 1), 1 }, Bytes(first, i, range));
+            AddNAL(stream, { static_cast<uint8_t>(nalType << 1), 1 }, Bytes(2000, ~i, range));
+        }
+        else
+        {
+            uint8_t nalType = key ? 0x65 : 0x41;
+            offset = AddNAL(stream, { AVCParser::AU_DELIMITER }, { 0xf0 });
+            AddNAL(stream, { nalType }, Bytes(first, i, range));
+            AddNAL(stream, { nalType }, Bytes(2000, ~i, range));
+        }
+
+        if (frames)
+            frames->emplace_back(offset, key);
+    }
+    return stream;
+}
+
+/// Feeds the stream to the parser the way DTVRecorder does, a packet
+/// payload at a time.
+static Frames Parse(H2645Parser &parser, const std::vector<uint8_t> &stream)
+{
+    Frames frames;
+    uint64_t packet = 0;
+    for (size_t pos = 0; pos < stream.size(); pos += kPayloadSize, packet++)
+    {
+        auto len = static_cast<uint32_t>(std::min(kPayloadSize, stream.size() - pos));
+        uint32_t i = 0;
+        while (i < len)
+        {
+            uint32_t used = parser.addBytes(&stream[pos + i], len - i, packet * 188);
+            if (parser.onFrameStart())
+                frames.emplace_back(parser.frameAUstreamOffset(), parser.onKeyFrameStart());
+            if (!used)
+                break;
+            i += used;
+        }
+    }
+    return frames;
+}
+
+void TestH2645Parser::FillRBSP_data(void)
+{
+    QTest::addColumn<uint>("chunk");
+    QTest::addColumn<uint>("range");
+    for (uint chunk : { 1, 7, 184, 100000 })
+    {
+        for (uint range : { 3, 0 })
+            QTest::addRow("%u byte chunks, range %u", chunk, range) << chunk << range;
+    }
+}
+
+void TestH2645Parser::FillRBSP(void)
+{
+    QFETCH(uint, chunk);
+    QFETCH(uint, range);
+
+    auto rbsp = Bytes(5000, 0x1234567, range);
+    auto nal = Escape(rbsp);
+    QVERIFY(range == 0 || nal.size() > rbsp.size());
+
+    // The parser passes on the next start code and NAL header byte too
+    nal.insert(nal.end(), { 0x00, 0x00, 0x01, 0x40 });
+
+    RBSPParser parser;
+    for (size_t pos = 0; pos < nal.size(); pos += chunk)
+    {
+        auto len = static_cast<uint32_t>(std::min<size_t>(chunk, nal.size() - pos));
+        QVERIFY(parser.fillRBSP(&nal[pos], len, pos + len == nal.size()));
+    }
+    QVERIFY(parser.RBSP() == rbsp);
+}
+
+void TestH2645Parser::HEVCFrames(void)
+{
+    Frames expected;
+    auto stream = Stream(true, 30, 3000, 4, &expected);
+
+    HEVCParser parser;
+    Frames frames = Parse(parser, stream);
+
+    QCOMPARE(frames.size(), expected.size());
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        QCOMPARE(frames[i].first, expected[i].first);
+        QCOMPARE(frames[i].second, expected[i].second);
+    }
+}
+
+void TestH2645Parser::Benchmark_data(void)
+{
+    QTest::addColumn<bool>("hevc");
+    QTest::newRow("H.264") << false;
+    QTest::newRow("HEVC") << true;
+}
+
+// Sixty pictures, about the same number of bytes as a second of UHD
+void TestH2645Parser::Benchmark(void)
+{
+    QFETCH(bool, hevc);
+
+    auto stream = Stream(hevc, 60, 40000, 0);
+    std::unique_ptr<H2645Parser> parser;
+    if (hevc)
+        parser = std::make_unique<HEVCParser>();
+    else
+        parser = std::make_unique<AVCParser>();
+
+    size_t frames = 0;
+    QBENCHMARK
+    {
+        parser->Reset();
+        frames += Parse(*parser, stream).size();
+    }
+    QVERIFY(frames > 0);
+}
+
+QTEST_APPLESS_MAIN(TestH2645Parser)
@@ -0,0 +1,200 @@
+/*
+ *  Class TestHLSReader
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <array>
+
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include "test_hlsreader.h"
+#include "libmythtv/recorders/HLS/HLSReader.h"
+
+static constexpr std::chrono::milliseconds kTick { 10ms };
+
+HLSTestServer::HLSTestServer(int segments, int packets,
+                             std::chrono::milliseconds latency,
+                             int bytes_per_sec)
+  : m_segments(segments),
+    m_packets(packets),
+    m_latency(latency),
+    m_chunk(std::max(1, bytes_per_sec / 100))
+{
+    listen(QHostAddress::LocalHost, 0);
+}
+
+QString HLSTestServer::PlaylistURL(void) const
+{
+    return QString("http://127.0.0.1:%1/stream.m3u8").arg(serverPort());
+}
+
+QByteArray HLSTestServer::Packet(int index)
+{
+    QByteArray packet(kPacketSize, '\xff');
+    packet[0] = 0x47;
+    packet[1] = 0x01;   // PID 0x100
+    packet[2] = 0x00;
+    packet[3] = static_cast<char>(0x10 | (index & 0x0f));
+    packet[4] = static_cast<char>((index >> 24) & 0xff);
+    packet[5] = static_cast<char>((index >> 16) & 0xff);
+    packet[6] = static_cast<char>((index >> 8) & 0xff);
+    packet[7] = static_cast<char>(index & 0xff);
+    return packet;
+}
+
+void HLSTestServer::incomingConnection(qintptr fd)
+{
+    auto *socket = new QTcpSocket(this);
+    socket->setSocketDescriptor(fd);
+    ++m_connections;
+    connect(socket, &QTcpSocket::readyRead, this,
+            [this, socket]() { ReadRequests(socket); });
+    connect(socket, &QTcpSocket::disconnected, this,
+            [this, socket]() { m_input.remove(socket); socket->deleteLater(); });
+}
+
+void HLSTestServer::ReadRequests(QTcpSocket *socket)
+{
+    QByteArray &input = m_input[socket];
+    input += socket->readAll();
+
+    int end = input.indexOf("\r\n\r\n");
+    while (end >= 0)
+    {
+        QByteArray request = input.left(end);
+        input.remove(0, end + 4);
+
+        // "GET /path HTTP/1.1"
+        QList<QByteArray> words = request.left(request.indexOf("\r\n")).split(' ');
+        QByteArray path = words.size() > 1 ? words[1] : QByteArray();
+        ++m_requests;
+        if (path.startsWith("/seg"))
+            m_maxInFlight = std::max(m_maxInFlight, ++m_inFlight);
+        QTimer::singleShot(m_latency, socket,
+                           [this, socket, path]() { Respond(socket, path); });
+
+        end = input.indexOf("\r\n\r\n");
+    }
+}
+
+void HLSTestServer::Respond(QTcpSocket *socket, const QByteArray &path)
+{
+    QByteArray body;
+    bool segment = false;
+
+    if (path == "/stream.m3u8")
+    {
+        body = "#EXTM3U\n"
+               "#EXT-X-VERSION:3\n"
+               "#EXT-X-TARGETDURATION:1\n"
+               "#EXT-X-MEDIA-SEQUENCE:0\n";
+        for (int i = 0; i < m_segments; ++i)
+            body += QString("#EXTINF:1,\nseg%1.ts\n").arg(i).toLatin1();
+        body += "#EXT-X-ENDLIST\n";
+    }
+    else if (path.startsWith("/seg") && path.endsWith(".ts"))
+    {
+        int seg = path.mid(4, path.size() - 7).toInt();
+        for (int i = 0; i < m_packets; ++i)
+            body += Packet((seg * m_packets) + i);
+        segment = true;
+    }
+
+    QByteArray header = body.isEmpty() ?
+        QByteArray("HTTP/1.1 404 Not Found\r\n") :
+        QByteArray("HTTP/1.1 200 OK\r\n");
+    header += "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+              "Connection: keep-alive\r\n\r\n";
+    socket->write(header);
+    SendBody(socket, body, 0, segment);
+}
+
+void HLSTestServer::SendBody(QTcpSocket *socket, const QByteArray &body,
+                             int offset, bool segment)
+{
+    int len = std::min(m_chunk, static_cast<int>(body.size()) - offset);
+    socket->write(body.constData() + offset, len);
+    offset += len;
+
+    if (offset < body.size())
+    {
+        QTimer::singleShot(kTick, socket,
+                           [this, socket, body, offset, segment]()
+            { SendBody(socket, body, offset, segment); });
+    }
+    else if (segment)
+    {
+        --m_inFlight;
+    }
+}
+
+void TestHLSReader::FetchesInOrder_data(void)
+{
+    QTest::addColumn<int>("fetches");
+
+    QTest::newRow("sequential") << 1;
+    QTest::newRow("parallel")   << 4;
+}
+
+void TestHLSReader::FetchesInOrder(void)
+{
+    QFETCH(int, fetches);
+
+    // Every segment request waits out the latency, so only concurrent
+    // fetches can overlap them.
+    static constexpr int kSegments { 12 };
+    static constexpr int kPackets  { 40 };
+    HLSTestServer server(kSegments, kPackets, 300ms, 200000);
+    QVERIFY(server.isListening());
+
+    HLSReader reader;
+    reader.SetConcurrentFetches(fetches);
+    QVERIFY(reader.Open(server.PlaylistURL()));
+    reader.Throttle(false);
+
+    const int expected = kSegments * kPackets * HLSTestServer::kPacketSize;
+    QByteArray output;
+    std::array<uint8_t,16 * HLSTestServer::kPacketSize> buffer {};
+    QElapsedTimer timer;
+    timer.start();
+    while (output.size() < expected && timer.elapsed() < 60000)
+    {
+        QTest::qWait(10);
+        qint64 len = reader.Read(buffer.data(), buffer.size());
+        output.append(reinterpret_cast<const char*>(buffer.data()),
+                      static_cast<int>(len));
+    }
+    reader.Close(true);
+
+    QCOMPARE(output.size(), expected);
+    for (int i = 0; i < kSegments * kPackets; ++i)
+    {
+        QCOMPARE(output.mid(i * HLSTestServer::kPacketSize,
+                            HLSTestServer::kPacketSize),
+                 HLSTestServer::Packet(i));
+    }
+
+    if (fetches > 1)
+        QVERIFY(server.MaxInFlight() > 1);
+    else
+        QCOMPARE(server.MaxInFlight(), 1);
+    // Downloads reuse their connections
+    QVERIFY(server.Connections() < server.Requests());
+}
+
+QTEST_GUILESS_MAIN(TestHLSReader)
@@ -0,0 +1,77 @@
+/*
+ *  Class TestHLSReader
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <chrono>
+
+#include <QMap>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+
+/** \class HLSTestServer
+ *  \brief Minimal HTTP/1.1 server publishing a VOD playlist of TS segments.
+ *
+ *  Every response is held back by a fixed latency and then sent at a
+ *  limited rate. Each TS packet carries its index in the whole stream
+ *  so a reader can check that nothing is missing or out of order.
+ */
+class HLSTestServer : public QTcpServer
+{
+    Q_OBJECT
+
+  public:
+    static constexpr int kPacketSize { 188 };
+
+    HLSTestServer(int segments, int packets,
+                  std::chrono::milliseconds latency, int bytes_per_sec);
+
+    QString PlaylistURL(void) const;
+    static QByteArray Packet(int index);
+
+    int Requests(void) const    { return m_requests; }
+    int Connections(void) const { return m_connections; }
+    int MaxInFlight(void) const { return m_maxInFlight; }
+
+  protected:
+    void incomingConnection(qintptr fd) override; // QTcpServer
+
+  private:
+    void ReadRequests(QTcpSocket *socket);
+    void Respond(QTcpSocket *socket, const QByteArray &path);
+    void SendBody(QTcpSocket *socket, const QByteArray &body, int offset,
+                  bool segment);
+
+    int                             m_segments    {0};
+    int                             m_packets     {0};
+    std::chrono::milliseconds       m_latency     {0};
+    int                             m_chunk       {0};
+    QMap<QTcpSocket*, QByteArray>   m_input;
+    int                             m_requests    {0};
+    int                             m_connections {0};
+    int                             m_inFlight    {0};
+    int                             m_maxInFlight {0};
+};
+
+class TestHLSReader : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    static void FetchesInOrder_data(void);
+    static void FetchesInOrder(void);
+};
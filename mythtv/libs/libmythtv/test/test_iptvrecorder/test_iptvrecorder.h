@@ -18,12 +18,15 @@
  *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
+#include <QNetworkInterface>
 #include <QTest>
+#include <QUdpSocket>
 
 #include "libmythtv/iptvtuningdata.h"
 #include "libmythtv/channelscan/iptvchannelfetcher.h"
 #include "libmythtv/recorders/rtp/rtpdatapacket.h"
 #include "libmythtv/recorders/rtp/rtptsdatapacket.h"
+#include "libmythtv/recorders/rtp/udpbatchreader.h"
 
 class TestIPTVRecorder: public QObject
 {
@@ -486,4 +489,116 @@ class TestIPTVRecorder: public QObject
         QCOMPARE (ts_packet2.GetTSData()[0], (uint8_t)0x47);
         QCOMPARE (ts_packet2.GetTSDataSize(), (unsigned int)7 * 188);
     }
+
+    /**
+     * Datagrams sent over loopback come back intact from batched reads.
+     */
+    static void BatchReceive(void)
+    {
+        if (!UDPBatchReader::IsAvailable())
+            QSKIP("Batched UDP reads are not supported on this platform");
+
+        QUdpSocket receiver;
+        QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+        QUdpSocket sender;
+
+        UDPBatchReader reader(static_cast<int>(receiver.socketDescriptor()),
+                              "test");
+        QVERIFY(reader.IsOK());
+        QCOMPARE(reader.Read(), 0);
+
+        // More than one batch, small enough to fit the default buffer.
+        static constexpr int kCount { 100 };
+        for (int i = 0; i < kCount; ++i)
+        {
+            QByteArray data(2 * 188, static_cast<char>(i));
+            QCOMPARE(sender.writeDatagram(data, QHostAddress::LocalHost,
+                                          receiver.localPort()),
+                     static_cast<qint64>(data.size()));
+        }
+
+        int received = 0;
+        int count = 0;
+        while (received < kCount && (count = reader.Read()) > 0)
+        {
+            for (int i = 0; i < count; ++i, ++received)
+            {
+                const QByteArray &data = reader.Packet(i).GetDataReference();
+                QCOMPARE(data.size(), 2 * 188);
+                QCOMPARE(data.at(0), static_cast<char>(received));
+                QCOMPARE(reader.Sender(i), QHostAddress(QHostAddress::LocalHost));
+            }
+        }
+        QCOMPARE(received, kCount);
+        QCOMPARE(reader.Read(), 0);
+    }
+
+    /**
+     * Compare QUdpSocket::readDatagram() with batched reads of a
+     * multicast stream looped back on this host.
+     */
+    static void BatchReceiveBenchmark_data(void)
+    {
+        QTest::addColumn<bool>("batched");
+        QTest::newRow("readDatagram") << false;
+        QTest::newRow("recvmmsg")     << true;
+    }
+
+    static void BatchReceiveBenchmark(void)
+    {
+        QFETCH(bool, batched);
+        if (batched && !UDPBatchReader::IsAvailable())
+            QSKIP("Batched UDP reads are not supported on this platform");
+
+        QNetworkInterface loopback;
+        for (const auto & iface : QNetworkInterface::allInterfaces())
+        {
+            if (iface.flags().testFlag(QNetworkInterface::IsLoopBack))
+                loopback = iface;
+        }
+
+        const QHostAddress group("239.255.42.42");
+        QUdpSocket receiver;
+        QVERIFY(receiver.bind(QHostAddress::AnyIPv4, 0,
+                              QUdpSocket::ShareAddress));
+        if (!loopback.isValid() ||
+            !receiver.joinMulticastGroup(group, loopback))
+            QSKIP("Multicast on the loopback interface is not available");
+
+        QUdpSocket sender;
+        QVERIFY(sender.bind(QHostAddress::AnyIPv4, 0));
+        sender.setMulticastInterface(loopback);
+        sender.setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+
+        UDPBatchReader reader(static_cast<int>(receiver.socketDescriptor()),
+                              "bench");
+
+        // One RTP packet carrying seven transport stream packets.
+        static constexpr int kBurst { 32 };
+        const QByteArray payload(12 + (7 * 188), '\x47');
+        QByteArray data(UDPBatchReader::kSlotSize, '\0');
+
+        QBENCHMARK {
+            for (int i = 0; i < kBurst; ++i)
+                sender.writeDatagram(payload, group, receiver.localPort());
+
+            int received = 0;
+            if (batched)
+            {
+                int count = 0;
+                while (received < kBurst && (count = reader.Read()) > 0)
+                    received += count;
+            }
+            else
+            {
+                while (received < kBurst && receiver.hasPendingDatagrams())
+                {
+                    receiver.readDatagram(data.data(), data.size());
+                    received++;
+                }
+            }
+            if (received != kBurst)
+                QSKIP("Multicast datagrams were not looped back");
+        }
+    }
 };
@@ -0,0 +1,427 @@
+/*
+ *  Class TestProgramData
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <random>
+
+#include "test_programdata.h"
+
+#include "libmythtv/listingsources.h"
+
+static const QDateTime kNow   { QDate(2030, 1, 1), QTime(0, 0), Qt::UTC };
+static const QDateTime kStart { QDate(2030, 6, 1), QTime(18, 0), Qt::UTC };
+
+DBEvent TestProgramData::makeEvent(const QString &title,
+                                   const QDateTime &start, int minutes)
+{
+    return { title, QString(), QString("All about %1").arg(title),
+             QString(), ProgramInfo::kCategoryNone,
+             start, start.addSecs(minutes * 60LL),
+             0, 0, 0, 0.0F, QString(), QString(), kListingSourceEIT,
+             0, 0, 0 };
+}
+
+// Same rows as load_program_window() selects from the database.
+ProgramWindow TestProgramData::loadWindow(const ProgramTable &table,
+                                          const QDateTime &minstart,
+                                          const QDateTime &maxend)
+{
+    ProgramWindow window;
+    for (const auto & [starttime, prog] : table)
+    {
+        if (starttime <= maxend &&
+            (prog.m_endtime >= minstart || starttime >= minstart))
+            window.AddRow(prog);
+    }
+    return window;
+}
+
+// Same steps as write_program_window() performs on the database.
+void TestProgramData::commit(ProgramTable &table, const ProgramWindow &window)
+{
+    for (const auto & starttime : window.GetDeleted())
+        table.erase(starttime);
+
+    for (const auto & step : window.GetWriteOrder())
+    {
+        auto node = table.extract(step.m_from);
+        QVERIFY2(!node.empty(), "moved row not in table");
+        QVERIFY2(table.find(step.m_to) == table.end(),
+                 "moved row collides with a row that was not moved yet");
+        node.key() = step.m_to;
+        if (step.m_final)
+            node.mapped() = step.m_row->m_program;
+        table.insert(std::move(node));
+    }
+
+    for (const auto & [starttime, row] : window.GetRows())
+    {
+        if (row.m_state == ProgramWindow::kRowInserted)
+            table.insert_or_assign(starttime, row.m_program);
+    }
+}
+
+// The steps of DBEvent::UpdateDB(MSqlQuery&,uint,int) for one event,
+// applied directly to the table without a ProgramWindow.
+void TestProgramData::updateDB(ProgramTable &table, RecordChanges &changes,
+                               const DBEvent &event)
+{
+    if (event.m_endtime < kNow)
+        return;
+
+    // GetOverlappingPrograms()
+    std::vector<DBEvent> programs;
+    for (const auto & [starttime, prog] : table)
+    {
+        if ((starttime >= event.m_starttime &&
+             starttime <  event.m_endtime) ||
+            (prog.m_endtime >  event.m_starttime &&
+             prog.m_endtime <= event.m_endtime) ||
+            (starttime < event.m_starttime &&
+             prog.m_endtime > event.m_endtime))
+        {
+            programs.push_back(prog);
+        }
+    }
+
+    int i = -1;
+    if (!programs.empty() && event.GetMatch(programs, i) < 1000)
+        i = -1;
+
+    for (size_t j = 0; j < programs.size(); ++j)
+    {
+        if (j != (uint)i)
+            moveOutOfTheWayDB(table, changes, event, programs[j]);
+    }
+
+    // InsertDB() does a REPLACE INTO
+    if (i < 0)
+    {
+        table.insert_or_assign(event.m_starttime, event);
+        return;
+    }
+
+    const DBEvent &match = programs[i];
+    if (event.m_starttime != match.m_starttime &&
+        event.m_starttime < kNow && event.m_endtime <= match.m_endtime)
+        return;
+
+    // update_program() fails on a duplicate key
+    if (event.m_starttime != match.m_starttime &&
+        table.find(event.m_starttime) != table.end())
+        return;
+
+    auto node = table.extract(match.m_starttime);
+    if (node.empty())
+        return;
+    node.key() = event.m_starttime;
+    node.mapped() = event.Merge(match);
+    table.insert(std::move(node));
+
+    if (event.m_starttime != match.m_starttime)
+        changes.emplace_back(match.m_starttime, event.m_starttime);
+}
+
+// The decisions of DBEvent::MoveOutOfTheWayDB()
+void TestProgramData::moveOutOfTheWayDB(ProgramTable &table,
+                                        RecordChanges &changes,
+                                        const DBEvent &event,
+                                        const DBEvent &prog)
+{
+    if (prog.m_starttime >= event.m_starttime &&
+        prog.m_endtime   <= event.m_endtime)
+    {
+        table.erase(prog.m_starttime);
+    }
+    else if (prog.m_starttime < event.m_starttime &&
+             prog.m_endtime   > event.m_starttime)
+    {
+        auto it = table.find(prog.m_starttime);
+        if (it != table.end())
+            it->second.m_endtime = event.m_starttime;
+    }
+    else if (prog.m_starttime < event.m_endtime &&
+             prog.m_endtime   > event.m_endtime)
+    {
+        if (table.find(event.m_endtime) != table.end())
+        {
+            table.erase(prog.m_starttime);
+            return;
+        }
+        changes.emplace_back(prog.m_starttime, event.m_endtime);
+        auto node = table.extract(prog.m_starttime);
+        if (node.empty())
+            return;
+        node.key() = event.m_endtime;
+        node.mapped().m_starttime = event.m_endtime;
+        table.insert(std::move(node));
+    }
+}
+
+// One event at a time, as DBEvent::UpdateDB().
+ProgramTable TestProgramData::perEvent(ProgramTable table,
+                                       const std::vector<DBEvent> &events,
+                                       RecordChanges *changes)
+{
+    RecordChanges recordChanges;
+    for (const auto & event : events)
+        updateDB(table, recordChanges, event);
+    if (changes)
+        *changes = recordChanges;
+    return table;
+}
+
+// One window for all events, as DBEvent::UpdateDBBatch().
+ProgramTable TestProgramData::batch(ProgramTable table,
+                                    const std::vector<DBEvent> &events,
+                                    RecordChanges *changes)
+{
+    QDateTime minstart = events.front().m_starttime;
+    QDateTime maxend   = events.front().m_endtime;
+    for (const auto & event : events)
+    {
+        minstart = std::min(minstart, event.m_starttime);
+        maxend   = std::max(maxend,   event.m_endtime);
+    }
+
+    ProgramWindow window = loadWindow(table, minstart, maxend);
+    for (const auto & event : events)
+        window.Apply(event, 1000, kNow);
+    commit(table, window);
+    if (changes)
+        *changes = window.GetRecordChanges();
+    return table;
+}
+
+void TestProgramData::compareTables(const ProgramTable &actual,
+                                    const ProgramTable &expected)
+{
+    QCOMPARE(actual.size(), expected.size());
+    auto ait = actual.cbegin();
+    auto eit = expected.cbegin();
+    for (; eit != expected.cend(); ++ait, ++eit)
+    {
+        QCOMPARE(ait->first, eit->first);
+        QCOMPARE(ait->second.m_starttime,     eit->second.m_starttime);
+        QCOMPARE(ait->second.m_endtime,       eit->second.m_endtime);
+        QCOMPARE(ait->second.m_title,         eit->second.m_title);
+        QCOMPARE(ait->second.m_subtitle,      eit->second.m_subtitle);
+        QCOMPARE(ait->second.m_description,   eit->second.m_description);
+        QCOMPARE(ait->second.m_listingsource, eit->second.m_listingsource);
+    }
+}
+
+void TestProgramData::initTestCase(void)
+{
+    QVERIFY(kNow.isValid());
+    QVERIFY(kStart > kNow);
+}
+
+void TestProgramData::testInsertIntoEmpty(void)
+{
+    std::vector<DBEvent> events;
+    QDateTime start = kStart;
+    for (int i = 0; i < 6; ++i)
+    {
+        events.push_back(makeEvent(QString("Show %1").arg(i), start, 30));
+        start = start.addSecs(30 * 60);
+    }
+
+    ProgramTable table = batch({}, events);
+    QCOMPARE(table.size(), events.size());
+    compareTables(table, perEvent({}, events));
+}
+
+void TestProgramData::testResendIsUnchanged(void)
+{
+    std::vector<DBEvent> events {
+        makeEvent("News",        kStart,                 30),
+        makeEvent("Weather",     kStart.addSecs(30*60),  10),
+        makeEvent("Documentary", kStart.addSecs(40*60),  80),
+    };
+    ProgramTable table = batch({}, events);
+    ProgramTable expected = table;
+
+    ProgramWindow window =
+        loadWindow(table, kStart, events.back().m_endtime);
+    for (const auto & event : events)
+        QCOMPARE(window.Apply(event, 1000, kNow), 1U);
+    QVERIFY(window.GetDeleted().empty());
+    QVERIFY(window.GetRecordChanges().empty());
+
+    commit(table, window);
+    compareTables(table, expected);
+}
+
+void TestProgramData::testUpdateMatch(void)
+{
+    ProgramTable table = batch({}, {
+        makeEvent("Evening News", kStart,                30),
+        makeEvent("Film Night",   kStart.addSecs(30*60), 120) });
+
+    // The film starts five minutes late and the news runs over.
+    std::vector<DBEvent> events {
+        makeEvent("Evening News", kStart,                35),
+        makeEvent("Film Night",   kStart.addSecs(35*60), 120) };
+
+    ProgramTable result = batch(table, events);
+    QCOMPARE(result.size(), 2UL);
+    QCOMPARE(result.cbegin()->second.m_endtime, kStart.addSecs(35*60));
+    QCOMPARE(result.crbegin()->first,           kStart.addSecs(35*60));
+    QCOMPARE(result.crbegin()->second.m_title,  QString("Film Night"));
+    compareTables(result, perEvent(table, events));
+}
+
+void TestProgramData::testShiftedSchedule(void)
+{
+    ProgramTable table = batch({}, {
+        makeEvent("Morning Show", kStart,                 60),
+        makeEvent("Cartoons",     kStart.addSecs(60*60),  60),
+        makeEvent("Cooking",      kStart.addSecs(120*60), 60),
+        makeEvent("Quiz",         kStart.addSecs(180*60), 60) });
+
+    std::vector<DBEvent> events {
+        makeEvent("Morning Show", kStart,                 30),
+        makeEvent("Breaking",     kStart.addSecs(30*60),  45),
+        makeEvent("Cartoons",     kStart.addSecs(75*60),  60),
+        makeEvent("Gardening",    kStart.addSecs(135*60), 90),
+        makeEvent("Quiz",         kStart.addSecs(225*60), 30) };
+
+    compareTables(batch(table, events), perEvent(table, events));
+}
+
+void TestProgramData::testOverlappingBatch(void)
+{
+    ProgramTable table = batch({}, {
+        makeEvent("Late Film",    kStart,                120),
+        makeEvent("Night Talk",   kStart.addSecs(120*60), 60) });
+
+    // Later events in the batch overlap with earlier ones
+    std::vector<DBEvent> events {
+        makeEvent("Late Film",    kStart.addSecs(10*60),  120),
+        makeEvent("Short",        kStart.addSecs(100*60), 15),
+        makeEvent("Night Talk",   kStart.addSecs(130*60), 60),
+        makeEvent("Late Film",    kStart.addSecs(5*60),   100),
+        makeEvent("Short",        kStart.addSecs(105*60), 25) };
+
+    compareTables(batch(table, events), perEvent(table, events));
+}
+
+void TestProgramData::testPastEventSkipped(void)
+{
+    ProgramWindow window;
+    DBEvent event = makeEvent("Old News", kNow.addDays(-1), 30);
+    QCOMPARE(window.Apply(event, 1000, kNow), 0U);
+    QVERIFY(window.GetRows().empty());
+}
+
+void TestProgramData::testSwappedStartTimes(void)
+{
+    // Two overlapping programs, as some providers send them.
+    ProgramTable table {
+        { kStart,                makeEvent("Alpha", kStart,                120) },
+        { kStart.addSecs(30*60), makeEvent("Beta",  kStart.addSecs(30*60), 30) } };
+
+    // Alpha moves to where Beta was and Beta to where Alpha was, so
+    // neither row can be written first.
+    std::vector<DBEvent> events {
+        makeEvent("Alpha", kStart.addSecs(60*60), 90),
+        makeEvent("Beta",  kStart,                45),
+        makeEvent("Alpha", kStart.addSecs(30*60), 90) };
+
+    RecordChanges changes;
+    ProgramTable result = batch(table, events, &changes);
+    QCOMPARE(result.size(), 2UL);
+    QCOMPARE(result.cbegin()->first,            kStart);
+    QCOMPARE(result.cbegin()->second.m_title,   QString("Beta"));
+    QCOMPARE(result.cbegin()->second.m_endtime, kStart.addSecs(30*60));
+    QCOMPARE(result.crbegin()->first,           kStart.addSecs(30*60));
+    QCOMPARE(result.crbegin()->second.m_title,  QString("Alpha"));
+
+    RecordChanges expectedChanges;
+    compareTables(result, perEvent(table, events, &expectedChanges));
+    QVERIFY(changes == expectedChanges);
+}
+
+void TestProgramData::testRandomSchedules(void)
+{
+    static const QStringList kTitles {
+        "News", "Weather", "Film Night", "Cartoons", "Documentary",
+        "Sports Tonight", "Quiz", "Music Hour" };
+
+    std::mt19937 gen(4242); // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<int> title(0, kTitles.size() - 1);
+    std::uniform_int_distribution<int> duration(1, 24);
+    std::uniform_int_distribution<int> shift(-4, 4);
+
+    for (int run = 0; run < 50; ++run)
+    {
+        std::vector<DBEvent> original;
+        QDateTime start = kStart;
+        while (start < kStart.addDays(1))
+        {
+            int minutes = duration(gen) * 5;
+            original.push_back(makeEvent(kTitles[title(gen)], start, minutes));
+            start = start.addSecs(minutes * 60LL);
+        }
+        ProgramTable table = batch({}, original);
+
+        // Resend the schedule with shifted, retitled and resized programs.
+        std::vector<DBEvent> events;
+        for (const auto & prog : original)
+        {
+            QString newtitle = (title(gen) == 0) ?
+                kTitles[title(gen)] : prog.m_title;
+            int minutes = std::max(5, static_cast<int>(
+                prog.m_starttime.secsTo(prog.m_endtime) / 60) +
+                                   (shift(gen) * 5));
+            QDateTime newstart = prog.m_starttime.addSecs(shift(gen) * 60LL);
+            events.push_back(makeEvent(newtitle, newstart, minutes));
+        }
+
+        RecordChanges changes;
+        RecordChanges expectedChanges;
+        ProgramTable result = batch(table, events, &changes);
+        ProgramTable expected = perEvent(table, events, &expectedChanges);
+        QVERIFY2(result.size() == expected.size(),
+                 qPrintable(QString("run %1: %2 rows, expected %3")
+                            .arg(run).arg(result.size())
+                            .arg(expected.size())));
+        auto ait = result.cbegin();
+        for (const auto & [starttime, prog] : expected)
+        {
+            QVERIFY2(ait->first == starttime &&
+                     ait->second.m_endtime == prog.m_endtime &&
+                     ait->second.m_title == prog.m_title,
+                     qPrintable(QString("run %1: %2 %3 '%4', expected "
+                                        "%5 %6 '%7'")
+                                .arg(run)
+                                .arg(ait->first.toString(Qt::ISODate),
+                                     ait->second.m_endtime.toString(Qt::ISODate),
+                                     ait->second.m_title,
+                                     starttime.toString(Qt::ISODate),
+                                     prog.m_endtime.toString(Qt::ISODate),
+                                     prog.m_title)));
+            ++ait;
+        }
+        QVERIFY2(changes == expectedChanges,
+                 qPrintable(QString("run %1: record changes differ")
+                            .arg(run)));
+    }
+}
+
+QTEST_APPLESS_MAIN(TestProgramData)
@@ -0,0 +1,64 @@
+/*
+ *  Class TestProgramData
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <map>
+#include <vector>
+
+#include <QTest>
+
+#include "libmythtv/programdata.h"
+
+/// Stand-in for the program table of one channel, keyed by start time.
+using ProgramTable = std::map<QDateTime, DBEvent>;
+/// Start time changes applied to the record table, old and new start time.
+using RecordChanges = std::vector<std::pair<QDateTime, QDateTime> >;
+
+class TestProgramData : public QObject
+{
+    Q_OBJECT
+
+    static DBEvent makeEvent(const QString &title,
+                             const QDateTime &start, int minutes);
+    static ProgramWindow loadWindow(const ProgramTable &table,
+                                    const QDateTime &minstart,
+                                    const QDateTime &maxend);
+    static void commit(ProgramTable &table, const ProgramWindow &window);
+    static void updateDB(ProgramTable &table, RecordChanges &changes,
+                         const DBEvent &event);
+    static void moveOutOfTheWayDB(ProgramTable &table, RecordChanges &changes,
+                                  const DBEvent &event, const DBEvent &prog);
+    static ProgramTable perEvent(ProgramTable table,
+                                 const std::vector<DBEvent> &events,
+                                 RecordChanges *changes = nullptr);
+    static ProgramTable batch(ProgramTable table,
+                              const std::vector<DBEvent> &events,
+                              RecordChanges *changes = nullptr);
+    static void compareTables(const ProgramTable &actual,
+                              const ProgramTable &expected);
+
+  private slots:
+    static void initTestCase(void);
+    static void testInsertIntoEmpty(void);
+    static void testResendIsUnchanged(void);
+    static void testUpdateMatch(void);
+    static void testShiftedSchedule(void);
+    static void testOverlappingBatch(void);
+    static void testPastEventSkipped(void);
+    static void testSwappedStartTimes(void);
+    static void testRandomSchedules(void);
+};
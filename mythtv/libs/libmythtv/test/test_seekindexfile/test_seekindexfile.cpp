@@ -0,0 +1,178 @@
+/*
+ *  Class TestSeekIndexFile
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include "test_seekindexfile.h"
+
+#include <QFile>
+
+static frm_pos_map_t make_map(long long first, int count)
+{
+    frm_pos_map_t map;
+    for (int i = 0; i < count; ++i)
+    {
+        long long frame = first + (i * 12LL);
+        map[frame] = frame * 188LL * 1000;
+    }
+    return map;
+}
+
+void TestSeekIndexFile::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void TestSeekIndexFile::write_and_load()
+{
+    QString filename = m_dir.filePath("write.ts");
+
+    QMap<MarkTypes, frm_pos_map_t> maps;
+    maps[MARK_GOP_BYFRAME] = make_map(0, 5000);
+    // Durations that are not monotonic still round trip.
+    maps[MARK_DURATION_MS][0]   = 0;
+    maps[MARK_DURATION_MS][12]  = 480;
+    maps[MARK_DURATION_MS][24]  = 200;
+    QVERIFY(SeekIndexFile::Write(filename, maps));
+    QVERIFY(SeekIndexFile::Exists(filename));
+
+    SeekIndexFile index;
+    QVERIFY(index.Load(filename));
+    frm_pos_map_t posMap;
+    QVERIFY(index.Get(MARK_GOP_BYFRAME, posMap));
+    QCOMPARE(posMap, maps[MARK_GOP_BYFRAME]);
+    QVERIFY(index.Get(MARK_DURATION_MS, posMap));
+    QCOMPARE(posMap, maps[MARK_DURATION_MS]);
+    QVERIFY(!index.Get(MARK_KEYFRAME, posMap));
+    QVERIFY(posMap.isEmpty());
+
+    index.Close();
+    QVERIFY(SeekIndexFile::Remove(filename));
+    QVERIFY(!SeekIndexFile::Exists(filename));
+}
+
+void TestSeekIndexFile::append_blocks()
+{
+    QString filename = m_dir.filePath("append.ts");
+
+    SeekIndexFile writer;
+    QVERIFY(writer.OpenForAppend(filename));
+    QVERIFY(writer.Append(make_map(0, 100), MARK_GOP_BYFRAME));
+    QVERIFY(writer.Append(make_map(0, 10), MARK_DURATION_MS));
+    QVERIFY(writer.Append(make_map(1200, 100), MARK_GOP_BYFRAME));
+    writer.Close();
+
+    // Reopening keeps the existing blocks.
+    QVERIFY(writer.OpenForAppend(filename));
+    QVERIFY(writer.Append(make_map(2400, 100), MARK_GOP_BYFRAME));
+    writer.Close();
+
+    frm_pos_map_t expected = make_map(0, 300);
+    SeekIndexFile index;
+    QVERIFY(index.Load(filename));
+    frm_pos_map_t posMap;
+    QVERIFY(index.Get(MARK_GOP_BYFRAME, posMap));
+    QCOMPARE(posMap, expected);
+    QVERIFY(index.Get(MARK_DURATION_MS, posMap));
+    QCOMPARE(posMap.size(), 10);
+}
+
+void TestSeekIndexFile::truncated_block()
+{
+    QString filename = m_dir.filePath("truncated.ts");
+
+    SeekIndexFile writer;
+    QVERIFY(writer.OpenForAppend(filename));
+    QVERIFY(writer.Append(make_map(0, 100), MARK_GOP_BYFRAME));
+    QVERIFY(writer.Append(make_map(1200, 100), MARK_GOP_BYFRAME));
+    writer.Close();
+
+    // Simulate a crash part way through writing the last block.
+    QFile file(SeekIndexFile::IndexName(filename));
+    QVERIFY(file.resize(file.size() - 7));
+
+    SeekIndexFile index;
+    QVERIFY(index.Load(filename));
+    frm_pos_map_t posMap;
+    QVERIFY(index.Get(MARK_GOP_BYFRAME, posMap));
+    QCOMPARE(posMap, make_map(0, 100));
+    index.Close();
+
+    // Appending drops the partial block before adding new data.
+    QVERIFY(writer.OpenForAppend(filename));
+    QVERIFY(writer.Append(make_map(1200, 100), MARK_GOP_BYFRAME));
+    writer.Close();
+
+    QVERIFY(index.Load(filename));
+    QVERIFY(index.Get(MARK_GOP_BYFRAME, posMap));
+    QCOMPARE(posMap, make_map(0, 200));
+}
+
+void TestSeekIndexFile::incomplete_index()
+{
+    QString filename = m_dir.filePath("incomplete.ts");
+
+    // An index started part way through a recording is not used.
+    SeekIndexFile writer;
+    QVERIFY(writer.OpenForAppend(filename, false));
+    QVERIFY(writer.Append(make_map(1200, 100), MARK_GOP_BYFRAME));
+    writer.Close();
+
+    SeekIndexFile index;
+    QVERIFY(SeekIndexFile::Exists(filename));
+    QVERIFY(!index.Load(filename));
+    QVERIFY(!index.IsLoaded());
+
+    // Nor is a complete one that is later appended to from part way.
+    QString other = m_dir.filePath("gap.ts");
+    QVERIFY(writer.OpenForAppend(other));
+    QVERIFY(writer.Append(make_map(0, 100), MARK_GOP_BYFRAME));
+    writer.Close();
+    QVERIFY(index.Load(other));
+    index.Close();
+    QVERIFY(writer.OpenForAppend(other, false));
+    QVERIFY(writer.Append(make_map(2400, 100), MARK_GOP_BYFRAME));
+    writer.Close();
+    QVERIFY(!index.Load(other));
+
+    // A full rebuild makes it usable again.
+    QMap<MarkTypes, frm_pos_map_t> maps;
+    maps[MARK_GOP_BYFRAME] = make_map(0, 300);
+    QVERIFY(SeekIndexFile::Write(filename, maps));
+    QVERIFY(index.Load(filename));
+    frm_pos_map_t posMap;
+    QVERIFY(index.Get(MARK_GOP_BYFRAME, posMap));
+    QCOMPARE(posMap, maps[MARK_GOP_BYFRAME]);
+}
+
+void TestSeekIndexFile::not_an_index()
+{
+    QString filename = m_dir.filePath("garbage.ts");
+
+    QFile file(SeekIndexFile::IndexName(filename));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("this is not a seek index");
+    file.close();
+
+    SeekIndexFile index;
+    QVERIFY(!index.Load(filename));
+    QVERIFY(!index.IsLoaded());
+
+    QString missing = m_dir.filePath("missing.ts");
+    QVERIFY(!SeekIndexFile::Exists(missing));
+    QVERIFY(!index.Load(missing));
+}
+
+QTEST_APPLESS_MAIN(TestSeekIndexFile)
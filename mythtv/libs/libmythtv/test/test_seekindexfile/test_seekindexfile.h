@@ -0,0 +1,40 @@
+/*
+ *  Class TestSeekIndexFile
+ *
+ * This file is part of MythTV.
+ *
+ * MythTV is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * MythTV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with MythTV; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "libmythtv/seekindexfile.h"
+
+class TestSeekIndexFile : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void write_and_load();
+    void append_blocks();
+    void truncated_block();
+    void incomplete_index();
+    void not_an_index();
+
+  private:
+    QTemporaryDir m_dir;
+};
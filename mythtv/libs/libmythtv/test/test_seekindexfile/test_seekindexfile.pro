@@ -0,0 +1,19 @@
+include ( ../../../../settings.pro )
+include ( ../../../../test.pro )
+
+QT += testlib
+
+TEMPLATE = app
+TARGET = test_seekindexfile
+INCLUDEPATH += ../../..
+#LIBS += -L../.. -lmythtv-$$LIBVERSION
+#LIBS += -Wl,$$_RPATH_$${PWD}/../..
+
+# Input
+HEADERS += test_seekindexfile.h
+SOURCES += test_seekindexfile.cpp
+
+QMAKE_CLEAN += $(TARGET)
+QMAKE_CLEAN += ; ( cd $(OBJECTS_DIR) && rm -f *.gcov *.gcda *.gcno )
+
+#LIBS += $$EXTRA_LIBS $$LATE_LIBS
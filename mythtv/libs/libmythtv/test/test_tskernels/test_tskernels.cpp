@@ -0,0 +1,313 @@
+/*
+ *  Class TestTSKernels
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <QFile>
+
+#include "test_tskernels.h"
+#include "libmythtv/mpeg/tskernels.h"
+
+Q_DECLARE_METATYPE(const TSKernels*)
+
+static constexpr size_t kPacketSize { 188 };
+
+// Odd lengths exercise the scalar tails of the vector loops
+static constexpr std::array<size_t,14> kLengths
+    { 0, 1, 2, 3, 4, 17, 33, 188, 189, 204, 220, 377, 500, 4099 };
+
+static std::vector<uint8_t> Bytes(size_t len, uint32_t seed, uint8_t range = 0)
+{
+    std::vector<uint8_t> buffer(len);
+    for (auto & byte : buffer)
+    {
+        seed = (seed * 1664525) + 1013904223;
+        byte = static_cast<uint8_t>(range ? (seed >> 24) % range : seed >> 24);
+    }
+    return buffer;
+}
+
+/// A transport stream of \a count packets with PIDs 0 to 0x1fff, with
+/// sync bytes and start codes in the payloads as well.
+static std::vector<uint8_t> Stream(size_t count)
+{
+    auto buffer = Bytes(count * kPacketSize, 0x1234567);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint8_t *packet = &buffer[i * kPacketSize];
+        uint pid = (i * 0x3b1) & 0x1fff;
+        packet[0] = 0x47;
+        packet[1] = static_cast<uint8_t>((packet[1] & 0xe0) | (pid >> 8));
+        packet[2] = static_cast<uint8_t>(pid);
+        packet[4 + (i % 180)] = 0x47;
+        if (i % 3 == 0)
+        {
+            packet[100] = 0x00;
+            packet[101] = 0x00;
+            packet[102] = 0x01;
+        }
+    }
+    return buffer;
+}
+
+static void AddKernelRows(void)
+{
+    QTest::addColumn<const TSKernels*>("kernels");
+    for (const auto *kernels : TSKernels::Available())
+        QTest::newRow(kernels->m_name) << kernels;
+}
+
+static const TSKernels &Reference(void)
+{
+    return *TSKernels::Available().front();
+}
+
+void TestTSKernels::Selection(void)
+{
+    auto available = TSKernels::Available();
+    QVERIFY(!available.empty());
+    QCOMPARE(QString(available.front()->m_name), QString("C"));
+    QCOMPARE(&TSKernels::Get(), available.back());
+}
+
+// Check the C kernels against the simplest possible loops
+void TestTSKernels::CKernels(void)
+{
+    const TSKernels &ref = Reference();
+
+    for (uint8_t range : { 3, 0 })
+    {
+        auto buffer = Bytes(3000, 0x7654321, range);
+        if (!range)
+            buffer[1500] = buffer[1500 + kPacketSize] = 0x47;
+
+        for (size_t len : kLengths)
+        {
+            len = std::min(len, buffer.size());
+            const uint8_t *end = buffer.data() + len;
+
+            const uint8_t *sync = end;
+            for (const uint8_t *p = buffer.data(); p + kPacketSize < end; p++)
+            {
+                if (p[0] == 0x47 && p[kPacketSize] == 0x47)
+                {
+                    sync = p;
+                    break;
+                }
+            }
+            QCOMPARE(ref.m_findSync(buffer.data(), end), sync);
+
+            const uint8_t *code = end;
+            for (const uint8_t *p = buffer.data(); p + 3 <= end; p++)
+            {
+                if (p[0] == 0 && p[1] == 0 && p[2] == 1)
+                {
+                    code = p;
+                    break;
+                }
+            }
+            QCOMPARE(ref.m_findStartCode(buffer.data(), end), code);
+        }
+    }
+}
+
+void TestTSKernels::FindSync_data(void)
+{
+    AddKernelRows();
+}
+
+void TestTSKernels::FindSync(void)
+{
+    QFETCH(const TSKernels*, kernels);
+
+    // A stream found from every offset, and a lone pair of sync bytes
+    // at every position in otherwise sync free data.
+    auto stream = Stream(20);
+    for (size_t start = 0; start < 2 * kPacketSize; start++)
+    {
+        const uint8_t *end = stream.data() + stream.size();
+        QCOMPARE(kernels->m_findSync(stream.data() + start, end),
+                 Reference().m_findSync(stream.data() + start, end));
+    }
+
+    auto noise = Bytes(600, 0x2468ace);
+    for (auto & byte : noise)
+        byte = (byte == 0x47) ? 0 : byte;
+    for (size_t pos = 0; pos + kPacketSize < noise.size(); pos++)
+    {
+        auto buffer = noise;
+        buffer[pos] = buffer[pos + kPacketSize] = 0x47;
+        for (size_t len : kLengths)
+        {
+            len = std::min(len, buffer.size());
+            const uint8_t *end = buffer.data() + len;
+            QCOMPARE(kernels->m_findSync(buffer.data(), end),
+                     Reference().m_findSync(buffer.data(), end));
+        }
+    }
+}
+
+void TestTSKernels::ScanPackets_data(void)
+{
+    AddKernelRows();
+}
+
+void TestTSKernels::ScanPackets(void)
+{
+    QFETCH(const TSKernels*, kernels);
+
+    static constexpr size_t kCount { 37 };
+    auto stream = Stream(kCount);
+
+    // Lose sync at every packet, and not at all
+    for (size_t bad = 0; bad <= kCount; bad++)
+    {
+        auto buffer = stream;
+        if (bad < kCount)
+            buffer[bad * kPacketSize] = 0x48;
+
+        for (size_t count = 0; count <= kCount; count++)
+        {
+            std::vector<uint16_t> expected(count);
+            std::vector<uint16_t> pids(count);
+            size_t synced = Reference().m_scanPackets(buffer.data(), count,
+                                                      expected.data());
+            QCOMPARE(synced, std::min(bad, count));
+            QCOMPARE(kernels->m_scanPackets(buffer.data(), count, pids.data()),
+                     synced);
+            QCOMPARE(kernels->m_scanPackets(buffer.data(), count, nullptr),
+                     synced);
+            for (size_t i = 0; i < synced; i++)
+                QCOMPARE(pids[i], expected[i]);
+        }
+    }
+
+    for (size_t i = 0; i < kCount; i++)
+    {
+        std::vector<uint16_t> pids(kCount);
+        kernels->m_scanPackets(stream.data(), kCount, pids.data());
+        QCOMPARE(uint(pids[i]), uint((i * 0x3b1) & 0x1fff));
+    }
+}
+
+void TestTSKernels::FindStartCode_data(void)
+{
+    AddKernelRows();
+}
+
+void TestTSKernels::FindStartCode(void)
+{
+    QFETCH(const TSKernels*, kernels);
+
+    // Bytes of 0, 1 and 2 only make start codes and near misses common
+    for (uint8_t range : { 3, 0 })
+    {
+        auto buffer = Bytes(5000, 0x1357913, range);
+        for (size_t len : kLengths)
+        {
+            for (size_t start = 0; start < 40 && start <= len; start++)
+            {
+                const uint8_t *p = buffer.data() + start;
+                const uint8_t *end = buffer.data() + len;
+                // Walk all of them, as the parsers do
+                while (p < end)
+                {
+                    const uint8_t *found = Reference().m_findStartCode(p, end);
+                    QCOMPARE(kernels->m_findStartCode(p, end), found);
+                    p = found + 1;
+                }
+            }
+        }
+    }
+}
+
+void TestTSKernels::Benchmark_data(void)
+{
+    QTest::addColumn<const TSKernels*>("kernels");
+    QTest::addColumn<QString>("routine");
+    for (const auto *kernels : TSKernels::Available())
+    {
+        for (const char *routine : { "resync", "scan", "startcode" })
+        {
+            QTest::addRow("%s %s", kernels->m_name, routine)
+                << kernels << QString(routine);
+        }
+    }
+}
+
+/** \brief Times the kernels on 10000 packets, just under 2MB.
+ *
+ *  The packets come from the start of the recording named by the
+ *  MYTHTV_TEST_TS environment variable when it is set, and are generated
+ *  otherwise. The resync run searches data without any sync byte pairs,
+ *  which is the worst case.
+ */
+void TestTSKernels::Benchmark(void)
+{
+    QFETCH(const TSKernels*, kernels);
+    QFETCH(QString, routine);
+
+    static constexpr size_t kCount { 10000 };
+
+    std::vector<uint8_t> stream;
+    QFile file(qEnvironmentVariable("MYTHTV_TEST_TS"));
+    if (!file.fileName().isEmpty() && file.open(QIODevice::ReadOnly))
+    {
+        QByteArray data = file.read(kCount * kPacketSize);
+        stream.assign(data.cbegin(), data.cend());
+        stream.resize(stream.size() - (stream.size() % kPacketSize));
+    }
+    if (stream.empty())
+        stream = Stream(kCount);
+
+    auto noise = Bytes(kCount * kPacketSize, 0x2468ace);
+    for (auto & byte : noise)
+        byte = (byte == 0x47) ? 0 : byte;
+
+    const uint8_t *end = stream.data() + stream.size();
+    std::vector<uint16_t> pids(stream.size() / kPacketSize);
+    size_t found = 0;
+
+    QBENCHMARK
+    {
+        if (routine == "resync")
+        {
+            const uint8_t *noiseEnd = noise.data() + noise.size();
+            found += (kernels->m_findSync(noise.data(), noiseEnd) != noiseEnd) ? 1 : 0;
+        }
+        else if (routine == "scan")
+        {
+            found += kernels->m_scanPackets(stream.data(), pids.size(), pids.data());
+        }
+        else
+        {
+            const uint8_t *p = stream.data();
+            while ((p = kernels->m_findStartCode(p, end)) != end)
+            {
+                found++;
+                p += 3;
+            }
+        }
+    }
+    QVERIFY(routine == "resync" ? found == 0 : found > 0);
+}
+
+QTEST_APPLESS_MAIN(TestTSKernels)
@@ -0,0 +1,39 @@
+/*
+ *  Class TestTSKernels
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QTest>
+
+class TestTSKernels : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    static void Selection(void);
+    static void CKernels(void);
+
+    // Every kernel set must give the same results as the C kernels
+    static void FindSync_data(void);
+    static void FindSync(void);
+    static void ScanPackets_data(void);
+    static void ScanPackets(void);
+    static void FindStartCode_data(void);
+    static void FindStartCode(void);
+
+    static void Benchmark_data(void);
+    static void Benchmark(void);
+};
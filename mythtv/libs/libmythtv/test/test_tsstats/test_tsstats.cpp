@@ -0,0 +1,213 @@
+/*
+ *  Class TestTSStats
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include "test_tsstats.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+static TSPacket make_packet(uint pid, uint cc)
+{
+    TSPacket packet;
+    std::fill_n(packet.data(), TSPacket::kSize, 0xFF);
+    packet.data()[0] = SYNC_BYTE;
+    packet.data()[1] = 0x00;
+    packet.data()[3] = 0x00;
+    packet.SetPID(pid);
+    packet.SetAdaptationFieldControl(1);
+    packet.SetContinuityCounter(cc);
+    return packet;
+}
+
+// Adds an adaptation field carrying a PCR with the given 90kHz base
+static void set_pcr(TSPacket &packet, int64_t base)
+{
+    unsigned char *data = packet.data();
+    packet.SetAdaptationFieldControl(3);
+    data[4]  = 7;
+    data[5]  = 0x10;
+    data[6]  = (base >> 25) & 0xFF;
+    data[7]  = (base >> 17) & 0xFF;
+    data[8]  = (base >> 9)  & 0xFF;
+    data[9]  = (base >> 1)  & 0xFF;
+    data[10] = ((base & 0x1) << 7) | 0x7E;
+    data[11] = 0x00;
+}
+
+static const TSStats::PIDStats *find_pid(
+    const TSStats::PIDStatsList &list, uint pid)
+{
+    auto it = std::find_if(list.cbegin(), list.cend(),
+                           [pid](const auto &s) { return s.m_pid == pid; });
+    return (it == list.cend()) ? nullptr : &(*it);
+}
+
+// The result would point into a temporary
+static const TSStats::PIDStats *find_pid(TSStats::PIDStatsList &&list, uint pid) = delete;
+
+void TestTSStats::continuity(void)
+{
+    TSStats stats;
+    for (uint i = 0; i < 40; ++i)
+    {
+        if (i == 20)
+            continue; // lost packet
+        stats.AddPacket(make_packet(0x100, i));
+    }
+    // The null PID is not checked
+    stats.AddPacket(make_packet(0x1fff, 3));
+    stats.AddPacket(make_packet(0x1fff, 9));
+    stats.Publish();
+
+    auto list = stats.GetSnapshot();
+    QCOMPARE(list.size(), size_t(2));
+    const auto *video = find_pid(list, 0x100);
+    QVERIFY(video != nullptr);
+    QCOMPARE(video->m_packets, uint64_t(39));
+    QCOMPARE(video->m_ccErrors, uint64_t(1));
+    const auto *null = find_pid(list, 0x1fff);
+    QVERIFY(null != nullptr);
+    QCOMPARE(null->m_packets, uint64_t(2));
+    QCOMPARE(null->m_ccErrors, uint64_t(0));
+}
+
+void TestTSStats::duplicates(void)
+{
+    TSStats stats;
+    stats.AddPacket(make_packet(0x100, 5));
+    stats.AddPacket(make_packet(0x100, 5)); // duplicate
+    stats.AddPacket(make_packet(0x100, 6));
+
+    // No payload, so the counter stays
+    TSPacket noPayload = make_packet(0x100, 6);
+    noPayload.SetAdaptationFieldControl(2);
+    noPayload.data()[4] = 183;
+    noPayload.data()[5] = 0x00;
+    stats.AddPacket(noPayload);
+    stats.AddPacket(make_packet(0x100, 7));
+
+    // A discontinuity indicator allows any counter
+    TSPacket jump = make_packet(0x100, 12);
+    jump.SetAdaptationFieldControl(3);
+    jump.data()[4] = 1;
+    jump.data()[5] = 0x80;
+    stats.AddPacket(jump);
+    stats.AddPacket(make_packet(0x100, 13));
+    stats.Publish();
+
+    const auto snap = stats.GetSnapshot();
+    const auto *pid = find_pid(snap, 0x100);
+    QVERIFY(pid != nullptr);
+    QCOMPARE(pid->m_packets, uint64_t(7));
+    QCOMPARE(pid->m_ccErrors, uint64_t(0));
+}
+
+void TestTSStats::errors(void)
+{
+    TSStats stats;
+    for (uint i = 0; i < 100; ++i)
+    {
+        TSPacket packet = make_packet(0x200, i);
+        packet.SetTransportError(i % 10 == 0);
+        packet.SetScrambled((i < 25) ? 2 : 0);
+        stats.AddPacket(packet);
+    }
+    stats.Publish();
+
+    const auto snap = stats.GetSnapshot();
+    const auto *pid = find_pid(snap, 0x200);
+    QVERIFY(pid != nullptr);
+    QCOMPARE(pid->m_packets, uint64_t(100));
+    QCOMPARE(pid->m_teiErrors, uint64_t(10));
+    QCOMPARE(pid->m_scrambled, uint64_t(25));
+    QCOMPARE(pid->ScrambledRatio(), 0.25);
+    // Packets with errors don't break the continuity check
+    QCOMPARE(pid->m_ccErrors, uint64_t(0));
+}
+
+void TestTSStats::pcr(void)
+{
+    TSStats stats;
+    // 40ms apart, wrapping around the end of the 33 bit base
+    int64_t base = (1LL << 33) - (3 * 3600);
+    for (uint i = 0; i < 6; ++i)
+    {
+        TSPacket packet = make_packet(0x100, i);
+        set_pcr(packet, base & ((1LL << 33) - 1));
+        stats.AddPacket(packet);
+        base += 3600;
+    }
+    stats.Publish();
+
+    const auto snap = stats.GetSnapshot();
+    const auto *pid = find_pid(snap, 0x100);
+    QVERIFY(pid != nullptr);
+    QCOMPARE(pid->m_pcrCount, uint64_t(6));
+    // Arriving together, each PCR is 40ms early
+    QVERIFY(pid->m_pcrJitterMax >= 39ms);
+    QVERIFY(pid->m_pcrJitterMax <= 41ms);
+}
+
+void TestTSStats::reset(void)
+{
+    TSStats stats;
+    stats.AddPacket(make_packet(0x100, 0));
+    stats.AddPacket(make_packet(0x100, 4));
+    stats.Publish();
+    QCOMPARE(stats.GetSnapshot().size(), size_t(1));
+
+    stats.Reset();
+    QVERIFY(stats.GetSnapshot().empty());
+
+    // The continuity counter starts over as well
+    stats.AddPacket(make_packet(0x100, 9));
+    stats.Publish();
+    const auto snap = stats.GetSnapshot();
+    const auto *pid = find_pid(snap, 0x100);
+    QVERIFY(pid != nullptr);
+    QCOMPARE(pid->m_packets, uint64_t(1));
+    QCOMPARE(pid->m_ccErrors, uint64_t(0));
+}
+
+/**
+ * Measures the cost of AddPacket() on a stream like a typical HD
+ * service: mostly video, with audio, tables and PCRs mixed in.
+ */
+void TestTSStats::benchmark(void)
+{
+    std::vector<TSPacket> packets;
+    std::array<uint,6> pids { 0x100, 0x100, 0x100, 0x100, 0x101, 0x0 };
+    std::array<uint,0x1fff + 1> cc {};
+    for (uint i = 0; i < 10000; ++i)
+    {
+        uint pid = pids[i % pids.size()];
+        TSPacket packet = make_packet(pid, cc[pid]++);
+        if (pid == 0x100 && (i % 100) == 0)
+            set_pcr(packet, i * 3600LL);
+        packets.push_back(packet);
+    }
+
+    TSStats stats;
+    QBENCHMARK
+    {
+        for (const auto & packet : packets)
+            stats.AddPacket(packet);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestTSStats)
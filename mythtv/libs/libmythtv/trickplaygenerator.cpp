@@ -0,0 +1,314 @@
+// C++ headers
+#include <algorithm>
+#include <cmath>
+
+// Qt headers
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QSaveFile>
+
+// MythTV headers
+#include "libmythbase/mthreadpool.h"
+#include "libmythbase/mythcorecontext.h"
+#include "libmythbase/mythlogging.h"
+#include "libmythbase/mythmiscutil.h"
+
+#include "io/mythmediabuffer.h"
+#include "mythpreviewplayer.h"
+#include "playercontext.h"
+#include "trickplaygenerator.h"
+
+extern "C" {
+#include "libavutil/mem.h"
+}
+
+#define LOC QString("TrickPlay: ")
+
+QMutex        TrickPlayGenerator::s_lock;
+QSet<QString> TrickPlayGenerator::s_generating;
+
+TrickPlayGenerator::TrickPlayGenerator(const ProgramInfo &pginfo)
+  : m_programInfo(pginfo),
+    m_pathname(pginfo.GetPathname())
+{
+    setAutoDelete(true);
+}
+
+/**
+ *  \brief Starts building the thumbnail index of a local recording in
+ *         the background, unless it is already being built.
+ */
+void TrickPlayGenerator::Queue(const ProgramInfo &pginfo)
+{
+    QString pathname = pginfo.GetPathname();
+    {
+        QMutexLocker locker(&s_lock);
+        if (s_generating.contains(pathname))
+            return;
+        s_generating.insert(pathname);
+    }
+
+    // Whole recordings are decoded here, so they get a pool of their own
+    // rather than holding up the short tasks of the global pool.
+    static MThreadPool *s_pool = nullptr;
+    {
+        QMutexLocker locker(&s_lock);
+        if (!s_pool)
+        {
+            s_pool = new MThreadPool("TrickPlayGenerator");
+            s_pool->setMaxThreadCount(1);
+        }
+    }
+    s_pool->start(new TrickPlayGenerator(pginfo), "TrickPlay");
+}
+
+bool TrickPlayGenerator::IsGenerating(const QString &pathname)
+{
+    QMutexLocker locker(&s_lock);
+    return s_generating.contains(pathname);
+}
+
+QString TrickPlayGenerator::IndexFilename(const QString &pathname)
+{
+    return pathname + ".trickplay.json";
+}
+
+QString TrickPlayGenerator::SheetFilename(const QString &pathname, uint sheet)
+{
+    return QString("%1.trickplay.%2.jpg").arg(pathname).arg(sheet);
+}
+
+/**
+ *  \brief Deletes the thumbnail index and sheets of a recording, so they
+ *         are built again from the recording as it is now.
+ */
+void TrickPlayGenerator::Remove(const QString &pathname)
+{
+    QFile::remove(IndexFilename(pathname));
+    for (uint sheet = 0; QFile::remove(SheetFilename(pathname, sheet)); ++sheet)
+        ;
+}
+
+void TrickPlayGenerator::run(void)
+{
+    Run();
+
+    QMutexLocker locker(&s_lock);
+    s_generating.remove(m_pathname);
+}
+
+/**
+ *  \brief Returns the keyframe at or after the start of every interval,
+ *         with its time from the start of the recording.
+ *
+ *   Times come from the duration map when the recorder saved one, and
+ *   are estimated from the frame rate otherwise.
+ */
+std::vector<std::pair<uint64_t,std::chrono::milliseconds>>
+TrickPlayGenerator::PickKeyframes(void) const
+{
+    std::vector<std::pair<uint64_t,std::chrono::milliseconds>> keyframes;
+
+    frm_pos_map_t posMap;
+    m_programInfo.QueryPositionMap(posMap, MARK_GOP_BYFRAME);
+    if (posMap.isEmpty())
+        m_programInfo.QueryPositionMap(posMap, MARK_GOP_START);
+    if (posMap.isEmpty())
+        return keyframes;
+
+    frm_pos_map_t durMap;
+    m_programInfo.QueryPositionMap(durMap, MARK_DURATION_MS);
+
+    double fps = m_programInfo.QueryAverageFrameRate() / 1000.0;
+    if (fps <= 0.0)
+        fps = 29.97;
+
+    std::chrono::milliseconds next = 0ms;
+    for (auto it = posMap.cbegin(); it != posMap.cend(); ++it)
+    {
+        auto frame = static_cast<uint64_t>(it.key());
+        auto dur = durMap.constFind(it.key());
+        auto ms = (dur != durMap.cend())
+            ? std::chrono::milliseconds(*dur)
+            : std::chrono::milliseconds(std::lround(frame * 1000 / fps));
+        if (ms < next)
+            continue;
+        keyframes.emplace_back(frame, ms);
+        next = ms - (ms % kInterval) + kInterval;
+    }
+
+    return keyframes;
+}
+
+bool TrickPlayGenerator::SaveSheet(uint sheet, const QImage &image) const
+{
+    QSaveFile file(SheetFilename(m_pathname, sheet));
+    if (!file.open(QIODevice::WriteOnly) ||
+        !image.save(&file, "JPG", kQuality) || !file.commit())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Failed to save '%1'")
+            .arg(file.fileName()));
+        return false;
+    }
+    makeFileAccessible(file.fileName());
+    return true;
+}
+
+/**
+ *  \brief Builds the thumbnail sheets and index, blocking until done.
+ *
+ *   The index is written last, so its presence means the sheets are
+ *   complete.
+ */
+bool TrickPlayGenerator::Run(void)
+{
+    const QFileInfo before(m_pathname);
+    if (!before.isReadable())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Can't read '%1'")
+            .arg(m_pathname));
+        return false;
+    }
+
+    auto keyframes = PickKeyframes();
+    if (keyframes.empty())
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC + QString("No seek table for '%1'")
+            .arg(m_pathname));
+        return false;
+    }
+
+    MythMediaBuffer *buffer = MythMediaBuffer::Create(m_pathname, false, false, 0ms);
+    if (!buffer || !buffer->IsOpen())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Could not open '%1'")
+            .arg(m_pathname));
+        delete buffer;
+        return false;
+    }
+
+    m_programInfo.MarkAsInUse(true, kPreviewGeneratorInUseID);
+    m_programInfo.SetIgnoreProgStart(true);
+
+    auto *ctx = new PlayerContext(kPreviewGeneratorInUseID);
+    auto *player = new MythPreviewPlayer(ctx, static_cast<PlayerFlags>(kAudioMuted | kVideoIsNull | kNoITV));
+    ctx->SetRingBuffer(buffer);
+    ctx->SetPlayingInfo(&m_programInfo);
+    ctx->SetPlayer(player);
+
+    const size_t perSheet = kColumns * kRows;
+    int thumbHeight = 0;
+    QImage sheet;
+    uint sheets = 0;
+    QJsonArray thumbnails;
+    bool ok = true;
+
+    for (size_t i = 0; ok && i < keyframes.size(); ++i)
+    {
+        int bufferSize = 0;
+        int width = 0;
+        int height = 0;
+        float aspect = 0.0F;
+        auto *data = reinterpret_cast<uint8_t*>(
+            player->GetKeyframeGrab(keyframes[i].first, bufferSize,
+                                    width, height, aspect));
+
+        if (thumbHeight == 0)
+        {
+            if (!data || !width || !height)
+            {
+                av_free(data);
+                ok = false;
+                break;
+            }
+            aspect = (aspect <= 0.0F) ? static_cast<float>(width) / height : aspect;
+            thumbHeight = std::max(1, static_cast<int>(std::lround(kThumbWidth / aspect)));
+        }
+
+        if (i % perSheet == 0)
+        {
+            if (!sheet.isNull())
+                ok = SaveSheet(sheets++, sheet);
+            size_t left = std::min(perSheet, keyframes.size() - i);
+            int rows = static_cast<int>((left + kColumns - 1) / kColumns);
+            sheet = QImage(kThumbWidth * kColumns, thumbHeight * rows,
+                           QImage::Format_RGB32);
+            sheet.fill(Qt::black);
+        }
+
+        // A failed grab leaves its cell black, so the position of every
+        // later thumbnail still follows from its index.
+        if (data && width && height)
+        {
+            const QImage img(data, width, height, QImage::Format_RGB32);
+            size_t cell = i % perSheet;
+            QPainter painter(&sheet);
+            painter.setRenderHint(QPainter::SmoothPixmapTransform);
+            painter.drawImage(QRect(static_cast<int>(cell % kColumns) * kThumbWidth,
+                                    static_cast<int>(cell / kColumns) * thumbHeight,
+                                    kThumbWidth, thumbHeight), img);
+        }
+        av_free(data);
+
+        thumbnails.append(QJsonObject {
+            { "ms",    static_cast<qint64>(keyframes[i].second.count()) },
+            { "frame", static_cast<qint64>(keyframes[i].first) } });
+    }
+
+    if (ok && !sheet.isNull())
+        ok = SaveSheet(sheets++, sheet);
+
+    delete ctx;
+    m_programInfo.MarkAsInUse(false, kPreviewGeneratorInUseID);
+
+    if (!ok)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Failed to build index for '%1'")
+            .arg(m_pathname));
+        return false;
+    }
+
+    // A transcode may have replaced the recording while it was decoded,
+    // and the thumbnails would then point at the wrong frames.
+    const QFileInfo after(m_pathname);
+    if (!after.exists() || after.size() != before.size() ||
+        after.lastModified() != before.lastModified())
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("'%1' changed while building its index, discarding it")
+            .arg(m_pathname));
+        for (uint i = 0; i < sheets; ++i)
+            QFile::remove(SheetFilename(m_pathname, i));
+        return false;
+    }
+
+    QJsonObject index {
+        { "version",    1 },
+        { "interval",   static_cast<qint64>(kInterval.count()) },
+        { "width",      kThumbWidth },
+        { "height",     thumbHeight },
+        { "columns",    kColumns },
+        { "rows",       kRows },
+        { "sheets",     static_cast<int>(sheets) },
+        { "thumbnails", thumbnails } };
+
+    QSaveFile file(IndexFilename(m_pathname));
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(QJsonDocument(index).toJson(QJsonDocument::Compact)) < 0 ||
+        !file.commit())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Failed to save '%1'")
+            .arg(file.fileName()));
+        return false;
+    }
+    makeFileAccessible(file.fileName());
+
+    LOG(VB_GENERAL, LOG_INFO, LOC + QString("Saved %1 thumbnails on %2 sheets for '%3'")
+        .arg(thumbnails.size()).arg(sheets).arg(m_pathname));
+    return true;
+}
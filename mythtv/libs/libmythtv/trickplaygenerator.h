@@ -0,0 +1,73 @@
+// -*- Mode: c++ -*-
+#ifndef TRICKPLAY_GENERATOR_H_
+#define TRICKPLAY_GENERATOR_H_
+
+#include <utility>
+#include <vector>
+
+#include <QMutex>
+#include <QRunnable>
+#include <QSet>
+#include <QString>
+
+#include "libmythbase/mythchrono.h"
+#include "libmythbase/programinfo.h"
+
+#include "mythtvexp.h"
+
+class QImage;
+
+/** \class TrickPlayGenerator
+ *  \brief Builds an index of small keyframe thumbnails for a recording,
+ *         so a frontend can scrub through it without reading the video.
+ *
+ *   Keyframes close to every kInterval of the recording are picked from
+ *   the seek table and decoded once each, without decoding the rest of
+ *   their GOP. The thumbnails are packed kColumns x kRows to a JPEG sheet
+ *   named "<recording>.trickplay.<sheet>.jpg", and described by a JSON
+ *   index in "<recording>.trickplay.json":
+ *
+ *   \code
+ *   { "version": 1, "interval": 10000, "width": 160, "height": 90,
+ *     "columns": 10, "rows": 10, "sheets": 2,
+ *     "thumbnails": [ { "ms": 0, "frame": 0 }, { "ms": 10010, "frame": 300 } ] }
+ *   \endcode
+ *
+ *   Thumbnail n is on sheet n / (columns * rows), in the cell counted
+ *   left to right, top to bottom. Both files are written next to the
+ *   recording, so they are deleted with it, and must be removed with
+ *   Remove() whenever the recording itself is rewritten.
+ */
+class MTV_PUBLIC TrickPlayGenerator : public QRunnable
+{
+  public:
+    static constexpr std::chrono::milliseconds kInterval { 10s };
+    static constexpr int kThumbWidth { 160 };
+    static constexpr int kColumns    { 10 };
+    static constexpr int kRows       { 10 };
+    static constexpr int kQuality    { 75 };
+
+    explicit TrickPlayGenerator(const ProgramInfo &pginfo);
+
+    static void Queue(const ProgramInfo &pginfo);
+    static bool IsGenerating(const QString &pathname);
+    static QString IndexFilename(const QString &pathname);
+    static QString SheetFilename(const QString &pathname, uint sheet);
+    static void Remove(const QString &pathname);
+
+    void run(void) override; // QRunnable
+    bool Run(void);
+
+  private:
+    std::vector<std::pair<uint64_t,std::chrono::milliseconds>>
+        PickKeyframes(void) const;
+    bool SaveSheet(uint sheet, const QImage &image) const;
+
+    ProgramInfo m_programInfo;
+    QString     m_pathname;
+
+    static QMutex        s_lock;
+    static QSet<QString> s_generating;
+};
+
+#endif // TRICKPLAY_GENERATOR_H_
@@ -0,0 +1,206 @@
+#include <algorithm>
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "libmythbase/mythcorecontext.h"
+#include "libmythbase/mythlogging.h"
+
+#include "tuningtrace.h"
+
+#define LOC QString("TuningTrace[%1]: ").arg(m_inputId)
+
+static QMutex s_statsLock;
+static std::array<TuningTrace::PhaseStats,TuningTrace::kPhases> s_stats {};
+
+static QMutex s_fileLock;
+
+/// Chrome trace timestamps are relative to this, so that the traces
+/// of all inputs line up.
+static const std::chrono::steady_clock::time_point s_epoch =
+    std::chrono::steady_clock::now();
+
+QString TuningTrace::PhaseName(Phase phase)
+{
+    switch (phase)
+    {
+        case kShutdowns:     return "Shutdowns";
+        case kRecorderPause: return "RecorderPause";
+        case kFrequency:     return "Frequency";
+        case kSignalLock:    return "SignalLock";
+        case kFirstPAT:      return "FirstPAT";
+        case kFirstPMT:      return "FirstPMT";
+        case kSignalGood:    return "SignalGood";
+        case kRecorderStart: return "RecorderStart";
+        case kFirstKeyframe: return "FirstKeyframe";
+        case kFirstWrite:    return "FirstWrite";
+        case kPhases:        break;
+    }
+    return "Unknown";
+}
+
+bool TuningTrace::IsSpan(Phase phase)
+{
+    return phase == kShutdowns || phase == kRecorderPause ||
+           phase == kFrequency || phase == kRecorderStart;
+}
+
+/// \brief Finishes any earlier trace and starts timing a new request.
+void TuningTrace::Start(const QString &request)
+{
+    Finish();
+
+    QMutexLocker locker(&m_lock);
+    m_active  = true;
+    m_request = request;
+    m_start   = Clock::now();
+    m_seen    = 0;
+    m_begun.fill(Clock::time_point());
+    m_events.clear();
+}
+
+/// \brief Marks the start of a span.
+void TuningTrace::Begin(Phase phase)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_active)
+        m_begun[phase] = Clock::now();
+}
+
+/// \brief Marks the end of a span started with Begin().
+void TuningTrace::End(Phase phase)
+{
+    QMutexLocker locker(&m_lock);
+    if (!m_active || m_begun[phase] == Clock::time_point())
+        return;
+    m_events.push_back({phase, m_begun[phase], Clock::now()});
+    m_begun[phase] = Clock::time_point();
+}
+
+/// \brief Marks a milestone. Only the first time in a trace counts.
+void TuningTrace::Mark(Phase phase)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        if (!m_active || (m_seen & (1U << phase)))
+            return;
+        m_seen |= (1U << phase);
+        m_events.push_back({phase, m_start, Clock::now()});
+    }
+
+    if (phase == kFirstWrite)
+        Finish();
+}
+
+/// \brief Adds the current trace to the histograms and the trace file.
+void TuningTrace::Finish(void)
+{
+    QMutexLocker locker(&m_lock);
+    if (!m_active)
+        return;
+    m_active = false;
+
+    {
+        QMutexLocker stats_locker(&s_statsLock);
+        for (const auto & event : m_events)
+        {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>
+                (event.m_end - event.m_begin);
+            PhaseStats &stats = s_stats[event.m_phase];
+            size_t bucket = 0;
+            while (bucket < kBucketLimits.size() &&
+                   elapsed >= kBucketLimits[bucket])
+                ++bucket;
+            ++stats.m_buckets[bucket];
+            ++stats.m_count;
+            stats.m_total += elapsed;
+            stats.m_max = std::max(stats.m_max, elapsed);
+        }
+    }
+
+    if (!m_events.empty())
+        WriteChromeTrace();
+}
+
+/** \brief Appends the current trace to the "TVRecTraceFile" file, in
+ *         the Chrome trace event format.
+ *
+ *   The file is a JSON array that is never closed, which the Chrome
+ *   trace viewer accepts, so traces can simply be appended.
+ */
+void TuningTrace::WriteChromeTrace(void) const
+{
+    QString filename = gCoreContext->GetSetting("TVRecTraceFile");
+    if (filename.isEmpty())
+        return;
+
+    auto usecs = [](Clock::time_point t)
+    {
+        return static_cast<qint64>(
+            std::chrono::duration_cast<std::chrono::microseconds>
+            (t - s_epoch).count());
+    };
+    auto base = [this](const QString &name)
+    {
+        QJsonObject obj;
+        obj["name"] = name;
+        obj["cat"]  = "tuning";
+        obj["pid"]  = 1;
+        obj["tid"]  = static_cast<int>(m_inputId);
+        return obj;
+    };
+
+    QByteArray data;
+    Clock::time_point last = m_start;
+    for (const auto & event : m_events)
+    {
+        QJsonObject obj = base(PhaseName(event.m_phase));
+        if (IsSpan(event.m_phase))
+        {
+            obj["ph"]  = "X";
+            obj["ts"]  = usecs(event.m_begin);
+            obj["dur"] = usecs(event.m_end) - usecs(event.m_begin);
+        }
+        else
+        {
+            obj["ph"]  = "i";
+            obj["s"]   = "t";
+            obj["ts"]  = usecs(event.m_end);
+        }
+        data += QJsonDocument(obj).toJson(QJsonDocument::Compact) + ",\n";
+        last = std::max(last, event.m_end);
+    }
+
+    QJsonObject request = base("Request");
+    request["ph"]   = "X";
+    request["ts"]   = usecs(m_start);
+    request["dur"]  = usecs(last) - usecs(m_start);
+    request["args"] = QJsonObject { { "request", m_request } };
+    data += QJsonDocument(request).toJson(QJsonDocument::Compact) + ",\n";
+
+    QMutexLocker locker(&s_fileLock);
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC +
+            QString("Can't open trace file '%1'").arg(filename));
+        return;
+    }
+    if (file.size() == 0)
+        file.write("[\n");
+    file.write(data);
+}
+
+/// \brief Returns the histograms of all the traces finished so far.
+std::vector<TuningTrace::PhaseStats> TuningTrace::GetStats(void)
+{
+    QMutexLocker locker(&s_statsLock);
+    std::vector<PhaseStats> stats(s_stats.cbegin(), s_stats.cend());
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        stats[i].m_name = PhaseName(static_cast<Phase>(i));
+        stats[i].m_span = IsSpan(static_cast<Phase>(i));
+    }
+    return stats;
+}
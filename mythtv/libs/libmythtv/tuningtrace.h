@@ -0,0 +1,98 @@
+// -*- Mode: c++ -*-
+#ifndef TUNING_TRACE_H
+#define TUNING_TRACE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <QMutex>
+#include <QString>
+
+#include "libmythbase/mythchrono.h"
+
+#include "mythtvexp.h"
+
+/** \class TuningTrace
+ *  \brief Timestamps the phases TVRec goes through for a tuning request.
+ *
+ *   A trace starts when TVRec takes a request off its tuning queue and
+ *   ends when the recorder writes its first packet, or when the next
+ *   request starts. Steps TVRec runs itself are recorded as spans, the
+ *   other milestones as the time from the start of the request. The
+ *   signal lock and the first PAT and PMT are sampled at the signal
+ *   monitor update rate.
+ *
+ *   Finished traces are added to histograms shared by all inputs, which
+ *   the Status service reports. When the "TVRecTraceFile" setting names
+ *   a file, every trace is also appended to it as Chrome trace events,
+ *   which chrome://tracing and Perfetto can load.
+ */
+class MTV_PUBLIC TuningTrace
+{
+  public:
+    enum Phase : std::uint8_t
+    {
+        kShutdowns = 0,    ///< span, TuningShutdowns()
+        kRecorderPause,    ///< span, waiting for the recorder to pause
+        kFrequency,        ///< span, TuningFrequency()
+        kSignalLock,       ///< milestone, signal monitor reports a lock
+        kFirstPAT,         ///< milestone, first PAT seen
+        kFirstPMT,         ///< milestone, first PMT seen
+        kSignalGood,       ///< milestone, TuningSignalCheck() passed
+        kRecorderStart,    ///< span, TuningNewRecorder() or restart
+        kFirstKeyframe,    ///< milestone, recorder found a keyframe
+        kFirstWrite,       ///< milestone, recorder wrote its first packet
+        kPhases
+    };
+
+    static constexpr std::array<std::chrono::milliseconds,7> kBucketLimits
+        { 100ms, 250ms, 500ms, 1s, 2s, 5s, 10s };
+
+    struct PhaseStats
+    {
+        QString                   m_name;
+        bool                      m_span    {false};
+        uint                      m_count   {0};
+        std::chrono::milliseconds m_total   {0ms};
+        std::chrono::milliseconds m_max     {0ms};
+        /// Last bucket counts everything above the last limit
+        std::array<uint,kBucketLimits.size() + 1> m_buckets {};
+    };
+
+    explicit TuningTrace(uint inputid) : m_inputId(inputid) {}
+    ~TuningTrace() { Finish(); }
+
+    void Start(const QString &request);
+    void Begin(Phase phase);
+    void End(Phase phase);
+    void Mark(Phase phase);
+    void Finish(void);
+
+    static QString PhaseName(Phase phase);
+    static bool IsSpan(Phase phase);
+    static std::vector<PhaseStats> GetStats(void);
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Event
+    {
+        Phase             m_phase;
+        Clock::time_point m_begin;
+        Clock::time_point m_end;
+    };
+
+    void WriteChromeTrace(void) const;
+
+    uint               m_inputId;
+    mutable QMutex     m_lock;
+    bool               m_active   {false};
+    QString            m_request;
+    Clock::time_point  m_start;
+    uint               m_seen     {0}; ///< Bit mask of finished phases
+    std::array<Clock::time_point,kPhases> m_begun {};
+    std::vector<Event> m_events;
+};
+
+#endif // TUNING_TRACE_H
@@ -5576,6 +5576,9 @@ void TV::SwitchInputs(uint ChanID, QString ChanNum, uint InputID)
 
     LOG(VB_CHANNEL, LOG_INFO, LOC + QString("(%1,'%2',%3)").arg(ChanID).arg(ChanNum).arg(InputID));
 
+    // The predictions for the old input don't hold for the new one
+    ClearPreTunedInputs(m_playerContext.GetCardID());
+
     RemoteEncoder *testrec = nullptr;
 
     if (!StateIsLiveTV(GetState()))
@@ -5990,6 +5993,14 @@ void TV::ChangeChannel(ChannelChangeDirection Direction)
     if (Direction == CHANNEL_DIRECTION_FAVORITE)
         Direction = CHANNEL_DIRECTION_UP;
 
+    // Switch to an idle input the backend has already tuned to that channel
+    uint pretuned = GetPreTunedChannel(Direction);
+    if (pretuned)
+    {
+        ChangeChannel(pretuned, "");
+        return;
+    }
+
     QString oldinputname = m_playerContext.m_recorder->GetInput();
 
     if (ContextIsPaused(__FILE__, __LINE__))
@@ -6013,6 +6024,7 @@ void TV::ChangeChannel(ChannelChangeDirection Direction)
     }
     m_playerContext.UnlockDeletePlayer(__FILE__, __LINE__);
 
+    ClearPreTunedInputs(m_playerContext.GetCardID());
     m_playerContext.m_recorder->ChangeChannel(Direction);
     ClearInputQueues(false);
 
@@ -6126,9 +6138,37 @@ void TV::ChangeChannel(uint Chanid, const QString &Channum)
         }
     }
 
+    // A channel this input can tune may already be waiting on an idle input
+    bool pretuned = false;
+    if (reclist.empty() && !getit && Chanid)
+    {
+        uint inputid = GetPreTunedInput(Chanid);
+        if (inputid)
+        {
+            LOG(VB_CHANNEL, LOG_INFO, LOC +
+                QString("Channel %1 is pre-tuned on input %2")
+                    .arg(channum).arg(inputid));
+            reclist.push_back(QString::number(inputid));
+            pretuned = true;
+        }
+    }
+
+    RemoteEncoder *testrec = nullptr;
+    if (!reclist.empty())
+    {
+        testrec = RemoteRequestFreeRecorderFromList(reclist, m_playerContext.GetCardID());
+        if (pretuned && (!testrec || !testrec->IsValidRecorder()))
+        {
+            // Someone else got there first, tune this input instead
+            m_preTunedInputs.remove(reclist.front().toUInt());
+            reclist.clear();
+            delete testrec;
+            testrec = nullptr;
+        }
+    }
+
     if (!reclist.empty())
     {
-        RemoteEncoder *testrec = RemoteRequestFreeRecorderFromList(reclist, m_playerContext.GetCardID());
         if (!testrec || !testrec->IsValidRecorder())
         {
             ClearInputQueues(true);
@@ -6177,6 +6217,7 @@ void TV::ChangeChannel(uint Chanid, const QString &Channum)
     }
     m_playerContext.UnlockDeletePlayer(__FILE__, __LINE__);
 
+    ClearPreTunedInputs(m_playerContext.GetCardID());
     m_playerContext.m_recorder->SetChannel(channum);
 
     emit ResetAudio();
@@ -6187,6 +6228,60 @@ void TV::ChangeChannel(uint Chanid, const QString &Channum)
         UpdateOSDInput();
 }
 
+/** \brief Returns the channel an idle input has been pre-tuned to for
+ *         a change in the given direction from the current input, or 0.
+ *
+ *   Only pre-tunes the backend announced for the channel currently
+ *   playing are used, older ones were guessed from another channel.
+ */
+uint TV::GetPreTunedChannel(ChannelChangeDirection Direction) const
+{
+    uint cardid = m_playerContext.GetCardID();
+    uint chanid = 0;
+    m_playerContext.LockPlayingInfo(__FILE__, __LINE__);
+    if (m_playerContext.m_playingInfo)
+        chanid = m_playerContext.m_playingInfo->GetChanID();
+    m_playerContext.UnlockPlayingInfo(__FILE__, __LINE__);
+    if (!chanid)
+        return 0;
+
+    for (const auto & pretuned : std::as_const(m_preTunedInputs))
+    {
+        if (pretuned.m_forInputId == cardid && pretuned.m_forChanId == chanid &&
+            pretuned.m_direction == Direction)
+            return pretuned.m_chanId;
+    }
+    return 0;
+}
+
+/** \brief Forgets the pre-tunes announced for the LiveTV session on
+ *         the given input, once it changes channel they are stale.
+ */
+void TV::ClearPreTunedInputs(uint ForInputId)
+{
+    for (auto it = m_preTunedInputs.begin(); it != m_preTunedInputs.end(); )
+    {
+        if (it->m_forInputId == ForInputId)
+            it = m_preTunedInputs.erase(it);
+        else
+            ++it;
+    }
+}
+
+/** \brief Returns an idle input other than the current one that has
+ *         been pre-tuned to the channel, or 0.
+ */
+uint TV::GetPreTunedInput(uint ChanId) const
+{
+    uint cardid = m_playerContext.GetCardID();
+    for (auto it = m_preTunedInputs.cbegin(); it != m_preTunedInputs.cend(); ++it)
+    {
+        if (it->m_chanId == ChanId && it.key() != cardid)
+            return it.key();
+    }
+    return 0;
+}
+
 void TV::ChangeChannel(const ChannelInfoList &Options)
 {
     for (const auto & option : Options)
@@ -7482,6 +7577,26 @@ void TV::customEvent(QEvent *Event)
         ReturnPlayerLock();
     }
 
+    if (message.startsWith("LIVETV_PRETUNE_END"))
+    {
+        if (tokens.size() >= 2)
+            m_preTunedInputs.remove(tokens[1].toUInt());
+    }
+    else if (message.startsWith("LIVETV_PRETUNE"))
+    {
+        // LIVETV_PRETUNE <for inputid> <for chanid>
+        //                [<inputid> <chanid> <direction>]...
+        uint forinput = (tokens.size() >= 2) ? tokens[1].toUInt() : 0;
+        uint forchan  = (tokens.size() >= 3) ? tokens[2].toUInt() : 0;
+        ClearPreTunedInputs(forinput);
+        for (int i = 3; i + 2 < tokens.size(); i += 3)
+        {
+            PreTunedInput pretuned { tokens[i + 1].toUInt(), forinput, forchan,
+                                     tokens[i + 2].toInt() };
+            m_preTunedInputs[tokens[i].toUInt()] = pretuned;
+        }
+    }
+
     if (message.startsWith("LIVETV_CHAIN"))
     {
         QString id;
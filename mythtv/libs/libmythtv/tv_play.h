@@ -319,6 +319,9 @@ class MTV_PUBLIC TV : public TVPlaybackState, public MythTVMenuItemDisplayer, pu
 
     void ShowPreviousChannel();
     void PopPreviousChannel(bool ImmediateChange);
+    uint GetPreTunedChannel(ChannelChangeDirection Direction) const;
+    uint GetPreTunedInput(uint ChanId) const;
+    void ClearPreTunedInputs(uint ForInputId);
 
     // key queue commands
     void AddKeyToInputQueue(char Key);
@@ -654,6 +657,19 @@ class MTV_PUBLIC TV : public TVPlaybackState, public MythTVMenuItemDisplayer, pu
     volatile int        m_channelGroupId {-1};
     ChannelInfoList     m_channelGroupChannelList;
 
+    // LiveTV pre-tuning
+    /// \brief An idle input the backend has tuned to a channel the
+    /// LiveTV session on another input is likely to change to.
+    /// These are only used in the UI thread, so no lock is needed.
+    struct PreTunedInput
+    {
+        uint m_chanId     {0};
+        uint m_forInputId {0};
+        uint m_forChanId  {0};
+        int  m_direction  {CHANNEL_DIRECTION_SAME};
+    };
+    QMap<uint,PreTunedInput> m_preTunedInputs;
+
     // Network Control stuff
     MythDeque<QString> m_networkControlCommands;
 
@@ -1,6 +1,9 @@
 // C headers
+#include <algorithm>
+#include <array>
 #include <chrono> // for milliseconds
 #include <cstdio>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <sched.h> // for sched_yield
@@ -41,6 +44,7 @@
 #include "recordingprofile.h"
 #include "recordingrule.h"
 #include "sourceutil.h"
+#include "trickplaygenerator.h"
 #include "tv_rec.h"
 #include "tvremoteutil.h"
 
@@ -872,6 +876,8 @@ void TVRec::FinishedRecording(RecordingInfo *curRec, RecordingQuality *recq)
                  (recq->IsDamaged()) ? "damaged" : "good",
                  recq->toStringXML()));
         is_good = !recq->IsDamaged();
+        TSStats::SaveSummary(curRec->GetRecordingID(),
+                             recq->GetPIDStatistics());
         delete recq;
         recq = nullptr;
     }
@@ -981,6 +987,9 @@ void TVRec::FinishedRecording(RecordingInfo *curRec, RecordingQuality *recq)
         (curRec->GetRecordingStatus() == RecStatus::Recorded))
     {
         PreviewGeneratorQueue::GetPreviewImage(*curRec, "");
+        if ((recgrp != "LiveTV") &&
+            gCoreContext->GetBoolSetting("TrickPlayThumbnails", false))
+            TrickPlayGenerator::Queue(*curRec);
     }
 
     // store recording in recorded table
@@ -1347,6 +1356,56 @@ static std::chrono::seconds eit_start_rand(uint inputId, std::chrono::seconds ei
     return timeout;
 }
 
+// How the tuner got to the channel for a LiveTV channel change
+enum LiveTVTuneKind : std::uint8_t
+{
+    kTuneCold = 0,          ///< Tuned and waited for a signal lock
+    kTuneSameMultiplex,     ///< Only changed program on the current multiplex
+    kTunePreTuned,          ///< Input had already been pre-tuned to the channel
+    kTuneKinds
+};
+
+static constexpr std::array<std::chrono::milliseconds,5> kTuneLatencyBounds
+    { 500ms, 1s, 2s, 3s, 5s };
+static QMutex s_tuneLatencyLock;
+static std::array<std::array<uint,kTuneLatencyBounds.size() + 1>,kTuneKinds>
+    s_tuneLatency {};
+static uint s_tuneLatencyCount {0};
+
+/// \brief Adds a LiveTV channel change to the latency histogram,
+///        and logs the histogram every 20 channel changes.
+static void add_tune_latency(uint inputid, uint kind,
+                             std::chrono::milliseconds elapsed)
+{
+    static const std::array<QString,kTuneKinds> kKindNames
+        { "cold", "same multiplex", "pre-tuned" };
+
+    QMutexLocker locker(&s_tuneLatencyLock);
+
+    size_t bucket = 0;
+    while (bucket < kTuneLatencyBounds.size() &&
+           elapsed >= kTuneLatencyBounds[bucket])
+        ++bucket;
+    ++s_tuneLatency[kind][bucket];
+
+    LOG(VB_RECORD, LOG_INFO, LOC2 +
+        QString("LiveTV channel change took %1 ms (%2)")
+            .arg(elapsed.count()).arg(kKindNames[kind]));
+
+    if (++s_tuneLatencyCount % 20)
+        return;
+
+    for (uint k = 0; k < kTuneKinds; ++k)
+    {
+        const auto &counts = s_tuneLatency[k];
+        LOG(VB_RECORD, LOG_INFO, QString("LiveTV channel change latency, "
+                                         "%1: <0.5s %2, <1s %3, <2s %4, "
+                                         "<3s %5, <5s %6, >=5s %7")
+            .arg(kKindNames[k]).arg(counts[0]).arg(counts[1])
+            .arg(counts[2]).arg(counts[3]).arg(counts[4]).arg(counts[5]));
+    }
+}
+
 /// \brief Event handling method, contains event loop.
 void TVRec::run(void)
 {
@@ -1399,6 +1458,23 @@ void TVRec::run(void)
             s_inputsLock.unlock();
         }
 
+        // Keep idle inputs tuned to the channels LiveTV may change to next
+        if (m_preTunePredict)
+        {
+            m_preTunePredict = false;
+            PreTuneIdleInputs();
+        }
+
+        // Release this input if nobody has asked for its pre-tune lately
+        if (m_preTuneChanId && m_tuningRequests.empty() &&
+            MythDate::current() > m_preTuneExpiry)
+        {
+            LOG(VB_CHANNEL, LOG_INFO, LOC +
+                QString("Pre-tune of channel %1 expired")
+                    .arg(m_preTuneChannel));
+            m_tuningRequests.enqueue(TuningRequest(kFlagNoRec));
+        }
+
         // Tell frontends about pending recordings
         HandlePendingRecordings();
 
@@ -1511,7 +1587,7 @@ void TVRec::run(void)
 
         // Start active EIT scan
         bool conflicting_input = false;
-        if (m_scanner && m_channel &&
+        if (m_scanner && m_channel && !m_preTuneChanId &&
             MythDate::current() > m_eitScanStartTime)
         {
             if (!m_dvbOpt.m_dvbEitScan)
@@ -2139,6 +2215,24 @@ bool TVRec::SetupSignalMonitor(bool tablemon, bool EITscan, bool notify)
     return true;
 }
 
+/** \brief Called by the signal monitor thread on every update, used to
+ *         time the signal lock and the first PAT and PMT of a tuning.
+ *
+ *   m_signalMonitor is safe to use here, the monitor can't be deleted
+ *   before its thread, which is calling this, has stopped.
+ */
+void TVRec::StatusSignalLock(const SignalMonitorValue &val)
+{
+    if (val.IsGood())
+        m_tuningTrace.Mark(TuningTrace::kSignalLock);
+
+    uint64_t flags = m_signalMonitor ? m_signalMonitor->GetFlags() : 0;
+    if (flags & SignalMonitor::kDTVSigMon_PATSeen)
+        m_tuningTrace.Mark(TuningTrace::kFirstPAT);
+    if (flags & SignalMonitor::kDTVSigMon_PMTSeen)
+        m_tuningTrace.Mark(TuningTrace::kFirstPMT);
+}
+
 /** \fn TVRec::TeardownSignalMonitor()
  *  \brief If a SignalMonitor instance exists, the monitoring thread is
  *         stopped and the instance is deleted.
@@ -2644,6 +2738,21 @@ long long TVRec::GetFilePosition(void)
     return -1;
 }
 
+/** \brief Returns the per PID statistics of the stream being recorded.
+ *
+ *  \return The statistics if the recorder reads a transport stream,
+ *          an empty list otherwise.
+ */
+TSStats::PIDStatsList TVRec::GetTSStatistics(void)
+{
+    QMutexLocker lock(&m_stateChangeLock);
+
+    auto *dtvrec = dynamic_cast<DTVRecorder*>(m_recorder);
+    if (dtvrec)
+        return dtvrec->GetTSStatistics();
+    return {};
+}
+
 /** \brief Returns byte position in RingBuffer
  *         of a keyframe according to recorder.
  *
@@ -3215,6 +3324,201 @@ bool TVRec::QueueEITChannelChange(const QString &name)
     return ok;
 }
 
+/** \brief Queues up tuning an idle input to a channel LiveTV on
+ *         another input is likely to change to next.
+ *
+ *   Like QueueEITChannelChange() this does not block, since it is
+ *   called from the event thread of the TVRec that is playing LiveTV.
+ *   If the input is already pre-tuned to the channel the pre-tune
+ *   is just kept alive for another kPreTuneTimeout.
+ *
+ *  \return true if the input is, or will be, tuned to the channel
+ */
+bool TVRec::QueuePreTune(const QString &channum, uint chanid)
+{
+    bool ok = false;
+    bool queued = false;
+    if (m_setChannelLock.tryLock())
+    {
+        if (m_stateChangeLock.tryLock())
+        {
+            if (m_internalState == kState_None && !m_changeState &&
+                m_tuningRequests.empty() &&
+                !HasFlags(kFlagEITScannerRunning) && !IsErrored())
+            {
+                m_preTuneExpiry =
+                    MythDate::current().addSecs(kPreTuneTimeout.count());
+                if (m_preTuneChanId != chanid)
+                {
+                    m_tuningRequests.enqueue(
+                        TuningRequest(kFlagPreTune, channum));
+                    queued = true;
+                }
+                ok = true;
+            }
+            m_stateChangeLock.unlock();
+        }
+        m_setChannelLock.unlock();
+    }
+
+    if (queued)
+        WakeEventLoop();
+
+    LOG(VB_CHANNEL, LOG_DEBUG, LOC +
+         QString("QueuePreTune(%1) %2")
+            .arg(channum, !ok ? "failed" : queued ? "queued" : "kept"));
+
+    return ok;
+}
+
+/** \brief Tunes idle inputs on the video source of this LiveTV session
+ *         to the channels the viewer is most likely to change to next.
+ *
+ *   The channels above and below the current one, the previously
+ *   watched channel and the next favorite are tried in that order.
+ *   Channels on the current multiplex are skipped, changing to them
+ *   doesn't need a retune. Only one input of each physical tuner is
+ *   used, and only when none of the inputs of that tuner are busy,
+ *   since multirec inputs share the tuner of their parent.
+ */
+void TVRec::PreTuneIdleInputs(void)
+{
+    if (!m_channel || !GetDTVChannel() ||
+        m_internalState != kState_WatchingLiveTV)
+        return;
+
+    uint sourceid   = m_channel->GetSourceID();
+    uint curchanid  = m_channel->GetChanID();
+    QString curchannum = m_channel->GetChannelName();
+
+    std::vector<std::pair<uint,ChannelChangeDirection> > predicted;
+    auto predict = [&](uint chanid, ChannelChangeDirection dir)
+    {
+        if (!chanid || chanid == curchanid)
+            return;
+        for (const auto & p : predicted)
+            if (p.first == chanid)
+                return;
+        QString channum = ChannelUtil::GetChanNum(chanid);
+        if (channum.isEmpty() ||
+            ChannelUtil::IsOnSameMultiplex(sourceid, channum, curchannum))
+            return;
+        predicted.emplace_back(chanid, dir);
+    };
+    predict(m_channel->GetNextChannel(curchanid, CHANNEL_DIRECTION_UP),
+            CHANNEL_DIRECTION_UP);
+    predict(m_channel->GetNextChannel(curchanid, CHANNEL_DIRECTION_DOWN),
+            CHANNEL_DIRECTION_DOWN);
+    predict(m_liveTVPrevChanId, CHANNEL_DIRECTION_SAME);
+    predict(m_channel->GetNextChannel(curchanid, CHANNEL_DIRECTION_FAVORITE),
+            CHANNEL_DIRECTION_FAVORITE);
+
+    // Inputs of the tuner this LiveTV session is using can't be used
+    std::vector<uint> claimed = CardUtil::GetConflictingInputs(m_inputId);
+    claimed.push_back(m_inputId);
+    auto is_claimed = [&claimed](uint inputid)
+    {
+        return std::find(claimed.cbegin(), claimed.cend(), inputid) !=
+            claimed.cend();
+    };
+
+    // Tell the frontends which inputs hold which of the predictions
+    QString message = QString("LIVETV_PRETUNE %1 %2")
+        .arg(m_inputId).arg(curchanid);
+    auto pretuned = [&](uint inputid, uint chanid)
+    {
+        auto match = std::find_if(predicted.cbegin(), predicted.cend(),
+            [chanid](const auto & p) { return p.first == chanid; });
+        message += QString(" %1 %2 %3").arg(inputid).arg(chanid)
+            .arg(static_cast<int>(match->second));
+    };
+
+    QReadLocker locker(&s_inputsLock);
+
+    // Find the idle inputs, keeping the ones already pre-tuned
+    // to a predicted channel where they are.
+    std::vector<std::pair<uint,ChannelChangeDirection> > remaining = predicted;
+    std::vector<std::pair<uint,std::vector<uint> > > idle;
+    for (auto it = s_inputs.cbegin(); it != s_inputs.cend(); ++it)
+    {
+        TVRec *rec = *it;
+        if (is_claimed(it.key()) || !rec || rec->GetSourceID() != sourceid ||
+            !rec->GetDTVChannel() || rec->IsBusy(nullptr, 5min))
+            continue;
+
+        std::vector<uint> tuner = CardUtil::GetConflictingInputs(it.key());
+        bool busy = false;
+        for (uint inputid : tuner)
+        {
+            TVRec *sibling = s_inputs.value(inputid);
+            if (sibling && sibling->IsBusy(nullptr, 5min))
+                busy = true;
+        }
+        if (busy)
+            continue;
+        tuner.push_back(it.key());
+
+        uint chanid = rec->m_preTuneChanId;
+        auto match = std::find_if(remaining.begin(), remaining.end(),
+            [chanid](const auto & p) { return p.first == chanid; });
+        if (chanid && match != remaining.end() &&
+            rec->QueuePreTune(ChannelUtil::GetChanNum(chanid), chanid))
+        {
+            LOG(VB_CHANNEL, LOG_INFO, LOC +
+                QString("Input %1 stays pre-tuned to chanid %2")
+                    .arg(it.key()).arg(chanid));
+            pretuned(it.key(), chanid);
+            remaining.erase(match);
+            claimed.insert(claimed.end(), tuner.cbegin(), tuner.cend());
+            continue;
+        }
+        idle.emplace_back(it.key(), tuner);
+    }
+
+    // Hand out the remaining channels, best guess first
+    auto next = remaining.cbegin();
+    for (const auto & [inputid, tuner] : idle)
+    {
+        if (next == remaining.cend())
+            break;
+        if (is_claimed(inputid))
+            continue;
+
+        TVRec *rec = s_inputs.value(inputid);
+        QString channum = ChannelUtil::GetChanNum(next->first);
+        if (!rec->QueuePreTune(channum, next->first))
+            continue;
+
+        LOG(VB_CHANNEL, LOG_INFO, LOC +
+            QString("Pre-tuning input %1 to channel %2")
+                .arg(inputid).arg(channum));
+        pretuned(inputid, next->first);
+        claimed.insert(claimed.end(), tuner.cbegin(), tuner.cend());
+        ++next;
+    }
+
+    MythEvent me(message);
+    gCoreContext->dispatch(me);
+}
+
+/** \brief Forgets the channel this input was pre-tuned to, and tells
+ *         the frontends it can no longer be switched to quickly.
+ */
+void TVRec::ClearPreTune(void)
+{
+    if (!m_preTuneChanId)
+        return;
+
+    LOG(VB_CHANNEL, LOG_INFO, LOC +
+        QString("Pre-tune of channel %1 ended").arg(m_preTuneChannel));
+
+    m_preTuneChanId = 0;
+    m_preTuneChannel.clear();
+
+    MythEvent me(QString("LIVETV_PRETUNE_END %1").arg(m_inputId));
+    gCoreContext->dispatch(me);
+}
+
 void TVRec::GetNextProgram(BrowseDirection direction,
                            QString &title,       QString &subtitle,
                            QString &desc,        QString &category,
@@ -3559,6 +3863,7 @@ void TVRec::HandleTuning(void)
         TuningRequest request = m_tuningRequests.front();
         LOG(VB_RECORD, LOG_INFO, LOC +
             "HandleTuning Request: " + request.toString());
+        m_tuningTrace.Start(request.toString());
 
         QString input;
         request.m_channel = TuningGetChanNum(request, input);
@@ -3567,25 +3872,69 @@ void TVRec::HandleTuning(void)
         if (TuningOnSameMultiplex(request))
             LOG(VB_CHANNEL, LOG_INFO, LOC + "On same multiplex");
 
+        // LiveTV on the channel this input is pre-tuned to takes over
+        // the running signal monitor and its stream data.
+        m_preTuneHandoff = ((request.m_flags & kFlagLiveTV) != 0U) &&
+            m_preTuneChanId && request.m_channel == m_preTuneChannel &&
+            HasFlags(kFlagSignalMonitorRunning) && GetDTVSignalMonitor();
+        if (m_preTuneHandoff)
+        {
+            LOG(VB_CHANNEL, LOG_INFO, LOC +
+                QString("Handing pre-tuned channel %1 over to LiveTV")
+                    .arg(request.m_channel));
+        }
+
+        m_tuningTrace.Begin(TuningTrace::kShutdowns);
         TuningShutdowns(request);
+        m_tuningTrace.End(TuningTrace::kShutdowns);
 
         // The dequeue isn't safe to do until now because we
         // release the stateChangeLock to teardown a recorder
         m_tuningRequests.dequeue();
 
+        // Time LiveTV channel changes until the recorder is running
+        if (request.m_flags & kFlagLiveTV)
+        {
+            if (request.IsOnSameMultiplex())
+                m_liveTVTuneKind = kTuneSameMultiplex;
+            else if (m_preTuneHandoff)
+                m_liveTVTuneKind = kTunePreTuned;
+            else
+                m_liveTVTuneKind = kTuneCold;
+            m_liveTVTuneTimer.start();
+        }
+        else
+        {
+            m_liveTVTuneTimer.stop();
+        }
+
+        if (request.m_flags & kFlagPreTune)
+        {
+            m_preTuneChannel = request.m_channel;
+            m_preTuneChanId  = static_cast<uint>(std::max(
+                ChannelUtil::GetChanID(GetSourceID(), request.m_channel), 0));
+        }
+        else
+        {
+            ClearPreTune();
+        }
+
         // Now we start new stuff
-        if (request.m_flags & (kFlagRecording|kFlagLiveTV|
-                               kFlagEITScan|kFlagAntennaAdjust))
+        if (request.m_flags & (kFlagRecording|kFlagLiveTV|kFlagEITScan|
+                               kFlagAntennaAdjust|kFlagPreTune))
         {
             if (!m_recorder)
             {
                 LOG(VB_RECORD, LOG_INFO, LOC +
                     "No recorder yet, calling TuningFrequency");
+                m_tuningTrace.Begin(TuningTrace::kFrequency);
                 TuningFrequency(request);
+                m_tuningTrace.End(TuningTrace::kFrequency);
             }
             else
             {
                 LOG(VB_RECORD, LOG_INFO, LOC + "Waiting for recorder pause..");
+                m_tuningTrace.Begin(TuningTrace::kRecorderPause);
                 SetFlags(kFlagWaitingForRecPause, __FILE__, __LINE__);
             }
         }
@@ -3598,9 +3947,12 @@ void TVRec::HandleTuning(void)
             return;
 
         ClearFlags(kFlagWaitingForRecPause, __FILE__, __LINE__);
+        m_tuningTrace.End(TuningTrace::kRecorderPause);
         LOG(VB_RECORD, LOG_INFO, LOC +
             "Recorder paused, calling TuningFrequency");
+        m_tuningTrace.Begin(TuningTrace::kFrequency);
         TuningFrequency(m_lastTuningRequest);
+        m_tuningTrace.End(TuningTrace::kFrequency);
     }
 
     MPEGStreamData *streamData = nullptr;
@@ -3613,14 +3965,32 @@ void TVRec::HandleTuning(void)
 
     if (HasFlags(kFlagNeedToStartRecorder))
     {
+        m_tuningTrace.Begin(TuningTrace::kRecorderStart);
         if (m_recorder)
             TuningRestartRecorder();
         else
             TuningNewRecorder(streamData);
+        m_tuningTrace.End(TuningTrace::kRecorderStart);
 
         // If we got this far it is safe to set a new starting channel...
         if (m_channel)
             m_channel->StoreInputChannels();
+
+        if (m_liveTVTuneTimer.isRunning() && HasFlags(kFlagRecorderRunning))
+        {
+            add_tune_latency(m_inputId, m_liveTVTuneKind,
+                             m_liveTVTuneTimer.elapsed());
+            m_liveTVTuneTimer.stop();
+
+            uint chanid = m_channel ? m_channel->GetChanID() : 0;
+            if (chanid != m_liveTVChanId)
+            {
+                m_liveTVPrevChanId = m_liveTVChanId;
+                m_liveTVChanId     = chanid;
+            }
+            m_preTunePredict =
+                gCoreContext->GetBoolSetting("LiveTVPreTune", false);
+        }
     }
 }
 
@@ -3645,7 +4015,9 @@ void TVRec::TuningShutdowns(const TuningRequest &request)
     if (m_scanner && !request.IsOnSameMultiplex())
         m_scanner->StopEITEventProcessing();
 
-    if (HasFlags(kFlagSignalMonitorRunning))
+    // Keep the signal monitor of a pre-tuned input LiveTV is taking over
+    bool handoff = m_preTuneHandoff && ((request.m_flags & kFlagLiveTV) != 0U);
+    if (HasFlags(kFlagSignalMonitorRunning) && !handoff)
     {
         MPEGStreamData *sd = nullptr;
         if (GetDTVSignalMonitor())
@@ -3851,12 +4223,18 @@ void TVRec::TuningFrequency(const TuningRequest &request)
         has_dummy = true;
     }
 
+    // A pre-tuned input already has a locked signal monitor with the
+    // tables of this channel, LiveTV just carries on with it.
+    bool handoff = m_preTuneHandoff && livetv && GetDTVSignalMonitor();
+    m_preTuneHandoff = false;
+
     // Start signal monitoring for devices capable of monitoring
     if (use_sm)
     {
-        LOG(VB_RECORD, LOG_INFO, LOC + "Starting Signal Monitor");
+        LOG(VB_RECORD, LOG_INFO, LOC + (handoff ?
+            "Reusing pre-tuned Signal Monitor" : "Starting Signal Monitor"));
         bool error = false;
-        if (!SetupSignalMonitor(
+        if (!handoff && !SetupSignalMonitor(
                 !antadj, (request.m_flags & kFlagEITScan) != 0U, livetv || antadj))
         {
             LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to setup signal monitor");
@@ -3977,6 +4355,7 @@ MPEGStreamData *TVRec::TuningSignalCheck(void)
     if (m_signalMonitor->IsAllGood())
     {
         LOG(VB_RECORD, LOG_INFO, LOC + "TuningSignalCheck: Good signal");
+        m_tuningTrace.Mark(TuningTrace::kSignalGood);
         if (m_curRecording && (current_time > m_startRecordingDeadline))
         {
             newRecStatus = RecStatus::Failing;
@@ -4016,7 +4395,8 @@ MPEGStreamData *TVRec::TuningSignalCheck(void)
         ClearFlags(kFlagNeedToStartRecorder, __FILE__, __LINE__);
         newRecStatus = RecStatus::Failed;
 
-        if (m_scanner && HasFlags(kFlagEITScannerRunning))
+        if ((m_scanner && HasFlags(kFlagEITScannerRunning)) ||
+            (m_lastTuningRequest.m_flags & kFlagPreTune))
         {
             m_tuningRequests.enqueue(TuningRequest(kFlagNoRec));
         }
@@ -4096,7 +4476,11 @@ MPEGStreamData *TVRec::TuningSignalCheck(void)
     if (GetDTVSignalMonitor())
         streamData = GetDTVSignalMonitor()->GetStreamData();
 
-    if (!HasFlags(kFlagEITScannerRunning))
+    // A pre-tuned input keeps its signal monitor, and with it the
+    // tuner lock and tables, until LiveTV takes it over or another
+    // tuning request releases it.
+    if (!HasFlags(kFlagEITScannerRunning) &&
+        !(m_lastTuningRequest.m_flags & kFlagPreTune))
     {
         // shut down signal monitoring
         TeardownSignalMonitor();
@@ -4557,6 +4941,8 @@ QString TVRec::FlagToString(uint f)
         if (kFlagKillRingBuffer & f)
             msg += "KillRingBuffer,";
     }
+    if (kFlagPreTune & f)
+        msg += "PreTune,";
     if ((kFlagAnyRunning & f) == kFlagAnyRunning)
         msg += "ANYRUNNING,";
     else
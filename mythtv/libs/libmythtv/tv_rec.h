@@ -2,6 +2,7 @@
 #define TVREC_H
 
 // C++ headers
+#include <atomic>
 #include <utility>
 #include <vector>                       // for vector
 
@@ -25,9 +26,11 @@
 #include "libmythbase/programtypes.h"   // for RecStatus, RecStatus::Type, etc
 
 #include "inputinfo.h"
+#include "mpeg/tsstats.h"
 #include "mythtvexp.h"                  // for MTV_PUBLIC
 #include "recordinginfo.h"
 #include "signalmonitorlistener.h"
+#include "tuningtrace.h"
 #include "tv.h"
 #include "videoouttypes.h"              // for PictureAttribute
 
@@ -186,6 +189,7 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     float GetFramerate(void);
     long long GetFramesWritten(void);
     long long GetFilePosition(void);
+    TSStats::PIDStatsList GetTSStatistics(void);
     long long GetMaxBitrate(void) const;
     int64_t GetKeyframePosition(uint64_t desired) const;
     bool GetKeyframePositions(int64_t start, int64_t end, frm_pos_map_t &map) const;
@@ -207,6 +211,7 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
         { SetChannel(QString("NextChannel %1").arg((int)dir)); }
     void SetChannel(const QString& name, uint requestType = kFlagDetect);
     bool QueueEITChannelChange(const QString &name);
+    bool QueuePreTune(const QString &channum, uint chanid);
 
     std::chrono::milliseconds SetSignalMonitoringRate(std::chrono::milliseconds rate, int notifyFrontend = 1);
     int  GetPictureAttribute(PictureAttribute attr);
@@ -245,10 +250,11 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     uint GetFlags(void) const { return m_stateFlags; }
 
     static TVRec *GetTVRec(uint inputid);
+    TuningTrace *GetTuningTrace(void) { return &m_tuningTrace; }
 
     void AllGood(void) override { WakeEventLoop(); } // SignalMonitorListener
     void StatusChannelTuned(const SignalMonitorValue &/*val*/) override { } // SignalMonitorListener
-    void StatusSignalLock(const SignalMonitorValue &/*val*/) override { } // SignalMonitorListener
+    void StatusSignalLock(const SignalMonitorValue &val) override; // SignalMonitorListener
     void StatusSignalStrength(const SignalMonitorValue &/*val*/) override { } // SignalMonitorListener
     void EnableActiveScan(bool enable);
 
@@ -299,6 +305,9 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     QString TuningGetChanNum(const TuningRequest &request, QString &input) const;
     bool TuningOnSameMultiplex(TuningRequest &request);
 
+    void PreTuneIdleInputs(void);
+    void ClearPreTune(void);
+
     void HandleStateChange(void);
     void ChangeState(TVState nextState);
     static bool StateIsRecording(TVState state);
@@ -368,6 +377,7 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
 
     // Configuration variables from setup routines
     uint               m_inputId;
+    TuningTrace        m_tuningTrace              {m_inputId};
     uint               m_parentId                 {0};
     bool               m_isPip                    {false};
 
@@ -395,6 +405,11 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     TuningRequest      m_lastTuningRequest        {0};
     QDateTime          m_eitScanStartTime;
     QDateTime          m_eitScanStopTime;
+    QString            m_preTuneChannel;
+    std::atomic<uint>  m_preTuneChanId            {0};
+    QDateTime          m_preTuneExpiry;
+    bool               m_preTunePredict           {false};
+    bool               m_preTuneHandoff           {false};
     mutable QMutex     m_triggerEventLoopLock;
     QWaitCondition     m_triggerEventLoopWait;
     bool               m_triggerEventLoopSignal   {false};
@@ -424,6 +439,12 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     // LiveTV file chain
     LiveTVChain       *m_tvChain                  {nullptr};
 
+    // LiveTV channel change timing
+    MythTimer          m_liveTVTuneTimer;
+    uint               m_liveTVTuneKind           {0};
+    uint               m_liveTVChanId             {0};
+    uint               m_liveTVPrevChanId         {0};
+
     // RingBuffer info
     MythMediaBuffer   *m_buffer                   {nullptr};
     QString            m_rbFileExt                {"ts"};
@@ -435,6 +456,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
   public:
     /// How many milliseconds the signal monitor should wait between checks
     static constexpr std::chrono::milliseconds kSignalMonitoringRate { 50ms };
+    /// How long an idle input stays pre-tuned without being asked again
+    static constexpr std::chrono::seconds kPreTuneTimeout { 10min };
 
     // General State flags
     static const uint kFlagFrontendReady        = 0x00000001;
@@ -463,6 +486,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
 
     static const uint kFlagNoRec                = 0x0000F000;
     static const uint kFlagKillRingBuffer       = 0x00010000;
+    /// keep an idle input tuned, without a recorder, for LiveTV
+    static const uint kFlagPreTune              = 0x00020000;
 
     // Waiting stuff
     static const uint kFlagWaitingForRecPause   = 0x00100000;
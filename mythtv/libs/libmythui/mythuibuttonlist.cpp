@@ -1444,6 +1444,7 @@ void MythUIButtonList::CalculateArrowStates()
         DistributeButtons();
 
     updateLCD();
+    PrefetchNextPage();
 
     m_needsUpdate = false;
 
@@ -1472,6 +1473,63 @@ void MythUIButtonList::CalculateArrowStates()
     }
 }
 
+/**
+ * Queue background loads of the images used by the items on the page
+ * following the visible one, so that paging through lists with large
+ * artwork finds them in the image cache.
+ */
+void MythUIButtonList::PrefetchNextPage(void)
+{
+    if (!m_buttontemplate || m_itemsVisible <= 0)
+        return;
+
+    int first = m_topPosition + m_itemsVisible;
+    int last  = std::min(first + m_itemsVisible, m_itemCount);
+    if (first >= last)
+        return;
+
+    auto *buttonstate = dynamic_cast<MythUIGroup *>
+        (m_buttontemplate->GetState(m_active ? "active" : "inactive"));
+    if (!buttonstate)
+        buttonstate = dynamic_cast<MythUIGroup *>(m_buttontemplate->GetState("active"));
+    if (!buttonstate)
+        return;
+
+    QList<MythUIImage *> images;
+    QList<MythUIType *> descendants = buttonstate->GetAllDescendants();
+    for (MythUIType *obj : std::as_const(descendants))
+    {
+        auto *image = dynamic_cast<MythUIImage *>(obj);
+        if (image)
+            images.append(image);
+    }
+
+    if (images.isEmpty())
+        return;
+
+    QList<QPair<MythUIImage *, QString>> page;
+    for (int i = first; i < last; ++i)
+    {
+        MythUIButtonListItem *item = m_itemList[i];
+        for (MythUIImage *image : std::as_const(images))
+        {
+            QString name = image->objectName();
+            if (name == "buttonimage")
+                page.append({ image, item->m_imageFilename });
+            else
+                page.append({ image, item->GetImageFilename(name) });
+        }
+    }
+
+    // This runs on every redraw, so only queue a page once
+    if (page == m_prefetchedPage)
+        return;
+    m_prefetchedPage = page;
+
+    for (const auto & entry : std::as_const(page))
+        entry.first->Prefetch(entry.second);
+}
+
 void MythUIButtonList::ItemVisible(MythUIButtonListItem *item)
 {
     if (item)
@@ -6,6 +6,7 @@
 // Qt headers
 #include <QHash>
 #include <QList>
+#include <QPair>
 #include <QString>
 #include <QVariant>
 
@@ -312,6 +313,7 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     bool DistributeButtons(void);
     void CalculateButtonPositions(void);
     void CalculateArrowStates(void);
+    void PrefetchNextPage(void);
     void SetScrollBarPosition(void);
     void ItemVisible(MythUIButtonListItem *item);
 
@@ -391,6 +393,7 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
 
     QList<MythUIButtonListItem*> m_itemList;
     int m_nextItemLoaded              {0};
+    QList<QPair<MythUIImage *, QString>> m_prefetchedPage;
 
     bool m_drawFromBottom             {false};
 
@@ -13,11 +13,13 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QDomDocument>
+#include <QElapsedTimer>
 #include <QEvent>
 #include <QFile>
 #include <QImageReader>
 #include <QReadWriteLock>
 #include <QRunnable>
+#include <QSet>
 
 // libmythbase
 #include "libmythbase/mthreadpool.h"
@@ -278,11 +280,16 @@ class ImageLoader
             image = painter->GetFormatImage();
             bool ok = false;
 
+            QElapsedTimer timer;
+            timer.start();
+
             if (imageReader)
                 ok = image->Load(imageReader);
             else
                 ok = image->Load(filename);
 
+            GetMythUI()->AddDecodeTime(std::chrono::microseconds(timer.nsecsElapsed() / 1000));
+
             if (!ok)
             {
                 image->DecrRef();
@@ -544,6 +551,55 @@ private:
     ImageCacheMode  m_cacheMode;
 };
 
+/*!
+* \class ImagePrefetchThread
+*
+* Loads an image into the cache without delivering it to any widget.
+*/
+class ImagePrefetchThread : public QRunnable
+{
+  public:
+    ImagePrefetchThread(MythPainter *painter, ImageProperties imProps,
+                        QString cacheKey) :
+        m_painter(painter), m_imageProperties(std::move(imProps)),
+        m_cacheKey(std::move(cacheKey))
+    {
+    }
+
+    /// Claims \p cacheKey for a prefetch, returns false if one is queued
+    static bool Claim(const QString &cacheKey)
+    {
+        QMutexLocker locker(&s_queuedLock);
+        if (s_queued.contains(cacheKey))
+            return false;
+        s_queued.insert(cacheKey);
+        return true;
+    }
+
+    void run() override // QRunnable
+    {
+        bool aborted = false;
+        MythImage *image = ImageLoader::LoadImage(m_painter, m_imageProperties,
+                                                  kCacheNormal, nullptr, aborted);
+        if (image)
+            image->DecrRef();
+
+        QMutexLocker locker(&s_queuedLock);
+        s_queued.remove(m_cacheKey);
+    }
+
+  private:
+    MythPainter    *m_painter {nullptr};
+    ImageProperties m_imageProperties;
+    QString         m_cacheKey;
+
+    static QSet<QString> s_queued;
+    static QMutex        s_queuedLock;
+};
+
+QSet<QString> ImagePrefetchThread::s_queued;
+QMutex        ImagePrefetchThread::s_queuedLock;
+
 /////////////////////////////////////////////////////////////////
 class MythUIImagePrivate
 {
@@ -1139,6 +1195,43 @@ bool MythUIImage::Load(bool allowLoadInBackground, bool forceStat)
     return true;
 }
 
+/**
+ *  \brief Decode \p filename into the image cache in the background, using
+ *         this widget's image properties, so that a later Load() of the
+ *         same file is a memory cache hit. The widget itself is not changed.
+ */
+void MythUIImage::Prefetch(const QString &filename)
+{
+    if (filename.isEmpty() || ImageLoader::SupportsAnimation(filename) ||
+        qEnvironmentVariableIsSet("DISABLETHREADEDMYTHUIIMAGE"))
+        return;
+
+    d->m_updateLock.lockForRead();
+    ImageProperties imProps = m_imageProperties;
+    d->m_updateLock.unlock();
+
+    imProps.m_filename = filename;
+    QString imagelabel = ImageLoader::GenImageLabel(imProps);
+
+    MythImage *img = GetMythUI()->LoadCacheImage(filename, imagelabel,
+                                                 GetPainter(), kCacheIgnoreDisk);
+    if (img)
+    {
+        img->DecrRef();
+        return;
+    }
+
+    if (!ImagePrefetchThread::Claim(imagelabel))
+        return;
+
+    LOG(VB_GUI | VB_FILE, LOG_DEBUG, LOC +
+        QString("Prefetch(), spawning thread to load '%1'").arg(filename));
+
+    // Queue behind the images that are actually being displayed
+    auto *prefetch = new ImagePrefetchThread(GetPainter(), imProps, imagelabel);
+    GetMythUI()->GetImageThreadPool()->start(prefetch, "ImagePrefetch", 1);
+}
+
 /**
  *  \copydoc MythUIType::Pulse()
  */
@@ -1,6 +1,7 @@
 // Qt
 #include <QDir>
 #include <QDateTime>
+#include <QElapsedTimer>
 
 // MythTV
 #include "libmythbase/mthreadpool.h"
@@ -22,6 +23,9 @@
 
 #define LOC QString("UICache: ")
 
+// Log the cache statistics after this many memory cache lookups
+static constexpr quint64 kStatsInterval { 1000 };
+
 MythUIThemeCache::MythUIThemeCache()
   : m_imageThreadPool(new MThreadPool("MythUIHelper"))
 {
@@ -35,15 +39,8 @@ MythUIThemeCache::~MythUIThemeCache()
     PruneCacheDir(GetRemoteCacheDir());
     PruneCacheDir(GetThumbnailDir());
 
-    QMutableMapIterator<QString, MythImage *> i(m_imageCache);
-    while (i.hasNext())
-    {
-        i.next();
-        i.value()->SetIsInCache(false);
-        i.value()->DecrRef();
-        i.remove();
-    }
-    m_cacheTrack.clear();
+    LogCacheStats();
+    ClearMemoryCache();
 
     delete m_imageThreadPool;
 }
@@ -62,17 +59,8 @@ void MythUIThemeCache::UpdateImageCache()
 {
     QMutexLocker locker(&m_cacheLock);
 
-    QMutableMapIterator<QString, MythImage *> i(m_imageCache);
-
-    while (i.hasNext())
-    {
-        i.next();
-        i.value()->SetIsInCache(false);
-        i.value()->DecrRef();
-        i.remove();
-    }
-
-    m_cacheTrack.clear();
+    LogCacheStats();
+    ClearMemoryCache();
     m_cacheSize.fetchAndStoreOrdered(0);
 
     ClearOldImageCache();
@@ -279,11 +267,13 @@ MythImage* MythUIThemeCache::LoadCacheImage(QString File, const QString& Label,
 
         QMutexLocker locker(&m_cacheLock);
 
-        if (m_imageCache.contains(Label) &&
-            m_cacheTrack[Label] + kImageCacheTimeout > now)
+        auto it = m_imageCache.find(Label);
+        if (it != m_imageCache.end() && it->m_time + kImageCacheTimeout > now)
         {
-            m_imageCache[Label]->IncrRef();
-            return m_imageCache[Label];
+            TouchCacheEntry(*it);
+            CountLookup(true);
+            it->m_image->IncrRef();
+            return it->m_image;
         }
     }
 
@@ -356,7 +346,12 @@ MythImage* MythUIThemeCache::LoadCacheImage(QString File, const QString& Label,
                     ret = Painter->GetFormatImage();
 
                     // Load file from disk cache to memory cache
-                    if (ret->Load(cachefilepath))
+                    QElapsedTimer timer;
+                    timer.start();
+                    bool loaded = ret->Load(cachefilepath);
+                    AddDecodeTime(std::chrono::microseconds(timer.nsecsElapsed() / 1000));
+
+                    if (loaded)
                     {
                         // Add to ram cache, and skip saving to disk since that is
                         // where we found this in the first place.
@@ -391,22 +386,17 @@ MythImage* MythUIThemeCache::GetImageFromCache(const QString& URL)
 {
     QMutexLocker locker(&m_cacheLock);
 
-    if (m_imageCache.contains(URL))
+    auto it = m_imageCache.find(URL);
+    if (it != m_imageCache.end())
     {
-        m_cacheTrack[URL] = SystemClock::now();
-        m_imageCache[URL]->IncrRef();
-        return m_imageCache[URL];
+        it->m_time = SystemClock::now();
+        TouchCacheEntry(*it);
+        CountLookup(true);
+        it->m_image->IncrRef();
+        return it->m_image;
     }
 
-    /*
-        if (QFileInfo(URL).exists())
-        {
-            MythImage *im = GetMythPainter()->GetFormatImage();
-            im->Load(URL,false);
-            return im;
-        }
-    */
-
+    CountLookup(false);
     return nullptr;
 }
 
@@ -423,82 +413,59 @@ MythImage *MythUIThemeCache::CacheImage(const QString& URL, MythImage* Image, bo
         Image->save(dstfile, "PNG");
     }
 
-    // delete the oldest cached images until we fall below threshold.
+    // Delete the least recently used images until we fall below threshold.
+    // Images still referenced outside of the cache are skipped, since
+    // evicting them would not release any memory.
     QMutexLocker locker(&m_cacheLock);
 
+    auto lru = m_cacheLru.end();
     while ((m_cacheSize.fetchAndAddOrdered(0) + Image->sizeInBytes()) >=
-           m_maxCacheSize.fetchAndAddOrdered(0) && !m_imageCache.empty())
+           m_maxCacheSize.fetchAndAddOrdered(0) && lru != m_cacheLru.begin())
     {
-        QMap<QString, MythImage *>::iterator it = m_imageCache.begin();
-        auto oldestTime = SystemClock::now();
-        QString oldestKey = it.key();
-
-        int count = 0;
-
-        for (; it != m_imageCache.end(); ++it)
-        {
-            if (m_cacheTrack[it.key()] < oldestTime)
-            {
-                if ((2 == it.value()->IncrRef()) && (it.value() != Image))
-                {
-                    oldestTime = m_cacheTrack[it.key()];
-                    oldestKey = it.key();
-                    count++;
-                }
-                it.value()->DecrRef();
-            }
-        }
-
-        LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +QString("%1 images are eligible for expiry").arg(count));
-        if (count > 0)
-        {
-            LOG(VB_GUI | VB_FILE, LOG_INFO, LOC + QString("Cache too big (%1), removing :%2:")
-                .arg(m_cacheSize.fetchAndAddOrdered(0) + Image->sizeInBytes())
-                .arg(oldestKey));
-
-            m_imageCache[oldestKey]->SetIsInCache(false);
-            m_imageCache[oldestKey]->DecrRef();
-            m_imageCache.remove(oldestKey);
-            m_cacheTrack.remove(oldestKey);
-        }
-        else
-        {
-            break;
-        }
+        --lru;
+        MythImage *oldest = m_imageCache[*lru].m_image;
+        bool unused = (2 == oldest->IncrRef()) && (oldest != Image);
+        oldest->DecrRef();
+        if (!unused)
+            continue;
+
+        LOG(VB_GUI | VB_FILE, LOG_INFO, LOC + QString("Cache too big (%1), removing :%2:")
+            .arg(m_cacheSize.fetchAndAddOrdered(0) + Image->sizeInBytes())
+            .arg(*lru));
+
+        QString key = *lru;
+        lru = std::next(lru);
+        RemoveCacheEntry(key);
+        m_evictions.fetchAndAddRelaxed(1);
     }
 
-    QMap<QString, MythImage *>::iterator it = m_imageCache.find(URL);
-
+    auto it = m_imageCache.find(URL);
     if (it == m_imageCache.end())
     {
         Image->IncrRef();
-        m_imageCache[URL] = Image;
-        m_cacheTrack[URL] = SystemClock::now();
+        m_cacheLru.push_front(URL);
+        it = m_imageCache.insert(URL, { Image, SystemClock::now(), m_cacheLru.begin() });
 
         Image->SetIsInCache(true);
         LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
             QString("NOT IN RAM CACHE, Adding, and adding to size :%1: :%2:").arg(URL)
         .arg(Image->sizeInBytes()));
     }
+    else
+    {
+        TouchCacheEntry(*it);
+    }
 
     LOG(VB_GUI | VB_FILE, LOG_INFO, LOC + QString("MythUIHelper::CacheImage : Cache Count = :%1: size :%2:")
         .arg(m_imageCache.count()).arg(m_cacheSize.fetchAndAddRelaxed(0)));
 
-    return m_imageCache[URL];
+    return it->m_image;
 }
 
 void MythUIThemeCache::RemoveFromCacheByURL(const QString& URL)
 {
     QMutexLocker locker(&m_cacheLock);
-    QMap<QString, MythImage *>::iterator it = m_imageCache.find(URL);
-
-    if (it != m_imageCache.end())
-    {
-        m_imageCache[URL]->SetIsInCache(false);
-        m_imageCache[URL]->DecrRef();
-        m_imageCache.remove(URL);
-        m_cacheTrack.remove(URL);
-    }
+    RemoveCacheEntry(URL);
 
     QString dstfile = GetCacheDirByUrl(URL) + '/' + URL;
     LOG(VB_GUI | VB_FILE, LOG_INFO, LOC + QString("RemoveFromCacheByURL removed :%1: from cache").arg(dstfile));
@@ -572,3 +539,71 @@ MThreadPool* MythUIThemeCache::GetImageThreadPool()
     return m_imageThreadPool;
 }
 
+void MythUIThemeCache::AddDecodeTime(std::chrono::microseconds Elapsed)
+{
+    m_decodes.fetchAndAddRelaxed(1);
+    m_decodeTime.fetchAndAddRelaxed(Elapsed.count());
+}
+
+void MythUIThemeCache::LogCacheStats()
+{
+    quint64 hits    = m_cacheHits.fetchAndAddRelaxed(0);
+    quint64 misses  = m_cacheMisses.fetchAndAddRelaxed(0);
+    quint64 decodes = m_decodes.fetchAndAddRelaxed(0);
+    qint64  decode  = m_decodeTime.fetchAndAddRelaxed(0);
+    if (hits + misses == 0)
+        return;
+
+    QMutexLocker locker(&m_cacheLock);
+    LOG(VB_GUI, LOG_INFO, LOC +
+        QString("Memory cache: %1 hits, %2 misses (%3% hit rate), %4 evictions, "
+                "%5 images, %6 of %7 bytes. %8 decodes, average %9 us")
+        .arg(hits).arg(misses).arg(hits * 100 / (hits + misses))
+        .arg(m_evictions.fetchAndAddRelaxed(0)).arg(m_imageCache.count())
+        .arg(m_cacheSize.fetchAndAddRelaxed(0))
+        .arg(m_maxCacheSize.fetchAndAddRelaxed(0))
+        .arg(decodes).arg(decodes ? decode / static_cast<qint64>(decodes) : 0));
+}
+
+/// Move an entry to the front of the LRU list. Caller must hold m_cacheLock.
+void MythUIThemeCache::TouchCacheEntry(CacheEntry& Entry)
+{
+    m_cacheLru.splice(m_cacheLru.begin(), m_cacheLru, Entry.m_lru);
+}
+
+/// Drop an image from the memory cache. Caller must hold m_cacheLock.
+void MythUIThemeCache::RemoveCacheEntry(const QString& URL)
+{
+    auto it = m_imageCache.find(URL);
+    if (it == m_imageCache.end())
+        return;
+
+    it->m_image->SetIsInCache(false);
+    it->m_image->DecrRef();
+    m_cacheLru.erase(it->m_lru);
+    m_imageCache.erase(it);
+}
+
+void MythUIThemeCache::ClearMemoryCache()
+{
+    QMutexLocker locker(&m_cacheLock);
+    for (auto & entry : m_imageCache)
+    {
+        entry.m_image->SetIsInCache(false);
+        entry.m_image->DecrRef();
+    }
+    m_imageCache.clear();
+    m_cacheLru.clear();
+}
+
+void MythUIThemeCache::CountLookup(bool Hit)
+{
+    if (Hit)
+        m_cacheHits.fetchAndAddRelaxed(1);
+    else
+        m_cacheMisses.fetchAndAddRelaxed(1);
+
+    quint64 lookups = m_cacheHits.fetchAndAddRelaxed(0) + m_cacheMisses.fetchAndAddRelaxed(0);
+    if ((lookups % kStatsInterval) == 0 && VERBOSE_LEVEL_CHECK(VB_GUI, LOG_DEBUG))
+        LogCacheStats();
+}
@@ -1,8 +1,11 @@
 #ifndef MYTHUICACHE_H
 #define MYTHUICACHE_H
 
+// Std
+#include <list>
+
 // Qt
-#include <QMap>
+#include <QHash>
 #include <QRecursiveMutex>
 
 // MythTV
@@ -37,8 +40,22 @@ class MUI_PUBLIC MythUIThemeCache
     void        IncludeInCacheSize(MythImage* Image);
     void        ExcludeFromCacheSize(MythImage* Image);
     MThreadPool* GetImageThreadPool();
+    void        AddDecodeTime(std::chrono::microseconds Elapsed);
+    void        LogCacheStats();
 
   private:
+    struct CacheEntry
+    {
+        MythImage* m_image { nullptr };
+        SystemTime m_time;
+        std::list<QString>::iterator m_lru;
+    };
+
+    void        TouchCacheEntry(CacheEntry& Entry);
+    void        RemoveCacheEntry(const QString& URL);
+    void        ClearMemoryCache();
+    void        CountLookup(bool Hit);
+
     QString     GetCacheDirByUrl(const QString& URL);
     void        RemoveFromCacheByURL(const QString& URL);
     MythImage*  GetImageFromCache(const QString& URL);
@@ -46,14 +63,21 @@ class MUI_PUBLIC MythUIThemeCache
     void        RemoveCacheDir(const QString& Dir);
     static void PruneCacheDir(const QString& Dir);
 
-    QMap<QString, MythImage *> m_imageCache;
-    QMap<QString, SystemTime> m_cacheTrack;
+    /// Memory cache, front of m_cacheLru is the most recently used image
+    QHash<QString, CacheEntry> m_imageCache;
+    std::list<QString> m_cacheLru;
     QRecursiveMutex m_cacheLock;
     QAtomicInteger<qint64> m_cacheSize    { 0 };
     QAtomicInteger<qint64> m_maxCacheSize { 30LL * 1024 * 1024 };
     QString m_themecachedir;
     QSize   m_cacheScreenSize;
     MThreadPool* m_imageThreadPool        { nullptr };
+
+    QAtomicInteger<quint64> m_cacheHits   { 0 };
+    QAtomicInteger<quint64> m_cacheMisses { 0 };
+    QAtomicInteger<quint64> m_evictions   { 0 };
+    QAtomicInteger<quint64> m_decodes     { 0 };
+    QAtomicInteger<qint64>  m_decodeTime  { 0 };
 };
 
 #endif
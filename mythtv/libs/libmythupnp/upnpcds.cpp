@@ -25,6 +25,16 @@
 static constexpr const char* DIDL_LITE_BEGIN { R"(<DIDL-Lite xmlns:dc="http://purl.org/dc/elements/1.1/" xmlns:upnp="urn:schemas-upnp-org:metadata-1-0/upnp/" xmlns="urn:schemas-upnp-org:metadata-1-0/DIDL-Lite/">)" };
 static constexpr const char* DIDL_LITE_END   { "</DIDL-Lite>" };
 
+// Children are fetched from the extensions, and cached, in blocks of this
+// many objects so paging through a large container only queries it once.
+static constexpr uint16_t kCacheBlock      { 200 };
+// Extensions don't tell us when their content changes (e.g. a recording in
+// progress growing), so don't keep results for longer than this.
+static constexpr qint64   kCacheMaxAgeMs   { 5LL * 60 * 1000 };
+static constexpr int      kCacheMaxEntries { 5000 };
+// Number of Browse/Search requests between latency summaries
+static constexpr int      kLatencyInterval { 100 };
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -361,8 +371,11 @@ void UPnpCDS::DetermineClient( HTTPRequest *pRequest,
 
 void UPnpCDS::HandleBrowse( HTTPRequest *pRequest )
 {
-    UPnpCDSExtensionResults *pResult  = nullptr;
     UPnpCDSRequest           request;
+    QElapsedTimer            timer;
+    bool                     bCached = false;
+
+    timer.start();
 
     DetermineClient( pRequest, &request );
     request.m_sObjectId         = pRequest->m_mapParams[ "objectid"      ];
@@ -470,46 +483,13 @@ void UPnpCDS::HandleBrowse( HTTPRequest *pRequest )
     }
     else
     {
-        // ------------------------------------------------------------------
-        // Look for a CDS Extension that knows how to handle this ObjectID
-        // ------------------------------------------------------------------
-
-        UPnpCDSExtensionList::iterator it = m_extensions.begin();
-        for (; (it != m_extensions.end()) && !pResult; ++it)
-        {
-            LOG(VB_UPNP, LOG_INFO,
-                QString("UPNP Browse : Searching for : %1  / ObjectID : %2")
-                    .arg((*it)->m_sExtensionId, request.m_sObjectId));
-
-            pResult = (*it)->Browse(&request);
-        }
-
-        if (pResult != nullptr)
-        {
-            eErrorCode  = pResult->m_eErrorCode;
-            sErrorDesc  = pResult->m_sErrorDesc;
-
-            if (eErrorCode == UPnPResult_Success)
-            {
-                while (pResult->m_List.size() > request.m_nRequestedCount)
-                {
-                    pResult->m_List.takeLast()->DecrRef();
-                }
-
-                nNumberReturned = pResult->m_List.count();
-                nTotalMatches   = pResult->m_nTotalMatches;
-                nUpdateID       = pResult->m_nUpdateID;
-                if (request.m_eBrowseFlag == CDS_BrowseMetadata)
-                    sResultXML      = pResult->GetResultXML(filter, true); // Ignore children
-                else
-                    sResultXML      = pResult->GetResultXML(filter);
-            }
-
-            delete pResult;
-            pResult = nullptr;
-        }
+        eErrorCode = BrowseExtensions( request, filter, sResultXML,
+                                       nNumberReturned, nTotalMatches,
+                                       nUpdateID, sErrorDesc, bCached );
     }
 
+    RecordLatency( timer.elapsed(), bCached );
+
     // ----------------------------------------------------------------------
     // Output Results of Browse Method
     // ----------------------------------------------------------------------
@@ -536,6 +516,220 @@ void UPnpCDS::HandleBrowse( HTTPRequest *pRequest )
 
 }
 
+/**
+ *  \brief Browse an object belonging to one of the extensions
+ *
+ *  Children are requested from the extensions kCacheBlock objects at a time
+ *  and each block is cached, already rendered, so paging through a large
+ *  container (or a second client browsing it) doesn't reload it every time.
+ */
+
+UPnPResultCode UPnpCDS::BrowseExtensions( UPnpCDSRequest &request,
+                                          FilterMap &filter,
+                                          QString &sResultXML,
+                                          uint16_t &nNumberReturned,
+                                          uint16_t &nTotalMatches,
+                                          uint16_t &nUpdateID,
+                                          QString &sErrorDesc,
+                                          bool &bCached )
+{
+    bool bMetadata = (request.m_eBrowseFlag == CDS_BrowseMetadata);
+    uint nStart    = bMetadata ? 0 : request.m_nStartingIndex;
+    uint nEnd      = nStart + request.m_nRequestedCount;
+    uint nBlock    = nStart / kCacheBlock;
+    bool bFirst    = true;
+
+    bCached = true;
+
+    while (true)
+    {
+        uint         nFirst = nBlock * kCacheBlock;
+        QString      sKey   = CacheKey( request, QString::number(nBlock) );
+        CachedResult block;
+
+        if (!GetCached( sKey, block ))
+        {
+            // --------------------------------------------------------------
+            // Look for a CDS Extension that knows how to handle this ObjectID
+            // --------------------------------------------------------------
+
+            UPnpCDSExtensionResults *pResult = nullptr;
+            UPnpCDSRequest           blockRequest = request;
+
+            if (!bMetadata)
+            {
+                blockRequest.m_nStartingIndex  = nFirst;
+                blockRequest.m_nRequestedCount = kCacheBlock;
+            }
+
+            UPnpCDSExtensionList::iterator it = m_extensions.begin();
+            for (; (it != m_extensions.end()) && !pResult; ++it)
+            {
+                LOG(VB_UPNP, LOG_INFO,
+                    QString("UPNP Browse : Searching for : %1  / ObjectID : %2")
+                        .arg((*it)->m_sExtensionId, request.m_sObjectId));
+
+                pResult = (*it)->Browse(&blockRequest);
+            }
+
+            if (pResult == nullptr)
+                return UPnPResult_CDS_NoSuchObject;
+
+            UPnPResultCode eErrorCode = pResult->m_eErrorCode;
+            if (eErrorCode != UPnPResult_Success)
+            {
+                sErrorDesc = pResult->m_sErrorDesc;
+                delete pResult;
+                return eErrorCode;
+            }
+
+            while (pResult->m_List.size() > blockRequest.m_nRequestedCount)
+            {
+                pResult->m_List.takeLast()->DecrRef();
+            }
+
+            for (auto *item : std::as_const(pResult->m_List))
+                block.m_items.append(item->toXml(filter, bMetadata)); // Ignore children of metadata
+            block.m_nTotalMatches = pResult->m_nTotalMatches;
+            block.m_nUpdateID     = pResult->m_nUpdateID;
+            delete pResult;
+
+            PutCached( sKey, block );
+            bCached = false;
+        }
+
+        if (bFirst)
+        {
+            nTotalMatches = block.m_nTotalMatches;
+            nUpdateID     = block.m_nUpdateID;
+            bFirst        = false;
+        }
+
+        for (uint i = std::max(nStart, nFirst) - nFirst;
+             (i < (uint)block.m_items.size()) && (nFirst + i < nEnd);
+             i++)
+        {
+            sResultXML += block.m_items[i];
+            nNumberReturned++;
+        }
+
+        nBlock++;
+        if (bMetadata || block.m_items.size() < kCacheBlock ||
+            nBlock * kCacheBlock >= nEnd ||
+            nBlock * kCacheBlock >= nTotalMatches)
+            break;
+    }
+
+    return UPnPResult_Success;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QString UPnpCDS::CacheKey( const UPnpCDSRequest &request,
+                           const QString &sExtra )
+{
+    return QString("%1\n%2\n%3\n%4\n%5\n%6\n%7\n%8")
+        .arg(request.m_sObjectId,
+             request.m_sContainerID,
+             QString::number(request.m_eBrowseFlag),
+             request.m_sFilter,
+             request.m_sSortCriteria,
+             QString::number(request.m_eClient),
+             QString::number(request.m_nClientVersion),
+             sExtra);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+bool UPnpCDS::GetCached( const QString &sKey, CachedResult &result )
+{
+    QMutexLocker locker(&m_cacheLock);
+
+    auto it = m_cache.find(sKey);
+    if (it == m_cache.end())
+        return false;
+
+    if (it->m_age.hasExpired(kCacheMaxAgeMs))
+    {
+        m_cache.erase(it);
+        return false;
+    }
+
+    result = *it;
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpCDS::PutCached( const QString &sKey, const CachedResult &result )
+{
+    QMutexLocker locker(&m_cacheLock);
+
+    if (m_cache.size() >= kCacheMaxEntries)
+    {
+        LOG(VB_UPNP, LOG_DEBUG, "UPnpCDS: Browse cache full, flushing");
+        m_cache.clear();
+    }
+
+    CachedResult &entry = m_cache[sKey];
+    entry = result;
+    entry.m_age.start();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void UPnpCDS::RecordLatency( qint64 nMs, bool bCached )
+{
+    LOG(VB_UPNP, LOG_DEBUG, QString("UPnpCDS: Request took %1ms%2")
+        .arg(nMs).arg(bCached ? " (cached)" : ""));
+
+    QMutexLocker locker(&m_cacheLock);
+
+    m_nRequests++;
+    m_nTotalMs += nMs;
+    m_nMaxMs    = std::max(m_nMaxMs, nMs);
+    if (bCached)
+        m_nCacheHits++;
+
+    if (m_nRequests < kLatencyInterval)
+        return;
+
+    LOG(VB_UPNP, LOG_INFO,
+        QString("UPnpCDS: %1 requests, %2 from cache, avg %3ms, max %4ms")
+            .arg(m_nRequests).arg(m_nCacheHits)
+            .arg(m_nTotalMs / m_nRequests).arg(m_nMaxMs));
+
+    m_nRequests  = 0;
+    m_nCacheHits = 0;
+    m_nTotalMs   = 0;
+    m_nMaxMs     = 0;
+}
+
+/**
+ *  \brief Forget all cached results and tell clients the content has changed
+ *
+ *  Call when recordings, videos etc. have been added or removed.
+ */
+
+void UPnpCDS::ContentChanged()
+{
+    {
+        QMutexLocker locker(&m_cacheLock);
+        m_cache.clear();
+    }
+
+    auto nId = GetValue<uint16_t>("SystemUpdateID");
+    SetValue< uint16_t >( "SystemUpdateID", static_cast<uint16_t>(nId + 1) );
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -544,6 +738,10 @@ void UPnpCDS::HandleSearch( HTTPRequest *pRequest )
 {
     UPnpCDSExtensionResults *pResult  = nullptr;
     UPnpCDSRequest           request;
+    QElapsedTimer            timer;
+    CachedResult             cached;
+
+    timer.start();
 
     UPnPResultCode eErrorCode      = UPnPResult_InvalidAction;
     QString       sErrorDesc      = "";
@@ -627,9 +825,26 @@ void UPnpCDS::HandleSearch( HTTPRequest *pRequest )
     bool bSearchDone = false;
 #endif
 
-    UPnpCDSExtensionList::iterator it = m_extensions.begin();
-    for (; (it != m_extensions.end()) && !pResult; ++it)
-        pResult = (*it)->Search(&request);
+    QString sKey = CacheKey( request, QString("search/%1/%2/%3")
+                                 .arg(request.m_sSearchCriteria)
+                                 .arg(request.m_nStartingIndex)
+                                 .arg(request.m_nRequestedCount) );
+    bool bCached = GetCached( sKey, cached );
+
+    if (bCached)
+    {
+        eErrorCode      = UPnPResult_Success;
+        nNumberReturned = cached.m_items.count();
+        nTotalMatches   = cached.m_nTotalMatches;
+        nUpdateID       = cached.m_nUpdateID;
+        sResultXML      = cached.m_items.join(QString());
+    }
+    else
+    {
+        UPnpCDSExtensionList::iterator it = m_extensions.begin();
+        for (; (it != m_extensions.end()) && !pResult; ++it)
+            pResult = (*it)->Search(&request);
+    }
 
     if (pResult != nullptr)
     {
@@ -642,16 +857,24 @@ void UPnpCDS::HandleSearch( HTTPRequest *pRequest )
             nNumberReturned = pResult->m_List.count();
             nTotalMatches   = pResult->m_nTotalMatches;
             nUpdateID       = pResult->m_nUpdateID;
-            sResultXML      = pResult->GetResultXML(filter);
+            for (auto *item : std::as_const(pResult->m_List))
+                cached.m_items.append(item->toXml(filter));
+            sResultXML      = cached.m_items.join(QString());
 #if 0
             bSearchDone = true;
 #endif
+
+            cached.m_nTotalMatches = nTotalMatches;
+            cached.m_nUpdateID     = nUpdateID;
+            PutCached( sKey, cached );
         }
 
         delete pResult;
         pResult = nullptr;
     }
 
+    RecordLatency( timer.elapsed(), bCached );
+
 #if 0
     nUpdateID       = 0;
     LOG(VB_UPNP, LOG_DEBUG, sResultXML);
@@ -17,8 +17,11 @@
 #include <utility>
 
 // QT headers
+#include <QElapsedTimer>
+#include <QHash>
 #include <QList>
 #include <QMap>
+#include <QMutex>
 #include <QObject>
 #include <QString>
 
@@ -292,6 +295,24 @@ class UPNP_PUBLIC UPnpCDS : public Eventing
         UPnPFeatureList        m_features;
         UPnPShortcutFeature   *m_pShortCuts {nullptr};
 
+        /// Browse/Search results as returned by the extensions
+        struct CachedResult
+        {
+            QStringList    m_items;             ///< DIDL-Lite of each object
+            uint16_t       m_nTotalMatches {0};
+            uint16_t       m_nUpdateID     {0};
+            QElapsedTimer  m_age;
+        };
+
+        QMutex                        m_cacheLock;
+        QHash<QString, CachedResult>  m_cache;
+
+        // Request latency, since last logged
+        int                    m_nRequests  {0};
+        int                    m_nCacheHits {0};
+        qint64                 m_nTotalMs   {0};
+        qint64                 m_nMaxMs     {0};
+
     private:
 
         static UPnpCDSMethod       GetMethod              ( const QString &sURI  );
@@ -306,6 +327,22 @@ class UPNP_PUBLIC UPnpCDS : public Eventing
         void            HandleGetServiceResetToken ( HTTPRequest *pRequest );
         static void     DetermineClient            ( HTTPRequest *pRequest, UPnpCDSRequest *pCDSRequest );
 
+        UPnPResultCode  BrowseExtensions ( UPnpCDSRequest &request,
+                                           FilterMap &filter,
+                                           QString &sResultXML,
+                                           uint16_t &nNumberReturned,
+                                           uint16_t &nTotalMatches,
+                                           uint16_t &nUpdateID,
+                                           QString &sErrorDesc,
+                                           bool &bCached );
+        static QString  CacheKey         ( const UPnpCDSRequest &request,
+                                           const QString &sExtra );
+        bool            GetCached        ( const QString &sKey,
+                                           CachedResult &result );
+        void            PutCached        ( const QString &sKey,
+                                           const CachedResult &result );
+        void            RecordLatency    ( qint64 nMs, bool bCached );
+
     protected:
 
         // Implement UPnpServiceImpl methods that we can
@@ -332,6 +369,8 @@ class UPNP_PUBLIC UPnpCDS : public Eventing
                                       const QString &objectID );
         void     RegisterFeature    ( UPnPFeature *feature );
 
+        void     ContentChanged     ( );
+
         QStringList GetBasePaths() override; // Eventing
         
         bool ProcessRequest( HTTPRequest *pRequest ) override; // Eventing
@@ -38,6 +38,12 @@ libmyth-test.target = buildtestmyth
 libmyth-test.commands = cd libmyth/test && $(QMAKE) && $(MAKE)
 unix:QMAKE_EXTRA_TARGETS += libmyth-test
 
+# unit tests libmythfreesurround
+libmythfreesurround-test.depends = sub-libmythfreesurround sub-libmythbase
+libmythfreesurround-test.target = buildtestmythfreesurround
+libmythfreesurround-test.commands = cd libmythfreesurround/test && $(QMAKE) && $(MAKE)
+unix:QMAKE_EXTRA_TARGETS += libmythfreesurround-test
+
 # unit tests libmythbase
 libmythbase-test.depends = sub-libmythbase
 libmythbase-test.target = buildtestmythbase
@@ -68,7 +74,7 @@ libmythservicecontracts-test.target = buildtestmythservicecontracts
 libmythservicecontracts-test.commands = cd libmythservicecontracts/test && $(QMAKE) && $(MAKE)
 unix:QMAKE_EXTRA_TARGETS += libmythservicecontracts-test
 
-unittest.depends = libmyth-test libmythbase-test libmythui-test libmythtv-test libmythmetadata-test libmythservicecontracts-test
+unittest.depends = libmyth-test libmythfreesurround-test libmythbase-test libmythui-test libmythtv-test libmythmetadata-test libmythservicecontracts-test
 unittest.target = test
 unittest.commands = ../programs/scripts/unittests.sh
 unix:QMAKE_EXTRA_TARGETS += unittest
@@ -54,6 +54,27 @@ static constexpr uint64_t kSpaceTooBigKB { 3ULL * 1024 * 1024 };
 // add to the autoexpire list.
 static constexpr int64_t kRecentInterval { 2LL * 60 * 60 };
 
+// Scheduled recordings starting within this many seconds are included in
+// the space wanted now.  This is the longest expire period.
+static constexpr int64_t kUpcomingWindow { 15LL * 60 };
+
+// Run the expirer this long before a scheduled recording starts.
+static constexpr int64_t kUpcomingLead { 5LL * 60 };
+
+// Period over which the expected disk usage is projected for the status page.
+static constexpr int64_t kProjectionWindow { 60LL * 60 };
+
+// Drop cached expire candidates that haven't been seen for this long.
+static constexpr int64_t kCandidateMaxAge { 60LL * 60 };
+
+/// Converts a bitrate in bits/sec to the KB written per minute.
+static uint64_t bitrate_to_kb_per_min(uint64_t maxBitrate)
+{
+    if (maxBitrate == 0)
+        maxBitrate = 19500000LL;
+    return (maxBitrate*((uint64_t)15))>>11;
+}
+
 /// \brief This calls AutoExpire::RunExpirer() from within a new thread.
 void ExpireThread::run(void)
 {
@@ -118,6 +139,29 @@ uint64_t AutoExpire::GetDesiredSpace(int fsID) const
     return 0;
 }
 
+/**
+ *   \brief  Used by the status pages
+ *   \return the KB expected to be written to the file system within the
+ *           next hour by current and scheduled recordings
+ */
+uint64_t AutoExpire::GetProjectedSpace(int fsID) const
+{
+    QMutexLocker locker(&m_instanceLock);
+    if (m_projectedSpace.contains(fsID))
+        return m_projectedSpace[fsID];
+    return 0;
+}
+
+/**
+ *   \brief  Called by the scheduler after each scheduling run with the
+ *           recordings it is going to start.
+ */
+void AutoExpire::SetUpcomingRecordings(const upcominglist_t &upcoming)
+{
+    QMutexLocker locker(&m_instanceLock);
+    m_upcoming = upcoming;
+}
+
 /** \fn AutoExpire::CalcParams()
  *   Calculates how much space needs to be cleared, and how often.
  */
@@ -168,6 +212,57 @@ void AutoExpire::CalcParams()
     }
     m_instanceLock.unlock();
 
+    // Scheduled recordings don't have a file system until they start, so
+    // like unknown recordings they count against all file systems.  An
+    // input that is recording now is already counted above.
+    m_instanceLock.lock();
+    upcominglist_t upcoming = m_upcoming;
+    m_instanceLock.unlock();
+
+    QDateTime now = MythDate::current();
+    QSet<uint> countedInputs;
+    for (auto it = fsEncoderMap.cbegin(); it != fsEncoderMap.cend(); ++it)
+    {
+        for (int cardid : std::as_const(*it))
+            countedInputs.insert(cardid);
+    }
+
+    QMap<uint, uint64_t> inputKBperMin;
+    uint64_t upcomingKBperMin = 0;
+    uint64_t upcomingProjectedKB = 0;
+    for (const auto & rec : upcoming)
+    {
+        if (rec.m_end <= now)
+            continue;
+
+        if (!inputKBperMin.contains(rec.m_inputId))
+        {
+            auto iter = m_encoderList->constFind(rec.m_inputId);
+            inputKBperMin[rec.m_inputId] = bitrate_to_kb_per_min(
+                (iter != m_encoderList->constEnd() && (*iter)->IsConnected()) ?
+                (*iter)->GetMaxBitrate() : 0);
+        }
+        uint64_t kbPerMin = inputKBperMin[rec.m_inputId];
+
+        QDateTime start = std::max(rec.m_start, now);
+        QDateTime end = std::min(rec.m_end, now.addSecs(kProjectionWindow));
+        if (start < end)
+            upcomingProjectedKB += kbPerMin * (start.secsTo(end) / 60);
+
+        if (rec.m_start <= now || rec.m_start > now.addSecs(kUpcomingWindow) ||
+            countedInputs.contains(rec.m_inputId))
+            continue;
+
+        countedInputs.insert(rec.m_inputId);
+        upcomingKBperMin += kbPerMin;
+        LOG(VB_FILE, LOG_INFO, LOC +
+            QString("Input %1: starts recording at %2, adding %3 KB/min")
+                .arg(rec.m_inputId)
+                .arg(rec.m_start.toString(Qt::ISODate))
+                .arg(kbPerMin));
+    }
+
+    QMap<int, uint64_t> projectedMap;
     QList<FileSystemInfo>::iterator fsit;
     for (fsit = fsInfos.begin(); fsit != fsInfos.end(); ++fsit)
     {
@@ -209,10 +304,7 @@ void AutoExpire::CalcParams()
                     continue;
                 }
 
-                uint64_t maxBitrate = enc->GetMaxBitrate();
-                if (maxBitrate==0)
-                    maxBitrate = 19500000LL;
-                thisKBperMin += (maxBitrate*((uint64_t)15))>>11;
+                thisKBperMin += bitrate_to_kb_per_min(enc->GetMaxBitrate());
                 LOG(VB_FILE, LOG_INFO, QString("    Cardid %1: max bitrate "
                         "%2 Kb/sec, fsID %3 max is now %4 KB/min")
                         .arg(enc->GetInputID())
@@ -221,6 +313,16 @@ void AutoExpire::CalcParams()
                         .arg(thisKBperMin));
             }
         }
+        projectedMap[fsit->getFSysID()] =
+            thisKBperMin * (kProjectionWindow / 60) + upcomingProjectedKB;
+
+        if (upcomingKBperMin > 0)
+        {
+            thisKBperMin += upcomingKBperMin;
+            LOG(VB_FILE, LOG_INFO,
+                QString("  fsID %1 max with scheduled recordings is %2 KB/min")
+                    .arg(fsit->getFSysID()).arg(thisKBperMin));
+        }
         fsMap[fsit->getFSysID()] = thisKBperMin;
 
         if (thisKBperMin > maxKBperMin)
@@ -258,6 +360,8 @@ void AutoExpire::CalcParams()
         m_desiredSpace[it.key()] = (*it + *it/3) * expireFreq + extraKB;
         ++it;
     }
+    for (it = projectedMap.begin(); it != projectedMap.end(); ++it)
+        m_projectedSpace[it.key()] = *it;
     m_instanceLock.unlock();
 }
 
@@ -274,6 +378,7 @@ void AutoExpire::RunExpirer(void)
     QElapsedTimer timer;
     QDateTime curTime;
     QDateTime next_expire = MythDate::current().addSecs(60);
+    QDateTime handledStart;
 
     QMutexLocker locker(&m_instanceLock);
 
@@ -287,6 +392,22 @@ void AutoExpire::RunExpirer(void)
         TVRec::s_inputsLock.lockForRead();
 
         curTime = MythDate::current();
+
+        // Expire ahead of a scheduled recording instead of waiting for
+        // the next regular run, once per recording start time.
+        QDateTime after = (handledStart.isValid() && handledStart > curTime) ?
+            handledStart : curTime;
+        QDateTime nextStart = NextUpcomingStart(after);
+        if (nextStart.isValid() && next_expire > curTime &&
+            curTime.secsTo(nextStart) <= kUpcomingLead)
+        {
+            LOG(VB_FILE, LOG_INFO, LOC +
+                QString("Recording starts at %1, running early")
+                    .arg(nextStart.toString(Qt::ISODate)));
+            next_expire = curTime;
+            handledStart = nextStart;
+        }
+
         // recalculate auto expire parameters
         if (curTime >= next_expire)
         {
@@ -331,6 +452,8 @@ void AutoExpire::RunExpirer(void)
             ExpireEpisodesOverMax();
 
             ExpireRecordings();
+
+            PruneCandidateCache();
         }
 
         TVRec::s_inputsLock.unlock();
@@ -973,7 +1096,7 @@ void AutoExpire::FillDBOrdered(pginfolist_t &expireList, int expMethod)
 
     MSqlQuery query(MSqlQuery::InitCon());
     QString querystr = QString(
-        "SELECT recorded.chanid, starttime "
+        "SELECT recorded.chanid, starttime, recorded.lastmodified "
         "FROM recorded "
         "LEFT JOIN channel ON recorded.chanid = channel.chanid "
         "WHERE %1 AND deletepending = 0 "
@@ -988,6 +1111,7 @@ void AutoExpire::FillDBOrdered(pginfolist_t &expireList, int expMethod)
     {
         uint chanid = query.value(0).toUInt();
         QDateTime recstartts = MythDate::as_utc(query.value(1).toDateTime());
+        QDateTime lastmodified = MythDate::as_utc(query.value(2).toDateTime());
 
         if (IsInDontExpireSet(chanid, recstartts))
         {
@@ -1005,7 +1129,7 @@ void AutoExpire::FillDBOrdered(pginfolist_t &expireList, int expMethod)
         }
         else
         {
-            auto *pginfo = new ProgramInfo(chanid, recstartts);
+            ProgramInfo *pginfo = LoadCandidate(chanid, recstartts, lastmodified);
             if (pginfo->GetChanID())
             {
                 LOG(VB_FILE, LOG_INFO, LOC + QString("    Adding   %1 at %2")
@@ -1115,6 +1239,68 @@ bool AutoExpire::IsInDontExpireSet(
     return (m_dontExpireSet.find(key) != m_dontExpireSet.end());
 }
 
+/**
+ *  \brief Returns a new ProgramInfo for a recording, copied from the
+ *         candidate cache unless the recording changed since it was loaded.
+ */
+ProgramInfo *AutoExpire::LoadCandidate(
+    uint chanid, const QDateTime &recstartts, const QDateTime &lastmodified)
+{
+    QString key = QString("%1_%2")
+        .arg(chanid).arg(recstartts.toString(Qt::ISODate));
+
+    m_candidateUsed[key] = MythDate::current();
+
+    auto it = m_candidates.constFind(key);
+    if (it != m_candidates.constEnd() &&
+        (*it)->GetLastModifiedTime() == lastmodified)
+    {
+        return new ProgramInfo(**it);
+    }
+
+    auto *pginfo = new ProgramInfo(chanid, recstartts);
+    if (pginfo->GetChanID())
+        m_candidates[key] = std::make_shared<ProgramInfo>(*pginfo);
+    else
+        m_candidates.remove(key);
+    return pginfo;
+}
+
+void AutoExpire::PruneCandidateCache(void)
+{
+    QDateTime cutoff = MythDate::current().addSecs(-kCandidateMaxAge);
+    auto it = m_candidateUsed.begin();
+    while (it != m_candidateUsed.end())
+    {
+        if (*it < cutoff)
+        {
+            m_candidates.remove(it.key());
+            it = m_candidateUsed.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    LOG(VB_FILE, LOG_DEBUG, LOC + QString("%1 cached expire candidates")
+            .arg(m_candidates.size()));
+}
+
+/**
+ *  \brief Returns the earliest start time of a scheduled recording
+ *         after the given time.  Must be called with m_instanceLock held.
+ */
+QDateTime AutoExpire::NextUpcomingStart(const QDateTime &after) const
+{
+    QDateTime next;
+    for (const auto & rec : m_upcoming)
+    {
+        if (rec.m_start > after && (!next.isValid() || rec.m_start < next))
+            next = rec.m_start;
+    }
+    return next;
+}
+
 bool AutoExpire::IsInExpireList(
     const pginfolist_t &expireList, uint chanid, const QDateTime &recstartts)
 {
@@ -2,6 +2,8 @@
 #define AUTOEXPIRE_H_
 
 #include <cstdint>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include <QWaitCondition>
@@ -10,6 +12,7 @@
 #include <QObject>
 #include <QString>
 #include <QMutex>
+#include <QHash>
 #include <QQueue>
 #include <QSet>
 #include <QMap>
@@ -57,6 +60,22 @@ class UpdateEntry
     int m_fsID;
 };
 
+/// A recording the scheduler is going to start, used to estimate the
+/// space needed before it starts.
+class UpcomingRecording
+{
+  public:
+    UpcomingRecording(uint _inputid, QDateTime _start, QDateTime _end)
+        : m_inputId(_inputid), m_start(std::move(_start)),
+          m_end(std::move(_end)) {};
+
+    uint      m_inputId;
+    QDateTime m_start;
+    QDateTime m_end;
+};
+
+using upcominglist_t = std::vector<UpcomingRecording>;
+
 class AutoExpire : public QObject
 {
     Q_OBJECT
@@ -71,6 +90,8 @@ class AutoExpire : public QObject
     void PrintExpireList(const QString& expHost = "ALL");
 
     uint64_t GetDesiredSpace(int fsID) const;
+    uint64_t GetProjectedSpace(int fsID) const;
+    void SetUpcomingRecordings(const upcominglist_t &upcoming);
 
     void GetAllExpiring(QStringList &strList);
     void GetAllExpiring(pginfolist_t &list);
@@ -104,6 +125,10 @@ class AutoExpire : public QObject
 
     void UpdateDontExpireSet(void);
     bool IsInDontExpireSet(uint chanid, const QDateTime &recstartts) const;
+    ProgramInfo *LoadCandidate(uint chanid, const QDateTime &recstartts,
+                               const QDateTime &lastmodified);
+    void PruneCandidateCache(void);
+    QDateTime NextUpcomingStart(const QDateTime &after) const;
     static bool IsInExpireList(const pginfolist_t &expireList,
                                uint chanid, const QDateTime &recstartts);
 
@@ -114,7 +139,14 @@ class AutoExpire : public QObject
     bool          m_expireThreadRun   {false};   // protected by m_instanceLock
 
     QMap<int, int64_t>  m_desiredSpace;          // protected by m_instanceLock
+    QMap<int, int64_t>  m_projectedSpace;        // protected by m_instanceLock
     QMap<int, int>      m_usedEncoders;          // protected by m_instanceLock
+    upcominglist_t      m_upcoming;              // protected by m_instanceLock
+
+    // Expire candidates loaded by FillDBOrdered(), keyed by chanid and
+    // starttime, reused while recorded.lastmodified is unchanged.
+    QHash<QString, std::shared_ptr<ProgramInfo> > m_candidates; // protected by m_instanceLock
+    QHash<QString, QDateTime> m_candidateUsed;   // protected by m_instanceLock
 
     mutable QMutex m_instanceLock;
     QWaitCondition m_instanceCond;               // protected by m_instanceLock
@@ -33,6 +33,7 @@
 #include "libmythbase/mythmiscutil.h"
 #include "libmythbase/mythsystemlegacy.h"
 #include "libmythbase/mythversion.h"
+#include "libmythbase/threadedfilewriter.h"
 #include "libmythtv/cardutil.h"
 #include "libmythtv/jobqueue.h"
 #include "libmythtv/tv.h"
@@ -421,6 +422,63 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
 
     jobqueue.setAttribute( "count", jobs.size() );
 
+    // Add how long the tuning phases of this backend's inputs took
+
+    QDomElement tuning = pDoc->createElement("TuningTrace");
+    root.appendChild(tuning);
+
+    for (const auto & stats : TuningTrace::GetStats())
+    {
+        QDomElement phase = pDoc->createElement("Phase");
+        tuning.appendChild(phase);
+
+        phase.setAttribute("name" , stats.m_name );
+        phase.setAttribute("span" , stats.m_span ? 1 : 0 );
+        phase.setAttribute("count", stats.m_count );
+        phase.setAttribute("avgms", stats.m_count ?
+                           static_cast<int>(stats.m_total.count() / stats.m_count) : 0 );
+        phase.setAttribute("maxms", static_cast<int>(stats.m_max.count()) );
+
+        for (size_t i = 0; i < stats.m_buckets.size(); ++i)
+        {
+            QDomElement bucket = pDoc->createElement("Bucket");
+            phase.appendChild(bucket);
+
+            // The last bucket has no upper limit
+            int upto = (i < TuningTrace::kBucketLimits.size()) ?
+                static_cast<int>(TuningTrace::kBucketLimits[i].count()) : 0;
+            bucket.setAttribute("uptoms", upto );
+            bucket.setAttribute("count" , stats.m_buckets[i] );
+        }
+    }
+
+    // Add what the shared writers of the stream handlers have written
+
+    QDomElement writers = pDoc->createElement("WriterGroups");
+    root.appendChild(writers);
+
+    for (const auto & stats : TFWGroup::GetAllStats())
+    {
+        QDomElement group = pDoc->createElement("Group");
+        writers.appendChild(group);
+
+        group.setAttribute("name"  , stats.m_total.m_filename );
+        group.setAttribute("bytes" , QString::number(stats.m_total.m_bytes) );
+        group.setAttribute("writes", QString::number(stats.m_total.m_writes) );
+        group.setAttribute("rate"  , QString::number(stats.m_total.m_rate) );
+
+        for (const auto & file : stats.m_files)
+        {
+            QDomElement fileElem = pDoc->createElement("File");
+            group.appendChild(fileElem);
+
+            fileElem.setAttribute("name"  , file.m_filename );
+            fileElem.setAttribute("bytes" , QString::number(file.m_bytes) );
+            fileElem.setAttribute("writes", QString::number(file.m_writes) );
+            fileElem.setAttribute("rate"  , QString::number(file.m_rate) );
+        }
+    }
+
     // Add Machine information
 
     QDomElement mInfo   = pDoc->createElement("MachineInfo");
@@ -473,6 +531,15 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
         group.setAttribute("free" , (int)(iAvail>>10) );
         group.setAttribute("dir"  , directory );
 
+        if (m_pExpirer && fsID != "total")
+        {
+            int id = fsID.toInt();
+            group.setAttribute("expiredesired",
+                               (int)(m_pExpirer->GetDesiredSpace(id)>>10) );
+            group.setAttribute("projected",
+                               (int)(m_pExpirer->GetProjectedSpace(id)>>10) );
+        }
+
         if (fsID == "total")
         {
             long long iLiveTV = -1;
@@ -2474,11 +2474,13 @@ void MainServer::DoDeleteThread(DeleteStruct *ds)
     QStringList nameFilters;
     nameFilters.push_back(fInfo.fileName() + "*.png");
     nameFilters.push_back(fInfo.fileName() + "*.jpg");
+    nameFilters.push_back(fInfo.fileName() + ".trickplay.json");
     nameFilters.push_back(fInfo.fileName() + ".tmp");
     nameFilters.push_back(fInfo.fileName() + ".old");
     nameFilters.push_back(fInfo.fileName() + ".map");
     nameFilters.push_back(fInfo.fileName() + ".tmp.map");
-    nameFilters.push_back(fInfo.baseName() + ".srt");  // e.g. 1234_20150213165800.srt
+    nameFilters.push_back(fInfo.fileName() + ".seek");
+    nameFilters.push_back(fInfo.baseName() + "*.srt"); // e.g. 1234_20150213165800.srt, and extracted captions
 
     QDir dir (fInfo.path());
     QFileInfoList miscFiles = dir.entryInfoList(nameFilters);
@@ -2628,6 +2630,18 @@ void MainServer::DoDeleteInDB(DeleteStruct *ds)
             QString("Error deleting recordedseek for %1.")
                 .arg(logInfo));
     }
+
+    query.prepare("DELETE FROM recordedtsstats "
+                  "WHERE recordedid = :RECORDEDID;");
+    query.bindValue(":RECORDEDID", ds->m_recordedid);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("Recorded program delete recordedtsstats", query);
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Error deleting recordedtsstats for %1.")
+                .arg(logInfo));
+    }
 }
 
 /**
@@ -23,6 +23,7 @@
 #endif
 #include "libmythbase/mythdb.h"
 #include "libmythbase/mythdirs.h"
+#include "libmythbase/mythevent.h"
 #include "libmythupnp/htmlserver.h"
 
 // MythBackend
@@ -253,11 +254,12 @@ void MediaServer::Init(bool bIsMaster, bool bDisableUPnp /* = false */)
             RegisterExtension(new UPnpCDSVideo());
         }
 
-#if 0
-        LOG(VB_UPNP, LOG_INFO, "MediaServer::Adding Context Listener");
+        if (m_pUPnpCDS != nullptr)
+        {
+            LOG(VB_UPNP, LOG_INFO, "MediaServer::Adding Context Listener");
 
-        gCoreContext->addListener( this );
-#endif
+            gCoreContext->addListener( this );
+        }
 
         Start();
 
@@ -288,9 +290,7 @@ MediaServer::~MediaServer()
 {
     // -=>TODO: Need to check to see if calling this more than once is ok.
 
-#if 0
     gCoreContext->removeListener(this);
-#endif
 
     delete m_webSocketServer;
     delete m_pHttpServer;
@@ -303,18 +303,29 @@ MediaServer::~MediaServer()
 //////////////////////////////////////////////////////////////////////////////
 //
 //////////////////////////////////////////////////////////////////////////////
-#if 0
+
 void MediaServer::customEvent( QEvent *e )
 {
-    if (MythEvent::Type(e->type()) == MythEvent::MythEventMessage)
+    if (e->type() == MythEvent::kMythEventMessage && m_pUPnpCDS != nullptr)
     {
-        MythEvent *me = static_cast<MythEvent *>(e);
-        QString message = me->Message();
+        auto *me = dynamic_cast<MythEvent *>(e);
+        if (me == nullptr)
+            return;
+        const QString& message = me->Message();
 
-        //-=>TODO: Need to handle events to notify clients of changes
+        // Drop cached browse results & bump the SystemUpdateID so
+        // clients know to re-browse
+        if (message.startsWith("RECORDING_LIST_CHANGE") ||
+            message == "VIDEO_LIST_CHANGE" ||
+            message.startsWith("MUSIC_SCANNER_FINISHED"))
+        {
+            LOG(VB_UPNP, LOG_DEBUG,
+                QString("MediaServer: Content changed (%1)").arg(message));
+            m_pUPnpCDS->ContentChanged();
+        }
     }
 }
-#endif
+
 //////////////////////////////////////////////////////////////////////////////
 //
 //////////////////////////////////////////////////////////////////////////////
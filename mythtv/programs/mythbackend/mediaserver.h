@@ -54,6 +54,9 @@ class MediaServer : public UPnp
         void     RegisterExtension  ( UPnpCDSExtension    *pExtension );
         void     UnregisterExtension( UPnpCDSExtension    *pExtension );
 
+    protected:
+        void customEvent( QEvent *e ) override; // QObject
+
 };
 
 #endif // MEDIASERVER_H
@@ -83,6 +83,7 @@ HEADERS += servicesv2/v2grabber.h servicesv2/v2freqtable.h
 HEADERS += servicesv2/v2recRule.h
 HEADERS += servicesv2/v2cutting.h servicesv2/v2cutList.h
 HEADERS += servicesv2/v2markup.h servicesv2/v2markupList.h
+HEADERS += servicesv2/v2tsPidStats.h servicesv2/v2tsStatsList.h
 HEADERS += servicesv2/v2encoder.h servicesv2/v2encoderList.h
 HEADERS += servicesv2/v2input.h servicesv2/v2inputList.h
 HEADERS += servicesv2/v2recRuleFilter.h servicesv2/v2recRuleFilterList.h
@@ -2490,6 +2490,25 @@ bool Scheduler::HandleReschedule(void)
         p->m_future = false;
     }
 
+    // Let the expirer make room for the recordings starting soon.
+    if (m_expirer)
+    {
+        upcominglist_t upcoming;
+        QDateTime horizon = MythDate::current().addSecs(3600);
+        for (auto *p : m_recList)
+        {
+            if ((p->GetRecordingStatus() == RecStatus::WillRecord ||
+                 p->GetRecordingStatus() == RecStatus::Pending) &&
+                p->GetRecordingStartTime() < horizon)
+            {
+                upcoming.emplace_back(p->GetInputID(),
+                                      p->GetRecordingStartTime(),
+                                      p->GetRecordingEndTime());
+            }
+        }
+        m_expirer->SetUpcomingRecordings(upcoming);
+    }
+
     gCoreContext->SendSystemEvent("SCHEDULER_RAN");
 
     return true;
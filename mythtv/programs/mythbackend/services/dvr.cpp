@@ -47,6 +47,7 @@
 #include "libmythtv/programdata.h"
 #include "libmythtv/recordinginfo.h"
 #include "libmythtv/recordingprofile.h"
+#include "libmythtv/seekindexfile.h"
 #include "libmythtv/tv_rec.h"
 
 // MythBackend
@@ -944,6 +945,9 @@ bool Dvr::SetRecordedMarkup (int RecordedId, const QJsonObject &jsonObj)
     }
 
     ri.SaveMarkup(mapMark, mapSeek);
+    // The seek index would still hold the seektable that was replaced
+    if (!mapSeek.isEmpty())
+        SeekIndexFile::Remove(ri.GetPlaybackURL(false, true));
 
     return true;
 }
@@ -55,6 +55,8 @@ class V2StorageGroup : public QObject
     SERVICE_PROPERTY2(int, Expirable)
     SERVICE_PROPERTY2(int, LiveTV)
     SERVICE_PROPERTY2(QString, Directory)
+    SERVICE_PROPERTY2(int, ExpireDesired)
+    SERVICE_PROPERTY2(int, Projected)
     public:
         Q_INVOKABLE V2StorageGroup(QObject *parent = nullptr)
             : QObject( parent )
@@ -136,6 +138,105 @@ class V2Job : public QObject
 Q_DECLARE_METATYPE(V2Job*)
 
 
+class V2TuningBucket : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "Version", "1.0" );
+
+    SERVICE_PROPERTY2( int, UpToMs )   // 0 for the last, unlimited, bucket
+    SERVICE_PROPERTY2( int, Count  )
+
+    public:
+        Q_INVOKABLE V2TuningBucket(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+    private:
+        Q_DISABLE_COPY(V2TuningBucket);
+};
+Q_DECLARE_METATYPE(V2TuningBucket*)
+
+class V2TuningPhase : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "Version", "1.0" );
+    Q_CLASSINFO( "Buckets", "type=V2TuningBucket");
+
+    SERVICE_PROPERTY2( QString     , Name      )
+    SERVICE_PROPERTY2( bool        , Span      )
+    SERVICE_PROPERTY2( int         , Count     )
+    SERVICE_PROPERTY2( int         , AverageMs )
+    SERVICE_PROPERTY2( int         , MaxMs     )
+    SERVICE_PROPERTY2( QVariantList, Buckets   )
+
+    public:
+        Q_INVOKABLE V2TuningPhase(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+        V2TuningBucket *AddNewBucket()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+            auto *pObject = new V2TuningBucket( this );
+            m_Buckets.append( QVariant::fromValue<QObject *>( pObject ));
+            return pObject;
+        }
+    private:
+        Q_DISABLE_COPY(V2TuningPhase);
+};
+Q_DECLARE_METATYPE(V2TuningPhase*)
+
+class V2WriterFile : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "Version", "1.0" );
+
+    SERVICE_PROPERTY2( QString  , Name   )
+    SERVICE_PROPERTY2( quint64  , Bytes  )
+    SERVICE_PROPERTY2( quint64  , Writes )
+    SERVICE_PROPERTY2( quint64  , Rate   )   // bytes per second
+
+    public:
+        Q_INVOKABLE V2WriterFile(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+    private:
+        Q_DISABLE_COPY(V2WriterFile);
+};
+Q_DECLARE_METATYPE(V2WriterFile*)
+
+class V2WriterGroup : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "Version", "1.0" );
+    Q_CLASSINFO( "Files", "type=V2WriterFile");
+
+    SERVICE_PROPERTY2( QString     , Name   )
+    SERVICE_PROPERTY2( quint64     , Bytes  )
+    SERVICE_PROPERTY2( quint64     , Writes )
+    SERVICE_PROPERTY2( quint64     , Rate   )   // bytes per second
+    SERVICE_PROPERTY2( QVariantList, Files  )
+
+    public:
+        Q_INVOKABLE V2WriterGroup(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+        V2WriterFile *AddNewFile()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+            auto *pObject = new V2WriterFile( this );
+            m_Files.append( QVariant::fromValue<QObject *>( pObject ));
+            return pObject;
+        }
+    private:
+        Q_DISABLE_COPY(V2WriterGroup);
+};
+Q_DECLARE_METATYPE(V2WriterGroup*)
+
 class V2BackendStatus : public QObject
 {
     Q_OBJECT
@@ -146,6 +247,8 @@ class V2BackendStatus : public QObject
     Q_CLASSINFO( "Frontends", "type=V2Frontend")
     Q_CLASSINFO( "Backends", "type=V2Backend")
     Q_CLASSINFO( "JobQueue", "type=V2Job")
+    Q_CLASSINFO( "TuningPhases", "type=V2TuningPhase")
+    Q_CLASSINFO( "WriterGroups", "type=V2WriterGroup")
     Q_CLASSINFO( "AsOf"    , "transient=true"   )
 
     SERVICE_PROPERTY2( QDateTime   , AsOf            )
@@ -156,6 +259,8 @@ class V2BackendStatus : public QObject
     SERVICE_PROPERTY2( QVariantList, Frontends )
     SERVICE_PROPERTY2( QVariantList, Backends  )
     SERVICE_PROPERTY2( QVariantList, JobQueue      )
+    SERVICE_PROPERTY2( QVariantList, TuningPhases  )
+    SERVICE_PROPERTY2( QVariantList, WriterGroups  )
     Q_PROPERTY( QObject*  MachineInfo    READ MachineInfo     USER true)
     SERVICE_PROPERTY_PTR(V2MachineInfo, MachineInfo     )
     SERVICE_PROPERTY2( QString     , Miscellaneous        )
@@ -191,6 +296,24 @@ class V2BackendStatus : public QObject
             return pObject;
         }
 
+        V2TuningPhase *AddNewTuningPhase()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+            auto *pObject = new V2TuningPhase( this );
+            m_TuningPhases.append( QVariant::fromValue<QObject *>( pObject ));
+            return pObject;
+        }
+
+        V2WriterGroup *AddNewWriterGroup()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+            auto *pObject = new V2WriterGroup( this );
+            m_WriterGroups.append( QVariant::fromValue<QObject *>( pObject ));
+            return pObject;
+        }
+
 
     private:
         Q_DISABLE_COPY(V2BackendStatus);
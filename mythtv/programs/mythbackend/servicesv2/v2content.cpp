@@ -46,6 +46,7 @@
 #include "libmythprotoserver/requesthandler/fileserverutil.h"
 #include "libmythtv/metadataimagehelper.h"
 #include "libmythtv/previewgenerator.h"
+#include "libmythtv/trickplaygenerator.h"
 
 // MythBackend
 #include "v2content.h"
@@ -684,6 +685,110 @@ QFileInfo V2Content::GetPreviewImage(        int        nRecordedId,
 //
 /////////////////////////////////////////////////////////////////////////////
 
+static ProgramInfo GetTrickPlayRecording(int nRecordedId, int nChanId,
+                                         const QDateTime &StartTime,
+                                         const QString &sMethod)
+{
+    if ((nRecordedId <= 0) &&
+        (nChanId <= 0 || !StartTime.isValid()))
+        throw QString("Recorded ID or Channel ID and StartTime appears invalid.");
+
+    ProgramInfo pginfo;
+    if (nRecordedId > 0)
+        pginfo = ProgramInfo(nRecordedId);
+    else
+        pginfo = ProgramInfo(nChanId, StartTime.toUTC());
+
+    if (!pginfo.GetChanID())
+    {
+        LOG(VB_GENERAL, LOG_ERR, QString("%1: No recording for '%2'")
+            .arg(sMethod).arg(nRecordedId));
+        return {};
+    }
+
+    if (pginfo.GetHostname().toLower() != gCoreContext->GetHostName().toLower()
+            &&  ! gCoreContext->GetBoolSetting("MasterBackendOverride", false))
+    {
+        QString sMsg =
+            QString("%1: Wrong Host '%2' request from '%3'")
+                          .arg( sMethod, gCoreContext->GetHostName(),
+                                pginfo.GetHostname() );
+
+        LOG(VB_UPNP, LOG_ERR, sMsg);
+
+        throw V2HttpRedirectException( pginfo.GetHostname() );
+    }
+
+    QString sFileName = GetPlaybackURL(&pginfo);
+    if (!pginfo.IsLocal() && sFileName.startsWith("/"))
+        pginfo.SetPathname(sFileName);
+
+    return pginfo;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Returns the JSON index of the recording's trick-play thumbnails. When
+// there is none yet, building one is started and nothing is returned, so
+// clients should ask again later.
+/////////////////////////////////////////////////////////////////////////////
+
+QFileInfo V2Content::GetTrickPlayIndex( int              nRecordedId,
+                                        int              nChanId,
+                                        const QDateTime &StartTime )
+{
+    ProgramInfo pginfo = GetTrickPlayRecording(nRecordedId, nChanId, StartTime,
+                                               "GetTrickPlayIndex");
+    if (!pginfo.GetChanID() || !pginfo.IsLocal())
+        return {};
+
+    QString sIndexFileName =
+        TrickPlayGenerator::IndexFilename(pginfo.GetPathname());
+
+    if (QFile::exists( sIndexFileName ))
+        return QFileInfo( sIndexFileName );
+
+    if (pginfo.GetRecordingStatus() == RecStatus::Recording)
+        return {};
+
+    TrickPlayGenerator::Queue(pginfo);
+
+    return {};
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+QFileInfo V2Content::GetTrickPlaySheet( int              nRecordedId,
+                                        int              nChanId,
+                                        const QDateTime &StartTime,
+                                        int              nSheet )
+{
+    if (nSheet < 0)
+        throw QString("GetTrickPlaySheet: Sheet appears invalid.");
+
+    ProgramInfo pginfo = GetTrickPlayRecording(nRecordedId, nChanId, StartTime,
+                                               "GetTrickPlaySheet");
+    if (!pginfo.GetChanID() || !pginfo.IsLocal())
+        return {};
+
+    // Sheets are only complete once the index has been written
+    if (!QFile::exists(TrickPlayGenerator::IndexFilename(pginfo.GetPathname())))
+        return {};
+
+    QString sSheetFileName =
+        TrickPlayGenerator::SheetFilename(pginfo.GetPathname(), nSheet);
+
+    if (!QFile::exists( sSheetFileName ))
+        return {};
+
+    return QFileInfo( sSheetFileName );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 QFileInfo V2Content::GetRecording( int              nRecordedId,
                                  int              nChanId,
                                  const QDateTime &StartTime,
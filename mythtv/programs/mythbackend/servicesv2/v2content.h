@@ -93,6 +93,15 @@ class V2Content : public MythHTTPService
                                                   int              SecsIn,
                                                   const QString   &Format);
 
+        static QFileInfo    GetTrickPlayIndex   ( int              RecordedId,
+                                                  int              ChanId,
+                                                  const QDateTime &StartTime );
+
+        static QFileInfo    GetTrickPlaySheet   ( int              RecordedId,
+                                                  int              ChanId,
+                                                  const QDateTime &StartTime,
+                                                  int              Sheet );
+
         QFileInfo    GetRecording               ( int              RecordedId,
                                                   int              ChanId,
                                                   const QDateTime &StartTime,
@@ -39,6 +39,7 @@
 #include "libmythtv/jobqueue.h"
 #include "libmythtv/playgroup.h"
 #include "libmythtv/programdata.h"
+#include "libmythtv/seekindexfile.h"
 #include "libmythtv/tv_rec.h"
 
 // MythBackend
@@ -62,6 +63,8 @@ void V2Dvr::RegisterCustomTypes()
     qRegisterMetaType<V2Cutting*>("V2Cutting");
     qRegisterMetaType<V2MarkupList*>("V2MarkupList");
     qRegisterMetaType<V2Markup*>("V2Markup");
+    qRegisterMetaType<V2TSStatsList*>("V2TSStatsList");
+    qRegisterMetaType<V2TSPidStats*>("V2TSPidStats");
     qRegisterMetaType<V2EncoderList*>("V2EncoderList");
     qRegisterMetaType<V2Encoder*>("V2Encoder");
     qRegisterMetaType<V2InputList*>("V2InputList");
@@ -1053,6 +1056,23 @@ V2CutList* V2Dvr::GetRecordedSeek ( int RecordedId,
 //
 /////////////////////////////////////////////////////////////////////////////
 
+V2TSStatsList* V2Dvr::GetRecordedTSStats ( int RecordedId )
+{
+    RecordingInfo ri;
+    ri = RecordingInfo(RecordedId);
+
+    if (!ri.HasPathname())
+        throw QString("Invalid RecordedId %1").arg(RecordedId);
+
+    auto *pList = new V2TSStatsList();
+    V2FillTSStats(pList, TSStats::LoadSummary(RecordedId));
+    return pList;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 V2MarkupList* V2Dvr::GetRecordedMarkup ( int RecordedId )
 {
     RecordingInfo ri;
@@ -1148,6 +1168,9 @@ bool V2Dvr::SetRecordedMarkup(int RecordedId, const QString &MarkupList)
     }
 
     ri.SaveMarkup(mapMark, mapSeek);
+    // The seek index would still hold the seektable that was replaced
+    if (!mapSeek.isEmpty())
+        SeekIndexFile::Remove(ri.GetPlaybackURL(false, true));
 
     return true;
 }
@@ -1167,6 +1190,26 @@ V2EncoderList* V2Dvr::GetEncoderList()
 //
 /////////////////////////////////////////////////////////////////////////////
 
+V2TSStatsList* V2Dvr::GetEncoderTSStats( int RecorderId )
+{
+    TSStats::PIDStatsList stats;
+    {
+        QReadLocker tvlocker(&TVRec::s_inputsLock);
+        TVRec *tvrec = TVRec::GetTVRec(RecorderId);
+        if (tvrec == nullptr)
+            throw QString("Invalid RecorderId %1 or recorder not local").arg(RecorderId);
+        stats = tvrec->GetTSStatistics();
+    }
+
+    auto *pList = new V2TSStatsList();
+    V2FillTSStats(pList, stats);
+    return pList;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 V2InputList* V2Dvr::GetInputList()
 {
     auto *pList = new V2InputList();
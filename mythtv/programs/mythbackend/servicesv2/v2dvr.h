@@ -30,6 +30,7 @@
 #include "v2programList.h"
 #include "v2cutList.h"
 #include "v2markupList.h"
+#include "v2tsStatsList.h"
 #include "v2encoderList.h"
 #include "v2inputList.h"
 #include "v2recRuleFilterList.h"
@@ -42,7 +43,7 @@
 class V2Dvr : public MythHTTPService
 {
     Q_OBJECT
-    Q_CLASSINFO("Version",      "7.1")
+    Q_CLASSINFO("Version",      "7.2")
     Q_CLASSINFO("AddRecordedCredits",  "methods=POST;name=bool")
     Q_CLASSINFO("AddRecordedProgram",  "methods=POST;name=int")
     Q_CLASSINFO("RemoveRecorded",      "methods=POST;name=bool")
@@ -197,6 +198,8 @@ class V2Dvr : public MythHTTPService
     static bool    SetRecordedMarkup      ( int              RecordedId,
                                             const QString   &MarkupList);
 
+    static V2TSStatsList* GetRecordedTSStats( int            RecordedId );
+
     static V2ProgramList* GetConflictList ( int              StartIndex,
                                             int              Count,
                                             int              RecordId,
@@ -211,6 +214,8 @@ class V2Dvr : public MythHTTPService
 
     static V2EncoderList*    GetEncoderList      ( );
 
+    static V2TSStatsList*    GetEncoderTSStats   ( int              RecorderId );
+
     static V2InputList*      GetInputList        ( );
 
     static QStringList       GetRecGroupList     ( );
@@ -722,6 +722,29 @@ void V2FillSeek(V2CutList* pCutList, RecordingInfo* rInfo, MarkTypes marktype)
     }
 }
 
+void V2FillTSStats(V2TSStatsList* pList, const TSStats::PIDStatsList &stats)
+{
+    for (const auto & pid : stats)
+    {
+        V2TSPidStats *pStats = pList->AddNewPid();
+        pStats->setPid           ( pid.m_pid                  );
+        pStats->setPackets       ( pid.m_packets              );
+        pStats->setBitrate       ( pid.m_bitrate              );
+        pStats->setAvgBitrate    ( pid.m_avgBitrate           );
+        pStats->setCCErrors      ( pid.m_ccErrors             );
+        pStats->setTEIErrors     ( pid.m_teiErrors            );
+        pStats->setScrambled     ( pid.m_scrambled            );
+        pStats->setScrambledRatio( pid.ScrambledRatio()       );
+        pStats->setPCRCount      ( pid.m_pcrCount             );
+        pStats->setPCRJitterAvg  ( pid.m_pcrJitterAvg.count() );
+        pStats->setPCRJitterMax  ( pid.m_pcrJitterMax.count() );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 void FillEncoderList(QVariantList &list, QObject* parent)
 {
     QReadLocker tvlocker(&TVRec::s_inputsLock);
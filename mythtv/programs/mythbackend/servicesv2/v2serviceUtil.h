@@ -10,6 +10,7 @@
 #include "libmythtv/channelgroup.h"
 #include "libmythtv/channelinfo.h"
 #include "libmythtv/inputinfo.h"
+#include "libmythtv/mpeg/tsstats.h"
 #include "libmythtv/programdata.h"
 #include "libmythtv/recordinginfo.h"
 #include "libmythtv/recordingrule.h"
@@ -21,6 +22,7 @@
 #include "v2musicMetadataInfoList.h"
 #include "v2programList.h"
 #include "v2recRule.h"
+#include "v2tsStatsList.h"
 #include "v2videoMetadataInfo.h"
 #include "v2captureCardList.h"
 
@@ -84,6 +86,8 @@ void V2FillSeek(V2CutList* pCutList, RecordingInfo* rInfo, MarkTypes marktype);
 
 void V2FillInputInfo( V2Input *input, const InputInfo& inputInfo);
 
+void V2FillTSStats( V2TSStatsList *pList, const TSStats::PIDStatsList &stats);
+
 int V2CreateRecordingGroup(const QString& groupName);
 
 void FillEncoderList(QVariantList& list, QObject* parent);
@@ -34,6 +34,7 @@
 #include "libmythbase/mythmiscutil.h"
 #include "libmythbase/mythsystemlegacy.h"
 #include "libmythbase/mythversion.h"
+#include "libmythbase/threadedfilewriter.h"
 #include "libmythtv/cardutil.h"
 #include "libmythtv/jobqueue.h"
 #include "libmythtv/tv.h"
@@ -72,6 +73,10 @@ void V2Status::RegisterCustomTypes()
     qRegisterMetaType<V2CastMember*>("V2CastMember");
     qRegisterMetaType<V2Input*>("V2Input");
     qRegisterMetaType<V2Backend*>("V2Backend");
+    qRegisterMetaType<V2TuningPhase*>("V2TuningPhase");
+    qRegisterMetaType<V2TuningBucket*>("V2TuningBucket");
+    qRegisterMetaType<V2WriterGroup*>("V2WriterGroup");
+    qRegisterMetaType<V2WriterFile*>("V2WriterFile");
 }
 
 V2Status::V2Status () : MythHTTPService(s_service),
@@ -241,6 +246,43 @@ V2BackendStatus*  V2Status::GetBackendStatus()
         V2FillProgramInfo( pProgram, &pginfo, true, false, false);
     }
 
+    // Tuning phase timing of this backend's inputs
+    for (const auto & stats : TuningTrace::GetStats())
+    {
+        V2TuningPhase *pPhase = pStatus->AddNewTuningPhase();
+        pPhase->setName(stats.m_name);
+        pPhase->setSpan(stats.m_span);
+        pPhase->setCount(static_cast<int>(stats.m_count));
+        pPhase->setAverageMs(stats.m_count ?
+            static_cast<int>(stats.m_total.count() / stats.m_count) : 0);
+        pPhase->setMaxMs(static_cast<int>(stats.m_max.count()));
+        for (size_t i = 0; i < stats.m_buckets.size(); ++i)
+        {
+            V2TuningBucket *pBucket = pPhase->AddNewBucket();
+            pBucket->setUpToMs((i < TuningTrace::kBucketLimits.size()) ?
+                static_cast<int>(TuningTrace::kBucketLimits[i].count()) : 0);
+            pBucket->setCount(static_cast<int>(stats.m_buckets[i]));
+        }
+    }
+
+    // Shared writers of the stream handlers
+    for (const auto & stats : TFWGroup::GetAllStats())
+    {
+        V2WriterGroup *pGroup = pStatus->AddNewWriterGroup();
+        pGroup->setName(stats.m_total.m_filename);
+        pGroup->setBytes(stats.m_total.m_bytes);
+        pGroup->setWrites(stats.m_total.m_writes);
+        pGroup->setRate(stats.m_total.m_rate);
+        for (const auto & file : stats.m_files)
+        {
+            V2WriterFile *pFile = pGroup->AddNewFile();
+            pFile->setName(file.m_filename);
+            pFile->setBytes(file.m_bytes);
+            pFile->setWrites(file.m_writes);
+            pFile->setRate(file.m_rate);
+        }
+    }
+
     // Machine Info
     V2MachineInfo *pMachineInfo = pStatus->MachineInfo();
     FillDriveSpace(pMachineInfo);
@@ -334,6 +376,13 @@ void V2Status::FillDriveSpace(V2MachineInfo* pMachineInfo)
         group->setFree((int)(iAvail>>10));
         group->setDirectory(directory);
 
+        if (gExpirer && fsID != "total")
+        {
+            int id = fsID.toInt();
+            group->setExpireDesired((int)(gExpirer->GetDesiredSpace(id)>>10));
+            group->setProjected((int)(gExpirer->GetProjectedSpace(id)>>10));
+        }
+
         if (fsID == "total")
         {
             long long iLiveTV = -1;
@@ -613,6 +662,63 @@ void V2Status::FillStatusXML( QDomDocument *pDoc )
 
     queue.setAttribute( "count", jobs.size() );
 
+    // Add how long the tuning phases of this backend's inputs took
+
+    QDomElement tuning = pDoc->createElement("TuningTrace");
+    root.appendChild(tuning);
+
+    for (const auto & stats : TuningTrace::GetStats())
+    {
+        QDomElement phase = pDoc->createElement("Phase");
+        tuning.appendChild(phase);
+
+        phase.setAttribute("name" , stats.m_name );
+        phase.setAttribute("span" , stats.m_span ? 1 : 0 );
+        phase.setAttribute("count", stats.m_count );
+        phase.setAttribute("avgms", stats.m_count ?
+                           static_cast<int>(stats.m_total.count() / stats.m_count) : 0 );
+        phase.setAttribute("maxms", static_cast<int>(stats.m_max.count()) );
+
+        for (size_t i = 0; i < stats.m_buckets.size(); ++i)
+        {
+            QDomElement bucket = pDoc->createElement("Bucket");
+            phase.appendChild(bucket);
+
+            // The last bucket has no upper limit
+            int upto = (i < TuningTrace::kBucketLimits.size()) ?
+                static_cast<int>(TuningTrace::kBucketLimits[i].count()) : 0;
+            bucket.setAttribute("uptoms", upto );
+            bucket.setAttribute("count" , stats.m_buckets[i] );
+        }
+    }
+
+    // Add what the shared writers of the stream handlers have written
+
+    QDomElement writers = pDoc->createElement("WriterGroups");
+    root.appendChild(writers);
+
+    for (const auto & stats : TFWGroup::GetAllStats())
+    {
+        QDomElement group = pDoc->createElement("Group");
+        writers.appendChild(group);
+
+        group.setAttribute("name"  , stats.m_total.m_filename );
+        group.setAttribute("bytes" , QString::number(stats.m_total.m_bytes) );
+        group.setAttribute("writes", QString::number(stats.m_total.m_writes) );
+        group.setAttribute("rate"  , QString::number(stats.m_total.m_rate) );
+
+        for (const auto & file : stats.m_files)
+        {
+            QDomElement fileElem = pDoc->createElement("File");
+            group.appendChild(fileElem);
+
+            fileElem.setAttribute("name"  , file.m_filename );
+            fileElem.setAttribute("bytes" , QString::number(file.m_bytes) );
+            fileElem.setAttribute("writes", QString::number(file.m_writes) );
+            fileElem.setAttribute("rate"  , QString::number(file.m_rate) );
+        }
+    }
+
     // Add Machine information
 
     QDomElement mInfo   = pDoc->createElement("MachineInfo");
@@ -665,6 +771,15 @@ void V2Status::FillStatusXML( QDomDocument *pDoc )
         group.setAttribute("free" , (int)(iAvail>>10) );
         group.setAttribute("dir"  , directory );
 
+        if (gExpirer && fsID != "total")
+        {
+            int id = fsID.toInt();
+            group.setAttribute("expiredesired",
+                               (int)(gExpirer->GetDesiredSpace(id)>>10) );
+            group.setAttribute("projected",
+                               (int)(gExpirer->GetProjectedSpace(id)>>10) );
+        }
+
         if (fsID == "total")
         {
             long long iLiveTV = -1;
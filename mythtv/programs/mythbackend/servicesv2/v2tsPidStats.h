@@ -0,0 +1,65 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: tsPidStats.h
+// Created     : Oct. 19, 2026
+//
+// Copyright (c) 2026 team MythTV
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef V2TSPIDSTATS_H_
+#define V2TSPIDSTATS_H_
+
+#include <QString>
+
+#include "libmythbase/http/mythhttpservice.h"
+
+/////////////////////////////////////////////////////////////////////////////
+
+class V2TSPidStats : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "Version"    , "1.0" );
+
+    SERVICE_PROPERTY2( uint      , Pid            )
+    SERVICE_PROPERTY2( quint64   , Packets        )
+    SERVICE_PROPERTY2( quint64   , Bitrate        )
+    SERVICE_PROPERTY2( quint64   , AvgBitrate     )
+    SERVICE_PROPERTY2( quint64   , CCErrors       )
+    SERVICE_PROPERTY2( quint64   , TEIErrors      )
+    SERVICE_PROPERTY2( quint64   , Scrambled      )
+    SERVICE_PROPERTY2( double    , ScrambledRatio )
+    SERVICE_PROPERTY2( quint64   , PCRCount       )
+    SERVICE_PROPERTY2( qint64    , PCRJitterAvg   )
+    SERVICE_PROPERTY2( qint64    , PCRJitterMax   )
+
+    public:
+
+        Q_INVOKABLE V2TSPidStats(QObject *parent = nullptr)
+            : QObject(parent)
+        {
+        }
+
+        void Copy( const V2TSPidStats *src )
+        {
+            m_Pid            = src->m_Pid            ;
+            m_Packets        = src->m_Packets        ;
+            m_Bitrate        = src->m_Bitrate        ;
+            m_AvgBitrate     = src->m_AvgBitrate     ;
+            m_CCErrors       = src->m_CCErrors       ;
+            m_TEIErrors      = src->m_TEIErrors      ;
+            m_Scrambled      = src->m_Scrambled      ;
+            m_ScrambledRatio = src->m_ScrambledRatio ;
+            m_PCRCount       = src->m_PCRCount       ;
+            m_PCRJitterAvg   = src->m_PCRJitterAvg   ;
+            m_PCRJitterMax   = src->m_PCRJitterMax   ;
+        }
+
+    private:
+        Q_DISABLE_COPY(V2TSPidStats);
+};
+
+Q_DECLARE_METATYPE(V2TSPidStats*)
+
+#endif
@@ -0,0 +1,61 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: tsStatsList.h
+// Created     : Oct. 19, 2026
+//
+// Copyright (c) 2026 team MythTV
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef V2TSSTATSLIST_H_
+#define V2TSSTATSLIST_H_
+
+#include <QVariantList>
+
+#include "libmythbase/http/mythhttpservice.h"
+
+#include "v2tsPidStats.h"
+
+class V2TSStatsList : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "Version", "1.0" );
+
+    // Q_CLASSINFO Used to augment Metadata for properties.
+    // See datacontracthelper.h for details
+
+    Q_CLASSINFO( "Pids", "type=V2TSPidStats");
+
+    SERVICE_PROPERTY2( QVariantList, Pids );
+
+    public:
+
+        Q_INVOKABLE V2TSStatsList(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+
+        void Copy( const V2TSStatsList *src )
+        {
+            CopyListContents< V2TSPidStats >( this, m_Pids, src->m_Pids );
+        }
+
+        V2TSPidStats *AddNewPid()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+
+            auto *pObject = new V2TSPidStats( this );
+            m_Pids.append( QVariant::fromValue<QObject *>( pObject ));
+
+            return pObject;
+        }
+
+    private:
+        Q_DISABLE_COPY(V2TSStatsList);
+};
+
+Q_DECLARE_METATYPE(V2TSStatsList*)
+
+#endif
@@ -68,6 +68,7 @@ namespace
 int  quiet = 0;
 bool progress = true;
 bool force = false;
+bool extractCaptions = false;
 
 MythCommFlagCommandLineParser cmdline;
 
@@ -430,6 +431,7 @@ static int DoFlagCommercials(
     if (result)
     {
         cfp->SaveTotalDuration();
+        cfp->FinishCaptions();
 
         frm_dir_map_t commBreakList;
         commDetector->GetCommercialBreakList(commBreakList);
@@ -751,6 +753,9 @@ static int FlagCommercials(ProgramInfo *program_info, int jobid,
     ctx->SetRingBuffer(tmprbuf);
     ctx->SetPlayer(cfp);
 
+    if (extractCaptions && filename.startsWith("/"))
+        cfp->ExtractCaptions(filename);
+
     if (useDB)
     {
         if (program_info->GetRecordingEndTime() > MythDate::current())
@@ -1006,6 +1011,8 @@ int main(int argc, char *argv[])
             outputMethod = outputTypes->value(om);
     }
 
+    extractCaptions = cmdline.toBool("captions");
+
     if (cmdline.toBool("chanid") && cmdline.toBool("starttime"))
     {
         // operate on a recording in the database
@@ -67,6 +67,11 @@ void MythCommFlagCommandLineParser::LoadArguments(void)
         "off, blank, scene, blankscene, logo, all, "
         "d2, d2_logo, d2_blank, d2_scene, d2_all", "")
             ->SetGroup("Commflagging");
+    add("--captions", "captions", false,
+        "Also extract closed captions and subtitles to files next to "
+        "the recording, in the same pass over the video.", "")
+            ->SetGroup("Commflagging")
+            ->SetBlocks("rebuild");
     add("--outputmethod", "outputmethod", "",
         "Format of output written to outputfile, essentials, full.", "")
             ->SetGroup("Commflagging");
@@ -140,6 +140,7 @@ AudioConfigSettings::AudioConfigSettings()
     addChild((m_maxAudioChannels = MaxAudioChannels()));
     addChild((m_audioUpmix = AudioUpmix()));
     addChild((m_audioUpmixType = AudioUpmixType()));
+    addChild((m_audioUpmixLowLatency = AudioUpmixLowLatency()));
     addChild(MythControlsVolume());
 
     //Advanced Settings
@@ -266,12 +267,14 @@ void AudioConfigSettings::AudioRescan()
 
 void AudioConfigSettings::UpdateVisibility(StandardSetting * /*setting*/)
 {
-    if (!m_maxAudioChannels || !m_audioUpmix || !m_audioUpmixType)
+    if (!m_maxAudioChannels || !m_audioUpmix || !m_audioUpmixType ||
+        !m_audioUpmixLowLatency)
         return;
 
     int cur_speakers = m_maxAudioChannels->getValue().toInt();
     m_audioUpmix->setEnabled(cur_speakers > 2);
     m_audioUpmixType->setEnabled(cur_speakers > 2);
+    m_audioUpmixLowLatency->setEnabled(cur_speakers > 2);
 }
 
 AudioOutputSettings AudioConfigSettings::UpdateCapabilities(
@@ -481,6 +484,21 @@ HostComboBoxSetting *AudioConfigSettings::AudioUpmixType()
     return gc;
 }
 
+HostCheckBoxSetting *AudioConfigSettings::AudioUpmixLowLatency()
+{
+    auto *gc = new HostCheckBoxSetting("AudioUpmixLowLatency");
+
+    gc->setLabel(tr("Low latency upmixing"));
+
+    gc->setValue(false);
+
+    gc->setHelpText(tr("If enabled, the Good and Best upconversions work "
+                       "on blocks of half the usual size. This halves the "
+                       "delay they add to the audio, at the cost of a "
+                       "less precise placement of low frequencies."));
+    return gc;
+}
+
 HostCheckBoxSetting *AudioConfigSettings::AC3PassThrough()
 {
     auto *gc = new HostCheckBoxSetting("AC3PassThru");
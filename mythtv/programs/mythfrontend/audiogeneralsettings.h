@@ -65,6 +65,7 @@ class AudioConfigSettings : public GroupSetting
     static HostComboBoxSetting *MaxAudioChannels();
     static HostCheckBoxSetting *AudioUpmix();
     static HostComboBoxSetting *AudioUpmixType();
+    static HostCheckBoxSetting *AudioUpmixLowLatency();
     static HostCheckBoxSetting *AC3PassThrough();
     static HostCheckBoxSetting *DTSPassThrough();
     static HostCheckBoxSetting *EAC3PassThrough();
@@ -92,6 +93,7 @@ class AudioConfigSettings : public GroupSetting
     HostComboBoxSetting *m_maxAudioChannels          {nullptr};
     HostCheckBoxSetting *m_audioUpmix                {nullptr};
     HostComboBoxSetting *m_audioUpmixType            {nullptr};
+    HostCheckBoxSetting *m_audioUpmixLowLatency      {nullptr};
 
     // digital settings
     GroupSetting        *m_triggerDigital            {nullptr};
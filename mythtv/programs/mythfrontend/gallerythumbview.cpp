@@ -464,10 +464,11 @@ void GalleryThumbView::customEvent(QEvent *event)
             // Refresh display
             LoadData(m_view->GetParentId());
         }
-        else if (token[0] == "IMAGE_SCAN_STATUS" && extra.size() == 3)
+        else if (token[0] == "IMAGE_SCAN_STATUS" && extra.size() >= 3)
         {
-            // Expects scanner id, scanned#, total#
-            UpdateScanProgress(extra[0], extra[1].toInt(), extra[2].toInt());
+            // Expects scanner id, scanned#, total#, optional throughput
+            UpdateScanProgress(extra[0], extra[1].toInt(), extra[2].toInt(),
+                               extra.value(3).toInt());
         }
     }
     else if (event->type() == DialogCompletionEvent::kEventType)
@@ -606,11 +607,12 @@ void GalleryThumbView::RemoveImages(const QStringList &ids, bool deleted)
 void GalleryThumbView::Start()
 {
     // Detect any running BE scans
-    // Expects OK, scanner id, current#, total#
+    // Expects OK, scanner id, current#, total#, optional throughput
     QStringList message = ImageManagerFe::ScanQuery();
-    if (message.size() == 4 && message[0] == "OK")
+    if (message.size() >= 4 && message[0] == "OK")
     {
-        UpdateScanProgress(message[1], message[2].toInt(), message[3].toInt());
+        UpdateScanProgress(message[1], message[2].toInt(), message[3].toInt(),
+                           message.value(4).toInt());
     }
 
     // Only receive events after device/scan status has been established
@@ -874,10 +876,11 @@ void GalleryThumbView::UpdateThumbnail(MythUIButtonListItem *button,
  \param total Total number of images to scan
 */
 void GalleryThumbView::UpdateScanProgress(const QString &scanner,
-                                          int current, int total)
+                                          int current, int total, int rate)
 {
     // Scan update
     m_scanProgress.insert(scanner, qMakePair(current, total));
+    m_scanRate.insert(scanner, rate);
 
     // Detect end of this scan
     if (current >= total)
@@ -903,6 +906,7 @@ void GalleryThumbView::UpdateScanProgress(const QString &scanner,
             }
 
             m_scanProgress.clear();
+            m_scanRate.clear();
 
             return;
         }
@@ -946,8 +950,18 @@ void GalleryThumbView::UpdateScanProgress(const QString &scanner,
         m_scanProgressBar->SetUsed(currentAgg);
         m_scanProgressBar->SetTotal(totalAgg);
     }
+    int rateAgg = 0;
+    for (int rate : std::as_const(m_scanRate))
+        rateAgg += rate;
+
     if (m_scanProgressText)
-        m_scanProgressText->SetText(tr("%L1 of %L3").arg(currentAgg).arg(totalAgg));
+    {
+        if (rateAgg > 0)
+            m_scanProgressText->SetText(tr("%L1 of %L2 (%L3 per second)")
+                                        .arg(currentAgg).arg(totalAgg).arg(rateAgg));
+        else
+            m_scanProgressText->SetText(tr("%L1 of %L3").arg(currentAgg).arg(totalAgg));
+    }
 }
 
 
@@ -44,7 +44,8 @@ private:
     void    TransformItem(ImageFileTransform tran = kRotateCW);
     void    TransformMarked(ImageFileTransform tran = kRotateCW);
     void    UpdateImageItem(MythUIButtonListItem *item);
-    void    UpdateScanProgress(const QString &scanner, int current, int total);
+    void    UpdateScanProgress(const QString &scanner, int current, int total,
+                               int rate = 0);
     void    StartSlideshow(ImageSlideShowType mode);
     void    SelectZoomWidget(int change);
     QString CheckThumbnail(MythUIButtonListItem *item, const ImagePtrK &im,
@@ -148,6 +149,8 @@ private:
 
     //! Last scan updates received from scanners
     QHash<QString, IntPair> m_scanProgress;
+    //! Images scanned per second, by scanner
+    QHash<QString, int>     m_scanRate;
     //! Scanners currently scanning
     QSet<QString>          m_scanActive;
 
@@ -2716,6 +2716,21 @@ static HostSpinBoxSetting *GUIFontZoom()
     return gs;
 }
 
+static HostSpinBoxSetting *UIImageCacheSize()
+{
+    auto *gs = new HostSpinBoxSetting("UIImageCacheSize", 10, 1024, 10, 10);
+
+    gs->setLabel(AppearanceSettings::tr("GUI image cache size (MB)"));
+
+    gs->setValue(30);
+
+    gs->setHelpText(AppearanceSettings::tr
+                    ("Amount of memory used to keep decoded theme and "
+                     "artwork images. Increase this for high resolution "
+                     "themes with large artwork. mythfrontend needs restart "
+                     "for this to take effect."));
+    return gs;
+}
 
 static HostComboBoxSetting *MythDateFormatCB()
 {
@@ -4799,6 +4814,7 @@ AppearanceSettings::AppearanceSettings()
     screen->addChild(SmoothTransitions());
     screen->addChild(StartupScreenDelay());
     screen->addChild(GUIFontZoom());
+    screen->addChild(UIImageCacheSize());
 #ifdef USING_AIRPLAY
     screen->addChild(AirPlayFullScreen());
 #endif
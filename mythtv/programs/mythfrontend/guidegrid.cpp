@@ -60,6 +60,13 @@ static constexpr int64_t kFiveMinutes   {       5LL * 60 };
 static constexpr int64_t kThirtyMinutes {      30LL * 60 };
 static constexpr int64_t kEightHours    {  8 * 60LL * 60 };
 static constexpr int64_t kOneDay        { 24 * 60LL * 60 };
+// Listings are cached from this far before the displayed window to this
+// far after it, so that moving through time is served from memory too.
+static constexpr int64_t kCacheBehind   {  1 * 60LL * 60 };
+static constexpr int64_t kCacheAhead    {  6 * 60LL * 60 };
+// Cached listings older than this are reloaded even without a schedule change
+static constexpr int64_t kCacheMaxAge   {      15LL * 60 };
+static constexpr int     kCacheMaxChannels { 400 };
 static bool SelectionIsTunable(const ChannelInfoList &selection);
 
 JumpToChannel::JumpToChannel(
@@ -274,6 +281,15 @@ public:
             return false;
         }
 
+        QVector<int> missing;
+        for (unsigned int i = 0; i < m_numRows; ++i)
+        {
+            if (!m_proglists[i])
+                missing.push_back(m_chanNums[i]);
+        }
+        if (missing.size() > 1)
+            m_guide->prefetchProgramLists(missing);
+
         for (unsigned int i = 0; i < m_numRows; ++i)
         {
             unsigned int row = i + m_firstRow;
@@ -340,6 +356,32 @@ public:
     QVector<bool> m_unavailables;
 };
 
+// GuidePrefetch loads the listings of channels just off screen into the
+// guide cache.  It never has anything to draw.
+class GuidePrefetch : public GuideUpdaterBase
+{
+public:
+    GuidePrefetch(GuideGrid *guide, uint startChan, QDateTime startTime,
+                  QVector<int> chanNums)
+        : GuideUpdaterBase(guide), m_currentStartChannel(startChan),
+          m_currentStartTime(std::move(startTime)),
+          m_chanNums(std::move(chanNums)) {}
+    bool ExecuteNonUI(void) override // GuideUpdaterBase
+    {
+        if (m_currentStartChannel == m_guide->GetCurrentStartChannel() &&
+            m_currentStartTime == m_guide->GetCurrentStartTime())
+        {
+            m_guide->prefetchProgramLists(m_chanNums);
+        }
+        return false;
+    }
+    void ExecuteUI(void) override {} // GuideUpdaterBase
+private:
+    const uint m_currentStartChannel;
+    const QDateTime m_currentStartTime;
+    const QVector<int> m_chanNums;
+};
+
 class UpdateGuideEvent : public QEvent
 {
 public:
@@ -408,6 +450,126 @@ QMutex                 GuideHelper::s_lock;
 QWaitCondition         GuideHelper::s_wait;
 QHash<GuideGrid*,uint> GuideHelper::s_loading;
 
+bool GuideCache::IsCached(uint chanid, const QDateTime &start,
+                          const QDateTime &end) const
+{
+    auto it = m_entries.constFind(chanid);
+    return it != m_entries.constEnd() &&
+        it->m_start <= start && it->m_end >= end &&
+        it->m_loaded.secsTo(MythDate::current()) < kCacheMaxAge;
+}
+
+ProgramList *GuideCache::Get(uint chanid, const QDateTime &start,
+                             const QDateTime &end) const
+{
+    QMutexLocker locker(&m_lock);
+
+    if (!IsCached(chanid, start, end))
+        return nullptr;
+
+    // Same conditions as the query in GuideGrid::getProgramListFromProgram()
+    QDateTime startlimit = start.addDays(-1);
+    auto *proglist = new ProgramList();
+    for (auto *pi : *m_entries[chanid].m_programs)
+    {
+        if (pi->GetScheduledEndTime() >= start &&
+            pi->GetScheduledStartTime() <= end &&
+            pi->GetScheduledStartTime() >= startlimit)
+        {
+            proglist->push_back(new ProgramInfo(*pi));
+        }
+    }
+    return proglist;
+}
+
+void GuideCache::Fill(const std::vector<uint> &chanids, const QDateTime &start,
+                      const QDateTime &end, const ProgramList &schedList)
+{
+    QStringList missing;
+    {
+        QMutexLocker locker(&m_lock);
+        for (uint chanid : chanids)
+        {
+            if (!IsCached(chanid, start, end))
+                missing << QString::number(chanid);
+        }
+    }
+    if (missing.isEmpty())
+        return;
+
+    QDateTime loadstart = start.addSecs(-kCacheBehind);
+    QDateTime loadend   = end.addSecs(kCacheAhead);
+
+    // Group by chanid as well, otherwise the default grouping would merge
+    // channels sharing a channum and callsign on different sources.
+    MSqlBindings bindings;
+    QString querystr = QString(
+        "WHERE program.chanid IN (%1) "
+        "  AND program.endtime >= :STARTTS "
+        "  AND program.starttime <= :ENDTS "
+        "  AND program.starttime >= :STARTLIMITTS "
+        "  AND program.manualid = 0 "
+        "GROUP BY program.chanid, program.starttime, channel.channum, "
+        "         channel.callsign, program.title ").arg(missing.join(","));
+    bindings[":STARTTS"] = loadstart;
+    bindings[":STARTLIMITTS"] = loadstart.addDays(-1);
+    bindings[":ENDTS"] = loadend;
+
+    ProgramList programs;
+    if (!LoadFromProgram(programs, querystr, bindings, schedList))
+        return;
+
+    QHash<uint, Entry> loaded;
+    QDateTime now = MythDate::current();
+    for (const auto & chanid : std::as_const(missing))
+    {
+        Entry &entry = loaded[chanid.toUInt()];
+        entry.m_start    = loadstart;
+        entry.m_end      = loadend;
+        entry.m_loaded   = now;
+        entry.m_programs = std::make_shared<ProgramList>();
+    }
+    // Hand the programs over to the per channel lists
+    programs.setAutoDelete(false);
+    for (auto *pi : programs)
+    {
+        auto it = loaded.find(pi->GetChanID());
+        if (it != loaded.end())
+            it->m_programs->push_back(pi);
+        else
+            delete pi;
+    }
+
+    QMutexLocker locker(&m_lock);
+    for (auto it = loaded.begin(); it != loaded.end(); ++it)
+    {
+        it->m_serial = ++m_serial;
+        m_entries[it.key()] = *it;
+    }
+
+    // Drop the least recently loaded channels once the cache is full
+    if (m_entries.size() > kCacheMaxChannels)
+    {
+        std::vector<std::pair<uint64_t, uint>> order;
+        order.reserve(m_entries.size());
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+            order.emplace_back(it->m_serial, it.key());
+        std::sort(order.begin(), order.end());
+        for (size_t i = 0; m_entries.size() > kCacheMaxChannels; ++i)
+            m_entries.remove(order[i].second);
+    }
+
+    LOG(VB_GUI, LOG_DEBUG, LOC + QString("Cached listings of %1 channels, "
+                                         "%2 channels in cache")
+        .arg(missing.size()).arg(m_entries.size()));
+}
+
+void GuideCache::Clear(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_entries.clear();
+}
+
 void GuideGrid::RunProgramGuide(uint chanid, const QString &channum,
                                 const QDateTime &startTime,
                                 TV *player, bool embedVideo,
@@ -591,6 +753,7 @@ void GuideGrid::Load(void)
     int maxchannel = GetChannelCount();
     m_channelCount = std::min(m_channelCount, maxchannel);
 
+    QVector<int> chanNums(m_channelCount, -1);
     for (int y = 0; y < m_channelCount; ++y)
     {
         int chanNum = y + m_currentStartChannel;
@@ -599,10 +762,18 @@ void GuideGrid::Load(void)
         if (chanNum >= (int) m_channelInfos.size())
             continue;
 
-        chanNum = std::max(chanNum, 0);
+        chanNums[y] = std::max(chanNum, 0);
+    }
+
+    prefetchProgramLists(chanNums);
+
+    for (int y = 0; y < m_channelCount; ++y)
+    {
+        if (chanNums[y] < 0)
+            continue;
 
         delete m_programs[y];
-        m_programs[y] = getProgramListFromProgram(chanNum);
+        m_programs[y] = getProgramListFromProgram(chanNums[y]);
     }
 }
 
@@ -1568,26 +1739,40 @@ void GuideGrid::fillProgramInfos(bool useExistingData)
 
 ProgramList *GuideGrid::getProgramListFromProgram(int chanNum)
 {
-    auto *proglist = new ProgramList();
+    QDateTime starttime = m_currentStartTime.addSecs(0 - m_currentStartTime.time().second());
+    QDateTime endtime = m_currentEndTime.addSecs(0 - m_currentEndTime.time().second());
+    uint chanid = GetChannelInfo(chanNum)->m_chanId;
 
+    ProgramList *proglist = m_guideCache.Get(chanid, starttime, endtime);
     if (proglist)
-    {
-        MSqlBindings bindings;
-        QString querystr = "WHERE program.chanid = :CHANID "
-                           "  AND program.endtime >= :STARTTS "
-                           "  AND program.starttime <= :ENDTS "
-                           "  AND program.starttime >= :STARTLIMITTS "
-                           "  AND program.manualid = 0 ";
-        QDateTime starttime = m_currentStartTime.addSecs(0 - m_currentStartTime.time().second());
-        bindings[":CHANID"]  = GetChannelInfo(chanNum)->m_chanId;
-        bindings[":STARTTS"] = starttime;
-        bindings[":STARTLIMITTS"] = starttime.addDays(-1);
-        bindings[":ENDTS"] = m_currentEndTime.addSecs(0 - m_currentEndTime.time().second());
+        return proglist;
 
-        LoadFromProgram(*proglist, querystr, bindings, m_recList);
+    m_guideCache.Fill({ chanid }, starttime, endtime, m_recList);
+    proglist = m_guideCache.Get(chanid, starttime, endtime);
+
+    return proglist ? proglist : new ProgramList();
+}
+
+// Load the listings of the given channels into the guide cache with a
+// single query, instead of one query per row.
+void GuideGrid::prefetchProgramLists(const QVector<int> &chanNums)
+{
+    std::vector<uint> chanids;
+    chanids.reserve(chanNums.size());
+    for (int chanNum : chanNums)
+    {
+        if (chanNum < 0)
+            continue;
+        const ChannelInfo *chinfo = GetChannelInfo(chanNum);
+        if (chinfo)
+            chanids.push_back(chinfo->m_chanId);
     }
+    if (chanids.empty())
+        return;
 
-    return proglist;
+    QDateTime starttime = m_currentStartTime.addSecs(0 - m_currentStartTime.time().second());
+    QDateTime endtime = m_currentEndTime.addSecs(0 - m_currentEndTime.time().second());
+    m_guideCache.Fill(chanids, starttime, endtime, m_recList);
 }
 
 void GuideGrid::fillProgramRowInfos(int firstRow, bool useExistingData)
@@ -1653,6 +1838,24 @@ void GuideGrid::fillProgramRowInfos(int firstRow, bool useExistingData)
                    m_verticalLayout, m_firstTime, m_lastTime);
     auto *updater = new GuideUpdateProgramRow(this, gs, proglists);
     m_threadPool.start(new GuideHelper(this, updater), "GuideHelper");
+
+    // When a whole page was requested, load the pages above and below
+    // it into the cache after the visible rows are done.
+    if (allRows && !m_channelInfos.empty())
+    {
+        int total = m_channelInfos.size();
+        int rows = numRows;
+        QVector<int> adjacent;
+        for (int i = 0; i < rows; ++i)
+        {
+            int chanNum = i + static_cast<int>(m_currentStartChannel);
+            adjacent.push_back((chanNum + rows) % total);
+            adjacent.push_back((((chanNum - rows) % total) + total) % total);
+        }
+        auto *prefetch = new GuidePrefetch(this, m_currentStartChannel,
+                                           m_currentStartTime, adjacent);
+        m_threadPool.start(new GuideHelper(this, prefetch), "GuidePrefetch", 1);
+    }
 }
 
 void GuideUpdateProgramRow::fillProgramRowInfosWith(int row,
@@ -1903,6 +2106,7 @@ void GuideGrid::customEvent(QEvent *event)
         {
             GuideHelper::Wait(this);
             LoadFromScheduler(m_recList);
+            m_guideCache.Clear();
             fillProgramInfos();
         }
     }
@@ -2282,6 +2486,7 @@ void GuideGrid::generateListings()
     m_channelCount = std::min(m_guideGrid->getChannelCount(), maxchannel + 1);
 
     LoadFromScheduler(m_recList);
+    m_guideCache.Clear();
     fillProgramInfos();
 }
 
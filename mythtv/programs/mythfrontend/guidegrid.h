@@ -3,7 +3,9 @@
 #define GUIDEGRID_H_
 
 // C++
+#include <cstdint>
 #include <list>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -11,6 +13,8 @@
 #include <QString>
 #include <QDateTime>
 #include <QEvent>
+#include <QHash>
+#include <QMutex>
 
 // MythTV
 #include "libmythbase/mthreadpool.h"
@@ -98,6 +102,43 @@ public:
     const bool m_selected;
 };
 
+// GuideCache keeps the listings of recently displayed and prefetched
+// channels for a time window wider than the displayed one, so that
+// paging through the guide is served from memory instead of running a
+// query per row.  It is filled from the helper threads and must be
+// cleared whenever the schedule changes, since the cached programs carry
+// their recording status.
+class GuideCache
+{
+  public:
+    // Returns a copy of the cached programs of chanid overlapping
+    // [start, end], or nullptr if that window isn't cached.
+    ProgramList *Get(uint chanid, const QDateTime &start,
+                     const QDateTime &end) const;
+    // Loads the channels that aren't already cached for [start, end]
+    // with a single query.
+    void Fill(const std::vector<uint> &chanids, const QDateTime &start,
+              const QDateTime &end, const ProgramList &schedList);
+    void Clear(void);
+
+  private:
+    struct Entry
+    {
+        QDateTime m_start;
+        QDateTime m_end;
+        QDateTime m_loaded;
+        uint64_t  m_serial {0};
+        std::shared_ptr<ProgramList> m_programs;
+    };
+
+    bool IsCached(uint chanid, const QDateTime &start,
+                  const QDateTime &end) const;
+
+    mutable QMutex     m_lock;
+    QHash<uint, Entry> m_entries;
+    uint64_t           m_serial {0};
+};
+
 class GuideGrid : public ScheduleCommon, public JumpToChannelListener
 {
     Q_OBJECT;
@@ -214,6 +255,7 @@ class GuideGrid : public ScheduleCommon, public JumpToChannelListener
 public:
     // These need to be public so that the helper classes can operate.
     ProgramList *getProgramListFromProgram(int chanNum);
+    void prefetchProgramLists(const QVector<int> &chanNums);
     void updateProgramsUI(unsigned int firstRow, unsigned int numRows,
                           int progPast,
                           const QVector<ProgramList*> &proglists,
@@ -246,6 +288,7 @@ private:
     std::vector<ProgramList*> m_programs;
     ProgInfoGuideArray m_programInfos {};
     ProgramList  m_recList;
+    GuideCache   m_guideCache;
 
     QDateTime m_originalStartTime;
     QDateTime m_currentStartTime;
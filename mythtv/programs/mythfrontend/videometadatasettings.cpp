@@ -33,6 +33,9 @@ bool MetadataSettings::Create()
         dynamic_cast<MythUICheckBox *> (GetChild("treeloadsmetacheck"));
     m_randomTrailerCheck =
         dynamic_cast<MythUICheckBox *> (GetChild("randomtrailercheck"));
+    // Optional
+    m_watchDirsCheck =
+        dynamic_cast<MythUICheckBox *> (GetChild("watchdirscheck"));
 
     m_okButton = dynamic_cast<MythUIButton *> (GetChild("ok"));
     m_cancelButton = dynamic_cast<MythUIButton *> (GetChild("cancel"));
@@ -65,6 +68,10 @@ bool MetadataSettings::Create()
     if (trailerSetting == 1)
         m_randomTrailerCheck->SetCheckState(MythUIStateType::Full);
 
+    if (m_watchDirsCheck &&
+        gCoreContext->GetNumSetting("VideoScanWatchDirs", 0) == 1)
+        m_watchDirsCheck->SetCheckState(MythUIStateType::Full);
+
     m_trailerSpin->SetRange(0,100,1);
     m_trailerSpin->SetValue(gCoreContext->GetNumSetting(
                            "mythvideo.TrailersRandomCount"));
@@ -99,6 +106,17 @@ bool MetadataSettings::Create()
                     "will cause the Video List to load any known video meta"
                     "data from the database. Turning this off can greatly "
                     "speed up how long it takes to load the Video List tree."));
+    if (m_watchDirsCheck)
+    {
+        m_watchDirsCheck->SetHelpText(
+                    tr("Only the listings of video directories are kept "
+                    "between scans. A scan for new videos still checks every "
+                    "directory, and reads again the ones that have changed. "
+                    "If set, directories on local disks are also watched for "
+                    "changes, so unchanged ones don't need to be checked. "
+                    "Directories on network shares are always checked. Takes "
+                    "effect when MythTV is next started."));
+    }
     m_cancelButton->SetHelpText(tr("Exit without saving settings"));
     m_okButton->SetHelpText(tr("Save settings and Exit"));
 
@@ -132,6 +150,14 @@ void MetadataSettings::slotSave(void)
         trailerState = 1;
     gCoreContext->SaveSetting("mythvideo.TrailersRandomEnabled", trailerState);
 
+    if (m_watchDirsCheck)
+    {
+        int watchDirsState = 0;
+        if (m_watchDirsCheck->GetCheckState() == MythUIStateType::Full)
+            watchDirsState = 1;
+        gCoreContext->SaveSetting("VideoScanWatchDirs", watchDirsState);
+    }
+
     Close();
 }
 
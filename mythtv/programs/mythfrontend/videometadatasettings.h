@@ -29,6 +29,7 @@ class MetadataSettings : public MythScreenType
     MythUICheckBox     *m_autoMetaUpdateCheck {nullptr};
     MythUICheckBox     *m_treeLoadsMetaCheck  {nullptr};
     MythUICheckBox     *m_randomTrailerCheck  {nullptr};
+    MythUICheckBox     *m_watchDirsCheck      {nullptr};
 
     MythUIButton       *m_okButton            {nullptr};
     MythUIButton       *m_cancelButton        {nullptr};
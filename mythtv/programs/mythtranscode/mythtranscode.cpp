@@ -26,10 +26,13 @@
 #include "libmythtv/HLS/httplivestream.h"
 #include "libmythtv/jobqueue.h"
 #include "libmythtv/recordinginfo.h"
+#include "libmythtv/seekindexfile.h"
+#include "libmythtv/trickplaygenerator.h"
 
 // MythTranscode
 #include "mpeg2fix.h"
 #include "mythtranscode_commandlineparser.h"
+#include "smartcut.h"
 #include "transcode.h"
 
 static void CompleteJob(int jobID, ProgramInfo *pginfo, bool useCutlist,
@@ -48,6 +51,7 @@ static void UpdatePositionMap(frm_pos_map_t &posMap, frm_pos_map_t &durMap, cons
         pginfo->ClearPositionMap(MARK_GOP_START);
         pginfo->SavePositionMap(posMap, MARK_GOP_BYFRAME);
         pginfo->SavePositionMap(durMap, MARK_DURATION_MS);
+        SeekIndexFile::Remove(pginfo->GetPlaybackURL(false, true));
     }
     else if (!mapfile.isEmpty())
     {
@@ -161,6 +165,8 @@ int main(int argc, char *argv[])
     bool build_index = false;
     bool fifosync = false;
     bool mpeg2 = false;
+    bool smartcut = false;
+    bool mkv = false;
     bool fifo_info = false;
     bool cleanCut = false;
     frm_dir_map_t deleteMap;
@@ -350,14 +356,21 @@ int main(int argc, char *argv[])
         recorderOptions = cmdline.toString("recopt");
     if (cmdline.toBool("mpeg2"))
         mpeg2 = true;
+    if (cmdline.toBool("smartcut"))
+    {
+        smartcut = true;
+        otype = REPLEX_TS_SD;
+    }
     if (cmdline.toBool("ostream"))
     {
-        if (cmdline.toString("ostream") == "dvd")
+        if (cmdline.toString("ostream") == "dvd" && !smartcut)
             otype = REPLEX_DVD;
-        else if (cmdline.toString("ostream") == "ps")
+        else if (cmdline.toString("ostream") == "ps" && !smartcut)
             otype = REPLEX_MPEG2;
         else if (cmdline.toString("ostream") == "ts")
             otype = REPLEX_TS_SD;
+        else if (cmdline.toString("ostream") == "mkv" && smartcut)
+            mkv = true;
         else
         {
             std::cerr << "Invalid 'ostream' type: "
@@ -454,6 +467,17 @@ int main(int argc, char *argv[])
         std::cerr << "--cleancut is pointless without --honorcutlist" << std::endl;
         return GENERIC_EXIT_INVALID_CMDLINE;
     }
+    if (smartcut && (mpeg2 || build_index))
+    {
+        std::cerr << "Cannot specify --smartcut with --mpeg2 or --buildindex"
+                  << std::endl;
+        return GENERIC_EXIT_INVALID_CMDLINE;
+    }
+    if (mkv && !cmdline.toBool("outputfile"))
+    {
+        std::cerr << "Must specify --outfile to smart cut to mkv" << std::endl;
+        return GENERIC_EXIT_INVALID_CMDLINE;
+    }
 
     if (fifo_info)
     {
@@ -604,7 +628,7 @@ int main(int argc, char *argv[])
     if (!recorderOptions.isEmpty())
         transcode->SetRecorderOptions(recorderOptions);
     int result = 0;
-    if ((!mpeg2 && !build_index) || cmdline.toBool("hls"))
+    if ((!mpeg2 && !smartcut && !build_index) || cmdline.toBool("hls"))
     {
         result = transcode->TranscodeFile(infile, outfile,
                                           profilename, useCutlist,
@@ -629,7 +653,7 @@ int main(int argc, char *argv[])
     }
 
     int exitcode = GENERIC_EXIT_OK;
-    if ((result == REENCODE_MPEG2TRANS) || mpeg2 || build_index)
+    if ((result == REENCODE_MPEG2TRANS) || mpeg2 || smartcut || build_index)
     {
         void (*update_func)(float) = nullptr;
         int (*check_func)() = nullptr;
@@ -672,8 +696,20 @@ int main(int argc, char *argv[])
         }
         else
         {
-            result = m2f->Start();
-            if (result == REENCODE_OK)
+            if (smartcut)
+            {
+                frm_pos_map_t seekTable;
+                pginfo->QueryPositionMap(seekTable, MARK_GOP_BYFRAME);
+                SmartCutter cutter(infile, outfile, deleteMap, seekTable, mkv,
+                                   showprogress, update_func, check_func);
+                result = cutter.Start();
+            }
+            else
+            {
+                result = m2f->Start();
+            }
+            // Matroska files carry their own index
+            if (result == REENCODE_OK && !mkv)
             {
                 result = BuildKeyframeIndex(m2f, outfile, posMap, durMap, jobID);
                 if (result == REENCODE_OK)
@@ -944,6 +980,11 @@ static void CompleteJob(int jobID, ProgramInfo *pginfo, bool useCutlist,
                     .arg(tmpfile, newfile) + ENO);
         }
 
+        // The seek index describes the original file, not the transcode.
+        SeekIndexFile::Remove(filename);
+        // So do the trick-play thumbnails; they are rebuilt on demand.
+        TrickPlayGenerator::Remove(filename);
+
         if (!gCoreContext->GetBoolSetting("SaveTranscoding", false) || forceDelete)
         {
             bool followLinks =
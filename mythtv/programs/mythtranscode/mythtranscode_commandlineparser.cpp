@@ -36,8 +36,17 @@ void MythTranscodeCommandLineParser::LoadArguments(void)
     add(QStringList{"-m", "--mpeg2"}, "mpeg2", false,
             "Specifies that a lossless transcode should be used.", "")
         ->SetGroup("Encoding");
+    add("--smartcut", "smartcut", false,
+            "Specifies that the cutlist should be removed from an H.264 or "
+            "HEVC recording by re-encoding only the GOPs at the cut points.",
+            "Copies every GOP that is kept whole and re-encodes only the "
+            "partial GOPs at the cut points. Writes a ts stream, or an mkv "
+            "stream with --ostream mkv.")
+        ->SetGroup("Encoding")
+        ->SetRequires("usecutlist");
     add(QStringList{"-e", "--ostream"}, "ostream", "",
-            "Output stream type: ps, dvd, ts (Default: ps)", "")
+            "Output stream type: ps, dvd, ts, mkv (Default: ps, ts with "
+            "--smartcut)", "")
         ->SetGroup("Encoding");
     add("--avf", "avf", false, "Generate libavformat output file.", "")
         ->SetGroup("Encoding");
@@ -0,0 +1,929 @@
+// C++
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+// Qt
+#include <QFileInfo>
+
+// MythTV
+#include "libmythbase/exitcodes.h"
+#include "libmythbase/mythdate.h"
+#include "libmythbase/mythlogging.h"
+
+// MythTranscode
+#include "smartcut.h"
+#include "transcodedefs.h"
+
+#define LOC QString("SmartCut: ")
+
+// Audio is muxed up to this far from the video it belongs with
+static constexpr int64_t kAudioSlackMs { 2000 };
+
+SmartCutter::SmartCutter(QString inf, QString outf,
+                         const frm_dir_map_t &deleteMap,
+                         const frm_pos_map_t &seekTable, bool mkv,
+                         bool showprog, void (*update_func)(float),
+                         int (*check_func)())
+  : m_infile(std::move(inf)),
+    m_outfile(std::move(outf)),
+    m_deleteMap(deleteMap),
+    m_seekTable(seekTable),
+    m_mkv(mkv),
+    m_showProgress(showprog),
+    m_updateStatus(update_func),
+    m_checkAbort(check_func)
+{
+    if (m_showProgress || m_updateStatus)
+    {
+        if (m_updateStatus)
+        {
+            m_statusUpdateTime = 20;
+            m_updateStatus(0);
+        }
+        m_statusTime = MythDate::current().addSecs(m_statusUpdateTime);
+        m_fileSize = QFileInfo(m_infile).size();
+    }
+}
+
+SmartCutter::~SmartCutter()
+{
+    for (auto & queue : m_queue)
+    {
+        for (auto & entry : queue)
+            av_packet_free(&entry.first);
+    }
+    if (m_outputFC)
+    {
+        if (!(m_outputFC->oformat->flags & AVFMT_NOFILE))
+            avio_closep(&m_outputFC->pb);
+        avformat_free_context(m_outputFC);
+    }
+    avformat_close_input(&m_inputFC);
+}
+
+/**
+ *  \brief Splits the kept sections of a recording into copied and
+ *         re-encoded runs of frames.
+ *
+ *  Frames from MARK_CUT_START up to, but not including, MARK_CUT_END are
+ *  removed. A kept section is copied from its first keyframe up to its
+ *  last one, or up to the end of the recording. Frames before and after
+ *  that are re-encoded, as is a section too short to hold a whole GOP.
+ *
+ *  \param keyframes Keyframes, in display order
+ *  \param frames    Number of frames in the recording
+ */
+SmartCutPlan SmartCutter::BuildPlan(const frm_dir_map_t &deleteMap,
+                                    const std::vector<uint64_t> &keyframes,
+                                    uint64_t frames)
+{
+    std::vector<uint64_t> keys(keyframes);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<std::pair<uint64_t,uint64_t>> keep;
+    uint64_t start = 0;
+    bool cutting = !deleteMap.isEmpty() &&
+                   (deleteMap.cbegin().value() == MARK_CUT_END);
+    for (auto it = deleteMap.cbegin(); it != deleteMap.cend(); ++it)
+    {
+        uint64_t frame = std::min(it.key(), frames);
+        if (*it == MARK_CUT_START && !cutting)
+        {
+            if (frame > start)
+                keep.emplace_back(start, frame);
+            cutting = true;
+        }
+        else if (*it == MARK_CUT_END && cutting)
+        {
+            start = frame;
+            cutting = false;
+        }
+    }
+    if (!cutting && frames > start)
+        keep.emplace_back(start, frames);
+
+    SmartCutPlan plan;
+    for (const auto & [from, to] : keep)
+    {
+        auto first = std::lower_bound(keys.cbegin(), keys.cend(), from);
+        uint64_t copyFrom = (first != keys.cend()) ? *first : frames;
+        uint64_t copyTo = to;
+        if (to < frames)
+        {
+            auto last = std::upper_bound(keys.cbegin(), keys.cend(), to);
+            copyTo = (last != keys.cbegin()) ? *(--last) : 0;
+        }
+
+        if (copyFrom >= copyTo)
+        {
+            plan.append({from, to, false});
+            continue;
+        }
+        if (from < copyFrom)
+            plan.append({from, copyFrom, false});
+        plan.append({copyFrom, copyTo, true});
+        if (copyTo < to)
+            plan.append({copyTo, to, false});
+    }
+    return plan;
+}
+
+int SmartCutter::Start()
+{
+    if (!InitInput())
+        return GENERIC_EXIT_NOT_OK;
+
+    int result = ScanVideo();
+    if (result != REENCODE_OK)
+        return result;
+
+    SmartCutPlan plan = BuildPlan(m_deleteMap, Keyframes(), m_display.size());
+    if (plan.isEmpty())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Nothing is left after cutting");
+        return GENERIC_EXIT_NOT_OK;
+    }
+
+    uint64_t copied = 0;
+    uint64_t encoded = 0;
+    for (const auto & segment : std::as_const(plan))
+        (segment.m_copy ? copied : encoded) += segment.m_end - segment.m_start;
+    m_keptFrames = copied + encoded;
+    LOG(VB_GENERAL, LOG_INFO, LOC +
+        QString("Keeping %1 of %2 frames, re-encoding %3 of them")
+        .arg(m_keptFrames).arg(m_display.size()).arg(encoded));
+
+    if (!InitOutput())
+        return GENERIC_EXIT_NOT_OK;
+
+    m_clock = m_display.front();
+    SmartCutPlan range;
+    for (const auto & segment : std::as_const(plan))
+    {
+        if (!range.isEmpty() && segment.m_start != range.back().m_end)
+        {
+            result = CutRange(range);
+            if (result != REENCODE_OK)
+                return result;
+            range.clear();
+        }
+        range.append(segment);
+    }
+    result = CutRange(range);
+    if (result != REENCODE_OK)
+        return result;
+
+    if (av_write_trailer(m_outputFC) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to finish the output file");
+        return GENERIC_EXIT_WRITE_FRAME_ERROR;
+    }
+
+    LOG(VB_GENERAL, LOG_INFO, LOC +
+        QString("Copied %1 and re-encoded %2 video frames")
+        .arg(m_copied).arg(m_encoded));
+    return REENCODE_OK;
+}
+
+bool SmartCutter::InitInput()
+{
+    QByteArray ifarray = m_infile.toLocal8Bit();
+    LOG(VB_GENERAL, LOG_INFO, LOC + QString("Opening %1").arg(m_infile));
+
+    int ret = avformat_open_input(&m_inputFC, ifarray.constData(), nullptr,
+                                  nullptr);
+    if (ret)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't open input file, error #%1").arg(ret));
+        return false;
+    }
+
+    ret = avformat_find_stream_info(m_inputFC, nullptr);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't get stream info, error #%1").arg(ret));
+        return false;
+    }
+
+    m_vidId = av_find_best_stream(m_inputFC, AVMEDIA_TYPE_VIDEO, -1, -1,
+                                  nullptr, 0);
+    if (m_vidId < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "No video stream found");
+        return false;
+    }
+
+    AVCodecID codec = m_inputFC->streams[m_vidId]->codecpar->codec_id;
+    if (codec != AV_CODEC_ID_H264 && codec != AV_CODEC_ID_HEVC)
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("Smart cutting is meant for H.264 and HEVC, not %1")
+            .arg(avcodec_get_name(codec)));
+    }
+    if (!avcodec_find_encoder(codec))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("No %1 encoder is available to re-encode the cut points")
+            .arg(avcodec_get_name(codec)));
+        return false;
+    }
+    return true;
+}
+
+bool SmartCutter::InitOutput()
+{
+    QByteArray ofarray = m_outfile.toLocal8Bit();
+    int ret = avformat_alloc_output_context2(&m_outputFC, nullptr,
+                                             m_mkv ? "matroska" : "mpegts",
+                                             ofarray.constData());
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't create output context, error #%1").arg(ret));
+        return false;
+    }
+
+    for (uint i = 0; i < m_inputFC->nb_streams; ++i)
+    {
+        AVStream *ist = m_inputFC->streams[i];
+        if (static_cast<int>(i) != m_vidId &&
+            (ist->codecpar->codec_type != AVMEDIA_TYPE_AUDIO ||
+             ist->codecpar->ch_layout.nb_channels == 0))
+            continue;
+
+        AVStream *ost = avformat_new_stream(m_outputFC, nullptr);
+        if (!ost ||
+            avcodec_parameters_copy(ost->codecpar, ist->codecpar) < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "Couldn't create output stream");
+            return false;
+        }
+        ost->codecpar->codec_tag = 0;
+        ost->time_base = ist->time_base;
+        ost->disposition = ist->disposition;
+        av_dict_copy(&ost->metadata, ist->metadata, 0);
+        m_streamMap[static_cast<int>(i)] = ost->index;
+        m_lastDts[ost->index] = AV_NOPTS_VALUE;
+    }
+
+    if (!(m_outputFC->oformat->flags & AVFMT_NOFILE))
+    {
+        ret = avio_open(&m_outputFC->pb, ofarray.constData(), AVIO_FLAG_WRITE);
+        if (ret < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Couldn't open output file %1, error #%2")
+                .arg(m_outfile).arg(ret));
+            return false;
+        }
+    }
+
+    ret = avformat_write_header(m_outputFC, nullptr);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Couldn't write output header, error #%1").arg(ret));
+        return false;
+    }
+    return true;
+}
+
+/**
+ *  \brief Reads the timestamps, positions and key flags of every video
+ *         packet, so the cut points can be turned into timestamps and
+ *         the GOPs around them located.
+ */
+int SmartCutter::ScanVideo()
+{
+    LOG(VB_GENERAL, LOG_INFO, LOC + "Scanning video packets");
+
+    AVPacket *pkt = av_packet_alloc();
+    if (pkt == nullptr)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "packet allocation failed");
+        return GENERIC_EXIT_NOT_OK;
+    }
+
+    int64_t bytes = 0;
+    while (av_read_frame(m_inputFC, pkt) >= 0)
+    {
+        if (pkt->stream_index == m_vidId)
+        {
+            VideoPacket video;
+            video.m_pts = (pkt->pts != AV_NOPTS_VALUE) ? pkt->pts : pkt->dts;
+            video.m_dts = (pkt->dts != AV_NOPTS_VALUE) ? pkt->dts : video.m_pts;
+            video.m_pos = pkt->pos;
+            video.m_key = (pkt->flags & AV_PKT_FLAG_KEY) != 0;
+            if (video.m_pts == AV_NOPTS_VALUE || m_index.contains(video.m_pts))
+            {
+                LOG(VB_GENERAL, LOG_DEBUG, LOC +
+                    QString("Ignoring video packet at %1").arg(pkt->pos));
+            }
+            else
+            {
+                m_index[video.m_pts] = m_packets.size();
+                if (video.m_key)
+                    m_keys.push_back(m_packets.size());
+                m_packets.push_back(video);
+                bytes += pkt->size;
+            }
+        }
+        int64_t pos = pkt->pos;
+        av_packet_unref(pkt);
+
+        float percent = (m_fileSize > 0) ? 10.0F * pos / m_fileSize : 0.0F;
+        if (!CheckStatus(percent))
+        {
+            av_packet_free(&pkt);
+            return REENCODE_STOPPED;
+        }
+    }
+    av_packet_free(&pkt);
+
+    if (m_keys.empty())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "No keyframes found");
+        return GENERIC_EXIT_NOT_OK;
+    }
+
+    m_display.reserve(m_packets.size());
+    for (const auto & video : m_packets)
+        m_display.push_back(video.m_pts);
+    std::sort(m_display.begin(), m_display.end());
+
+    AVStream *st = m_inputFC->streams[m_vidId];
+    AVRational rate = av_guess_frame_rate(m_inputFC, st, nullptr);
+    if (rate.num > 0 && rate.den > 0)
+        m_frameDuration = av_rescale_q(1, av_inv_q(rate), st->time_base);
+    else if (m_display.size() > 1)
+        m_frameDuration = (m_display.back() - m_display.front()) /
+                          static_cast<int64_t>(m_display.size() - 1);
+    m_frameDuration = std::max<int64_t>(m_frameDuration, 1);
+
+    const VideoPacket &key = m_packets[m_keys.front()];
+    m_reorderDelay = std::max<int64_t>(key.m_pts - key.m_dts, 0);
+    m_gopSize = static_cast<int>(m_packets.size() / m_keys.size());
+
+    double seconds = av_q2d(st->time_base) *
+        static_cast<double>(m_display.back() - m_display.front() +
+                            m_frameDuration);
+    if (seconds > 0)
+        m_bitrate = static_cast<int64_t>(bytes * 8 / seconds);
+
+    LOG(VB_GENERAL, LOG_INFO, LOC +
+        QString("%1 video frames, %2 keyframes, %3 kbit/s")
+        .arg(m_packets.size()).arg(m_keys.size()).arg(m_bitrate / 1000));
+    return REENCODE_OK;
+}
+
+/**
+ *  \brief Returns the keyframes to cut at, in display order.
+ *
+ *  These are the seek table entries the demuxer also flags as key
+ *  packets. Without a usable seek table every key packet is used.
+ */
+std::vector<uint64_t> SmartCutter::Keyframes() const
+{
+    std::vector<uint64_t> keyframes;
+    auto rank = [this](int64_t pts)
+    {
+        return static_cast<uint64_t>(
+            std::lower_bound(m_display.cbegin(), m_display.cend(), pts) -
+            m_display.cbegin());
+    };
+
+    for (auto it = m_seekTable.cbegin(); it != m_seekTable.cend(); ++it)
+    {
+        if (it.key() < m_packets.size() && m_packets[it.key()].m_key)
+            keyframes.push_back(rank(m_packets[it.key()].m_pts));
+    }
+
+    if (keyframes.size() * 2 < static_cast<size_t>(m_seekTable.size()))
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            "The seek table does not match the recording, using key packets");
+        keyframes.clear();
+    }
+    if (keyframes.empty())
+    {
+        for (size_t key : m_keys)
+            keyframes.push_back(rank(m_packets[key].m_pts));
+    }
+    return keyframes;
+}
+
+int64_t SmartCutter::FramePts(uint64_t frame) const
+{
+    if (frame < m_display.size())
+        return m_display[frame];
+    return m_display.back() + m_frameDuration;
+}
+
+/// Returns the decode index of the last key packet shown at or before \p pts.
+size_t SmartCutter::KeyframeBefore(int64_t pts) const
+{
+    size_t found = m_keys.front();
+    for (size_t key : m_keys)
+    {
+        if (m_packets[key].m_pts > pts)
+            break;
+        found = key;
+    }
+    return found;
+}
+
+bool SmartCutter::IsCopied(size_t index) const
+{
+    return index >= m_copyFirst && index < m_copyEnd &&
+           m_packets[index].m_pts >= m_copyFrom &&
+           m_packets[index].m_pts < m_copyTo;
+}
+
+/**
+ *  \brief Writes one kept section of the recording.
+ *
+ *  The section is read once, in file order, starting a GOP ahead of
+ *  the first packet needed so that audio muxed early is not lost. The
+ *  packets of the copied GOPs, and those encoded for the frames before
+ *  and after them, are queued per phase and written in display order.
+ */
+int SmartCutter::CutRange(const SmartCutPlan &range)
+{
+    int64_t from = FramePts(range.front().m_start);
+    int64_t to = FramePts(range.back().m_end);
+    m_offset = from - m_clock;
+
+    m_copyFirst = m_copyEnd = 0;
+    m_copyFrom = m_copyTo = to;
+    for (const auto & segment : range)
+    {
+        if (!segment.m_copy)
+            continue;
+        m_copyFrom = FramePts(segment.m_start);
+        m_copyTo = FramePts(segment.m_end);
+        m_copyFirst = m_index.value(m_copyFrom);
+        m_copyEnd = (segment.m_end < m_display.size()) ?
+            m_index.value(m_copyTo) : m_packets.size();
+    }
+
+    size_t copyLeft = 0;
+    for (size_t i = m_copyFirst; i < m_copyEnd; ++i)
+        copyLeft += IsCopied(i) ? 1 : 0;
+
+    // Frames after the copied GOPs, including any leading B-frames of the
+    // keyframe that ends them, are encoded from the first one shown.
+    int64_t tailFrom = to;
+    if (copyLeft)
+    {
+        for (size_t i = m_copyFirst;
+             i < m_packets.size() && m_packets[i].m_dts < to; ++i)
+        {
+            int64_t pts = m_packets[i].m_pts;
+            if (pts >= m_copyFrom && pts < to && !IsCopied(i))
+                tailFrom = std::min(tailFrom, pts);
+        }
+    }
+
+    Encode head;
+    Encode tail;
+    if (!StartEncode(head, from, copyLeft ? m_copyFrom : to) ||
+        (copyLeft && !StartEncode(tail, tailFrom, to)))
+    {
+        CloseEncode(head);
+        return GENERIC_EXIT_NOT_OK;
+    }
+
+    m_phaseDone[kHead] = !head.m_active;
+    m_phaseDone[kCopy] = (copyLeft == 0);
+    m_phaseDone[kTail] = !tail.m_active;
+
+    size_t first = copyLeft ? m_copyFirst : m_packets.size();
+    if (head.m_active)
+        first = std::min(first, head.m_first);
+    if (tail.m_active)
+        first = std::min(first, tail.m_first);
+    if (first >= m_packets.size())
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC + "Nothing to write for section");
+        return REENCODE_OK;
+    }
+
+    // Start reading a GOP early for the audio
+    auto key = std::lower_bound(m_keys.cbegin(), m_keys.cend(), first);
+    int64_t pos = 0;
+    if (key != m_keys.cbegin())
+        pos = std::max<int64_t>(m_packets[*std::prev(key)].m_pos, 0);
+    if (av_seek_frame(m_inputFC, -1, pos, AVSEEK_FLAG_BYTE) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Seek to %1 failed").arg(pos));
+        CloseEncode(head);
+        CloseEncode(tail);
+        return GENERIC_EXIT_NOT_OK;
+    }
+
+    AVRational vtb = m_inputFC->streams[m_vidId]->time_base;
+    int64_t slack = av_rescale_q(kAudioSlackMs, {1, 1000}, vtb);
+    QHash<int,bool> audioDone;
+    int64_t lastVideo = AV_NOPTS_VALUE;
+    bool ok = true;
+    bool stopped = false;
+
+    AVPacket *pkt = av_packet_alloc();
+    while (ok && av_read_frame(m_inputFC, pkt) >= 0)
+    {
+        if (pkt->stream_index == m_vidId)
+        {
+            int64_t pts = (pkt->pts != AV_NOPTS_VALUE) ? pkt->pts : pkt->dts;
+            auto it = m_index.constFind(pts);
+            if (it != m_index.constEnd() && *it >= first)
+            {
+                size_t index = *it;
+                lastVideo = m_packets[index].m_dts;
+
+                if (head.m_active && index >= head.m_first)
+                {
+                    if (index <= head.m_last)
+                        ok &= FeedEncode(head, kHead, pkt);
+                    if (index >= head.m_last)
+                        ok &= FeedEncode(head, kHead, nullptr);
+                }
+                if (IsCopied(index))
+                {
+                    Queue(kCopy, av_packet_clone(pkt), false);
+                    m_phaseDone[kCopy] = (--copyLeft == 0);
+                }
+                if (tail.m_active && index >= tail.m_first)
+                {
+                    if (index <= tail.m_last)
+                        ok &= FeedEncode(tail, kTail, pkt);
+                    if (index >= tail.m_last)
+                        ok &= FeedEncode(tail, kTail, nullptr);
+                }
+                ok &= WriteQueued();
+            }
+        }
+        else if (m_streamMap.contains(pkt->stream_index) &&
+                 pkt->pts != AV_NOPTS_VALUE)
+        {
+            AVRational atb = m_inputFC->streams[pkt->stream_index]->time_base;
+            int64_t pts = av_rescale_q(pkt->pts, atb, vtb);
+            if (pts >= from && pts < to)
+                ok &= WriteAudio(pkt);
+            else if (pts >= to)
+                audioDone[pkt->stream_index] = true;
+        }
+        av_packet_unref(pkt);
+
+        float percent = 10.0F;
+        if (m_keptFrames > 0)
+            percent += 90.0F * (m_copied + m_encoded) / m_keptFrames;
+        if (!CheckStatus(percent))
+        {
+            stopped = true;
+            break;
+        }
+
+        bool videoDone = m_phaseDone[kHead] && m_phaseDone[kCopy] &&
+                         m_phaseDone[kTail];
+        if (videoDone &&
+            (audioDone.size() + 1 >= m_streamMap.size() ||
+             (lastVideo != AV_NOPTS_VALUE && lastVideo >= to + slack)))
+            break;
+    }
+    av_packet_free(&pkt);
+
+    // End of file, or stopped early
+    if (ok && !stopped)
+    {
+        if (head.m_active)
+            ok &= FeedEncode(head, kHead, nullptr);
+        if (tail.m_active)
+            ok &= FeedEncode(tail, kTail, nullptr);
+        m_phaseDone.fill(true);
+        ok &= WriteQueued();
+    }
+    CloseEncode(head);
+    CloseEncode(tail);
+    for (auto & queue : m_queue)
+    {
+        for (auto & entry : queue)
+            av_packet_free(&entry.first);
+        queue.clear();
+    }
+
+    if (stopped)
+        return REENCODE_STOPPED;
+    if (!ok)
+        return GENERIC_EXIT_WRITE_FRAME_ERROR;
+
+    m_clock += to - from;
+    return REENCODE_OK;
+}
+
+/**
+ *  \brief Prepares to re-encode the frames shown from \p from up to \p to,
+ *         that are not copied, decoding from the keyframe before them.
+ */
+bool SmartCutter::StartEncode(Encode &enc, int64_t from, int64_t to)
+{
+    enc.m_from = from;
+    enc.m_to = to;
+    enc.m_first = KeyframeBefore(from);
+    enc.m_active = false;
+
+    bool found = false;
+    for (size_t i = enc.m_first;
+         i < m_packets.size() && m_packets[i].m_dts < to; ++i)
+    {
+        int64_t pts = m_packets[i].m_pts;
+        if (pts >= from && pts < to && !IsCopied(i))
+        {
+            enc.m_last = i;
+            found = true;
+        }
+    }
+    if (!found)
+        return true;
+
+    AVStream *st = m_inputFC->streams[m_vidId];
+    const AVCodec *codec = avcodec_find_decoder(st->codecpar->codec_id);
+    enc.m_decoder = codec ? avcodec_alloc_context3(codec) : nullptr;
+    if (!enc.m_decoder ||
+        avcodec_parameters_to_context(enc.m_decoder, st->codecpar) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Couldn't create the video decoder");
+        CloseEncode(enc);
+        return false;
+    }
+    enc.m_decoder->pkt_timebase = st->time_base;
+    if (avcodec_open2(enc.m_decoder, codec, nullptr) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Couldn't open the video decoder");
+        CloseEncode(enc);
+        return false;
+    }
+
+    LOG(VB_GENERAL, LOG_DEBUG, LOC +
+        QString("Re-encoding %1 to %2 from packet %3")
+        .arg(from).arg(to).arg(enc.m_first));
+    enc.m_active = true;
+    return true;
+}
+
+/**
+ *  \brief Decodes \p pkt, or drains the decoder when it is null, and
+ *         encodes the frames that fall inside the re-encoded run.
+ */
+bool SmartCutter::FeedEncode(Encode &enc, Phase phase, const AVPacket *pkt)
+{
+    if (!enc.m_active)
+        return true;
+
+    int ret = avcodec_send_packet(enc.m_decoder, pkt);
+    if (ret < 0 && ret != AVERROR_EOF)
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("Video decode error #%1").arg(ret));
+    }
+
+    bool ok = true;
+    AVFrame *frame = av_frame_alloc();
+    while (ok && avcodec_receive_frame(enc.m_decoder, frame) >= 0)
+    {
+        int64_t pts = frame->best_effort_timestamp;
+        if (pts >= enc.m_from && pts < enc.m_to)
+            ok = EncodeFrame(enc, phase, frame);
+        av_frame_unref(frame);
+    }
+    av_frame_free(&frame);
+
+    if (pkt == nullptr)
+    {
+        if (ok)
+            ok = EncodeFrame(enc, phase, nullptr);
+        CloseEncode(enc);
+        m_phaseDone[phase] = true;
+    }
+    return ok;
+}
+
+/**
+ *  \brief Encodes one decoded frame, or drains the encoder when \p frame
+ *         is null.
+ *
+ *  The encoder is opened on the first frame. It uses the source codec,
+ *  no B-frames and in-band parameter sets so that the run starts with a
+ *  keyframe that can follow or precede the copied GOPs.
+ */
+bool SmartCutter::EncodeFrame(Encode &enc, Phase phase, AVFrame *frame)
+{
+    if (!frame)
+    {
+        if (!enc.m_encoder)
+            return true;
+        avcodec_send_frame(enc.m_encoder, nullptr);
+        return ReceivePackets(enc, phase);
+    }
+
+    if (!enc.m_encoder)
+    {
+        AVStream *st = m_inputFC->streams[m_vidId];
+        const AVCodec *codec = avcodec_find_encoder(st->codecpar->codec_id);
+        enc.m_encoder = codec ? avcodec_alloc_context3(codec) : nullptr;
+        if (!enc.m_encoder)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "Couldn't create the video encoder");
+            return false;
+        }
+
+        AVCodecContext *c = enc.m_encoder;
+        c->width                  = frame->width;
+        c->height                 = frame->height;
+        c->pix_fmt                = static_cast<AVPixelFormat>(frame->format);
+        c->sample_aspect_ratio    = frame->sample_aspect_ratio;
+        c->color_range            = frame->color_range;
+        c->color_primaries        = frame->color_primaries;
+        c->color_trc              = frame->color_trc;
+        c->colorspace             = frame->colorspace;
+        c->chroma_sample_location = frame->chroma_location;
+        c->time_base              = st->time_base;
+        c->framerate              = av_guess_frame_rate(m_inputFC, st, nullptr);
+        c->gop_size               = std::max(m_gopSize, 1);
+        c->max_b_frames           = 0;
+        // Short runs without B-frames need more bits than the source
+        c->bit_rate               = m_bitrate * 3 / 2;
+        if (frame->interlaced_frame)
+        {
+            c->flags |= AV_CODEC_FLAG_INTERLACED_DCT |
+                        AV_CODEC_FLAG_INTERLACED_ME;
+            c->field_order = frame->top_field_first ? AV_FIELD_TT : AV_FIELD_BB;
+        }
+
+        int ret = avcodec_open2(c, codec, nullptr);
+        if (ret < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Couldn't open the %1 encoder, error #%2")
+                .arg(codec->name).arg(ret));
+            return false;
+        }
+        frame->pict_type = AV_PICTURE_TYPE_I;
+    }
+    else
+    {
+        frame->pict_type = AV_PICTURE_TYPE_NONE;
+    }
+
+    frame->pts = frame->best_effort_timestamp - m_offset;
+    int ret = avcodec_send_frame(enc.m_encoder, frame);
+    if (ret < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Video encode error #%1").arg(ret));
+        return false;
+    }
+    return ReceivePackets(enc, phase);
+}
+
+bool SmartCutter::ReceivePackets(Encode &enc, Phase phase)
+{
+    AVPacket *pkt = av_packet_alloc();
+    while (avcodec_receive_packet(enc.m_encoder, pkt) >= 0)
+    {
+        if (pkt->duration <= 0)
+            pkt->duration = m_frameDuration;
+        Queue(phase, av_packet_clone(pkt), true);
+        av_packet_unref(pkt);
+    }
+    av_packet_free(&pkt);
+    return true;
+}
+
+void SmartCutter::CloseEncode(Encode &enc)
+{
+    avcodec_free_context(&enc.m_decoder);
+    avcodec_free_context(&enc.m_encoder);
+    enc.m_active = false;
+}
+
+void SmartCutter::Queue(Phase phase, AVPacket *pkt, bool encoded)
+{
+    if (pkt)
+        m_queue[phase].emplace_back(pkt, encoded);
+}
+
+/// Writes the queued video of each phase once every earlier one is done.
+bool SmartCutter::WriteQueued()
+{
+    for (int phase = kHead; phase < kPhases; ++phase)
+    {
+        auto & queue = m_queue[phase];
+        while (!queue.empty())
+        {
+            auto [pkt, encoded] = queue.front();
+            queue.pop_front();
+            bool ok = WriteVideo(pkt, encoded);
+            av_packet_free(&pkt);
+            if (!ok)
+                return false;
+        }
+        if (!m_phaseDone[phase])
+            break;
+    }
+    return true;
+}
+
+/**
+ *  \brief Writes a copied or encoded video packet with the timestamps of
+ *         the cut output.
+ *
+ *  Encoded packets have no B-frames, so their dts is placed the source's
+ *  reorder delay before their pts. This keeps the dts increasing across
+ *  the joins with the copied GOPs.
+ */
+bool SmartCutter::WriteVideo(AVPacket *pkt, bool encoded)
+{
+    int stream = m_streamMap[m_vidId];
+    int64_t last = m_lastDts[stream];
+
+    if (encoded)
+    {
+        pkt->dts = pkt->pts - m_reorderDelay;
+        ++m_encoded;
+    }
+    else
+    {
+        pkt->pts -= m_offset;
+        pkt->dts -= m_offset;
+        ++m_copied;
+    }
+    if (last != AV_NOPTS_VALUE && pkt->dts <= last)
+        pkt->dts = std::min(last + 1, pkt->pts);
+    if (last != AV_NOPTS_VALUE && pkt->dts <= last)
+    {
+        LOG(VB_GENERAL, LOG_DEBUG, LOC +
+            QString("Dropping video packet at %1").arg(pkt->pts));
+        return true;
+    }
+    m_lastDts[stream] = pkt->dts;
+
+    pkt->stream_index = stream;
+    pkt->pos = -1;
+    av_packet_rescale_ts(pkt, m_inputFC->streams[m_vidId]->time_base,
+                         m_outputFC->streams[stream]->time_base);
+    if (av_interleaved_write_frame(m_outputFC, pkt) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to write video packet");
+        return false;
+    }
+    return true;
+}
+
+bool SmartCutter::WriteAudio(AVPacket *pkt)
+{
+    AVStream *ist = m_inputFC->streams[pkt->stream_index];
+    int stream = m_streamMap[pkt->stream_index];
+    int64_t offset = av_rescale_q(m_offset,
+                                  m_inputFC->streams[m_vidId]->time_base,
+                                  ist->time_base);
+
+    pkt->pts -= offset;
+    pkt->dts = (pkt->dts != AV_NOPTS_VALUE) ? pkt->dts - offset : pkt->pts;
+    // The previous section may already have covered this frame
+    if (m_lastDts[stream] != AV_NOPTS_VALUE && pkt->dts <= m_lastDts[stream])
+        return true;
+    m_lastDts[stream] = pkt->dts;
+
+    pkt->stream_index = stream;
+    pkt->pos = -1;
+    av_packet_rescale_ts(pkt, ist->time_base,
+                         m_outputFC->streams[stream]->time_base);
+    if (av_interleaved_write_frame(m_outputFC, pkt) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to write audio packet");
+        return false;
+    }
+    return true;
+}
+
+/// Reports progress and returns false if the job has been stopped.
+bool SmartCutter::CheckStatus(float percent_done)
+{
+    if ((!m_showProgress && !m_updateStatus) ||
+        MythDate::current() <= m_statusTime)
+        return true;
+
+    if (m_updateStatus)
+        m_updateStatus(percent_done);
+    if (m_showProgress)
+        LOG(VB_GENERAL, LOG_INFO, QString("%1% complete")
+                .arg(percent_done, 0, 'f', 1));
+    if (m_checkAbort && m_checkAbort())
+        return false;
+    m_statusTime = MythDate::current().addSecs(m_statusUpdateTime);
+    return true;
+}
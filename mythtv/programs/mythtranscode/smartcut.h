@@ -0,0 +1,155 @@
+#ifndef SMARTCUT_H
+#define SMARTCUT_H
+
+// C++
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Qt
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+extern "C"
+{
+#include "libavcodec/avcodec.h"
+#include "libavformat/avformat.h"
+}
+
+// MythTV
+#include "libmythbase/programtypes.h"
+
+/// A run of frames of a smart cut, either copied or re-encoded.
+struct SmartCutSegment
+{
+    uint64_t m_start {0};     ///< First frame, in display order
+    uint64_t m_end   {0};     ///< Frame after the last one
+    bool     m_copy  {false}; ///< Whole GOPs, copied untouched
+
+    bool operator==(const SmartCutSegment &other) const
+    {
+        return m_start == other.m_start && m_end == other.m_end &&
+               m_copy == other.m_copy;
+    }
+};
+using SmartCutPlan = QList<SmartCutSegment>;
+
+/** \class SmartCutter
+ *  \brief Removes the cutlist from an H.264 or HEVC recording, re-encoding
+ *         only the frames around the cut points.
+ *
+ *  Every GOP that lies completely inside a kept section is copied as it
+ *  is. The partial GOPs at either end of a section are decoded from the
+ *  preceding keyframe and re-encoded, with the same codec, into a closed
+ *  GOP that starts with a keyframe carrying its own parameter sets.
+ *  Audio packets inside the kept sections are copied. Timestamps are
+ *  shifted after each cut so the output plays back without gaps.
+ *
+ *  Keyframes come from the recording's seek table when one is available,
+ *  otherwise from the key flags of the demuxed packets.
+ */
+class SmartCutter
+{
+  public:
+    SmartCutter(QString inf, QString outf, const frm_dir_map_t &deleteMap,
+                const frm_pos_map_t &seekTable, bool mkv, bool showprog,
+                void (*update_func)(float) = nullptr,
+                int (*check_func)() = nullptr);
+    ~SmartCutter();
+
+    int Start();
+
+    static SmartCutPlan BuildPlan(const frm_dir_map_t &deleteMap,
+                                  const std::vector<uint64_t> &keyframes,
+                                  uint64_t frames);
+
+  private:
+    enum Phase : std::uint8_t { kHead = 0, kCopy, kTail, kPhases };
+
+    struct VideoPacket
+    {
+        int64_t m_pts {AV_NOPTS_VALUE};
+        int64_t m_dts {AV_NOPTS_VALUE};
+        int64_t m_pos {-1};
+        bool    m_key {false};
+    };
+
+    struct Encode
+    {
+        AVCodecContext *m_decoder  {nullptr};
+        AVCodecContext *m_encoder  {nullptr};
+        int64_t         m_from     {AV_NOPTS_VALUE}; ///< first pts encoded
+        int64_t         m_to       {AV_NOPTS_VALUE}; ///< pts after the last
+        size_t          m_first    {0};   ///< decode index to start at
+        size_t          m_last     {0};   ///< last decode index needed
+        bool            m_active   {false};
+    };
+
+    bool InitInput();
+    bool InitOutput();
+    int  ScanVideo();
+    std::vector<uint64_t> Keyframes() const;
+    int64_t FramePts(uint64_t frame) const;
+    size_t  KeyframeBefore(int64_t pts) const;
+    bool    IsCopied(size_t index) const;
+
+    int  CutRange(const SmartCutPlan &range);
+    bool StartEncode(Encode &enc, int64_t from, int64_t to);
+    bool FeedEncode(Encode &enc, Phase phase, const AVPacket *pkt);
+    bool EncodeFrame(Encode &enc, Phase phase, AVFrame *frame);
+    bool ReceivePackets(Encode &enc, Phase phase);
+    static void CloseEncode(Encode &enc);
+
+    void Queue(Phase phase, AVPacket *pkt, bool encoded);
+    bool WriteQueued();
+    bool WriteVideo(AVPacket *pkt, bool encoded);
+    bool WriteAudio(AVPacket *pkt);
+    bool CheckStatus(float percent_done);
+
+    QString          m_infile;
+    QString          m_outfile;
+    frm_dir_map_t    m_deleteMap;
+    frm_pos_map_t    m_seekTable;
+    bool             m_mkv              {false};
+
+    AVFormatContext *m_inputFC          {nullptr};
+    AVFormatContext *m_outputFC         {nullptr};
+    int              m_vidId            {-1};
+    QHash<int,int>   m_streamMap;       ///< input stream -> output stream
+
+    std::vector<VideoPacket> m_packets; ///< video packets in decode order
+    std::vector<int64_t>     m_display; ///< video pts in display order
+    QHash<int64_t,size_t>    m_index;   ///< video pts -> decode index
+    std::vector<size_t>      m_keys;    ///< decode indexes of key packets
+    int64_t          m_frameDuration    {0};
+    int64_t          m_reorderDelay     {0};
+    int64_t          m_bitrate          {0};
+    int              m_gopSize          {0};
+
+    // Output state, in input stream time bases
+    int64_t          m_clock            {0};
+    int64_t          m_offset           {0};
+    size_t           m_copyFirst        {0}; ///< copied decode indexes
+    size_t           m_copyEnd          {0};
+    int64_t          m_copyFrom         {0}; ///< copied pts
+    int64_t          m_copyTo           {0};
+    QHash<int,int64_t> m_lastDts;       ///< output stream -> last dts
+    std::array<std::deque<std::pair<AVPacket*,bool>>,kPhases> m_queue;
+    std::array<bool,kPhases> m_phaseDone {};
+    uint64_t         m_keptFrames       {0};
+    uint64_t         m_copied           {0};
+    uint64_t         m_encoded          {0};
+
+    // Progress
+    bool             m_showProgress     {false};
+    void           (*m_updateStatus)(float) {nullptr};
+    int            (*m_checkAbort)()    {nullptr};
+    QDateTime        m_statusTime;
+    int              m_statusUpdateTime {5};
+    int64_t          m_fileSize         {0};
+};
+
+#endif // SMARTCUT_H
@@ -0,0 +1,198 @@
+/*
+ *  Class TestSmartCut
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "test_smartcut.h"
+#include "smartcut.h"
+
+using Keyframes = std::vector<uint64_t>;
+Q_DECLARE_METATYPE(frm_dir_map_t)
+Q_DECLARE_METATYPE(Keyframes)
+Q_DECLARE_METATYPE(SmartCutPlan)
+
+// Regular GOPs of the given length
+static Keyframes GOPs(uint64_t length, uint64_t frames)
+{
+    Keyframes keys;
+    for (uint64_t frame = 0; frame < frames; frame += length)
+        keys.push_back(frame);
+    return keys;
+}
+
+static frm_dir_map_t Cuts(std::initializer_list<std::pair<uint64_t,uint64_t>> cuts)
+{
+    frm_dir_map_t map;
+    for (const auto & [start, end] : cuts)
+    {
+        map[start] = MARK_CUT_START;
+        map[end] = MARK_CUT_END;
+    }
+    return map;
+}
+
+void TestSmartCut::Plan_data(void)
+{
+    QTest::addColumn<frm_dir_map_t>("cuts");
+    QTest::addColumn<Keyframes>("keyframes");
+    QTest::addColumn<SmartCutPlan>("expected");
+
+    const Keyframes gop12 = GOPs(12, 120);
+
+    QTest::newRow("nothing cut")
+        << frm_dir_map_t() << gop12
+        << SmartCutPlan{{0, 120, true}};
+    QTest::newRow("cut on keyframes")
+        << Cuts({{24, 60}}) << gop12
+        << SmartCutPlan{{0, 24, true}, {60, 120, true}};
+    QTest::newRow("cut inside GOPs")
+        << Cuts({{30, 65}}) << gop12
+        << SmartCutPlan{{0, 24, true}, {24, 30, false},
+                        {65, 72, false}, {72, 120, true}};
+    QTest::newRow("cut from the start")
+        << Cuts({{0, 5}}) << gop12
+        << SmartCutPlan{{5, 12, false}, {12, 120, true}};
+    QTest::newRow("cut to the end")
+        << Cuts({{100, 120}}) << gop12
+        << SmartCutPlan{{0, 96, true}, {96, 100, false}};
+    QTest::newRow("short section")
+        << Cuts({{10, 14}, {20, 50}}) << gop12
+        << SmartCutPlan{{0, 10, false}, {14, 20, false}, {50, 60, false},
+                        {60, 120, true}};
+    QTest::newRow("leading end mark")
+        << frm_dir_map_t{{40, MARK_CUT_END}} << gop12
+        << SmartCutPlan{{40, 48, false}, {48, 120, true}};
+    QTest::newRow("no keyframes")
+        << Cuts({{30, 65}}) << Keyframes()
+        << SmartCutPlan{{0, 30, false}, {65, 120, false}};
+}
+
+void TestSmartCut::Plan(void)
+{
+    QFETCH(frm_dir_map_t, cuts);
+    QFETCH(Keyframes, keyframes);
+    QFETCH(SmartCutPlan, expected);
+
+    SmartCutPlan plan = SmartCutter::BuildPlan(cuts, keyframes, 120);
+    QCOMPARE(plan.size(), expected.size());
+    for (int i = 0; i < plan.size(); ++i)
+    {
+        QCOMPARE(plan[i].m_start, expected[i].m_start);
+        QCOMPARE(plan[i].m_end, expected[i].m_end);
+        QCOMPARE(plan[i].m_copy, expected[i].m_copy);
+    }
+}
+
+void TestSmartCut::Corpus_data(void)
+{
+    QTest::addColumn<frm_dir_map_t>("cuts");
+    QTest::addColumn<Keyframes>("keyframes");
+    QTest::addColumn<uint64_t>("frames");
+
+    // A cut list typical of a commercial flagged recording, against the
+    // GOP structures of different broadcasts.
+    const frm_dir_map_t adverts = Cuts({{0, 1499}, {21017, 26460},
+                                        {51233, 56880}, {86011, 90000}});
+
+    // DVB-T2 H.264, 25 fps, 0.96 second GOPs
+    QTest::newRow("h264-24") << adverts << GOPs(24, 90000) << uint64_t{90000};
+    // ATSC 3.0 HEVC, 59.94 fps, two second GOPs
+    QTest::newRow("hevc-120") << adverts << GOPs(120, 90000) << uint64_t{90000};
+    // Satellite H.264 with irregular GOPs from scene change keyframes
+    Keyframes irregular;
+    for (uint64_t frame = 0, length = 7; frame < 90000; frame += length)
+    {
+        irregular.push_back(frame);
+        length = 7 + ((length * 13) % 50);
+    }
+    QTest::newRow("h264-irregular") << adverts << irregular << uint64_t{90000};
+    // HEVC with ten second GOPs, longer than some of the kept sections
+    frm_dir_map_t short_sections = Cuts({{100, 200}, {400, 650}, {700, 5000}});
+    QTest::newRow("hevc-long-gop") << short_sections << GOPs(600, 9000)
+                                   << uint64_t{9000};
+}
+
+/**
+ *  Checks that the plan keeps exactly the frames the cut list keeps, so
+ *  that the output has the expected duration and every cut lands on the
+ *  requested frame, and that only partial GOPs are re-encoded.
+ */
+void TestSmartCut::Corpus(void)
+{
+    QFETCH(frm_dir_map_t, cuts);
+    QFETCH(Keyframes, keyframes);
+    QFETCH(uint64_t, frames);
+
+    SmartCutPlan plan = SmartCutter::BuildPlan(cuts, keyframes, frames);
+
+    // Frame by frame, the plan keeps what the cut list keeps
+    std::vector<bool> kept(frames, false);
+    uint64_t previous = 0;
+    for (const auto & segment : std::as_const(plan))
+    {
+        QVERIFY(segment.m_start < segment.m_end);
+        QVERIFY(segment.m_start >= previous);
+        previous = segment.m_end;
+        for (uint64_t frame = segment.m_start; frame < segment.m_end; ++frame)
+            kept[frame] = true;
+    }
+
+    uint64_t expected = 0;
+    bool cutting = false;
+    auto mark = cuts.cbegin();
+    for (uint64_t frame = 0; frame < frames; ++frame)
+    {
+        while (mark != cuts.cend() && mark.key() <= frame)
+        {
+            cutting = (*mark == MARK_CUT_START);
+            ++mark;
+        }
+        QCOMPARE(bool(kept[frame]), !cutting);
+        expected += cutting ? 0 : 1;
+    }
+    QCOMPARE(static_cast<uint64_t>(std::count(kept.cbegin(), kept.cend(), true)),
+             expected);
+
+    // Copies run between keyframes, re-encodes stay within one GOP
+    uint64_t longest = 0;
+    for (size_t i = 1; i < keyframes.size(); ++i)
+        longest = std::max(longest, keyframes[i] - keyframes[i - 1]);
+    uint64_t encoded = 0;
+    for (const auto & segment : std::as_const(plan))
+    {
+        if (segment.m_copy)
+        {
+            QVERIFY(std::binary_search(keyframes.cbegin(), keyframes.cend(),
+                                       segment.m_start));
+            QVERIFY(segment.m_end == frames ||
+                    std::binary_search(keyframes.cbegin(), keyframes.cend(),
+                                       segment.m_end));
+        }
+        else
+        {
+            QVERIFY(segment.m_end - segment.m_start < longest);
+            encoded += segment.m_end - segment.m_start;
+        }
+    }
+    // Two partial GOPs at most for each cut
+    QVERIFY(encoded <= static_cast<uint64_t>(cuts.size()) * longest);
+}
+
+QTEST_APPLESS_MAIN(TestSmartCut)
@@ -296,6 +296,69 @@ static GlobalCheckBoxSetting *DeletesFollowLinks()
     return gc;
 };
 
+static GlobalCheckBoxSetting *SeekIndexFiles()
+{
+    auto *gc = new GlobalCheckBoxSetting("SeekIndexFiles");
+    gc->setLabel(QObject::tr("Write seek index files"));
+    gc->setValue(false);
+    gc->setHelpText(QObject::tr("If enabled, recorders also write the seek "
+                    "table to a compact file stored next to each new "
+                    "recording. Playback reads this file instead of loading "
+                    "the seek table from the database, which is much faster "
+                    "for long recordings."));
+    return gc;
+};
+
+static GlobalCheckBoxSetting *RecordingWriterGroups()
+{
+    auto *gc = new GlobalCheckBoxSetting("RecordingWriterGroups");
+    gc->setLabel(QObject::tr("Share file writers between recordings"));
+    gc->setValue(false);
+    gc->setHelpText(QObject::tr("If enabled, the recordings made at the same "
+                    "time from one tuner are written to disk by a single "
+                    "thread, using fewer and larger writes. A slow disk "
+                    "then delays every recording from that tuner. If "
+                    "disabled, each recording has its own writer."));
+    return gc;
+};
+
+static GlobalCheckBoxSetting *TrickPlayThumbnails()
+{
+    auto *gc = new GlobalCheckBoxSetting("TrickPlayThumbnails");
+    gc->setLabel(QObject::tr("Build trick-play thumbnails"));
+    gc->setValue(false);
+    gc->setHelpText(QObject::tr("If enabled, the backend builds sheets of "
+                    "small keyframe thumbnails next to each finished "
+                    "recording, so clients can show where they are when "
+                    "scrubbing through it without reading the recording."));
+    return gc;
+};
+
+static GlobalSpinBoxSetting *HLSConcurrentFetches()
+{
+    auto *gc = new GlobalSpinBoxSetting("HLSConcurrentFetches", 1, 8, 1);
+    gc->setLabel(QObject::tr("HLS concurrent segment downloads"));
+    gc->setValue(3);
+    gc->setHelpText(QObject::tr("Number of segments an HLS recorder "
+                    "downloads at the same time. More parallel downloads "
+                    "keep up with servers that are slow to respond, at the "
+                    "cost of more connections to the server."));
+    return gc;
+};
+
+static GlobalCheckBoxSetting *LiveTVPreTune()
+{
+    auto *gc = new GlobalCheckBoxSetting("LiveTVPreTune");
+    gc->setLabel(QObject::tr("Pre-tune idle tuners for LiveTV"));
+    gc->setValue(false);
+    gc->setHelpText(QObject::tr("While LiveTV is being watched, keep idle "
+                    "tuners on the same video source tuned to the channels "
+                    "most likely to be selected next, so that changing to "
+                    "one of them is faster. Idle tuners are released as "
+                    "soon as they are needed for a recording."));
+    return gc;
+};
+
 static GlobalSpinBoxSetting *HDRingbufferSize()
 {
     auto *bs = new GlobalSpinBoxSetting(
@@ -710,6 +773,22 @@ static GlobalCheckBoxSetting *AutoCommflagWhileRecording()
     return gc;
 };
 
+static GlobalCheckBoxSetting *JobCommFlagCaptions()
+{
+    auto *gc = new GlobalCheckBoxSetting("JobCommFlagCaptions");
+    gc->setLabel(QObject::tr("Commercial detection also extracts captions"));
+    gc->setValue(false);
+    gc->setHelpText(QObject::tr("If enabled, commercial detection jobs also "
+                                "write the closed captions and subtitles of "
+                                "the recording to files next to it, in the "
+                                "same pass over the video. This is an option "
+                                "of commercial detection, not a job of its "
+                                "own, and only applies when the "
+                                "commercial-detection command is "
+                                "mythcommflag."));
+    return gc;
+};
+
 static GlobalTextEditSetting *UserJob(uint job_num)
 {
     auto *gc = new GlobalTextEditSetting(QString("UserJob%1").arg(job_num));
@@ -980,6 +1059,9 @@ BackendSettings::BackendSettings()
     fm->addChild(DeletesFollowLinks());
     fm->addChild(TruncateDeletes());
     fm->addChild(HDRingbufferSize());
+    fm->addChild(SeekIndexFiles());
+    fm->addChild(RecordingWriterGroups());
+    fm->addChild(TrickPlayThumbnails());
     fm->addChild(StorageScheduler());
     group2->addChild(fm);
     auto* upnp = new GroupSetting();
@@ -990,6 +1072,8 @@ BackendSettings::BackendSettings()
     group2->addChild(MiscStatusScript());
     group2->addChild(DisableAutomaticBackup());
     group2->addChild(DisableFirewireReset());
+    group2->addChild(HLSConcurrentFetches());
+    group2->addChild(LiveTVPreTune());
     addChild(group2);
 
     auto* group2a1 = new GroupSetting();
@@ -1059,6 +1143,7 @@ BackendSettings::BackendSettings()
     group6->addChild(JobsRunOnRecordHost());
     group6->addChild(AutoCommflagWhileRecording());
     group6->addChild(JobQueueCommFlagCommand());
+    group6->addChild(JobCommFlagCaptions());
     group6->addChild(JobQueueTranscodeCommand());
     group6->addChild(AutoTranscodeBeforeAutoCommflag());
     group6->addChild(SaveTranscoding());
@@ -12,6 +12,7 @@ using std::cout;
 // libmyth* includes
 #include "libmythbase/exitcodes.h"
 #include "libmythbase/mythlogging.h"
+#include "libmythtv/seekindexfile.h"
 
 // Local includes
 #include "markuputils.h"
@@ -194,6 +195,46 @@ static int ClearSeekTable(const MythUtilCommandLineParser &cmdline)
     pginfo.ClearPositionMap(MARK_DURATION_MS);
     pginfo.ClearMarkupFlag(MARK_DURATION_MS);
     pginfo.ClearMarkupFlag(MARK_TOTAL_FRAMES);
+    SeekIndexFile::Remove(pginfo.GetPlaybackURL(false, true));
+
+    return GENERIC_EXIT_OK;
+}
+
+static int WriteSeekIndex(const MythUtilCommandLineParser &cmdline)
+{
+    ProgramInfo pginfo;
+    if (!GetProgramInfo(cmdline, pginfo))
+        return GENERIC_EXIT_NO_RECORDING_DATA;
+
+    QString filename = pginfo.GetPlaybackURL(false, true);
+    if (filename.isEmpty() || filename.startsWith("myth://"))
+    {
+        LOG(VB_STDIO|VB_FLUSH, LOG_ERR,
+            QString("Recording file '%1' is not stored on this host\n")
+                .arg(filename));
+        return GENERIC_EXIT_NOT_OK;
+    }
+
+    QMap<MarkTypes, frm_pos_map_t> maps;
+    int entries = 0;
+    for (MarkTypes type : { MARK_GOP_BYFRAME, MARK_GOP_START,
+                            MARK_KEYFRAME, MARK_DURATION_MS })
+    {
+        pginfo.QueryPositionMap(maps[type], type);
+        entries += maps[type].size();
+    }
+
+    if (entries == 0)
+    {
+        cout << "No seek table to write\n";
+        return GENERIC_EXIT_NOT_OK;
+    }
+
+    cout << QString("Writing %1 seek table entries to %2\n")
+        .arg(entries).arg(SeekIndexFile::IndexName(filename))
+        .toLocal8Bit().constData();
+    if (!SeekIndexFile::Write(filename, maps))
+        return GENERIC_EXIT_NOT_OK;
 
     return GENERIC_EXIT_OK;
 }
@@ -359,6 +400,9 @@ static int SetMarkup(const MythUtilCommandLineParser &cmdline)
         }
     }
     pginfo.SaveMarkup(mapMark, mapSeek);
+    // The seek index would still hold the seektable that was replaced
+    if (!mapSeek.isEmpty())
+        SeekIndexFile::Remove(pginfo.GetPlaybackURL(false, true));
 
     return GENERIC_EXIT_OK;
 }
@@ -373,6 +417,7 @@ void registerMarkupUtils(UtilMap &utilMap)
     utilMap["setskiplist"]            = &SetSkipList;
     utilMap["clearskiplist"]          = &ClearSkipList;
     utilMap["clearseektable"]         = &ClearSeekTable;
+    utilMap["writeseekindex"]         = &WriteSeekIndex;
     utilMap["clearbookmarks"]         = &ClearBookmarks;
     utilMap["getmarkup"]              = &GetMarkup;
     utilMap["setmarkup"]              = &SetMarkup;
@@ -73,6 +73,15 @@ void MythUtilCommandLineParser::LoadArguments(void)
                 "Clear the seek table.", "")
                 ->SetGroup("Recording Markup")
                 ->SetParentOf(ChanidStartimeVideo)
+        << add("--writeseekindex", "writeseekindex", false,
+                "Write the seek table to a seek index file.",
+                "This command copies the seek table of a recording from "
+                "the database into a compact seek index file stored next "
+                "to the recording, which playback then uses instead of "
+                "the database. It must be run on the backend that holds "
+                "the recording.")
+                ->SetGroup("Recording Markup")
+                ->SetParentOf(ChanidStartimeVideo)
         << add("--clearbookmarks", "clearbookmarks", false,
                 "Clear all bookmarks.", "This command will reset the playback "
                 "start to the very beginning of the recording file.")
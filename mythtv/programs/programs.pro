@@ -34,9 +34,18 @@ using_backend {
     unix:QMAKE_EXTRA_TARGETS += mythbackend-test
 }
 
-using_mythtranscode: SUBDIRS += mythtranscode
+using_mythtranscode {
+    SUBDIRS += mythtranscode
+
+    # unit tests mythtranscode
+    mythtranscode-test.depends = sub-mythtranscode
+    mythtranscode-test.target = buildtestmythtranscode
+    mythtranscode-test.commands = cd mythtranscode/test && $(QMAKE) && $(MAKE)
+    unix:QMAKE_EXTRA_TARGETS += mythtranscode-test
+}
 
 unittest.depends = mythfrontend-test mythbackend-test
+using_mythtranscode: unittest.depends += mythtranscode-test
 unittest.target = test
 unittest.commands = scripts/unittests.sh
 unix:QMAKE_EXTRA_TARGETS += unittest